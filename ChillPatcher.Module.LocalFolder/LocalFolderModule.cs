@@ -91,7 +91,7 @@ namespace ChillPatcher.Module.LocalFolder
             context.Logger.LogInfo($"[{DisplayName}] 数据库位置: {dbPath}");
 
             // 初始化封面加载器
-            _coverLoader = new CoverLoader(_database, context.DefaultCover, context.Logger);
+            _coverLoader = new CoverLoader(_database, context.DefaultCover, context.CoverThumbnails, context.Logger);
 
             // 初始化文件夹扫描器
             _scanner = new FolderScanner(
@@ -255,6 +255,9 @@ namespace ChillPatcher.Module.LocalFolder
                     {
                         album.Artist = jsonArtist;
                     }
+
+                    // 已保存的封面占位图，封面加载完成前显示模糊预览
+                    album.CoverPlaceholder = _coverLoader.GetAlbumPlaceholder(album.DirectoryPath);
                 }
                 
                 _context.AlbumRegistry.RegisterAlbum(album, ModuleId);
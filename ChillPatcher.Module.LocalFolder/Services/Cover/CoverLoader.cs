@@ -4,6 +4,7 @@ using System.IO;
 using System.Threading.Tasks;
 using BepInEx.Logging;
 using ChillPatcher.SDK.Interfaces;
+using ChillPatcher.SDK.Models;
 using UnityEngine;
 
 namespace ChillPatcher.Module.LocalFolder.Services.Cover
@@ -18,14 +19,19 @@ namespace ChillPatcher.Module.LocalFolder.Services.Cover
         private readonly ManualLogSource _logger;
         private readonly CoverSearcher _searcher;
         private readonly ImageLoader _imageLoader;
+        private readonly ICoverThumbnailLoader _thumbnails;
+
+        // 压缩缩略图边长（与主界面封面分辨率一致）
+        private const int THUMBNAIL_SIZE = 256;
 
         // 内存缓存
         private readonly Dictionary<string, Sprite> _spriteCache = new Dictionary<string, Sprite>();
 
-        public CoverLoader(LocalDatabase database, IDefaultCoverProvider defaultCover, ManualLogSource logger)
+        public CoverLoader(LocalDatabase database, IDefaultCoverProvider defaultCover, ICoverThumbnailLoader thumbnails, ManualLogSource logger)
         {
             _database = database;
             _defaultCover = defaultCover;
+            _thumbnails = thumbnails;
             _logger = logger;
             _searcher = new CoverSearcher();
             _imageLoader = new ImageLoader(logger);
@@ -51,11 +57,18 @@ namespace ChillPatcher.Module.LocalFolder.Services.Cover
 
             Sprite cover = null;
 
-            // 1. 尝试从音频文件内嵌封面读取
-            var audioBytes = await _imageLoader.ExtractAudioCoverAsync(filePath);
-            if (audioBytes != null)
+            // 1. 尝试从音频文件内嵌封面读取（FLAC 优先使用压缩缩略图缓存）
+            if (IsFlacFile(filePath))
+            {
+                cover = await LoadThumbnailAsync(filePath);
+            }
+            if (cover == null)
             {
-                cover = _imageLoader.CreateSpriteFromBytes(audioBytes);
+                var audioBytes = await _imageLoader.ExtractAudioCoverAsync(filePath);
+                if (audioBytes != null)
+                {
+                    cover = _imageLoader.CreateSpriteFromBytes(audioBytes);
+                }
             }
 
             // 2. 如果没有，尝试从目录封面读取
@@ -101,6 +114,7 @@ namespace ChillPatcher.Module.LocalFolder.Services.Cover
                 if (cover != null)
                 {
                     _spriteCache[cacheKey] = cover;
+                    EnsureAlbumPlaceholder(cacheKey, dbCache.Value.coverPath, (CoverSourceType)dbCache.Value.sourceType);
                     return cover;
                 }
                 // 缓存失效
@@ -116,6 +130,7 @@ namespace ChillPatcher.Module.LocalFolder.Services.Cover
                 {
                     _spriteCache[cacheKey] = cover;
                     _database.SaveCoverCache(cacheKey, coverPath, (int)sourceType);
+                    EnsureAlbumPlaceholder(cacheKey, coverPath, sourceType);
                     return cover;
                 }
             }
@@ -124,6 +139,46 @@ namespace ChillPatcher.Module.LocalFolder.Services.Cover
             return _defaultCover.DefaultAlbumCover;
         }
 
+        /// <summary>
+        /// 获取专辑的封面占位图（保存在封面缓存中，首次加载到封面后生成），没有时返回 null
+        /// </summary>
+        public CoverPlaceholder GetAlbumPlaceholder(string directoryPath)
+        {
+            if (string.IsNullOrEmpty(directoryPath))
+                return null;
+
+            return CoverPlaceholder.Parse(_database.GetCoverPlaceholder($"album:{directoryPath}"));
+        }
+
+        /// <summary>
+        /// 缓存中还没有占位图时在后台生成并保存，不阻塞封面显示
+        /// </summary>
+        private void EnsureAlbumPlaceholder(string cacheKey, string coverPath, CoverSourceType sourceType)
+        {
+            if (_thumbnails == null || !_thumbnails.IsAvailable)
+                return;
+            if (sourceType != CoverSourceType.ImageFile && !IsFlacFile(coverPath))
+                return;
+            if (_database.GetCoverPlaceholder(cacheKey) != null)
+                return;
+
+            _ = SaveAlbumPlaceholderAsync(cacheKey, coverPath);
+        }
+
+        private async Task SaveAlbumPlaceholderAsync(string cacheKey, string coverPath)
+        {
+            try
+            {
+                var placeholder = await _thumbnails.LoadPlaceholderAsync(coverPath);
+                if (placeholder != null)
+                    _database.SaveCoverPlaceholder(cacheKey, placeholder.ToString());
+            }
+            catch (Exception ex)
+            {
+                _logger.LogDebug($"生成封面占位图失败 [{coverPath}]: {ex.Message}");
+            }
+        }
+
         /// <summary>
         /// 获取歌单封面（仅从目录图片加载）
         /// </summary>
@@ -163,6 +218,13 @@ namespace ChillPatcher.Module.LocalFolder.Services.Cover
 
         private async Task<Sprite> LoadFromPathAsync(string path, CoverSourceType sourceType)
         {
+            if (sourceType == CoverSourceType.ImageFile || IsFlacFile(path))
+            {
+                var thumbnail = await LoadThumbnailAsync(path);
+                if (thumbnail != null)
+                    return thumbnail;
+            }
+
             byte[] bytes = null;
             if (sourceType == CoverSourceType.ImageFile)
             {
@@ -176,6 +238,22 @@ namespace ChillPatcher.Module.LocalFolder.Services.Cover
             return bytes != null ? _imageLoader.CreateSpriteFromBytes(bytes) : null;
         }
 
+        /// <summary>
+        /// 通过主程序的缩略图管线加载（Native 解码并压缩，结果持久化缓存），不可用时返回 null
+        /// </summary>
+        private async Task<Sprite> LoadThumbnailAsync(string path)
+        {
+            if (_thumbnails == null || !_thumbnails.IsAvailable)
+                return null;
+
+            return await _thumbnails.LoadThumbnailAsync(path, THUMBNAIL_SIZE, false);
+        }
+
+        private static bool IsFlacFile(string path)
+        {
+            return string.Equals(Path.GetExtension(path), ".flac", StringComparison.OrdinalIgnoreCase);
+        }
+
         private async Task<Sprite> LoadFromCacheDataAsync(string path, int sourceType)
         {
             if (!File.Exists(path))
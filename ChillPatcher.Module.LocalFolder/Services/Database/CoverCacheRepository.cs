@@ -57,6 +57,34 @@ namespace ChillPatcher.Module.LocalFolder.Services.Database
             }
         }
 
+        /// <summary>
+        /// 获取缓存的封面占位图（CoverPlaceholder.ToString 的结果）
+        /// </summary>
+        public string GetCoverPlaceholder(string cacheKey)
+        {
+            var sql = "SELECT placeholder FROM cover_cache WHERE cache_key = @key";
+            using (var cmd = new SQLiteCommand(sql, _connection))
+            {
+                cmd.Parameters.AddWithValue("@key", cacheKey);
+                var result = cmd.ExecuteScalar();
+                return result == null || result == DBNull.Value ? null : (string)result;
+            }
+        }
+
+        /// <summary>
+        /// 保存封面占位图（封面路径变化时 SaveCoverCache 会整行替换，占位图随之失效）
+        /// </summary>
+        public void SaveCoverPlaceholder(string cacheKey, string placeholder)
+        {
+            var sql = "UPDATE cover_cache SET placeholder = @placeholder WHERE cache_key = @key";
+            using (var cmd = new SQLiteCommand(sql, _connection))
+            {
+                cmd.Parameters.AddWithValue("@key", cacheKey);
+                cmd.Parameters.AddWithValue("@placeholder", (object)placeholder ?? DBNull.Value);
+                cmd.ExecuteNonQuery();
+            }
+        }
+
         /// <summary>
         /// 移除封面缓存
         /// </summary>
@@ -10,7 +10,7 @@ namespace ChillPatcher.Module.LocalFolder.Services.Database
     /// </summary>
     public class DatabaseCore : IDisposable
     {
-        private const int DB_VERSION = 3;
+        private const int DB_VERSION = 4;
         private readonly string _dbPath;
         private readonly ManualLogSource _logger;
         private SQLiteConnection _connection;
@@ -104,7 +104,8 @@ namespace ChillPatcher.Module.LocalFolder.Services.Database
                     cache_key TEXT PRIMARY KEY,
                     cover_path TEXT,
                     source_type INTEGER DEFAULT 0,
-                    cached_at TEXT NOT NULL
+                    cached_at TEXT NOT NULL,
+                    placeholder TEXT
                 );
 
                 CREATE INDEX IF NOT EXISTS idx_favorites_uuid ON favorites(uuid);
@@ -158,6 +159,11 @@ namespace ChillPatcher.Module.LocalFolder.Services.Database
                     MigrateToV3();
                 }
 
+                if (currentVersion < 4)
+                {
+                    MigrateToV4();
+                }
+
                 var updateVersion = $"UPDATE db_version SET version = {DB_VERSION}";
                 using (var cmd = new SQLiteCommand(updateVersion, _connection))
                 {
@@ -183,6 +189,32 @@ namespace ChillPatcher.Module.LocalFolder.Services.Database
             }
         }
 
+        private void MigrateToV4()
+        {
+            // cover_cache 增加封面占位图列（新建的表已经包含该列）
+            var hasColumn = false;
+            using (var cmd = new SQLiteCommand("PRAGMA table_info(cover_cache)", _connection))
+            using (var reader = cmd.ExecuteReader())
+            {
+                while (reader.Read())
+                {
+                    if (reader.GetString(1) == "placeholder")
+                    {
+                        hasColumn = true;
+                        break;
+                    }
+                }
+            }
+
+            if (!hasColumn)
+            {
+                using (var cmd = new SQLiteCommand("ALTER TABLE cover_cache ADD COLUMN placeholder TEXT", _connection))
+                {
+                    cmd.ExecuteNonQuery();
+                }
+            }
+        }
+
         public void Dispose()
         {
             _connection?.Close();
@@ -86,6 +86,8 @@ namespace ChillPatcher.Module.LocalFolder.Services
 
         public (string coverPath, int sourceType)? GetCoverCache(string cacheKey) => _coverCache.GetCoverCache(cacheKey);
         public void SaveCoverCache(string cacheKey, string coverPath, int sourceType) => _coverCache.SaveCoverCache(cacheKey, coverPath, sourceType);
+        public string GetCoverPlaceholder(string cacheKey) => _coverCache.GetCoverPlaceholder(cacheKey);
+        public void SaveCoverPlaceholder(string cacheKey, string placeholder) => _coverCache.SaveCoverPlaceholder(cacheKey, placeholder);
         public void RemoveCoverCache(string cacheKey) => _coverCache.RemoveCoverCache(cacheKey);
         public void ClearAllCoverCache() => _coverCache.ClearAllCoverCache();
 
@@ -188,21 +188,28 @@ namespace ChillPatcher.Module.LocalFolder.Services.Scanner
             // 自动创建 playlist.json（如果不存在）
             MetadataReader.EnsurePlaylistMetadata(playlistDir, playlistDisplayName);
 
+            // 先列出整个歌单的音频文件（专辑内递归两层 + 散装），一次性批量探测元数据
+            var albumFiles = albumDirs
+                .Select(dir => AudioFileHelper.GetAudioFilesRecursive(dir, 1).ToList())
+                .ToList();
+            var looseAudioFiles = AudioFileHelper.GetAudioFiles(playlistDir).ToList();
+            var metadata = ProbeMetadata(albumFiles.SelectMany(files => files).Concat(looseAudioFiles).ToList());
+
             // 扫描子目录作为专辑
-            foreach (var albumDir in albumDirs)
+            for (int albumIndex = 0; albumIndex < albumDirs.Length; albumIndex++)
             {
+                var albumDir = albumDirs[albumIndex];
                 var albumName = Path.GetFileName(albumDir);
                 var albumId = $"{tagId}_{albumName}";
                 var albumDisplayName = MetadataReader.ReadAlbumName(albumDir) ?? albumName;
                 var albumArtist = MetadataReader.ReadAlbumArtist(albumDir);
 
-                // 扫描专辑内的音频文件（递归两层）
-                var audioFiles = AudioFileHelper.GetAudioFilesRecursive(albumDir, 1);
+                var audioFiles = albumFiles[albumIndex];
                 var musicList = new System.Collections.Generic.List<MusicInfo>();
                 
                 foreach (var file in audioFiles)
                 {
-                    var music = CreateMusicInfo(file, tagId, albumId);
+                    var music = CreateMusicInfo(file, tagId, albumId, metadata);
                     musicList.Add(music);
                     result.Music.Add(music);
                 }
@@ -227,15 +234,14 @@ namespace ChillPatcher.Module.LocalFolder.Services.Scanner
                 result.Albums.Add(album);
             }
 
-            // 扫描歌单目录下的散装音频（归入默认专辑，使用歌单名称）
-            var looseAudioFiles = AudioFileHelper.GetAudioFiles(playlistDir).ToList();
+            // 歌单目录下的散装音频（归入默认专辑，使用歌单名称）
             if (looseAudioFiles.Any())
             {
                 var defaultAlbumId = $"{tagId}_other";
 
                 foreach (var file in looseAudioFiles)
                 {
-                    var music = CreateMusicInfo(file, tagId, defaultAlbumId);
+                    var music = CreateMusicInfo(file, tagId, defaultAlbumId, metadata);
                     result.Music.Add(music);
                 }
 
@@ -252,29 +258,63 @@ namespace ChillPatcher.Module.LocalFolder.Services.Scanner
             }
         }
 
-        private MusicInfo CreateMusicInfo(string filePath, string tagId, string albumId)
+        /// <summary>
+        /// 批量探测元数据（主程序在 Native 线程池上并发读取），返回 路径 → 元数据，不支持的文件不在其中
+        /// </summary>
+        private System.Collections.Generic.Dictionary<string, AudioFileMetadata> ProbeMetadata(
+            System.Collections.Generic.List<string> files)
+        {
+            var metadata = new System.Collections.Generic.Dictionary<string, AudioFileMetadata>(StringComparer.OrdinalIgnoreCase);
+            if (_audioLoader == null || files.Count == 0)
+                return metadata;
+
+            var results = _audioLoader.ProbeMetadataBatch(files);
+            for (int i = 0; i < files.Count; i++)
+            {
+                if (results[i] != null)
+                    metadata[files[i]] = results[i];
+            }
+            return metadata;
+        }
+
+        private MusicInfo CreateMusicInfo(string filePath, string tagId, string albumId,
+            System.Collections.Generic.Dictionary<string, AudioFileMetadata> metadata)
         {
             var fileName = Path.GetFileNameWithoutExtension(filePath);
             // 基于相对路径生成 UUID，确保目录迁移不影响 UUID
             var relativePath = GetRelativePath(filePath);
             var uuid = GenerateUUIDFromRelativePath(relativePath);
 
-            // 使用 TagLib 读取元数据
             string title = fileName;
             string artist = null;
-            try
+            float duration = 0f;
+
+            // 优先使用主程序批量探测的结果（FLAC 只读取元数据块），不支持时回退到 TagLib
+            if (metadata.TryGetValue(filePath, out var probed))
             {
-                using (var tagFile = TagLib.File.Create(filePath))
-                {
-                    if (!string.IsNullOrEmpty(tagFile.Tag.Title))
-                        title = tagFile.Tag.Title;
-                    if (!string.IsNullOrEmpty(tagFile.Tag.FirstPerformer))
-                        artist = tagFile.Tag.FirstPerformer;
-                }
+                if (!string.IsNullOrEmpty(probed.Title))
+                    title = probed.Title;
+                artist = string.IsNullOrEmpty(probed.Artist) ? null : probed.Artist;
+                duration = probed.Duration;
             }
-            catch (Exception ex)
+            else
             {
-                _logger?.LogWarning($"Failed to read metadata from {filePath}: {ex.Message}");
+                try
+                {
+                    using (var tagFile = TagLib.File.Create(filePath))
+                    {
+                        if (!string.IsNullOrEmpty(tagFile.Tag.Title))
+                            title = tagFile.Tag.Title;
+                        if (!string.IsNullOrEmpty(tagFile.Tag.FirstPerformer))
+                            artist = tagFile.Tag.FirstPerformer;
+                        if (tagFile.Properties != null)
+                            duration = (float)tagFile.Properties.Duration.TotalSeconds;
+                    }
+                }
+                catch (Exception ex)
+                {
+                    _logger?.LogWarning($"Failed to read metadata from {filePath}: {ex.Message}");
+                }
             }
 
             return new MusicInfo
@@ -286,6 +326,7 @@ namespace ChillPatcher.Module.LocalFolder.Services.Scanner
                 TagId = tagId,
                 SourceType = MusicSourceType.File,
                 SourcePath = filePath,
+                Duration = duration,
                 IsUnlocked = true
             };
         }
@@ -1,4 +1,6 @@
+using System.Collections.Generic;
 using System.Threading.Tasks;
+using ChillPatcher.SDK.Models;
 using UnityEngine;
 
 namespace ChillPatcher.SDK.Interfaces
@@ -62,9 +64,54 @@ namespace ChillPatcher.SDK.Interfaces
         /// <returns>元组: (AudioClip, Title, Artist)</returns>
         Task<(AudioClip clip, string title, string artist)> LoadWithMetadataAsync(string filePath);
 
+        /// <summary>
+        /// 只读取文件头部的元数据（不加载音频，可在任意线程调用）
+        /// </summary>
+        /// <param name="filePath">文件路径</param>
+        /// <returns>元数据，格式不支持快速探测或读取失败时返回 null（调用者可回退到其他方式）</returns>
+        AudioFileMetadata ProbeMetadata(string filePath);
+
+        /// <summary>
+        /// 批量读取元数据（支持的格式在 Native 线程池上并发探测，适合扫描大量文件）
+        /// </summary>
+        /// <param name="filePaths">文件路径</param>
+        /// <returns>与 filePaths 一一对应的结果，不支持快速探测或读取失败的项为 null</returns>
+        AudioFileMetadata[] ProbeMetadataBatch(IList<string> filePaths);
+
         /// <summary>
         /// 卸载 AudioClip
         /// </summary>
         void UnloadClip(AudioClip clip);
     }
+
+    /// <summary>
+    /// 封面缩略图加载器
+    /// 由主程序实现，在 Native 中解码、缩放并压缩为 GPU 纹理格式（DXT1 / DXT5），结果持久化缓存
+    /// </summary>
+    public interface ICoverThumbnailLoader
+    {
+        /// <summary>
+        /// Native 缩略图管线是否可用（不可用时调用者应使用自己的加载方式）
+        /// </summary>
+        bool IsAvailable { get; }
+
+        /// <summary>
+        /// 加载封面缩略图（需在主线程调用，解码和压缩在后台线程按优先级完成）
+        /// </summary>
+        /// <param name="sourcePath">FLAC 文件（读取内嵌封面）或图片文件（JPEG / PNG / BMP / GIF）路径</param>
+        /// <param name="size">边长（像素，4 的倍数）</param>
+        /// <param name="circular">是否应用圆形遮罩</param>
+        /// <returns>缩略图 Sprite，不可用、没有封面或格式不支持时返回 null</returns>
+        /// <exception cref="System.OperationCanceledException">
+        /// 请求所属的列表项滚出预加载范围、被主程序取消（调用者不应把这种情况当作没有封面缓存下来）
+        /// </exception>
+        Task<Sprite> LoadThumbnailAsync(string sourcePath, int size, bool circular);
+
+        /// <summary>
+        /// 计算封面占位图（主色 + blurhash），结果很小，适合与曲库索引一起保存
+        /// </summary>
+        /// <param name="sourcePath">FLAC 文件或图片文件路径</param>
+        /// <returns>占位图，不可用或没有封面时返回 null</returns>
+        Task<CoverPlaceholder> LoadPlaceholderAsync(string sourcePath);
+    }
 }
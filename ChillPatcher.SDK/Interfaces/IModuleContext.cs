@@ -55,6 +55,12 @@ namespace ChillPatcher.SDK.Interfaces
         /// </summary>
         IAudioLoader AudioLoader { get; }
 
+        /// <summary>
+        /// 封面缩略图加载器
+        /// 用于生成压缩纹理格式的封面缩略图（带持久化缓存）
+        /// </summary>
+        ICoverThumbnailLoader CoverThumbnails { get; }
+
         /// <summary>
         /// 依赖加载器
         /// 用于加载原生 DLL 依赖
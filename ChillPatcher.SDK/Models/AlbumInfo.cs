@@ -62,6 +62,11 @@ namespace ChillPatcher.SDK.Models
         /// </summary>
         public string CoverPath { get; set; }
 
+        /// <summary>
+        /// 封面占位图 (可选，封面加载完成前代替加载图显示)
+        /// </summary>
+        public CoverPlaceholder CoverPlaceholder { get; set; }
+
         /// <summary>
         /// 专辑中的歌曲数量 (运行时计算)
         /// </summary>
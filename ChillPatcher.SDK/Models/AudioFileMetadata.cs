@@ -0,0 +1,48 @@
+namespace ChillPatcher.SDK.Models
+{
+    /// <summary>
+    /// 音频文件元数据（只读取文件头部得到，不加载音频）
+    /// </summary>
+    public class AudioFileMetadata
+    {
+        /// <summary>
+        /// 标题（文件中没有时为 null）
+        /// </summary>
+        public string Title { get; set; }
+
+        /// <summary>
+        /// 艺术家（文件中没有时为 null）
+        /// </summary>
+        public string Artist { get; set; }
+
+        /// <summary>
+        /// 专辑（文件中没有时为 null）
+        /// </summary>
+        public string Album { get; set; }
+
+        /// <summary>
+        /// 时长 (秒)，无法确定时为 0
+        /// </summary>
+        public float Duration { get; set; }
+
+        /// <summary>
+        /// 采样率
+        /// </summary>
+        public int SampleRate { get; set; }
+
+        /// <summary>
+        /// 声道数
+        /// </summary>
+        public int Channels { get; set; }
+
+        /// <summary>
+        /// 位深
+        /// </summary>
+        public int BitsPerSample { get; set; }
+
+        /// <summary>
+        /// 是否内嵌封面
+        /// </summary>
+        public bool HasCover { get; set; }
+    }
+}
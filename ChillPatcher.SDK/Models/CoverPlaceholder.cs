@@ -0,0 +1,80 @@
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+using System.Text;
+using UnityEngine;
+
+namespace ChillPatcher.SDK.Models
+{
+    /// <summary>
+    /// 封面占位图（封面加载完成前显示的模糊预览）
+    /// 只有几十个字节，可以和曲库索引一起保存，显示时无需解码任何图片
+    /// </summary>
+    public class CoverPlaceholder
+    {
+        /// <summary>
+        /// blurhash 字符串（4×3 分量）
+        /// </summary>
+        public string Blurhash { get; set; }
+
+        /// <summary>
+        /// 主色（按占比从大到小）
+        /// </summary>
+        public Color32[] DominantColors { get; set; } = new Color32[0];
+
+        /// <summary>
+        /// 各主色覆盖的像素比例（与 DominantColors 一一对应）
+        /// </summary>
+        public float[] Weights { get; set; } = new float[0];
+
+        /// <summary>
+        /// 序列化为紧凑字符串：blurhash;RRGGBB:百分比;...（用于保存到数据库）
+        /// </summary>
+        public override string ToString()
+        {
+            var sb = new StringBuilder(Blurhash ?? string.Empty);
+            for (int i = 0; i < DominantColors.Length; i++)
+            {
+                var c = DominantColors[i];
+                int percent = i < Weights.Length ? Mathf.RoundToInt(Weights[i] * 100f) : 0;
+                sb.Append($";{c.r:X2}{c.g:X2}{c.b:X2}:{percent}");
+            }
+            return sb.ToString();
+        }
+
+        /// <summary>
+        /// 从 ToString 的结果还原，格式无效时返回 null
+        /// </summary>
+        public static CoverPlaceholder Parse(string value)
+        {
+            if (string.IsNullOrEmpty(value))
+                return null;
+
+            var parts = value.Split(';');
+            var colors = new List<Color32>();
+            var weights = new List<float>();
+            for (int i = 1; i < parts.Length; i++)
+            {
+                var fields = parts[i].Split(':');
+                if (fields.Length != 2 || fields[0].Length != 6 ||
+                    !uint.TryParse(fields[0], NumberStyles.HexNumber, CultureInfo.InvariantCulture, out var rgb) ||
+                    !int.TryParse(fields[1], NumberStyles.Integer, CultureInfo.InvariantCulture, out var percent))
+                {
+                    return null;
+                }
+                colors.Add(new Color32((byte)(rgb >> 16), (byte)(rgb >> 8), (byte)rgb, 255));
+                weights.Add(percent / 100f);
+            }
+
+            if (string.IsNullOrEmpty(parts[0]) && colors.Count == 0)
+                return null;
+
+            return new CoverPlaceholder
+            {
+                Blurhash = string.IsNullOrEmpty(parts[0]) ? null : parts[0],
+                DominantColors = colors.ToArray(),
+                Weights = weights.ToArray()
+            };
+        }
+    }
+}
@@ -29,6 +29,7 @@ namespace ChillPatcher.ModuleSystem
         public ManualLogSource Logger => _logger;
         public IDefaultCoverProvider DefaultCover { get; }
         public IAudioLoader AudioLoader { get; }
+        public ICoverThumbnailLoader CoverThumbnails { get; }
         public IDependencyLoader DependencyLoader { get; }
 
         public ModuleContext(
@@ -42,6 +43,7 @@ namespace ChillPatcher.ModuleSystem
             IEventBus eventBus,
             IDefaultCoverProvider defaultCover,
             IAudioLoader audioLoader,
+            ICoverThumbnailLoader coverThumbnails,
             IDependencyLoader dependencyLoader)
         {
             _pluginPath = pluginPath;
@@ -55,6 +57,7 @@ namespace ChillPatcher.ModuleSystem
             EventBus = eventBus;
             DefaultCover = defaultCover;
             AudioLoader = audioLoader;
+            CoverThumbnails = coverThumbnails;
             DependencyLoader = dependencyLoader;
 
             ConfigManager = new ModuleConfigManager(config, moduleId);
@@ -25,6 +25,7 @@ namespace ChillPatcher.ModuleSystem
         private readonly IEventBus _eventBus;
         private readonly IDefaultCoverProvider _defaultCover;
         private readonly IAudioLoader _audioLoader;
+        private readonly ICoverThumbnailLoader _coverThumbnails;
         private readonly IDependencyLoader _dependencyLoader;
 
         public ModuleContextFactory(
@@ -37,6 +38,7 @@ namespace ChillPatcher.ModuleSystem
             IEventBus eventBus,
             IDefaultCoverProvider defaultCover,
             IAudioLoader audioLoader,
+            ICoverThumbnailLoader coverThumbnails,
             IDependencyLoader dependencyLoader)
         {
             _pluginPath = pluginPath;
@@ -48,6 +50,7 @@ namespace ChillPatcher.ModuleSystem
             _eventBus = eventBus;
             _defaultCover = defaultCover;
             _audioLoader = audioLoader;
+            _coverThumbnails = coverThumbnails;
             _dependencyLoader = dependencyLoader;
         }
 
@@ -69,6 +72,7 @@ namespace ChillPatcher.ModuleSystem
                 _eventBus,
                 _defaultCover,
                 _audioLoader,
+                _coverThumbnails,
                 _dependencyLoader);
         }
     }
@@ -1,10 +1,13 @@
 using System;
+using System.Collections.Generic;
 using System.IO;
 using System.Linq;
 using System.Threading;
 using System.Threading.Tasks;
 using Bulbul;
+using ChillPatcher.Native;
 using ChillPatcher.SDK.Interfaces;
+using ChillPatcher.SDK.Models;
 using ChillPatcher.UIFramework.Audio;
 using Cysharp.Threading.Tasks;
 using UnityEngine;
@@ -336,6 +339,67 @@ namespace ChillPatcher.ModuleSystem.Services
             }
         }
 
+        public AudioFileMetadata ProbeMetadata(string filePath)
+        {
+            // 目前只有 FLAC 有 Native 快速探测
+            if (!IsFlacFile(filePath))
+                return null;
+
+            return ToMetadata(FlacDecoder.ProbeFile(filePath));
+        }
+
+        public AudioFileMetadata[] ProbeMetadataBatch(IList<string> filePaths)
+        {
+            var results = new AudioFileMetadata[filePaths?.Count ?? 0];
+
+            var flacIndices = new List<int>();
+            var flacPaths = new List<string>();
+            for (int i = 0; i < results.Length; i++)
+            {
+                if (IsFlacFile(filePaths[i]))
+                {
+                    flacIndices.Add(i);
+                    flacPaths.Add(filePaths[i]);
+                }
+            }
+            if (flacPaths.Count == 0)
+                return results;
+
+            var infos = FlacDecoder.ProbeFiles(flacPaths);
+            if (infos == null)
+                return results;
+
+            for (int i = 0; i < infos.Length; i++)
+            {
+                results[flacIndices[i]] = ToMetadata(infos[i]);
+            }
+            return results;
+        }
+
+        private static bool IsFlacFile(string filePath)
+        {
+            return !string.IsNullOrEmpty(filePath) &&
+                string.Equals(Path.GetExtension(filePath), ".flac", StringComparison.OrdinalIgnoreCase);
+        }
+
+        private static AudioFileMetadata ToMetadata(FlacDecoder.FlacFileInfo info)
+        {
+            if (info == null)
+                return null;
+
+            return new AudioFileMetadata
+            {
+                Title = info.GetTag("TITLE"),
+                Artist = info.GetTag("ARTIST"),
+                Album = info.GetTag("ALBUM"),
+                Duration = (float)info.Duration,
+                SampleRate = info.SampleRate,
+                Channels = info.Channels,
+                BitsPerSample = info.BitsPerSample,
+                HasCover = info.HasCover
+            };
+        }
+
         public void UnloadClip(AudioClip clip)
         {
             if (clip != null)
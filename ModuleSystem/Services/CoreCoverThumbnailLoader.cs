@@ -0,0 +1,249 @@
+using System;
+using System.Collections.Generic;
+using System.Threading;
+using System.Threading.Tasks;
+using ChillPatcher.Native;
+using ChillPatcher.SDK.Interfaces;
+using ChillPatcher.SDK.Models;
+using ChillPatcher.UIFramework.Music;
+using Cysharp.Threading.Tasks;
+using UnityEngine;
+
+namespace ChillPatcher.ModuleSystem.Services
+{
+    /// <summary>
+    /// 封面缩略图加载器实现
+    /// 解码、缩放和 BC1 / BC3 压缩都在 Native 中完成，压缩结果保存在缩略图缓存文件中，
+    /// 命中缓存时只需拷贝块数据并上传纹理
+    ///
+    /// 缩略图任务由 Native 调度器按优先级执行：带请求键（RequestKey）的请求按列表可见范围排序，
+    /// 滚出预加载范围时取消；不带键的请求（如当前播放的封面）总是最先执行
+    /// </summary>
+    public class CoreCoverThumbnailLoader : ICoverThumbnailLoader
+    {
+        private static CoreCoverThumbnailLoader _instance;
+        public static CoreCoverThumbnailLoader Instance => _instance;
+
+        // 任务优先级（数值大的先执行）
+        private const int PRIORITY_IMMEDIATE = 3;
+        private const int PRIORITY_VISIBLE = 2;
+        private const int PRIORITY_PREFETCH = 1;
+        private const int PRIORITY_BACKGROUND = 0;
+        private const int PRIORITY_CANCELLED = -1;
+
+        private class PendingJob
+        {
+            public string Key;
+            public int Priority;
+            public TaskCompletionSource<FlacDecoder.CoverJobResult> Completion;
+        }
+
+        // 当前异步调用链的请求键，由发起加载的一方（CoverService）在调用模块之前设置
+        private static readonly AsyncLocal<string> _requestKey = new AsyncLocal<string>();
+
+        // 以下成员只在主线程上访问
+        private readonly Dictionary<long, PendingJob> _pending = new Dictionary<long, PendingJob>();
+        private readonly List<FlacDecoder.CoverJobResult> _pollResults = new List<FlacDecoder.CoverJobResult>();
+        private HashSet<string> _visibleKeys = new HashSet<string>();
+        private HashSet<string> _prefetchKeys = new HashSet<string>();
+        private bool _hasVisibility;
+        private bool _polling;
+
+        public static void Initialize()
+        {
+            if (_instance != null)
+                return;
+
+            _instance = new CoreCoverThumbnailLoader();
+            Plugin.Logger.LogInfo("CoreCoverThumbnailLoader 初始化完成");
+        }
+
+        private CoreCoverThumbnailLoader()
+        {
+        }
+
+        /// <summary>
+        /// 当前异步调用链发起的缩略图请求所关联的键（如 "album:{albumId}"），null 表示不参与可见范围调度
+        /// </summary>
+        public static string RequestKey
+        {
+            get => _requestKey.Value;
+            set => _requestKey.Value = value;
+        }
+
+        public bool IsAvailable => FlacDecoder.IsAvailable();
+
+        public async Task<Sprite> LoadThumbnailAsync(string sourcePath, int size, bool circular)
+        {
+            if (!IsAvailable || string.IsNullOrEmpty(sourcePath) || size <= 0 || size % 4 != 0)
+                return null;
+
+            // 请求键在切换线程之前读取
+            var key = RequestKey;
+            await UniTask.SwitchToMainThread();
+
+            int priority = GetPriority(key);
+            if (priority == PRIORITY_CANCELLED)
+                throw new OperationCanceledException($"Cover request out of range: {key}");
+
+            long jobId = FlacDecoder.SubmitCoverThumbnailJob(sourcePath, size, circular, priority);
+            if (jobId == 0)
+                return null;
+
+            var job = new PendingJob
+            {
+                Key = key,
+                Priority = priority,
+                Completion = new TaskCompletionSource<FlacDecoder.CoverJobResult>()
+            };
+            _pending[jobId] = job;
+            EnsurePolling();
+
+            // 被取消时抛出 OperationCanceledException，调用方不应缓存结果
+            var result = await job.Completion.Task;
+            return AlbumArtReader.CreateSpriteFromCompressed(result.Blocks, size, result.Format);
+        }
+
+        public async Task<CoverPlaceholder> LoadPlaceholderAsync(string sourcePath)
+        {
+            if (!IsAvailable || string.IsNullOrEmpty(sourcePath))
+                return null;
+
+            try
+            {
+                return await UniTask.RunOnThreadPool(() => FlacDecoder.LoadCoverPlaceholderFromFile(sourcePath));
+            }
+            catch (Exception ex)
+            {
+                Plugin.Logger.LogWarning($"[CoverThumbnail] Failed to load placeholder: {ex.Message}");
+                return null;
+            }
+        }
+
+        /// <summary>
+        /// 更新列表的可见范围（需在主线程调用）：可见的键优先，预加载范围内的次之，
+        /// 其余带键的等待中任务全部取消
+        /// </summary>
+        /// <param name="visibleKeys">视口内的请求键</param>
+        /// <param name="prefetchKeys">预加载范围内的请求键</param>
+        public void UpdateVisibility(IEnumerable<string> visibleKeys, IEnumerable<string> prefetchKeys)
+        {
+            _visibleKeys = new HashSet<string>(visibleKeys);
+            _prefetchKeys = new HashSet<string>(prefetchKeys);
+            _hasVisibility = true;
+            ApplyPriorities();
+        }
+
+        /// <summary>
+        /// 列表关闭时调用：取消全部带键的任务，之后的请求不再按可见范围过滤
+        /// </summary>
+        public void ResetVisibility()
+        {
+            _visibleKeys = new HashSet<string>();
+            _prefetchKeys = new HashSet<string>();
+            _hasVisibility = true;
+            ApplyPriorities();
+            _hasVisibility = false;
+        }
+
+        private int GetPriority(string key)
+        {
+            if (key == null)
+                return PRIORITY_IMMEDIATE;
+            if (!_hasVisibility)
+                return PRIORITY_BACKGROUND;
+            if (_visibleKeys.Contains(key))
+                return PRIORITY_VISIBLE;
+            if (_prefetchKeys.Contains(key))
+                return PRIORITY_PREFETCH;
+            return PRIORITY_CANCELLED;
+        }
+
+        private void ApplyPriorities()
+        {
+            var updatedIds = new List<long>();
+            var updatedPriorities = new List<int>();
+            var cancelled = new List<long>();
+
+            foreach (var kvp in _pending)
+            {
+                var job = kvp.Value;
+                if (job.Key == null)
+                    continue;
+
+                int priority = GetPriority(job.Key);
+                if (priority == PRIORITY_CANCELLED)
+                {
+                    cancelled.Add(kvp.Key);
+                }
+                else if (priority != job.Priority)
+                {
+                    job.Priority = priority;
+                    updatedIds.Add(kvp.Key);
+                    updatedPriorities.Add(priority);
+                }
+            }
+
+            if (updatedIds.Count > 0)
+                FlacDecoder.SetCoverThumbnailJobPriorities(updatedIds.ToArray(), updatedPriorities.ToArray());
+
+            if (cancelled.Count > 0)
+            {
+                FlacDecoder.CancelCoverThumbnailJobs(cancelled.ToArray());
+                foreach (var jobId in cancelled)
+                {
+                    var job = _pending[jobId];
+                    _pending.Remove(jobId);
+                    job.Completion.TrySetCanceled();
+                }
+            }
+        }
+
+        private void EnsurePolling()
+        {
+            if (_polling)
+                return;
+
+            _polling = true;
+            PollLoopAsync().Forget();
+        }
+
+        // 有等待中的任务时每帧轮询一次完成队列
+        private async UniTaskVoid PollLoopAsync()
+        {
+            try
+            {
+                while (_pending.Count > 0)
+                {
+                    await UniTask.Yield();
+
+                    _pollResults.Clear();
+                    while (FlacDecoder.PollCoverThumbnailJobs(_pollResults) > 0)
+                    {
+                    }
+
+                    foreach (var result in _pollResults)
+                    {
+                        // 已取消的任务可能在取消前刚好完成，忽略
+                        if (_pending.TryGetValue(result.JobId, out var job))
+                        {
+                            _pending.Remove(result.JobId);
+                            job.Completion.TrySetResult(result);
+                        }
+                    }
+                }
+            }
+            catch (Exception ex)
+            {
+                Plugin.Logger.LogWarning($"[CoverThumbnail] Poll failed: {ex.Message}");
+                foreach (var job in _pending.Values)
+                    job.Completion.TrySetException(ex);
+                _pending.Clear();
+            }
+            finally
+            {
+                _polling = false;
+            }
+        }
+    }
+}
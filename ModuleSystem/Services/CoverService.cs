@@ -1,11 +1,15 @@
 using System;
 using System.Collections.Generic;
+using System.Linq;
 using System.Threading.Tasks;
 using BepInEx.Logging;
 using ChillPatcher.SDK.Events;
 using ChillPatcher.SDK.Interfaces;
+using ChillPatcher.SDK.Models;
 using ChillPatcher.ModuleSystem.Registry;
+using ChillPatcher.Native;
 using ChillPatcher.UIFramework.Core;
+using ChillPatcher.UIFramework.Music;
 using UnityEngine;
 
 namespace ChillPatcher.ModuleSystem.Services
@@ -24,6 +28,11 @@ namespace ChillPatcher.ModuleSystem.Services
         private readonly ManualLogSource _logger;
         private readonly Dictionary<string, Sprite> _spriteCache = new Dictionary<string, Sprite>();
         private readonly Dictionary<string, (byte[] data, string mimeType)> _bytesCache = new Dictionary<string, (byte[], string)>();
+        private readonly Dictionary<string, Sprite> _placeholderCache = new Dictionary<string, Sprite>();
+        private readonly HashSet<string> _pendingAlbumLoads = new HashSet<string>();
+
+        // 占位图纹理边长，显示时由双线性过滤放大（blurhash 本身只有 4×3 个分量）
+        private const int PLACEHOLDER_SIZE = 32;
 
         /// <summary>
         /// 专辑封面加载完成事件
@@ -82,6 +91,50 @@ namespace ChillPatcher.ModuleSystem.Services
         /// </summary>
         public Sprite LoadingPlaceholder => EmbeddedResources.LoadingPlaceholder;
 
+        /// <summary>
+        /// 获取专辑的封面占位图（由 AlbumInfo.CoverPlaceholder 生成的模糊预览），没有时返回 null
+        /// </summary>
+        public Sprite GetAlbumPlaceholderSprite(string albumId)
+        {
+            var placeholder = AlbumRegistry.Instance?.GetAlbum(albumId)?.CoverPlaceholder;
+            if (placeholder == null)
+                return null;
+
+            var key = placeholder.ToString();
+            if (_placeholderCache.TryGetValue(key, out var cached) && cached != null)
+                return cached;
+
+            var sprite = CreatePlaceholderSprite(placeholder);
+            _placeholderCache[key] = sprite;
+            return sprite;
+        }
+
+        private static Sprite CreatePlaceholderSprite(CoverPlaceholder placeholder)
+        {
+            // 优先用 Native 解码 blurhash，不可用时退回主色纯色图
+            var rgba = FlacDecoder.DecodeCoverPlaceholderPixels(placeholder.Blurhash, PLACEHOLDER_SIZE);
+            if (rgba == null)
+            {
+                if (placeholder.DominantColors == null || placeholder.DominantColors.Length == 0)
+                    return null;
+
+                var color = placeholder.DominantColors[0];
+                rgba = new byte[PLACEHOLDER_SIZE * PLACEHOLDER_SIZE * 4];
+                for (int i = 0; i < rgba.Length; i += 4)
+                {
+                    rgba[i] = color.r;
+                    rgba[i + 1] = color.g;
+                    rgba[i + 2] = color.b;
+                    rgba[i + 3] = 255;
+                }
+            }
+
+            var sprite = AlbumArtReader.CreateSpriteFromRgba(rgba, PLACEHOLDER_SIZE);
+            if (sprite != null)
+                sprite.texture.wrapMode = TextureWrapMode.Clamp;
+            return sprite;
+        }
+
         #endregion
 
         #region Synchronous Placeholder Access
@@ -100,9 +153,10 @@ namespace ChillPatcher.ModuleSystem.Services
             if (_spriteCache.TryGetValue(cacheKey, out var cached) && cached != null)
                 return cached;
 
-            // 未缓存，触发异步加载并返回占位图
-            _ = LoadAlbumCoverAsync(albumId);
-            return LoadingPlaceholder;
+            // 未缓存，触发异步加载并返回占位图（有封面占位图时直接显示模糊预览）
+            if (_pendingAlbumLoads.Add(albumId))
+                _ = LoadAlbumCoverAsync(albumId);
+            return GetAlbumPlaceholderSprite(albumId) ?? LoadingPlaceholder;
         }
 
         /// <summary>
@@ -135,6 +189,8 @@ namespace ChillPatcher.ModuleSystem.Services
             
             try
             {
+                // 缩略图请求按专辑在列表中的可见范围调度
+                CoreCoverThumbnailLoader.RequestKey = GetAlbumRequestKey(albumId);
                 var sprite = await TryGetAlbumCoverFromModuleAsync(albumId);
                 var cacheKey = $"album:{albumId}";
                 
@@ -151,11 +207,20 @@ namespace ChillPatcher.ModuleSystem.Services
                     OnAlbumCoverLoaded?.Invoke(albumId, defaultCover);
                 }
             }
+            catch (OperationCanceledException)
+            {
+                // 专辑滚出了预加载范围，不缓存结果，重新进入可见范围时再次请求
+                _logger.LogDebug($"LoadAlbumCoverAsync cancelled [{albumId}]");
+            }
             catch (Exception ex)
             {
                 _logger.LogWarning($"LoadAlbumCoverAsync failed [{albumId}]: {ex.Message}");
                 OnAlbumCoverLoaded?.Invoke(albumId, GetDefaultAlbumCover());
             }
+            finally
+            {
+                _pendingAlbumLoads.Remove(albumId);
+            }
         }
 
         /// <summary>
@@ -194,6 +259,46 @@ namespace ChillPatcher.ModuleSystem.Services
 
         #endregion
 
+        #region Visibility Scheduling
+
+        /// <summary>
+        /// 更新专辑列表的可见范围（由虚拟滚动控制器在范围变化时调用）：
+        /// 可见专辑的封面优先解码，预加载范围内的次之，范围外等待中的请求取消
+        /// </summary>
+        /// <param name="visibleAlbumIds">视口内的专辑</param>
+        /// <param name="prefetchAlbumIds">预加载范围内的专辑</param>
+        public void UpdateAlbumCoverVisibility(IEnumerable<string> visibleAlbumIds, IEnumerable<string> prefetchAlbumIds)
+        {
+            CoreCoverThumbnailLoader.Instance?.UpdateVisibility(
+                visibleAlbumIds.Select(GetAlbumRequestKey),
+                prefetchAlbumIds.Select(GetAlbumRequestKey));
+        }
+
+        /// <summary>
+        /// 专辑列表关闭时调用，取消全部按可见范围调度的封面请求
+        /// </summary>
+        public void ResetAlbumCoverVisibility()
+        {
+            CoreCoverThumbnailLoader.Instance?.ResetVisibility();
+        }
+
+        /// <summary>
+        /// 专辑头重新进入可见范围时调用：封面尚未加载（之前的请求可能因滚出范围被取消）时重新请求。
+        /// 不属于任何模块的分组（游戏内置、默认分组）原样返回 current
+        /// </summary>
+        /// <returns>应显示的封面</returns>
+        public Sprite EnsureAlbumCoverRequested(string albumId, Sprite current)
+        {
+            if (string.IsNullOrEmpty(albumId) || AlbumRegistry.Instance?.GetAlbum(albumId) == null)
+                return current;
+
+            return GetAlbumCoverOrPlaceholder(albumId);
+        }
+
+        private static string GetAlbumRequestKey(string albumId) => $"album:{albumId}";
+
+        #endregion
+
         #region Async API
 
         /// <summary>
@@ -341,6 +446,16 @@ namespace ChillPatcher.ModuleSystem.Services
             }
             _spriteCache.Clear();
             _bytesCache.Clear();
+
+            foreach (var sprite in _placeholderCache.Values)
+            {
+                if (sprite != null)
+                {
+                    UnityEngine.Object.Destroy(sprite.texture);
+                    UnityEngine.Object.Destroy(sprite);
+                }
+            }
+            _placeholderCache.Clear();
         }
 
         /// <summary>
@@ -437,6 +552,10 @@ namespace ChillPatcher.ModuleSystem.Services
             {
                 return await provider.GetAlbumCoverAsync(albumId);
             }
+            catch (OperationCanceledException)
+            {
+                throw;
+            }
             catch (Exception ex)
             {
                 _logger.LogDebug($"获取专辑封面失败 [{albumId}]: {ex.Message}");
@@ -1,6 +1,9 @@
 using System;
+using System.Collections.Generic;
 using System.Runtime.InteropServices;
 using System.IO;
+using System.Text;
+using ChillPatcher.SDK.Models;
 using UnityEngine;
 
 namespace ChillPatcher.Native
@@ -44,6 +47,7 @@ namespace ChillPatcher.Native
                 else
                 {
                     Plugin.Log.LogInfo($"[FlacDecoder] ✅ Loaded Native DLL from: {DllPath}");
+                    InitializeSeekIndexCache();
                 }
             }
             catch (Exception ex)
@@ -52,6 +56,31 @@ namespace ChillPatcher.Native
             }
         }
 
+        // seek 索引旁路文件目录（与其他 ChillPatcher 缓存放在一起）
+        private static readonly string SeekIndexCacheDirectory = Path.Combine(
+            Environment.GetFolderPath(Environment.SpecialFolder.LocalApplicationData).Replace("Local", "LocalLow"),
+            "Nestopi",
+            "Chill With You",
+            "ChillPatcherCache",
+            "flac_seek_index"
+        );
+
+        /// <summary>
+        /// 让 Native 把没有 SEEKTABLE 的文件的 seek 索引持久化到缓存目录
+        /// </summary>
+        private static void InitializeSeekIndexCache()
+        {
+            try
+            {
+                Directory.CreateDirectory(SeekIndexCacheDirectory);
+                SetFlacSeekIndexCacheDir(SeekIndexCacheDirectory);
+            }
+            catch (Exception ex)
+            {
+                Plugin.Log.LogWarning($"[FlacDecoder] Seek index cache disabled: {ex.Message}");
+            }
+        }
+
         // Windows LoadLibrary
         [DllImport("kernel32", SetLastError = true, CharSet = CharSet.Unicode)]
         private static extern IntPtr LoadLibrary(string lpFileName);
@@ -82,6 +111,29 @@ namespace ChillPatcher.Native
         [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
         private static extern void FreeFlacData(ref FlacAudioInfo info);
 
+        /// <summary>
+        /// 指定格式的解码结果（与 C++ FlacPcmData 对应）
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        private struct FlacPcmData
+        {
+            public int sampleRate;
+            public int channels;
+            public ulong totalPcmFrameCount;
+            public int sampleFormat;
+            public IntPtr pcmData;
+            public UIntPtr pcmDataSize;
+        }
+
+        /// <summary>
+        /// 多线程解码整个文件（在 FLAC 帧边界切段，结果与单线程解码逐位一致）
+        /// </summary>
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Unicode)]
+        private static extern int DecodeFlacFileParallel(string filePath, int sampleFormat, int dither, int threads, out FlacPcmData data);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void FreeFlacPcmData(ref FlacPcmData data);
+
         /// <summary>
         /// 获取最后的错误消息
         /// </summary>
@@ -90,6 +142,22 @@ namespace ChillPatcher.Native
 
         // ========== 流式解码 API ==========
 
+        /// <summary>
+        /// 流打开选项（与 C++ FlacStreamOptions 对应）
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        private struct FlacStreamOptions
+        {
+            public int decodeAheadMs;
+            public int sampleFormat;  // 0=交错 float32（Unity 回调需要的格式）
+            public int dither;
+            public int outputSampleRate;  // 0=保持源采样率
+            public int resampleQuality;   // 0=标准，1=快速，2=高质量
+            public int outputChannels;    // 0=保持源声道数，1=单声道，2=立体声（多声道源在 Native 侧缩混）
+            public float gainDb;          // 输出增益（dB，-60~24），0=不改变
+            public int limiter;           // 1=增益后软限幅
+        }
+
         [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Unicode)]
         private static extern IntPtr OpenFlacStream(
             string filePath,
@@ -97,6 +165,14 @@ namespace ChillPatcher.Native
             out int channels,
             out ulong totalPcmFrames);
 
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Unicode)]
+        private static extern IntPtr OpenFlacStreamEx(
+            string filePath,
+            ref FlacStreamOptions options,
+            out int sampleRate,
+            out int channels,
+            out ulong totalPcmFrames);
+
         [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
         private static extern long ReadFlacFrames(
             IntPtr streamHandle,
@@ -107,210 +183,1572 @@ namespace ChillPatcher.Native
         private static extern int SeekFlacStream(IntPtr streamHandle, ulong frameIndex);
 
         [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
-        private static extern void CloseFlacStream(IntPtr streamHandle);
+        private static extern int GetFlacSeekState(IntPtr streamHandle);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        private static extern long GetFlacStreamPosition(IntPtr streamHandle);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        private static extern long GetFlacStreamBufferedFrames(IntPtr streamHandle);
+
+        // ========== 频谱分析 API ==========
 
         /// <summary>
-        /// [已废弃] 解码 FLAC 文件并创建 Unity AudioClip（一次性全部加载到内存）
-        /// 
-        /// ⚠️ 此方法会将整个 FLAC 文件解码到内存中，对于高采样率的文件会占用大量内存。
-        /// 建议使用 FlacStreamReader + CreateStreamingAudioClip 实现流式播放。
-        /// 
-        /// 保留此方法仅用于调试和特殊场景。
+        /// 频谱分析选项（与 C++ FlacAnalysisOptions 对应，为 0 的字段使用默认值）
         /// </summary>
-        /// <param name="filePath">FLAC 文件路径</param>
-        /// <param name="clipName">AudioClip 名称</param>
-        /// <returns>Unity AudioClip 对象，失败返回 null</returns>
-        [Obsolete("Use FlacStreamReader for streaming playback to reduce memory usage")]
-        public static AudioClip DecodeFlacToAudioClip(string filePath, string clipName)
+        [StructLayout(LayoutKind.Sequential)]
+        private struct FlacAnalysisOptions
         {
-            if (!File.Exists(filePath))
-            {
-                Plugin.Log.LogError($"[FlacDecoder] File not found: {filePath}");
-                return null;
-            }
+            public int fftSize;         // 0=2048
+            public int bandCount;       // 0=32
+            public float minFrequency;  // 0=20Hz
+            public float maxFrequency;  // 0=min(20kHz, 采样率 / 2)
+            public int intervalMs;      // 0=16
+            public float smoothing;     // 0=不平滑
+        }
 
-            FlacAudioInfo info = default;
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        private static extern int EnableFlacAnalysis(IntPtr streamHandle, ref FlacAnalysisOptions options);
 
-            try
-            {
-                // 调用 Native Plugin 解码
-                int result = DecodeFlacFile(filePath, out info);
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        private static extern int GetFlacAnalysisBands(IntPtr streamHandle, [Out] float[] bands, int capacity, out ulong frame);
 
-                if (result != 0)
-                {
-                    string error = GetErrorMessage();
-                    Plugin.Log.LogError($"[FlacDecoder] Failed to decode FLAC: {error} (code={result})");
-                    return null;
-                }
+        // ========== 响度分析 API ==========
 
-                // 验证音频参数
-                if (info.channels < 1 || info.channels > 8)
-                {
-                    Plugin.Log.LogError($"[FlacDecoder] Invalid channel count: {info.channels}");
-                    return null;
-                }
+        /// <summary>
+        /// 响度来源（与 C++ FlacLoudnessSource 对应）
+        /// </summary>
+        public enum FlacLoudnessSource
+        {
+            Pending = 0,
+            Measured = 1,
+            Tagged = 2
+        }
 
-                if (info.sampleRate < 8000 || info.sampleRate > 192000)
-                {
-                    Plugin.Log.LogError($"[FlacDecoder] Invalid sample rate: {info.sampleRate}");
-                    return null;
-                }
+        /// <summary>
+        /// 单个文件的响度分析结果（与 C++ FlacLoudnessInfo 对应）
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public struct FlacLoudnessInfo
+        {
+            /// <summary>0=成功，-2=无法打开文件，-3=不是有效的 FLAC 文件，-5=解码失败，-6=已取消</summary>
+            public int Status;
+            public FlacLoudnessSource Source;
+            /// <summary>1=测量结果读取自旁路缓存</summary>
+            public int FromCache;
+            /// <summary>1=AlbumGainDb / AlbumPeak 有效（只来自标签）</summary>
+            public int HasAlbumGain;
+            /// <summary>综合响度（LUFS）</summary>
+            public double IntegratedLufs;
+            /// <summary>响度范围（LU），来自标签时为 0</summary>
+            public double LoudnessRangeLu;
+            /// <summary>真峰值（线性，1.0=0 dBTP）</summary>
+            public double TruePeak;
+            /// <summary>曲目增益（dB，参考 -18 LUFS），可直接用于 FlacStreamReader.SetGain</summary>
+            public double TrackGainDb;
+            public double AlbumGainDb;
+            public double AlbumPeak;
+        }
 
-                if (info.totalPcmFrameCount == 0 || info.pcmData == IntPtr.Zero)
-                {
-                    Plugin.Log.LogError("[FlacDecoder] No PCM data decoded");
-                    return null;
-                }
+        private const int FLAC_LOUDNESS_IGNORE_TAGS = 1;
 
-                // 复制 PCM 数据到托管数组
-                int sampleCount = (int)(info.totalPcmFrameCount * (ulong)info.channels);
-                float[] pcmData = new float[sampleCount];
-                Marshal.Copy(info.pcmData, pcmData, 0, sampleCount);
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        private static extern IntPtr StartFlacLoudnessBatch(
+            [MarshalAs(UnmanagedType.LPArray, ArraySubType = UnmanagedType.LPWStr)] string[] filePaths,
+            int count,
+            int threads,
+            int flags);
 
-                // 创建 Unity AudioClip
-                AudioClip clip = AudioClip.Create(
-                    clipName,
-                    (int)info.totalPcmFrameCount,
-                    info.channels,
-                    info.sampleRate,
-                    false
-                );
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        private static extern int GetFlacLoudnessProgress(IntPtr batch);
 
-                if (clip == null)
-                {
-                    Plugin.Log.LogError("[FlacDecoder] Failed to create AudioClip");
-                    return null;
-                }
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        private static extern int GetFlacLoudnessResults(IntPtr batch, int start, int count, [Out] FlacLoudnessInfo[] results);
 
-                // 设置 PCM 数据
-                if (!clip.SetData(pcmData, 0))
-                {
-                    Plugin.Log.LogError("[FlacDecoder] Failed to set AudioClip data");
-                    UnityEngine.Object.Destroy(clip);
-                    return null;
-                }
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void CloseFlacLoudnessBatch(IntPtr batch);
 
-                Plugin.Log.LogInfo($"[FlacDecoder] ✅ Decoded: {Path.GetFileName(filePath)} " +
-                    $"({info.sampleRate}Hz, {info.channels}ch, {info.totalPcmFrameCount} frames)");
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        private static extern int SetFlacStreamGain(IntPtr streamHandle, float gainDb, int limiter);
 
-                return clip;
-            }
-            catch (DllNotFoundException ex)
-            {
-                Plugin.Log.LogError($"[FlacDecoder] Native DLL not found: {ex.Message}");
-                Plugin.Log.LogError($"[FlacDecoder] Please ensure ChillFlacDecoder.dll is in BepInEx/plugins/ChillPatcher/native/");
-                return null;
-            }
-            catch (Exception ex)
-            {
-                Plugin.Log.LogError($"[FlacDecoder] Exception: {ex}");
-                return null;
-            }
-            finally
-            {
-                // 释放 Native 分配的内存
-                if (info.pcmData != IntPtr.Zero)
-                {
-                    FreeFlacData(ref info);
-                }
-            }
-        }
+        // ========== 注册输出缓冲区 ==========
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        private static extern IntPtr RegisterFlacOutputBuffer(IntPtr streamHandle, IntPtr buffer, ulong capacityFrames);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        private static extern long FillFlacOutput(IntPtr streamHandle, ulong offsetFrames, ulong frameCount);
+
+        // ========== 边写边读 API ==========
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Unicode)]
+        private static extern IntPtr OpenFlacGrowingStream(
+            string filePath,
+            ulong writtenBytes,
+            ref FlacStreamOptions options,
+            out int sampleRate,
+            out int channels,
+            out ulong totalPcmFrames);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        private static extern long UpdateFlacGrowingStream(IntPtr streamHandle, ulong writtenBytes, int isComplete);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        private static extern long GetFlacDecodableFrames(IntPtr streamHandle);
+
+        // ========== 推送 API ==========
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        private static extern IntPtr CreateFlacPushStream(ref FlacStreamOptions options);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        private static extern int PushFlacStreamData(IntPtr streamHandle, byte[] data, UIntPtr size);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        private static extern int FinishFlacPushStream(IntPtr streamHandle);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        private static extern int GetFlacStreamInfo(
+            IntPtr streamHandle,
+            out int sampleRate,
+            out int channels,
+            out ulong totalPcmFrames);
+
+        // ========== Seek 索引 ==========
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Unicode)]
+        private static extern void SetFlacSeekIndexCacheDir(string dirPath);
+
+        // ========== I/O 后端 ==========
 
         /// <summary>
-        /// 获取 Native Plugin 错误消息
+        /// 本地文件的读取方式（与 C++ FlacIoBackend 对应）
         /// </summary>
-        private static string GetErrorMessage()
+        public enum FlacIoBackend
         {
-            try
-            {
-                IntPtr ptr = FlacGetLastError();
-                if (ptr != IntPtr.Zero)
-                {
-                    return Marshal.PtrToStringAnsi(ptr) ?? "Unknown error";
-                }
-            }
-            catch { }
-            return "Unknown error";
+            /// <summary>内存映射（异步后端由配置 Advanced.FlacIoBackend 开启）</summary>
+            Auto = 0,
+            Mapped = 1,
+            ThreadPool = 2,
+            /// <summary>不可用时退回线程池</summary>
+            IoUring = 3
         }
 
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        private static extern int SetFlacIoBackend(int backend, int latencyUs);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        private static extern int GetFlacIoBackend();
+
+        // ========== 内存 ==========
+
         /// <summary>
-        /// 检查 Native Plugin 是否可用
+        /// 解码器内存统计（与 C++ FlacMemoryStats 对应）
         /// </summary>
-        public static bool IsAvailable()
+        [StructLayout(LayoutKind.Sequential)]
+        public struct FlacMemoryStats
         {
-            return DllHandle != IntPtr.Zero;
+            /// <summary>使用中的字节数（按块计，含流的 arena）</summary>
+            public ulong CurrentBytes;
+            public ulong PeakBytes;
+            /// <summary>池中保留待复用的空闲块字节数</summary>
+            public ulong CachedBytes;
+            public ulong Allocations;
+            /// <summary>向系统堆申请的次数（稳定状态下不再增长）</summary>
+            public ulong HeapAllocations;
+            public int LiveArenas;
         }
 
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        private static extern int GetFlacMemoryStats(out FlacMemoryStats stats);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void TrimFlacMemoryPool();
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void CloseFlacStream(IntPtr streamHandle);
+
+        // ========== 预加载 API ==========
+
         /// <summary>
-        /// FLAC 流式读取器
+        /// 预加载条目的状态（与 C++ FlacPrepareState 对应）
         /// </summary>
-        public class FlacStreamReader : IDisposable
+        public enum FlacPrepareState
         {
-            private IntPtr _streamHandle;
-            private bool _disposed = false;
-
-            public int SampleRate { get; private set; }
-            public int Channels { get; private set; }
-            public ulong TotalPcmFrames { get; private set; }
-            public ulong CurrentFrame { get; private set; }
-
-            public FlacStreamReader(string filePath)
-            {
-                _streamHandle = OpenFlacStream(
-                    filePath,
-                    out int sampleRate,
-                    out int channels,
-                    out ulong totalFrames);
+            /// <summary>不在预加载列表中（或已被取走）</summary>
+            None = 0,
+            /// <summary>等待打开或正在打开</summary>
+            Pending = 1,
+            /// <summary>已打开并预解码，可以取走</summary>
+            Ready = 2,
+            Failed = -1,
+            /// <summary>超出内存预算，未保留</summary>
+            OverBudget = -2
+        }
 
-                if (_streamHandle == IntPtr.Zero)
-                {
-                    throw new Exception($"Failed to open FLAC stream: {GetErrorMessage()}");
-                }
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        private static extern IntPtr CreateFlacPreloader(ref FlacStreamOptions options, ulong memoryBudgetBytes);
 
-                SampleRate = sampleRate;
-                Channels = channels;
-                TotalPcmFrames = totalFrames;
-                CurrentFrame = 0;
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        private static extern int PrepareFlacStreams(
+            IntPtr preloader,
+            [MarshalAs(UnmanagedType.LPArray, ArraySubType = UnmanagedType.LPWStr)] string[] filePaths,
+            int count);
 
-                Plugin.Log.LogInfo($"[FlacStreamReader] Opened stream: {sampleRate}Hz, {channels}ch, {totalFrames} frames");
-            }
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Unicode)]
+        private static extern int GetFlacPreparedState(IntPtr preloader, string filePath);
 
-            /// <summary>
-            /// 读取 PCM 帧到缓冲区
-            /// </summary>
-            /// <param name="buffer">交错格式的 float 缓冲区（长度 = 帧数 * 声道数）</param>
-            /// <param name="framesToRead">要读取的帧数</param>
-            /// <returns>实际读取的帧数</returns>
-            public long ReadFrames(float[] buffer, ulong framesToRead)
-            {
-                if (_disposed || _streamHandle == IntPtr.Zero)
-                    throw new ObjectDisposedException(nameof(FlacStreamReader));
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Unicode)]
+        private static extern IntPtr TakeFlacPreparedStream(
+            IntPtr preloader,
+            string filePath,
+            out int sampleRate,
+            out int channels,
+            out ulong totalPcmFrames);
 
-                long framesRead = ReadFlacFrames(_streamHandle, buffer, framesToRead);
-                if (framesRead > 0)
-                {
-                    CurrentFrame += (ulong)framesRead;
-                }
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void CloseFlacPreloader(IntPtr preloader);
 
-                return framesRead;
-            }
+        // ========== 过渡引擎 API ==========
+
+        /// <summary>
+        /// 曲目之间的衔接方式（与 C++ FlacTransitionMode 对应）
+        /// </summary>
+        public enum FlacTransitionMode
+        {
+            /// <summary>无缝：上一首的最后一帧之后紧接下一首的第一帧</summary>
+            Gapless = 0,
+            /// <summary>交叉淡化：上一首结尾与下一首开头重叠混合</summary>
+            Crossfade = 1
+        }
+
+        /// <summary>
+        /// 交叉淡化曲线（与 C++ FlacFadeCurve 对应）
+        /// </summary>
+        public enum FlacFadeCurve
+        {
+            /// <summary>等功率 sin / cos</summary>
+            Sine = 0,
+            /// <summary>等功率平方根</summary>
+            Sqrt = 1,
+            /// <summary>等增益线性</summary>
+            Linear = 2
+        }
+
+        /// <summary>
+        /// 过渡引擎状态（与 C++ FlacTransitionState 对应）
+        /// </summary>
+        public enum FlacTransitionState
+        {
+            Idle = 0,
+            Playing = 1,
+            /// <summary>正在交叉淡化（位置为淡入的曲目的位置）</summary>
+            Fading = 2,
+            /// <summary>当前曲目已播放完，没有排队的下一首</summary>
+            Ended = 3
+        }
+
+        /// <summary>
+        /// 编码器填充的裁剪量（输出采样率下的帧数，与 C++ FlacGaplessTrim 对应）
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public struct FlacGaplessTrim
+        {
+            /// <summary>开头跳过的帧数（编码器延迟）</summary>
+            public ulong LeadingFrames;
+            /// <summary>结尾丢弃的帧数（编码器填充）</summary>
+            public ulong TrailingFrames;
+        }
+
+        /// <summary>
+        /// 过渡引擎状态快照（与 C++ FlacTransitionStatus 对应）
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public struct FlacTransitionStatus
+        {
+            /// <summary>曲目序号：每次切换到新的曲目加 1</summary>
+            public uint Serial;
+            public FlacTransitionState State;
+            /// <summary>当前曲目的播放位置（帧，从裁剪后的开头算起）</summary>
+            public ulong Position;
+            /// <summary>当前曲目裁剪后的长度（帧，未知时为 0）</summary>
+            public ulong Length;
+            /// <summary>1=有排队的下一首</summary>
+            public int NextQueued;
+        }
+
+        private const int FLAC_TRANSITION_QUEUE_NEXT = 0;
+        private const int FLAC_TRANSITION_QUEUE_NOW = 1;
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        private static extern IntPtr CreateFlacTransition(int sampleRate, int channels);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        private static extern int SetFlacTransitionMode(IntPtr engine, int mode, int crossfadeMs, int curve);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Unicode)]
+        private static extern int GetFlacGaplessTrim(string filePath, int outputSampleRate, out FlacGaplessTrim trim);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        private static extern int QueueFlacTransitionStream(IntPtr engine, IntPtr streamHandle, ref FlacGaplessTrim trim, int queue);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        private static extern long ReadFlacTransition(IntPtr engine, float[] buffer, ulong frames);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        private static extern int SeekFlacTransition(IntPtr engine, ulong frameIndex);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        private static extern int GetFlacTransitionStatus(IntPtr engine, out FlacTransitionStatus status);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void CloseFlacTransition(IntPtr engine);
+
+        // ========== 元数据探测 API ==========
+
+        [StructLayout(LayoutKind.Sequential, CharSet = CharSet.Ansi)]
+        private struct FlacPictureInfoNative
+        {
+            public int pictureType;
+            public uint width;
+            public uint height;
+            public ulong dataOffset;
+            public uint dataSize;
+            [MarshalAs(UnmanagedType.ByValTStr, SizeConst = 64)]
+            public string mimeType;
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        private struct FlacProbeInfoNative
+        {
+            public int sampleRate;
+            public int channels;
+            public int bitsPerSample;
+            public ulong totalPcmFrames;
+            public double durationSeconds;
+            [MarshalAs(UnmanagedType.ByValArray, SizeConst = 16)]
+            public byte[] md5;
+            public IntPtr tags;           // tagCount 个以 NUL 结尾的 UTF-8 "KEY=value"
+            public UIntPtr tagsSize;
+            public int tagCount;
+            public IntPtr pictures;       // FlacPictureInfoNative[pictureCount]
+            public int pictureCount;
+        }
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Unicode)]
+        private static extern int ProbeFlacFile(string filePath, out FlacProbeInfoNative info);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void FreeFlacProbeInfo(ref FlacProbeInfoNative info);
+
+        [StructLayout(LayoutKind.Sequential)]
+        private struct FlacProbeBatchEntryNative
+        {
+            public int status;
+            public int sampleRate;
+            public int channels;
+            public int bitsPerSample;
+            public ulong totalPcmFrames;
+            public double durationSeconds;
+            [MarshalAs(UnmanagedType.ByValArray, SizeConst = 16)]
+            public byte[] md5;
+            public ulong tagsOffset;      // 以下偏移均相对结果缓冲区起始
+            public ulong tagsSize;
+            public ulong picturesOffset;
+            public int tagCount;
+            public int pictureCount;
+        }
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        private static extern IntPtr ProbeFlacFiles(
+            [MarshalAs(UnmanagedType.LPArray, ArraySubType = UnmanagedType.LPWStr)] string[] filePaths,
+            int count,
+            int threadCount,
+            out ulong size);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void FreeFlacProbeBatch(IntPtr batch);
+
+        /// <summary>
+        /// FLAC 文件中的图片（只有位置信息，需要时按偏移读取文件）
+        /// </summary>
+        public struct FlacPicture
+        {
+            /// <summary>图片类型（与 ID3v2 APIC 相同，3=封面）</summary>
+            public int Type;
+            public int Width;
+            public int Height;
+            /// <summary>图片数据在文件中的绝对偏移</summary>
+            public long DataOffset;
+            public int DataSize;
+            public string MimeType;
+        }
+
+        /// <summary>
+        /// ProbeFile 的结果
+        /// </summary>
+        public class FlacFileInfo
+        {
+            public int SampleRate { get; internal set; }
+            public int Channels { get; internal set; }
+            public int BitsPerSample { get; internal set; }
+
+            /// <summary>总帧数（无法确定时为 0）</summary>
+            public ulong TotalPcmFrames { get; internal set; }
+
+            /// <summary>时长（秒）</summary>
+            public double Duration { get; internal set; }
+
+            /// <summary>未编码音频的 MD5（全 0 表示编码器未计算）</summary>
+            public byte[] Md5 { get; internal set; }
+
+            /// <summary>Vorbis 注释（键不区分大小写，同一个键可以有多个值）</summary>
+            public Dictionary<string, List<string>> Tags { get; } =
+                new Dictionary<string, List<string>>(StringComparer.OrdinalIgnoreCase);
+
+            public FlacPicture[] Pictures { get; internal set; }
+
+            /// <summary>获取标签的第一个值，不存在时返回 null</summary>
+            public string GetTag(string key)
+            {
+                return Tags.TryGetValue(key, out var values) && values.Count > 0 ? values[0] : null;
+            }
+
+            /// <summary>是否包含图片（封面）</summary>
+            public bool HasCover => Pictures != null && Pictures.Length > 0;
+        }
+
+        /// <summary>
+        /// 只读取元数据块获取文件信息（不解码音频、不读取图片数据），可在任意线程调用
+        /// </summary>
+        /// <param name="filePath">FLAC 文件路径</param>
+        /// <returns>文件信息，失败（或 Native 不可用）返回 null</returns>
+        public static FlacFileInfo ProbeFile(string filePath)
+        {
+            if (!IsAvailable())
+                return null;
+
+            FlacProbeInfoNative info = default;
+            try
+            {
+                int result = ProbeFlacFile(filePath, out info);
+                if (result != 0)
+                {
+                    Plugin.Log.LogDebug($"[FlacDecoder] Probe failed: {GetErrorMessage()} (code={result})");
+                    return null;
+                }
+
+                var fileInfo = new FlacFileInfo
+                {
+                    SampleRate = info.sampleRate,
+                    Channels = info.channels,
+                    BitsPerSample = info.bitsPerSample,
+                    TotalPcmFrames = info.totalPcmFrames,
+                    Duration = info.durationSeconds,
+                    Md5 = info.md5,
+                    Pictures = new FlacPicture[info.pictureCount]
+                };
+
+                if (info.tags != IntPtr.Zero)
+                {
+                    var packed = new byte[(int)info.tagsSize];
+                    Marshal.Copy(info.tags, packed, 0, packed.Length);
+                    ParsePackedTags(packed, 0, packed.Length, fileInfo);
+                }
+
+                int pictureSize = Marshal.SizeOf(typeof(FlacPictureInfoNative));
+                for (int i = 0; i < info.pictureCount; i++)
+                {
+                    var picture = (FlacPictureInfoNative)Marshal.PtrToStructure(
+                        IntPtr.Add(info.pictures, i * pictureSize), typeof(FlacPictureInfoNative));
+                    fileInfo.Pictures[i] = new FlacPicture
+                    {
+                        Type = picture.pictureType,
+                        Width = (int)picture.width,
+                        Height = (int)picture.height,
+                        DataOffset = (long)picture.dataOffset,
+                        DataSize = (int)picture.dataSize,
+                        MimeType = picture.mimeType
+                    };
+                }
+
+                return fileInfo;
+            }
+            catch (Exception ex)
+            {
+                Plugin.Log.LogWarning($"[FlacDecoder] Probe exception: {ex.Message}");
+                return null;
+            }
+            finally
+            {
+                if (info.tags != IntPtr.Zero || info.pictures != IntPtr.Zero)
+                {
+                    FreeFlacProbeInfo(ref info);
+                }
+            }
+        }
+
+        /// <summary>
+        /// 并行探测多个文件（Native 线程池并发读取，一次调用、一次复制取回全部结果）
+        /// </summary>
+        /// <param name="filePaths">FLAC 文件路径</param>
+        /// <param name="threadCount">工作线程数，0 表示自动</param>
+        /// <returns>与 filePaths 一一对应的结果，单个文件失败时对应项为 null；Native 不可用时返回 null</returns>
+        public static FlacFileInfo[] ProbeFiles(IList<string> filePaths, int threadCount = 0)
+        {
+            if (!IsAvailable() || filePaths == null)
+                return null;
+
+            var results = new FlacFileInfo[filePaths.Count];
+            if (results.Length == 0)
+                return results;
+
+            var paths = new string[filePaths.Count];
+            filePaths.CopyTo(paths, 0);
+
+            IntPtr batch = IntPtr.Zero;
+            try
+            {
+                batch = ProbeFlacFiles(paths, paths.Length, threadCount, out ulong size);
+                if (batch == IntPtr.Zero)
+                {
+                    Plugin.Log.LogWarning($"[FlacDecoder] Batch probe failed: {GetErrorMessage()}");
+                    return null;
+                }
+
+                var buffer = new byte[(int)size];
+                Marshal.Copy(batch, buffer, 0, buffer.Length);
+                FreeFlacProbeBatch(batch);
+                batch = IntPtr.Zero;
+
+                // 结果缓冲区只含偏移，固定托管副本后按偏移解析
+                var handle = GCHandle.Alloc(buffer, GCHandleType.Pinned);
+                try
+                {
+                    IntPtr basePtr = handle.AddrOfPinnedObject();
+                    int entrySize = Marshal.SizeOf(typeof(FlacProbeBatchEntryNative));
+                    int pictureSize = Marshal.SizeOf(typeof(FlacPictureInfoNative));
+
+                    for (int i = 0; i < results.Length; i++)
+                    {
+                        var entry = (FlacProbeBatchEntryNative)Marshal.PtrToStructure(
+                            IntPtr.Add(basePtr, i * entrySize), typeof(FlacProbeBatchEntryNative));
+                        if (entry.status != 0)
+                            continue;
+
+                        var fileInfo = new FlacFileInfo
+                        {
+                            SampleRate = entry.sampleRate,
+                            Channels = entry.channels,
+                            BitsPerSample = entry.bitsPerSample,
+                            TotalPcmFrames = entry.totalPcmFrames,
+                            Duration = entry.durationSeconds,
+                            Md5 = entry.md5,
+                            Pictures = new FlacPicture[entry.pictureCount]
+                        };
+                        ParsePackedTags(buffer, (int)entry.tagsOffset, (int)entry.tagsSize, fileInfo);
+
+                        for (int p = 0; p < entry.pictureCount; p++)
+                        {
+                            var picture = (FlacPictureInfoNative)Marshal.PtrToStructure(
+                                IntPtr.Add(basePtr, (int)entry.picturesOffset + p * pictureSize), typeof(FlacPictureInfoNative));
+                            fileInfo.Pictures[p] = new FlacPicture
+                            {
+                                Type = picture.pictureType,
+                                Width = (int)picture.width,
+                                Height = (int)picture.height,
+                                DataOffset = (long)picture.dataOffset,
+                                DataSize = (int)picture.dataSize,
+                                MimeType = picture.mimeType
+                            };
+                        }
+
+                        results[i] = fileInfo;
+                    }
+                }
+                finally
+                {
+                    handle.Free();
+                }
+
+                return results;
+            }
+            catch (Exception ex)
+            {
+                Plugin.Log.LogWarning($"[FlacDecoder] Batch probe exception: {ex.Message}");
+                return null;
+            }
+            finally
+            {
+                if (batch != IntPtr.Zero)
+                {
+                    FreeFlacProbeBatch(batch);
+                }
+            }
+        }
+
+        /// <summary>
+        /// 解析打包的 "KEY=value\0" 标签（UTF-8）
+        /// </summary>
+        private static void ParsePackedTags(byte[] packed, int offset, int size, FlacFileInfo fileInfo)
+        {
+            int start = offset;
+            int end = offset + size;
+            for (int i = offset; i < end; i++)
+            {
+                if (packed[i] != 0) continue;
+                var comment = Encoding.UTF8.GetString(packed, start, i - start);
+                start = i + 1;
+
+                int equals = comment.IndexOf('=');
+                if (equals <= 0) continue;
+                var key = comment.Substring(0, equals);
+                if (!fileInfo.Tags.TryGetValue(key, out var values))
+                {
+                    values = new List<string>();
+                    fileInfo.Tags[key] = values;
+                }
+                values.Add(comment.Substring(equals + 1));
+            }
+        }
+
+        // ========== 封面缩略图 API ==========
+
+        private const int FLAC_COVER_CIRCULAR = 1;
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Unicode)]
+        private static extern int LoadCoverThumbnail(string filePath, int size, int flags, byte[] outRgba);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        private static extern int CreateCoverThumbnail(byte[] data, UIntPtr dataSize, int size, int flags, byte[] outRgba);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        private static extern int ResizeCoverImage(Color32[] rgba, int width, int height, int size, int flags, byte[] outRgba);
+
+        /// <summary>
+        /// 从文件生成封面缩略图：FLAC 读取内嵌封面，其他文件按图片（JPEG / PNG / BMP / GIF）解码。
+        /// 全部像素处理在 Native 完成，可在任意线程调用
+        /// </summary>
+        /// <param name="filePath">FLAC 文件或图片文件路径</param>
+        /// <param name="size">输出边长（像素）</param>
+        /// <param name="circular">是否应用圆形遮罩</param>
+        /// <returns>size×size 的 RGBA32 数据（Unity 行序，可直接 LoadRawTextureData），失败返回 null</returns>
+        public static byte[] LoadCoverThumbnailFromFile(string filePath, int size, bool circular)
+        {
+            if (!IsAvailable() || string.IsNullOrEmpty(filePath))
+                return null;
+
+            var rgba = new byte[size * size * 4];
+            int result = LoadCoverThumbnail(filePath, size, circular ? FLAC_COVER_CIRCULAR : 0, rgba);
+            if (result != 0)
+            {
+                Plugin.Log.LogDebug($"[FlacDecoder] Cover thumbnail failed: {GetErrorMessage()} (code={result})");
+                return null;
+            }
+            return rgba;
+        }
+
+        /// <summary>
+        /// 从内存中的图片数据生成封面缩略图，其余同 LoadCoverThumbnailFromFile
+        /// </summary>
+        public static byte[] CreateCoverThumbnailFromBytes(byte[] imageData, int size, bool circular)
+        {
+            if (!IsAvailable() || imageData == null || imageData.Length == 0)
+                return null;
+
+            var rgba = new byte[size * size * 4];
+            int result = CreateCoverThumbnail(imageData, (UIntPtr)imageData.Length, size, circular ? FLAC_COVER_CIRCULAR : 0, rgba);
+            if (result != 0)
+            {
+                Plugin.Log.LogDebug($"[FlacDecoder] Cover thumbnail failed: {GetErrorMessage()} (code={result})");
+                return null;
+            }
+            return rgba;
+        }
+
+        /// <summary>
+        /// 缩放已解码的像素（Texture2D.GetPixels32 的结果）为缩略图
+        /// </summary>
+        /// <returns>size×size 的 RGBA32 数据，失败返回 null</returns>
+        public static byte[] ResizeCoverPixels(Color32[] pixels, int width, int height, int size, bool circular)
+        {
+            if (!IsAvailable() || pixels == null || pixels.Length < width * height)
+                return null;
+
+            var rgba = new byte[size * size * 4];
+            int result = ResizeCoverImage(pixels, width, height, size, circular ? FLAC_COVER_CIRCULAR : 0, rgba);
+            return result == 0 ? rgba : null;
+        }
+
+        // ========== 封面占位图 API ==========
+
+        private const int FLAC_PLACEHOLDER_MAX_COLORS = 4;
+
+        [StructLayout(LayoutKind.Sequential, CharSet = CharSet.Ansi)]
+        private struct FlacCoverPlaceholderNative
+        {
+            [MarshalAs(UnmanagedType.ByValArray, SizeConst = FLAC_PLACEHOLDER_MAX_COLORS)]
+            public uint[] colors;
+            [MarshalAs(UnmanagedType.ByValArray, SizeConst = FLAC_PLACEHOLDER_MAX_COLORS)]
+            public float[] weights;
+            public int colorCount;
+            [MarshalAs(UnmanagedType.ByValTStr, SizeConst = 32)]
+            public string blurhash;
+        }
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Unicode)]
+        private static extern int LoadCoverPlaceholder(string filePath, out FlacCoverPlaceholderNative placeholder);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Ansi)]
+        private static extern int DecodeCoverPlaceholder(string blurhash, int size, byte[] outRgba);
+
+        /// <summary>
+        /// 从文件计算封面占位图（主色 + blurhash），来源同 LoadCoverThumbnailFromFile。可在任意线程调用
+        /// </summary>
+        /// <returns>占位图，没有封面或失败返回 null</returns>
+        public static CoverPlaceholder LoadCoverPlaceholderFromFile(string filePath)
+        {
+            if (!IsAvailable() || string.IsNullOrEmpty(filePath))
+                return null;
+
+            int result = LoadCoverPlaceholder(filePath, out var native);
+            if (result != 0)
+            {
+                Plugin.Log.LogDebug($"[FlacDecoder] Cover placeholder failed: {GetErrorMessage()} (code={result})");
+                return null;
+            }
+
+            int count = Math.Min(native.colorCount, FLAC_PLACEHOLDER_MAX_COLORS);
+            var colors = new Color32[count];
+            var weights = new float[count];
+            for (int i = 0; i < count; i++)
+            {
+                uint rgb = native.colors[i];
+                colors[i] = new Color32((byte)(rgb >> 16), (byte)(rgb >> 8), (byte)rgb, 255);
+                weights[i] = native.weights[i];
+            }
+
+            return new CoverPlaceholder
+            {
+                Blurhash = native.blurhash,
+                DominantColors = colors,
+                Weights = weights
+            };
+        }
+
+        /// <summary>
+        /// 把 blurhash 解码为 size×size 的 RGBA32 像素（Unity 行序，可直接 LoadRawTextureData）
+        /// </summary>
+        /// <returns>像素数据，blurhash 无效时返回 null</returns>
+        public static byte[] DecodeCoverPlaceholderPixels(string blurhash, int size)
+        {
+            if (!IsAvailable() || string.IsNullOrEmpty(blurhash))
+                return null;
+
+            var rgba = new byte[size * size * 4];
+            return DecodeCoverPlaceholder(blurhash, size, rgba) == 0 ? rgba : null;
+        }
+
+        // ========== 缩略图缓存 API ==========
+
+        private const int FLAC_THUMBNAIL_BC3 = 2;
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Unicode)]
+        private static extern IntPtr OpenThumbnailCache(string cachePath);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Unicode)]
+        private static extern int GetCachedCoverThumbnail(
+            IntPtr cacheHandle, string filePath, int size, int flags,
+            byte[] outBlocks, UIntPtr capacity, out int format);
+
+        // 压缩缩略图缓存文件（与 seek 索引放在同一个缓存目录下）
+        private static readonly string ThumbnailCachePath = Path.Combine(
+            Path.GetDirectoryName(SeekIndexCacheDirectory), "cover_thumbnails.cptc");
+
+        private static readonly object ThumbnailCacheLock = new object();
+        private static IntPtr _thumbnailCache = IntPtr.Zero;
+        private static bool _thumbnailCacheOpened;
+
+        // 首次使用时打开缓存，失败时不使用缓存（每次重新生成）。句柄在进程生命周期内保持打开
+        private static IntPtr GetThumbnailCache()
+        {
+            lock (ThumbnailCacheLock)
+            {
+                if (!_thumbnailCacheOpened)
+                {
+                    _thumbnailCacheOpened = true;
+                    try
+                    {
+                        Directory.CreateDirectory(Path.GetDirectoryName(ThumbnailCachePath));
+                        _thumbnailCache = OpenThumbnailCache(ThumbnailCachePath);
+                        if (_thumbnailCache == IntPtr.Zero)
+                            Plugin.Log.LogWarning($"[FlacDecoder] Thumbnail cache disabled: {GetErrorMessage()}");
+                    }
+                    catch (Exception ex)
+                    {
+                        Plugin.Log.LogWarning($"[FlacDecoder] Thumbnail cache disabled: {ex.Message}");
+                    }
+                }
+                return _thumbnailCache;
+            }
+        }
+
+        /// <summary>
+        /// 获取 GPU 压缩格式（方形 DXT1，圆形 DXT5）的封面缩略图，结果持久化在缩略图缓存中，
+        /// 之后同一文件（或同一张封面）直接读取块数据，无需解码和缩放。可在任意线程调用
+        /// </summary>
+        /// <param name="filePath">FLAC 文件或图片文件路径</param>
+        /// <param name="size">输出边长（像素，4 的倍数）</param>
+        /// <param name="circular">是否应用圆形遮罩</param>
+        /// <param name="format">纹理格式（DXT1 或 DXT5）</param>
+        /// <returns>压缩块数据（可直接 LoadRawTextureData），失败返回 null</returns>
+        public static byte[] LoadCompressedCoverThumbnail(string filePath, int size, bool circular, out TextureFormat format)
+        {
+            format = circular ? TextureFormat.DXT5 : TextureFormat.DXT1;
+            if (!IsAvailable() || string.IsNullOrEmpty(filePath))
+                return null;
+
+            var blocks = new byte[circular ? size * size : size * size / 2];
+            int result = GetCachedCoverThumbnail(
+                GetThumbnailCache(), filePath, size, circular ? FLAC_COVER_CIRCULAR : 0,
+                blocks, (UIntPtr)blocks.Length, out int nativeFormat);
+            if (result < 0)
+            {
+                Plugin.Log.LogDebug($"[FlacDecoder] Cached cover thumbnail failed: {GetErrorMessage()} (code={result})");
+                return null;
+            }
+            format = nativeFormat == FLAC_THUMBNAIL_BC3 ? TextureFormat.DXT5 : TextureFormat.DXT1;
+            return blocks;
+        }
+
+        // ========== 封面加载调度 API ==========
+
+        [StructLayout(LayoutKind.Sequential)]
+        private struct FlacCoverJobResultNative
+        {
+            public long jobId;
+            public int status;
+            public int format;
+            public IntPtr data;
+        }
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        private static extern IntPtr CreateCoverScheduler(IntPtr thumbnailCache, int threads);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Unicode)]
+        private static extern long SubmitCoverJob(IntPtr scheduler, string filePath, int size, int flags, int priority);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        private static extern int SetCoverJobPriorities(IntPtr scheduler, long[] jobIds, int[] priorities, int count);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        private static extern int CancelCoverJobs(IntPtr scheduler, long[] jobIds, int count);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        private static extern int PollCoverJobs(IntPtr scheduler, [Out] FlacCoverJobResultNative[] results, int maxResults);
+
+        // 每次轮询最多取回的结果数
+        private const int COVER_POLL_BATCH = 16;
+
+        private static readonly object CoverSchedulerLock = new object();
+        private static IntPtr _coverScheduler = IntPtr.Zero;
+        private static readonly FlacCoverJobResultNative[] _coverPollBuffer = new FlacCoverJobResultNative[COVER_POLL_BATCH];
+
+        /// <summary>
+        /// 已完成的封面任务
+        /// </summary>
+        public struct CoverJobResult
+        {
+            public long JobId;
+            /// <summary>压缩块数据（可直接 LoadRawTextureData），失败时为 null</summary>
+            public byte[] Blocks;
+            public TextureFormat Format;
+        }
+
+        // 首次使用时创建调度器（使用缩略图缓存），在进程生命周期内保持
+        private static IntPtr GetCoverScheduler()
+        {
+            lock (CoverSchedulerLock)
+            {
+                if (_coverScheduler == IntPtr.Zero)
+                    _coverScheduler = CreateCoverScheduler(GetThumbnailCache(), 0);
+                return _coverScheduler;
+            }
+        }
+
+        /// <summary>
+        /// 提交压缩封面缩略图任务（结果同 LoadCompressedCoverThumbnail），由 Native 工作线程按优先级执行，
+        /// 完成后通过 PollCoverThumbnailJobs 取回
+        /// </summary>
+        /// <param name="priority">优先级，数值大的先执行</param>
+        /// <returns>任务 ID，失败返回 0</returns>
+        public static long SubmitCoverThumbnailJob(string filePath, int size, bool circular, int priority)
+        {
+            if (!IsAvailable() || string.IsNullOrEmpty(filePath))
+                return 0;
+
+            long jobId = SubmitCoverJob(GetCoverScheduler(), filePath, size, circular ? FLAC_COVER_CIRCULAR : 0, priority);
+            return jobId > 0 ? jobId : 0;
+        }
+
+        /// <summary>
+        /// 批量调整尚未开始执行的封面任务的优先级
+        /// </summary>
+        public static void SetCoverThumbnailJobPriorities(long[] jobIds, int[] priorities)
+        {
+            if (!IsAvailable() || jobIds == null || jobIds.Length == 0)
+                return;
+
+            SetCoverJobPriorities(GetCoverScheduler(), jobIds, priorities, jobIds.Length);
+        }
+
+        /// <summary>
+        /// 批量取消封面任务，被取消的任务不会出现在轮询结果中
+        /// </summary>
+        public static void CancelCoverThumbnailJobs(long[] jobIds)
+        {
+            if (!IsAvailable() || jobIds == null || jobIds.Length == 0)
+                return;
+
+            CancelCoverJobs(GetCoverScheduler(), jobIds, jobIds.Length);
+        }
+
+        /// <summary>
+        /// 取回已完成的封面任务（只应在主线程上调用）
+        /// </summary>
+        /// <param name="results">结果追加到此列表</param>
+        /// <returns>取回的数量</returns>
+        public static int PollCoverThumbnailJobs(List<CoverJobResult> results)
+        {
+            if (!IsAvailable())
+                return 0;
+
+            int count = PollCoverJobs(GetCoverScheduler(), _coverPollBuffer, COVER_POLL_BATCH);
+            for (int i = 0; i < count; i++)
+            {
+                var native = _coverPollBuffer[i];
+                byte[] blocks = null;
+                if (native.status > 0 && native.data != IntPtr.Zero)
+                {
+                    blocks = new byte[native.status];
+                    Marshal.Copy(native.data, blocks, 0, native.status);
+                }
+                results.Add(new CoverJobResult
+                {
+                    JobId = native.jobId,
+                    Blocks = blocks,
+                    Format = native.format == FLAC_THUMBNAIL_BC3 ? TextureFormat.DXT5 : TextureFormat.DXT1
+                });
+            }
+            return Math.Max(0, count);
+        }
+
+        // ========== 波形概览 API ==========
+
+        /// <summary>
+        /// 波形峰值（所有声道合并统计）
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public struct FlacWaveformPeak
+        {
+            /// <summary>最小采样值 × 127</summary>
+            public sbyte Min;
+            /// <summary>最大采样值 × 127</summary>
+            public sbyte Max;
+            /// <summary>均方根 × 255</summary>
+            public byte Rms;
+            /// <summary>1=已生成，0=尚未生成</summary>
+            public byte Ready;
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        private struct FlacWaveformInfoNative
+        {
+            public int sampleRate;
+            public int channels;
+            public ulong totalPcmFrames;
+            public int framesPerPeak;
+            public int levelCount;
+            public int state;
+            public int fromCache;
+            public float progress;
+        }
+
+        private const int FLAC_WAVEFORM_RUNNING = 0;
+        private const int FLAC_WAVEFORM_COMPLETE = 1;
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Unicode)]
+        private static extern IntPtr StartFlacWaveform(string filePath, int threads);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        private static extern int GetFlacWaveformInfo(IntPtr waveform, out FlacWaveformInfoNative info);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        private static extern int GetFlacWaveformPeaks(IntPtr waveform, int level, ulong start, int count, [Out] FlacWaveformPeak[] peaks);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void CloseFlacWaveform(IntPtr waveform);
+
+        /// <summary>
+        /// [已废弃] 解码 FLAC 文件并创建 Unity AudioClip（一次性全部加载到内存）
+        /// 
+        /// ⚠️ 此方法会将整个 FLAC 文件解码到内存中，对于高采样率的文件会占用大量内存。
+        /// 建议使用 FlacStreamReader + CreateStreamingAudioClip 实现流式播放。
+        /// 
+        /// 保留此方法仅用于调试和特殊场景。
+        /// </summary>
+        /// <param name="filePath">FLAC 文件路径</param>
+        /// <param name="clipName">AudioClip 名称</param>
+        /// <returns>Unity AudioClip 对象，失败返回 null</returns>
+        [Obsolete("Use FlacStreamReader for streaming playback to reduce memory usage")]
+        public static AudioClip DecodeFlacToAudioClip(string filePath, string clipName)
+        {
+            if (!File.Exists(filePath))
+            {
+                Plugin.Log.LogError($"[FlacDecoder] File not found: {filePath}");
+                return null;
+            }
+
+            FlacPcmData info = default;
+
+            try
+            {
+                // 调用 Native Plugin 解码（交错 float32，按 CPU 核心数并行）
+                int result = DecodeFlacFileParallel(filePath, 0, 0, 0, out info);
+
+                if (result != 0)
+                {
+                    string error = GetErrorMessage();
+                    Plugin.Log.LogError($"[FlacDecoder] Failed to decode FLAC: {error} (code={result})");
+                    return null;
+                }
+
+                // 验证音频参数
+                if (info.channels < 1 || info.channels > 8)
+                {
+                    Plugin.Log.LogError($"[FlacDecoder] Invalid channel count: {info.channels}");
+                    return null;
+                }
+
+                if (info.sampleRate < 8000 || info.sampleRate > 192000)
+                {
+                    Plugin.Log.LogError($"[FlacDecoder] Invalid sample rate: {info.sampleRate}");
+                    return null;
+                }
+
+                if (info.totalPcmFrameCount == 0 || info.pcmData == IntPtr.Zero)
+                {
+                    Plugin.Log.LogError("[FlacDecoder] No PCM data decoded");
+                    return null;
+                }
+
+                // 复制 PCM 数据到托管数组
+                int sampleCount = (int)(info.totalPcmFrameCount * (ulong)info.channels);
+                float[] pcmData = new float[sampleCount];
+                Marshal.Copy(info.pcmData, pcmData, 0, sampleCount);
+
+                // 创建 Unity AudioClip
+                AudioClip clip = AudioClip.Create(
+                    clipName,
+                    (int)info.totalPcmFrameCount,
+                    info.channels,
+                    info.sampleRate,
+                    false
+                );
+
+                if (clip == null)
+                {
+                    Plugin.Log.LogError("[FlacDecoder] Failed to create AudioClip");
+                    return null;
+                }
+
+                // 设置 PCM 数据
+                if (!clip.SetData(pcmData, 0))
+                {
+                    Plugin.Log.LogError("[FlacDecoder] Failed to set AudioClip data");
+                    UnityEngine.Object.Destroy(clip);
+                    return null;
+                }
+
+                Plugin.Log.LogInfo($"[FlacDecoder] ✅ Decoded: {Path.GetFileName(filePath)} " +
+                    $"({info.sampleRate}Hz, {info.channels}ch, {info.totalPcmFrameCount} frames)");
+
+                return clip;
+            }
+            catch (DllNotFoundException ex)
+            {
+                Plugin.Log.LogError($"[FlacDecoder] Native DLL not found: {ex.Message}");
+                Plugin.Log.LogError($"[FlacDecoder] Please ensure ChillFlacDecoder.dll is in BepInEx/plugins/ChillPatcher/native/");
+                return null;
+            }
+            catch (Exception ex)
+            {
+                Plugin.Log.LogError($"[FlacDecoder] Exception: {ex}");
+                return null;
+            }
+            finally
+            {
+                // 释放 Native 分配的内存
+                if (info.pcmData != IntPtr.Zero)
+                {
+                    FreeFlacPcmData(ref info);
+                }
+            }
+        }
+
+        /// <summary>
+        /// 获取 Native Plugin 错误消息
+        /// </summary>
+        private static string GetErrorMessage()
+        {
+            try
+            {
+                IntPtr ptr = FlacGetLastError();
+                if (ptr != IntPtr.Zero)
+                {
+                    return Marshal.PtrToStringAnsi(ptr) ?? "Unknown error";
+                }
+            }
+            catch { }
+            return "Unknown error";
+        }
+
+        /// <summary>
+        /// 设置之后打开的文件使用的 I/O 后端
+        /// </summary>
+        /// <param name="backend">后端</param>
+        /// <param name="latencyUs">每个异步请求附加的人为延迟（微秒，测试慢速存储用），0=关闭</param>
+        public static bool ConfigureIoBackend(FlacIoBackend backend, int latencyUs = 0)
+        {
+            if (!IsAvailable()) return false;
+            return SetFlacIoBackend((int)backend, latencyUs) == 0;
+        }
+
+        /// <summary>
+        /// 新打开的文件实际使用的 I/O 后端（Auto 已解析，io_uring 不可用时为 ThreadPool）
+        /// </summary>
+        public static FlacIoBackend GetEffectiveIoBackend()
+        {
+            return IsAvailable() ? (FlacIoBackend)GetFlacIoBackend() : FlacIoBackend.Mapped;
+        }
+
+        /// <summary>
+        /// 获取解码器内存统计，Native 不可用时返回 false
+        /// </summary>
+        public static bool TryGetMemoryStats(out FlacMemoryStats stats)
+        {
+            stats = default;
+            return IsAvailable() && GetFlacMemoryStats(out stats) == 0;
+        }
+
+        /// <summary>
+        /// 把解码器块池中保留的空闲块交还系统堆
+        /// </summary>
+        public static void TrimMemoryPool()
+        {
+            if (IsAvailable()) TrimFlacMemoryPool();
+        }
+
+        /// <summary>
+        /// 检查 Native Plugin 是否可用
+        /// </summary>
+        public static bool IsAvailable()
+        {
+            return DllHandle != IntPtr.Zero;
+        }
+
+        /// <summary>
+        /// FLAC 流式读取器
+        /// </summary>
+        public class FlacStreamReader : IDisposable
+        {
+            // 默认输出缓冲区容量（帧），Unity 回调块更大时自动重新注册
+            private const int DEFAULT_OUTPUT_FRAMES = 4096;
+
+            private IntPtr _streamHandle;
+            private bool _disposed = false;
+
+            // Native 分配的输出缓冲区（随流释放），只在读取线程上使用
+            private IntPtr _outputBuffer;
+            private int _outputFrames;
+
+            public int SampleRate { get; private set; }
+            public int Channels { get; private set; }
+            public ulong TotalPcmFrames { get; private set; }
+
+            /// <summary>
+            /// 当前读取位置（由 Native 维护，seek 尚未落地时为目标位置）
+            /// </summary>
+            public ulong CurrentFrame
+            {
+                get
+                {
+                    if (_disposed || _streamHandle == IntPtr.Zero)
+                        return 0;
+                    return (ulong)Math.Max(0, GetFlacStreamPosition(_streamHandle));
+                }
+            }
+
+            /// <summary>
+            /// 最近一次 Seek 是否尚未落地（解码方还没在读取边界执行它）
+            /// </summary>
+            public bool IsSeekPending => !_disposed && _streamHandle != IntPtr.Zero && GetFlacSeekState(_streamHandle) == 1;
+
+            /// <summary>是否启用了 Native 预解码（ReadFrames 只从环形缓冲区拷贝）</summary>
+            public bool IsDecodeAhead { get; private set; }
+
+            public FlacStreamReader(string filePath) : this(filePath, 0)
+            {
+            }
+
+            /// <param name="filePath">FLAC 文件路径</param>
+            /// <param name="decodeAheadMs">预解码缓冲时长（毫秒），0 表示在音频线程上同步解码</param>
+            public FlacStreamReader(string filePath, int decodeAheadMs) : this(filePath, decodeAheadMs, 0, 0)
+            {
+            }
+
+            /// <param name="filePath">FLAC 文件路径</param>
+            /// <param name="decodeAheadMs">预解码缓冲时长（毫秒），0 表示在音频线程上同步解码</param>
+            /// <param name="outputSampleRate">输出采样率，0 表示保持源采样率。
+            /// 启用后 SampleRate、TotalPcmFrames 和 Seek 位置都以输出采样率计</param>
+            /// <param name="outputChannels">输出声道数（1 或 2），0 表示保持源声道数。
+            /// 源声道更多时按 ITU 系数缩混，Channels 为缩混后的声道数</param>
+            public FlacStreamReader(string filePath, int decodeAheadMs, int outputSampleRate, int outputChannels)
+            {
+                var options = new FlacStreamOptions
+                {
+                    decodeAheadMs = decodeAheadMs,
+                    outputSampleRate = outputSampleRate,
+                    outputChannels = outputChannels
+                };
+                var handle = OpenFlacStreamEx(
+                    filePath,
+                    ref options,
+                    out int sampleRate,
+                    out int channels,
+                    out ulong totalFrames);
+
+                if (handle == IntPtr.Zero)
+                {
+                    throw new Exception($"Failed to open FLAC stream: {GetErrorMessage()}");
+                }
+
+                Initialize(handle, sampleRate, channels, totalFrames, decodeAheadMs);
+            }
+
+            private FlacStreamReader()
+            {
+            }
+
+            /// <summary>
+            /// 打开仍在写入中的 FLAC 文件（边下边播缓存）
+            /// 元数据尚未完整写入时返回 null，可在写入更多数据后重试
+            /// </summary>
+            /// <param name="filePath">FLAC 文件路径</param>
+            /// <param name="writtenBytes">当前已写入的字节数</param>
+            /// <param name="decodeAheadMs">预解码缓冲时长（毫秒），0 表示同步解码</param>
+            public static FlacStreamReader TryOpenGrowing(string filePath, long writtenBytes, int decodeAheadMs = 0)
+            {
+                var options = new FlacStreamOptions { decodeAheadMs = decodeAheadMs };
+                var handle = OpenFlacGrowingStream(
+                    filePath,
+                    (ulong)writtenBytes,
+                    ref options,
+                    out int sampleRate,
+                    out int channels,
+                    out ulong totalFrames);
+
+                if (handle == IntPtr.Zero)
+                {
+                    Plugin.Log.LogDebug($"[FlacStreamReader] Growing stream not ready: {GetErrorMessage()}");
+                    return null;
+                }
+
+                var reader = new FlacStreamReader { IsGrowing = true };
+                reader.Initialize(handle, sampleRate, channels, totalFrames, decodeAheadMs);
+                return reader;
+            }
+
+            /// <summary>
+            /// 取走预加载器中已打开并预解码的流（正在打开时等待打开完成）
+            /// 没有可用的待命流时返回 null，调用者应照常打开
+            /// </summary>
+            /// <param name="preloader">预加载器</param>
+            /// <param name="filePath">FLAC 文件路径（与 Prepare 传入的完全相同）</param>
+            public static FlacStreamReader TryTakePrepared(FlacStreamPreloader preloader, string filePath)
+            {
+                if (preloader == null || preloader.Handle == IntPtr.Zero || string.IsNullOrEmpty(filePath))
+                    return null;
+
+                var handle = TakeFlacPreparedStream(
+                    preloader.Handle,
+                    filePath,
+                    out int sampleRate,
+                    out int channels,
+                    out ulong totalFrames);
+
+                if (handle == IntPtr.Zero)
+                    return null;
+
+                var reader = new FlacStreamReader();
+                reader.Initialize(handle, sampleRate, channels, totalFrames, preloader.DecodeAheadMs);
+                return reader;
+            }
+
+            /// <summary>
+            /// 创建推送流：下载到的字节通过 PushData 直接送入解码器，不经过临时文件
+            /// 收到完整元数据前 IsReady 为 false，音频信息尚不可用
+            /// </summary>
+            /// <param name="decodeAheadMs">预解码缓冲时长（毫秒），0 表示同步解码</param>
+            public static FlacStreamReader CreatePush(int decodeAheadMs = 0)
+            {
+                var options = new FlacStreamOptions { decodeAheadMs = decodeAheadMs };
+                var handle = CreateFlacPushStream(ref options);
+                if (handle == IntPtr.Zero)
+                {
+                    throw new Exception($"Failed to create FLAC push stream: {GetErrorMessage()}");
+                }
+
+                return new FlacStreamReader
+                {
+                    _streamHandle = handle,
+                    _decodeAheadMs = decodeAheadMs,
+                    IsGrowing = true,
+                    IsPush = true
+                };
+            }
+
+            private void Initialize(IntPtr handle, int sampleRate, int channels, ulong totalFrames, int decodeAheadMs)
+            {
+                _streamHandle = handle;
+                SampleRate = sampleRate;
+                Channels = channels;
+                TotalPcmFrames = totalFrames;
+                IsDecodeAhead = decodeAheadMs > 0;
+                IsReady = true;
+
+                // 读取开始前注册一次输出缓冲区，之后每次回调只传帧数
+                RegisterOutput(DEFAULT_OUTPUT_FRAMES);
+
+                Plugin.Log.LogInfo($"[FlacStreamReader] Opened {(IsPush ? "push " : IsGrowing ? "growing " : "")}stream: {sampleRate}Hz, {channels}ch, {totalFrames} frames" +
+                    (IsDecodeAhead ? $", decode-ahead {decodeAheadMs}ms" : ""));
+            }
+
+            /// <summary>是否为边写边读流（推送流也属于边写边读流）</summary>
+            public bool IsGrowing { get; private set; }
+
+            /// <summary>是否为推送流</summary>
+            public bool IsPush { get; private set; }
+
+            /// <summary>解码器是否已打开（推送流收到完整元数据后才为 true）</summary>
+            public bool IsReady { get; private set; }
+
+            private int _decodeAheadMs;
+
+            /// <summary>
+            /// 向推送流追加数据（只能在单个线程上调用）
+            /// 收到完整元数据后自动打开解码器，可通过 TryGetStreamInfo 获取音频信息
+            /// </summary>
+            /// <returns>是否成功（数据不是 FLAC 时返回 false）</returns>
+            public bool PushData(byte[] data, int count)
+            {
+                if (_disposed || _streamHandle == IntPtr.Zero || !IsPush)
+                    return false;
+                return PushFlacStreamData(_streamHandle, data, (UIntPtr)(uint)count) == 0;
+            }
+
+            /// <summary>
+            /// 通知推送流数据已全部送达
+            /// </summary>
+            /// <returns>是否成功（已送达的数据不是有效 FLAC 时返回 false）</returns>
+            public bool FinishPush()
+            {
+                if (_disposed || _streamHandle == IntPtr.Zero || !IsPush)
+                    return false;
+                return FinishFlacPushStream(_streamHandle) == 0;
+            }
+
+            /// <summary>
+            /// 推送流：检查解码器是否已打开，打开后填充 SampleRate / Channels / TotalPcmFrames
+            /// </summary>
+            public bool TryGetStreamInfo()
+            {
+                if (IsReady) return true;
+                if (_disposed || _streamHandle == IntPtr.Zero)
+                    return false;
+
+                if (GetFlacStreamInfo(_streamHandle, out int sampleRate, out int channels, out ulong totalFrames) != 0)
+                    return false;
+
+                Initialize(_streamHandle, sampleRate, channels, totalFrames, _decodeAheadMs);
+                return true;
+            }
+
+            /// <summary>
+            /// 可安全解码的 PCM 帧数（边写边读流为已完整写入的帧数，否则为总帧数）
+            /// </summary>
+            public ulong DecodableFrames
+            {
+                get
+                {
+                    if (_disposed || _streamHandle == IntPtr.Zero)
+                        return 0;
+                    return (ulong)Math.Max(0, GetFlacDecodableFrames(_streamHandle));
+                }
+            }
+
+            /// <summary>
+            /// 通知边写边读流文件已写入更多数据（可在下载线程调用）
+            /// </summary>
+            /// <returns>可安全解码的 PCM 帧数</returns>
+            public ulong UpdateWrittenBytes(long writtenBytes, bool isComplete)
+            {
+                if (_disposed || _streamHandle == IntPtr.Zero || !IsGrowing || IsPush)
+                    return 0;
+                return (ulong)Math.Max(0, UpdateFlacGrowingStream(_streamHandle, (ulong)writtenBytes, isComplete ? 1 : 0));
+            }
+
+            /// <summary>
+            /// 读取 PCM 帧到缓冲区
+            /// </summary>
+            /// <param name="buffer">交错格式的 float 缓冲区（长度 = 帧数 * 声道数）</param>
+            /// <param name="framesToRead">要读取的帧数</param>
+            /// <returns>实际读取的帧数</returns>
+            public long ReadFrames(float[] buffer, ulong framesToRead)
+            {
+                if (_disposed || _streamHandle == IntPtr.Zero)
+                    throw new ObjectDisposedException(nameof(FlacStreamReader));
+
+                return ReadFlacFrames(_streamHandle, buffer, framesToRead);
+            }
+
+            /// <summary>
+            /// 用 PCM 数据填满 Unity 回调的整块缓冲区（Native 侧补齐静音）
+            /// 解码写入注册的 Native 缓冲区，只有一次内存拷贝，没有数组封送
+            /// </summary>
+            /// <param name="data">Unity 回调的交错格式缓冲区</param>
+            /// <returns>其中有效音频的帧数（其余为静音），-1 表示错误（缓冲区内容未定义）</returns>
+            public long FillBuffer(float[] data)
+            {
+                if (_disposed || _streamHandle == IntPtr.Zero)
+                    throw new ObjectDisposedException(nameof(FlacStreamReader));
+
+                int frames = data.Length / Channels;
+                if (frames > _outputFrames && !RegisterOutput(frames))
+                    return -1;
+
+                long filled = FillFlacOutput(_streamHandle, 0, (ulong)frames);
+                if (filled < 0)
+                    return -1;
+
+                Marshal.Copy(_outputBuffer, data, 0, frames * Channels);
+                return filled;
+            }
+
+            private bool RegisterOutput(int frames)
+            {
+                var buffer = RegisterFlacOutputBuffer(_streamHandle, IntPtr.Zero, (ulong)frames);
+                if (buffer == IntPtr.Zero)
+                {
+                    Plugin.Log.LogWarning($"[FlacStreamReader] Failed to register output buffer: {GetErrorMessage()}");
+                    return false;
+                }
+
+                _outputBuffer = buffer;
+                _outputFrames = frames;
+                return true;
+            }
 
             /// <summary>
             /// 定位到指定帧
+            /// 只投递到 Native 的 seek 信箱，不会与音频线程上的 ReadFrames 竞争，可在任意线程调用
             /// </summary>
+            /// <returns>是否已投递</returns>
             public bool Seek(ulong frameIndex)
             {
                 if (_disposed || _streamHandle == IntPtr.Zero)
                     throw new ObjectDisposedException(nameof(FlacStreamReader));
 
-                int result = SeekFlacStream(_streamHandle, frameIndex);
-                if (result == 0)
+                return SeekFlacStream(_streamHandle, frameIndex) == 0;
+            }
+
+            /// <summary>
+            /// 开启频谱分析（只支持预解码模式）。Native 在低优先级线程上按播放位置做 FFT，不占用音频线程
+            /// </summary>
+            /// <param name="fftSize">FFT 点数（2 的幂，256~16384），0=2048</param>
+            /// <param name="bandCount">对数频带数，0=32</param>
+            /// <param name="smoothing">指数平滑系数（0~1，不含 1），0=不平滑</param>
+            /// <returns>是否成功</returns>
+            public bool EnableSpectrumAnalysis(int fftSize = 0, int bandCount = 0, float smoothing = 0f)
+            {
+                if (_disposed || _streamHandle == IntPtr.Zero)
+                    return false;
+
+                var options = new FlacAnalysisOptions
+                {
+                    fftSize = fftSize,
+                    bandCount = bandCount,
+                    smoothing = smoothing
+                };
+                if (EnableFlacAnalysis(_streamHandle, ref options) != 0)
+                {
+                    Plugin.Log.LogWarning($"[FlacStreamReader] Failed to enable spectrum analysis: {GetErrorMessage()}");
+                    return false;
+                }
+                return true;
+            }
+
+            /// <summary>
+            /// 获取最新的频带能量（dBFS，低频在前），无锁，应在主线程上调用
+            /// </summary>
+            /// <param name="bands">输出数组</param>
+            /// <param name="frame">该结果对应的播放位置</param>
+            /// <returns>写入的频带数，未开启分析时为 0</returns>
+            public int GetSpectrumBands(float[] bands, out ulong frame)
+            {
+                frame = 0;
+                if (_disposed || _streamHandle == IntPtr.Zero || bands == null || bands.Length == 0)
+                    return 0;
+                return Math.Max(0, GetFlacAnalysisBands(_streamHandle, bands, bands.Length, out frame));
+            }
+
+            /// <summary>
+            /// 设置输出增益（如 FlacLoudnessInfo.TrackGainDb）。在解码方施加，预解码模式下已缓冲的数据不受影响
+            /// </summary>
+            /// <param name="gainDb">增益（dB，-60~24）</param>
+            /// <param name="limiter">是否对超过 -1 dBFS 的采样软限幅（正增益时建议开启）</param>
+            /// <returns>是否成功</returns>
+            public bool SetGain(float gainDb, bool limiter)
+            {
+                if (_disposed || _streamHandle == IntPtr.Zero)
+                    return false;
+                return SetFlacStreamGain(_streamHandle, gainDb, limiter ? 1 : 0) == 0;
+            }
+
+            /// <summary>
+            /// 预解码环中已缓冲的帧数（未启用预解码时为 0）
+            /// </summary>
+            public long BufferedFrames
+            {
+                get
                 {
-                    CurrentFrame = frameIndex;
-                    return true;
+                    if (_disposed || _streamHandle == IntPtr.Zero)
+                        return 0;
+                    return Math.Max(0, GetFlacStreamBufferedFrames(_streamHandle));
                 }
+            }
+
+            internal IntPtr Handle => _disposed ? IntPtr.Zero : _streamHandle;
 
-                return false;
+            /// <summary>
+            /// 交出流句柄（所有权转移给过渡引擎等 Native 持有者），之后读取器视为已释放
+            /// </summary>
+            internal IntPtr DetachHandle()
+            {
+                var handle = _streamHandle;
+                _streamHandle = IntPtr.Zero;
+                _disposed = true;
+                return handle;
             }
 
             public void Dispose()
@@ -327,5 +1765,343 @@ namespace ChillPatcher.Native
                 }
             }
         }
+
+        /// <summary>
+        /// 播放队列预加载：Native 后台线程提前打开接下来的文件并预解码开头，切歌时用 FlacStreamReader.TryTakePrepared 取走
+        /// </summary>
+        public class FlacStreamPreloader : IDisposable
+        {
+            // decodeAheadMs 为 0 时 Native 使用的预解码时长（与 flac_preload.cpp 一致）
+            private const int DEFAULT_PRELOAD_MS = 300;
+
+            private IntPtr _handle;
+
+            internal IntPtr Handle => _handle;
+
+            /// <summary>待命流的预解码时长（毫秒），取走的流总是预解码模式</summary>
+            public int DecodeAheadMs { get; }
+
+            /// <param name="decodeAheadMs">预解码缓冲时长（毫秒），0 表示使用默认值（300 毫秒）</param>
+            /// <param name="outputSampleRate">输出采样率，0 表示保持源采样率</param>
+            /// <param name="outputChannels">输出声道数（1 或 2），0 表示保持源声道数</param>
+            /// <param name="memoryBudgetBytes">待命流的内存预算，0 表示默认值（32MB）</param>
+            public FlacStreamPreloader(int decodeAheadMs, int outputSampleRate, int outputChannels, long memoryBudgetBytes = 0)
+            {
+                var options = new FlacStreamOptions
+                {
+                    decodeAheadMs = decodeAheadMs,
+                    outputSampleRate = outputSampleRate,
+                    outputChannels = outputChannels
+                };
+                _handle = CreateFlacPreloader(ref options, (ulong)Math.Max(0, memoryBudgetBytes));
+                if (_handle == IntPtr.Zero)
+                {
+                    throw new Exception($"Failed to create FLAC preloader: {GetErrorMessage()}");
+                }
+                DecodeAheadMs = decodeAheadMs > 0 ? decodeAheadMs : DEFAULT_PRELOAD_MS;
+            }
+
+            /// <summary>
+            /// 设置需要预加载的文件（按优先级从高到低），不在列表中的待命流被取消。不阻塞调用线程
+            /// </summary>
+            public void Prepare(IList<string> filePaths)
+            {
+                if (_handle == IntPtr.Zero)
+                    return;
+                var paths = new string[filePaths?.Count ?? 0];
+                filePaths?.CopyTo(paths, 0);
+                PrepareFlacStreams(_handle, paths, paths.Length);
+            }
+
+            /// <summary>
+            /// 查询文件的预加载状态
+            /// </summary>
+            public FlacPrepareState GetState(string filePath)
+            {
+                if (_handle == IntPtr.Zero || string.IsNullOrEmpty(filePath))
+                    return FlacPrepareState.None;
+                return (FlacPrepareState)GetFlacPreparedState(_handle, filePath);
+            }
+
+            /// <summary>
+            /// 关闭预加载器和所有未取走的流（已取走的流不受影响）
+            /// </summary>
+            public void Dispose()
+            {
+                if (_handle != IntPtr.Zero)
+                {
+                    CloseFlacPreloader(_handle);
+                    _handle = IntPtr.Zero;
+                }
+            }
+        }
+
+        /// <summary>
+        /// 过渡引擎：持有正在播放和排队的流，在 Native 侧完成无缝衔接、交叉淡化和编码器填充裁剪，
+        /// 混合为一路连续 PCM，供单个 AudioClip 的 PCMReaderCallback 读取
+        /// Read 在音频线程调用，其余方法在主线程调用
+        /// </summary>
+        public class FlacTransitionEngine : IDisposable
+        {
+            private IntPtr _handle;
+
+            public int SampleRate { get; }
+            public int Channels { get; }
+
+            /// <param name="sampleRate">输出采样率，排队的流必须与之相同</param>
+            /// <param name="channels">输出声道数（1~8），排队的流必须与之相同</param>
+            public FlacTransitionEngine(int sampleRate, int channels)
+            {
+                _handle = CreateFlacTransition(sampleRate, channels);
+                if (_handle == IntPtr.Zero)
+                {
+                    throw new Exception($"Failed to create FLAC transition engine: {GetErrorMessage()}");
+                }
+                SampleRate = sampleRate;
+                Channels = channels;
+            }
+
+            /// <summary>
+            /// 读取文件元数据中的编码器延迟与填充（iTunSMPB），没有记录时为 0
+            /// </summary>
+            /// <param name="filePath">FLAC 文件路径</param>
+            /// <param name="outputSampleRate">输出采样率，0 表示源采样率</param>
+            public static FlacGaplessTrim GetGaplessTrim(string filePath, int outputSampleRate)
+            {
+                if (string.IsNullOrEmpty(filePath) || GetFlacGaplessTrim(filePath, outputSampleRate, out var trim) != 0)
+                    return default;
+                return trim;
+            }
+
+            /// <summary>
+            /// 设置衔接方式（从下一次衔接开始生效）
+            /// </summary>
+            /// <param name="mode">衔接方式</param>
+            /// <param name="crossfadeMs">交叉淡化时长（毫秒，0~20000），无缝模式下只用于立即切换时的淡出</param>
+            /// <param name="curve">淡化曲线</param>
+            public bool SetMode(FlacTransitionMode mode, int crossfadeMs, FlacFadeCurve curve)
+            {
+                if (_handle == IntPtr.Zero)
+                    return false;
+                return SetFlacTransitionMode(_handle, (int)mode, crossfadeMs, (int)curve) == 0;
+            }
+
+            /// <summary>
+            /// 把流交给引擎。成功后读取器的句柄归引擎所有（读取器视为已释放），失败时读取器不受影响
+            /// </summary>
+            /// <param name="reader">以交错 float32 打开、采样率和声道数与引擎相同的流</param>
+            /// <param name="trim">编码器填充的裁剪量</param>
+            /// <param name="now">true=立即切换（交叉淡化时当前曲目淡出），false=当前曲目结束后播放</param>
+            public bool Queue(FlacStreamReader reader, FlacGaplessTrim trim, bool now)
+            {
+                if (_handle == IntPtr.Zero || reader == null || reader.Handle == IntPtr.Zero)
+                    return false;
+
+                int queue = now ? FLAC_TRANSITION_QUEUE_NOW : FLAC_TRANSITION_QUEUE_NEXT;
+                if (QueueFlacTransitionStream(_handle, reader.Handle, ref trim, queue) != 0)
+                {
+                    Plugin.Log.LogWarning($"[FlacTransition] Failed to queue stream: {GetErrorMessage()}");
+                    return false;
+                }
+                reader.DetachHandle();
+                return true;
+            }
+
+            /// <summary>
+            /// 用混合后的 PCM 填满 Unity 回调的缓冲区（音频线程，没有曲目的部分为静音）
+            /// </summary>
+            public void Read(float[] data)
+            {
+                if (_handle == IntPtr.Zero || ReadFlacTransition(_handle, data, (ulong)(data.Length / Channels)) < 0)
+                {
+                    Array.Clear(data, 0, data.Length);
+                }
+            }
+
+            /// <summary>
+            /// 定位当前曲目（从裁剪后的开头算起），只投递请求
+            /// </summary>
+            public bool Seek(ulong frameIndex)
+            {
+                if (_handle == IntPtr.Zero)
+                    return false;
+                return SeekFlacTransition(_handle, frameIndex) == 0;
+            }
+
+            /// <summary>
+            /// 查询引擎状态（不等待音频线程），同时关闭音频线程交还的流
+            /// </summary>
+            public FlacTransitionStatus GetStatus()
+            {
+                FlacTransitionStatus status = default;
+                if (_handle != IntPtr.Zero)
+                    GetFlacTransitionStatus(_handle, out status);
+                return status;
+            }
+
+            /// <summary>
+            /// 关闭引擎及其持有的所有流（调用前需停止音频线程的读取）
+            /// </summary>
+            public void Dispose()
+            {
+                if (_handle != IntPtr.Zero)
+                {
+                    CloseFlacTransition(_handle);
+                    _handle = IntPtr.Zero;
+                }
+            }
+        }
+
+        /// <summary>
+        /// 进度条波形概览：Native 在后台并行解码生成多分辨率峰值，生成过程中即可按段读取已完成的部分。
+        /// 设置了 seek 索引缓存目录时结果会被缓存，再次打开同一文件直接读取
+        /// </summary>
+        public class FlacWaveformOverview : IDisposable
+        {
+            private IntPtr _handle;
+
+            public int SampleRate { get; }
+            public ulong TotalPcmFrames { get; }
+
+            /// <summary>第 0 层每个峰值覆盖的帧数（约 20 毫秒），第 L 层为其 4^L 倍</summary>
+            public int FramesPerPeak { get; }
+
+            /// <summary>层数，最后一层只有 1 个峰值</summary>
+            public int LevelCount { get; }
+
+            /// <summary>是否从缓存读取（没有重新解码）</summary>
+            public bool FromCache { get; }
+
+            /// <summary>已生成的比例（0~1）</summary>
+            public float Progress => Query().progress;
+
+            /// <summary>全部层是否都已生成</summary>
+            public bool IsComplete => Query().state == FLAC_WAVEFORM_COMPLETE;
+
+            /// <summary>生成是否已结束（完成或失败）</summary>
+            public bool IsFinished => Query().state != FLAC_WAVEFORM_RUNNING;
+
+            /// <param name="filePath">FLAC 文件路径</param>
+            /// <param name="threads">解码线程数，0 表示使用 CPU 核心数</param>
+            public FlacWaveformOverview(string filePath, int threads = 0)
+            {
+                _handle = StartFlacWaveform(filePath, threads);
+                if (_handle == IntPtr.Zero)
+                {
+                    throw new Exception($"Failed to start waveform: {GetErrorMessage()}");
+                }
+
+                var info = Query();
+                SampleRate = info.sampleRate;
+                TotalPcmFrames = info.totalPcmFrames;
+                FramesPerPeak = info.framesPerPeak;
+                LevelCount = info.levelCount;
+                FromCache = info.fromCache != 0;
+            }
+
+            /// <summary>
+            /// 第 level 层的峰值数量
+            /// </summary>
+            public long GetPeakCount(int level)
+            {
+                ulong frames = (ulong)FramesPerPeak << (2 * level);
+                return (long)((TotalPcmFrames + frames - 1) / frames);
+            }
+
+            /// <summary>
+            /// 选择每个峰值不少于 framesPerPixel 帧的最精细层级（用于按进度条宽度取数据）
+            /// </summary>
+            public int SelectLevel(double framesPerPixel)
+            {
+                int level = 0;
+                while (level + 1 < LevelCount && ((long)FramesPerPeak << (2 * (level + 1))) <= framesPerPixel)
+                    level++;
+                return level;
+            }
+
+            /// <summary>
+            /// 读取某一层的峰值，尚未生成的峰值 Ready 为 0
+            /// </summary>
+            /// <returns>写入的数量</returns>
+            public int GetPeaks(int level, long start, FlacWaveformPeak[] peaks)
+            {
+                if (_handle == IntPtr.Zero || peaks == null || start < 0)
+                    return 0;
+                return Math.Max(0, GetFlacWaveformPeaks(_handle, level, (ulong)start, peaks.Length, peaks));
+            }
+
+            private FlacWaveformInfoNative Query()
+            {
+                FlacWaveformInfoNative info = default;
+                if (_handle != IntPtr.Zero)
+                    GetFlacWaveformInfo(_handle, out info);
+                return info;
+            }
+
+            public void Dispose()
+            {
+                if (_handle != IntPtr.Zero)
+                {
+                    CloseFlacWaveform(_handle);
+                    _handle = IntPtr.Zero;
+                }
+            }
+        }
+
+        /// <summary>
+        /// 批量响度分析（后台多线程，有 ReplayGain 标签的文件只读取元数据）
+        /// </summary>
+        public class FlacLoudnessBatch : IDisposable
+        {
+            private IntPtr _handle;
+
+            /// <summary>文件数</summary>
+            public int Count { get; }
+
+            /// <summary>已完成的文件数</summary>
+            public int Completed => _handle == IntPtr.Zero ? 0 : Math.Max(0, GetFlacLoudnessProgress(_handle));
+
+            /// <summary>是否全部完成</summary>
+            public bool IsComplete => Completed >= Count;
+
+            /// <param name="filePaths">FLAC 文件路径</param>
+            /// <param name="threads">工作线程数，0 表示使用 CPU 核心数</param>
+            /// <param name="ignoreTags">忽略 REPLAYGAIN 标签，总是解码测量</param>
+            public FlacLoudnessBatch(string[] filePaths, int threads = 0, bool ignoreTags = false)
+            {
+                if (filePaths == null || filePaths.Length == 0)
+                    throw new ArgumentException("No files to analyze", nameof(filePaths));
+
+                _handle = StartFlacLoudnessBatch(filePaths, filePaths.Length, threads, ignoreTags ? FLAC_LOUDNESS_IGNORE_TAGS : 0);
+                if (_handle == IntPtr.Zero)
+                {
+                    throw new Exception($"Failed to start loudness analysis: {GetErrorMessage()}");
+                }
+                Count = filePaths.Length;
+            }
+
+            /// <summary>
+            /// 读取从 start 开始的结果，尚未完成的项 Source 为 Pending
+            /// </summary>
+            /// <returns>写入的数量</returns>
+            public int GetResults(int start, FlacLoudnessInfo[] results)
+            {
+                if (_handle == IntPtr.Zero || results == null || start < 0)
+                    return 0;
+                return Math.Max(0, GetFlacLoudnessResults(_handle, start, results.Length, results));
+            }
+
+            /// <summary>
+            /// 释放批次，未完成的文件会被取消
+            /// </summary>
+            public void Dispose()
+            {
+                if (_handle != IntPtr.Zero)
+                {
+                    CloseFlacLoudnessBatch(_handle);
+                    _handle = IntPtr.Zero;
+                }
+            }
+        }
     }
 }
@@ -25,6 +25,23 @@ typedef struct {
     size_t pcm_data_size;  // PCM 数据字节数
 } FlacAudioInfo;
 
+// PCM 输出格式（FlacStreamOptions.sample_format / DecodeFlacFileEx）
+typedef enum {
+    FLAC_SAMPLE_F32 = 0,         // 交错 float32，范围 [-1.0, 1.0]（默认）
+    FLAC_SAMPLE_S16 = 1,         // 交错 int16，内存和带宽减半
+    FLAC_SAMPLE_F32_PLANAR = 2   // 平面 float32：每个声道的采样连续存放
+} FlacSampleFormat;
+
+// 指定格式的解码结果（DecodeFlacFileEx 输出，调用者需要调用 FreeFlacPcmData 释放）
+typedef struct {
+    int sample_rate;
+    int channels;
+    unsigned long long total_pcm_frame_count;
+    int sample_format;     // FlacSampleFormat；平面格式中声道 c 从第 c * total_pcm_frame_count 个采样开始
+    void* pcm_data;
+    size_t pcm_data_size;  // PCM 数据字节数
+} FlacPcmData;
+
 /**
  * 解码 FLAC 文件为 PCM 数据
  * 
@@ -34,6 +51,39 @@ typedef struct {
  */
 FLAC_API int DecodeFlacFile(const wchar_t* file_path, FlacAudioInfo* out_info);
 
+/**
+ * 解码 FLAC 文件为指定格式的 PCM 数据
+ * 
+ * @param file_path FLAC 文件路径
+ * @param sample_format 输出格式（FlacSampleFormat）
+ * @param dither 1=输出 s16 且源位深高于 16 位时加 TPDF 抖动，0=直接截断
+ * @param out_data 输出数据（调用者需要调用 FreeFlacPcmData 释放）
+ * @return 0=成功, 非0=错误码（与 DecodeFlacFile 相同，-5=格式无效）
+ */
+FLAC_API int DecodeFlacFileEx(const wchar_t* file_path, int sample_format, int dither, FlacPcmData* out_data);
+
+/**
+ * 多线程解码整个文件（输出与 DecodeFlacFileEx 逐位一致，包括抖动）
+ *
+ * 按 SEEKTABLE（没有时使用持久化 seek 索引，必要时扫描帧头生成）把文件在 FLAC 帧边界切段，
+ * 每个线程以独立的解码器直接写入段在输出缓冲区中的位置。总帧数未知或文件较短时退回单线程解码。
+ *
+ * @param file_path FLAC 文件路径
+ * @param sample_format 输出格式（FlacSampleFormat）
+ * @param dither 同 DecodeFlacFileEx
+ * @param threads 解码线程数，<= 0 时使用 CPU 核心数
+ * @param out_data 输出数据（调用者需要调用 FreeFlacPcmData 释放）
+ * @return 0=成功, 非0=错误码（与 DecodeFlacFileEx 相同）
+ */
+FLAC_API int DecodeFlacFileParallel(const wchar_t* file_path, int sample_format, int dither, int threads, FlacPcmData* out_data);
+
+/**
+ * 释放 DecodeFlacFileEx 输出的 PCM 数据
+ * 
+ * @param data 要释放的数据
+ */
+FLAC_API void FreeFlacPcmData(FlacPcmData* data);
+
 /**
  * 释放解码后的 PCM 数据
  * 
@@ -50,6 +100,25 @@ FLAC_API const char* FlacGetLastError();
 
 // ========== 流式解码 API ==========
 
+// 重采样质量（FlacStreamOptions.resample_quality）
+typedef enum {
+    FLAC_RESAMPLE_STANDARD = 0,  // 每相位 32 抽头，阻带约 90dB（默认）
+    FLAC_RESAMPLE_FAST = 1,      // 每相位 16 抽头，阻带约 60dB
+    FLAC_RESAMPLE_HIGH = 2       // 每相位 64 抽头，阻带约 120dB
+} FlacResampleQuality;
+
+// 流打开选项（OpenFlacStreamEx 使用，传 NULL 等同于全部为 0）
+typedef struct {
+    int decode_ahead_ms;   // 预解码缓冲时长（毫秒），0=关闭（在调用线程上同步解码）
+    int sample_format;     // 输出格式（FlacSampleFormat），0=交错 float32；预解码环按此格式存储（平面格式除外）
+    int dither;            // 1=输出 s16 且源位深高于 16 位（或经过缩混 / 重采样 / 增益）时加 TPDF 抖动
+    int output_sample_rate; // 输出采样率（8000~384000），0=保持源采样率；不同时由 Native 重采样
+    int resample_quality;  // 重采样质量（FlacResampleQuality）
+    int output_channels;   // 输出声道数，0=保持源声道数，1=单声道，2=立体声；源声道更多时由 Native 缩混
+    float gain_db;         // 输出增益（dB，-60~24），0=不改变；之后可用 SetFlacStreamGain 修改
+    int limiter;           // 1=增益后软限幅（-1 dBFS 以上压缩，输出不超过 0 dBFS）
+} FlacStreamOptions;
+
 /**
  * 打开 FLAC 文件用于流式读取
  * 
@@ -61,25 +130,956 @@ FLAC_API const char* FlacGetLastError();
  */
 FLAC_API void* OpenFlacStream(const wchar_t* file_path, int* out_sample_rate, int* out_channels, unsigned long long* out_total_pcm_frames);
 
+/**
+ * 打开 FLAC 文件用于流式读取（带选项）
+ * 
+ * decode_ahead_ms > 0 时启用预解码模式：后台线程提前解码到无锁环形缓冲区，
+ * ReadFlacFrames 只从环中拷贝数据，不在调用线程上进行任何 I/O 或解码。
+ * 
+ * @param file_path FLAC 文件路径（UTF-8 编码）
+ * @param options 打开选项，可为 NULL
+ * @param out_sample_rate 输出采样率
+ * @param out_channels 输出声道数
+ * @param out_total_pcm_frames 输出总帧数
+ * @return 流句柄，失败返回 NULL
+ */
+FLAC_API void* OpenFlacStreamEx(const wchar_t* file_path, const FlacStreamOptions* options, int* out_sample_rate, int* out_channels, unsigned long long* out_total_pcm_frames);
+
 /**
  * 从 FLAC 流读取 PCM 帧
  * 
+ * 预解码模式下环中数据不足（欠载）或 seek 尚未完成时返回的帧数会少于请求值（可能为 0），
+ * 调用者应以静音补齐。
+ * 
+ * 缓冲区格式由打开选项的 sample_format 决定（默认交错 float32）。平面格式下声道 c 的数据
+ * 写在 buffer + c * frames_to_read 处，读取不足时每个平面只有前面的返回值帧有效。
+ * 
  * @param stream_handle 流句柄（由 OpenFlacStream 返回）
- * @param buffer 输出缓冲区（float 数组，交错格式）
+ * @param buffer 输出缓冲区，需容纳 frames_to_read 帧
  * @param frames_to_read 要读取的帧数
  * @return 实际读取的帧数，0表示到达末尾，-1表示错误
  */
-FLAC_API long long ReadFlacFrames(void* stream_handle, float* buffer, unsigned long long frames_to_read);
+FLAC_API long long ReadFlacFrames(void* stream_handle, void* buffer, unsigned long long frames_to_read);
 
 /**
  * 定位到指定的 PCM 帧位置
  * 
+ * 只把请求投递到流的 seek 信箱并立即返回（无锁、不等待），可以在任意线程调用。
+ * 解码方在下一个读取边界执行最新的请求：同步模式为下一次 ReadFlacFrames，预解码模式为后台线程。
+ * 连续多次请求只执行最后一次。落地前 ReadFlacFrames 返回 0，可通过 GetFlacSeekState 查询。
+ * 
  * @param stream_handle 流句柄
  * @param frame_index 目标帧索引
- * @return 0=成功, 非0=失败
+ * @return 0=已投递, 非0=失败
  */
 FLAC_API int SeekFlacStream(void* stream_handle, unsigned long long frame_index);
 
+/**
+ * 查询最近一次 seek 的状态
+ * 
+ * @param stream_handle 流句柄
+ * @return 0=已落地（或从未 seek）, 1=尚未落地, 2=执行失败（目标超出范围）, -1=错误
+ */
+FLAC_API int GetFlacSeekState(void* stream_handle);
+
+/**
+ * 获取当前读取位置（下一次 ReadFlacFrames 返回的第一帧）
+ * 
+ * seek 尚未落地时返回 seek 目标。
+ * 
+ * @param stream_handle 流句柄
+ * @return PCM 帧位置，-1表示错误
+ */
+FLAC_API long long GetFlacStreamPosition(void* stream_handle);
+
+/**
+ * 获取预解码环中已缓冲的帧数
+ * 
+ * @param stream_handle 流句柄
+ * @return 已缓冲帧数（未启用预解码时为 0），-1表示错误
+ */
+FLAC_API long long GetFlacStreamBufferedFrames(void* stream_handle);
+
+// ========== 边写边读 API ==========
+
+/**
+ * 打开仍在写入中的 FLAC 文件（如边下边播的缓存文件）
+ * 
+ * 流只读取 [0, written_bytes) 范围内的数据，并通过扫描帧头确定哪些帧已经完整写入，
+ * ReadFlacFrames 永远不会越过最后一个完整帧。元数据（含封面）尚未写完时返回 NULL，可稍后重试。
+ * 
+ * @param file_path FLAC 文件路径（UTF-8 编码）
+ * @param written_bytes 当前已写入的字节数
+ * @param options 打开选项，可为 NULL
+ * @param out_sample_rate 输出采样率
+ * @param out_channels 输出声道数
+ * @param out_total_pcm_frames 输出总帧数（来自 STREAMINFO）
+ * @return 流句柄，失败返回 NULL
+ */
+FLAC_API void* OpenFlacGrowingStream(const wchar_t* file_path, unsigned long long written_bytes, const FlacStreamOptions* options, int* out_sample_rate, int* out_channels, unsigned long long* out_total_pcm_frames);
+
+/**
+ * 通知流文件已写入更多数据
+ * 
+ * 可在写入线程上调用，与 ReadFlacFrames 并发安全。
+ * 
+ * @param stream_handle 流句柄（由 OpenFlacGrowingStream 返回）
+ * @param written_bytes 当前已写入的字节数
+ * @param is_complete 文件是否已经写完（1=是）
+ * @return 可安全解码的 PCM 帧数（即最后一个完整帧的结束位置），-1表示错误
+ */
+FLAC_API long long UpdateFlacGrowingStream(void* stream_handle, unsigned long long written_bytes, int is_complete);
+
+/**
+ * 获取可安全解码的 PCM 帧数
+ * 
+ * @param stream_handle 流句柄
+ * @return 边写边读流返回已完整写入的帧数，其他流返回总帧数，-1表示错误
+ */
+FLAC_API long long GetFlacDecodableFrames(void* stream_handle);
+
+// ========== 回调 / 推送 API ==========
+
+/**
+ * 读取回调：读取最多 bytes_to_read 字节到 buffer
+ * @return 实际读取的字节数，0表示末尾
+ */
+typedef size_t (*FlacReadCallback)(void* user_data, void* buffer, size_t bytes_to_read);
+
+/**
+ * 定位回调：origin 0=起始, 1=当前位置, 2=末尾
+ * @return 定位后的绝对位置，-1表示失败
+ */
+typedef long long (*FlacSeekCallback)(void* user_data, long long offset, int origin);
+
+/**
+ * 通过调用者提供的读取/定位回调打开 FLAC 流（内存、网络等任意数据源）
+ *
+ * 回调在解码方线程上调用（同步模式为 ReadFlacFrames 的调用线程，预解码模式为后台线程）。
+ * on_seek 可为 NULL，此时 SeekFlacStream 会失败。
+ *
+ * @param on_read 读取回调
+ * @param on_seek 定位回调，可为 NULL
+ * @param user_data 原样传给回调，需在 CloseFlacStream 之前保持有效
+ * @param options 打开选项，可为 NULL
+ * @param out_sample_rate 输出采样率
+ * @param out_channels 输出声道数
+ * @param out_total_pcm_frames 输出总帧数
+ * @return 流句柄，失败返回 NULL
+ */
+FLAC_API void* OpenFlacStreamCallbacks(FlacReadCallback on_read, FlacSeekCallback on_seek, void* user_data, const FlacStreamOptions* options, int* out_sample_rate, int* out_channels, unsigned long long* out_total_pcm_frames);
+
+/**
+ * 创建推送流：调用者通过 PushFlacStreamData 送入字节，无需临时文件
+ *
+ * 收到完整元数据前 ReadFlacFrames 返回 0、GetFlacStreamInfo 返回 1；
+ * 之后与边写边读流一样，只解码已完整送达的帧。
+ *
+ * @param options 打开选项，可为 NULL
+ * @return 流句柄
+ */
+FLAC_API void* CreateFlacPushStream(const FlacStreamOptions* options);
+
+/**
+ * 向推送流追加数据（只能由单个线程调用，与 ReadFlacFrames 并发安全）
+ *
+ * @param stream_handle 流句柄（由 CreateFlacPushStream 返回）
+ * @param data 数据
+ * @param size 字节数
+ * @return 0=成功, -1=失败（数据不是 FLAC、超出容量或流已结束）
+ */
+FLAC_API int PushFlacStreamData(void* stream_handle, const void* data, size_t size);
+
+/**
+ * 通知推送流数据已全部送达
+ *
+ * @param stream_handle 流句柄
+ * @return 0=成功, -1=失败（已送达的数据不是有效的 FLAC）
+ */
+FLAC_API int FinishFlacPushStream(void* stream_handle);
+
+/**
+ * 获取流的音频信息
+ *
+ * @param stream_handle 流句柄
+ * @param out_sample_rate 输出采样率
+ * @param out_channels 输出声道数
+ * @param out_total_pcm_frames 输出总帧数
+ * @return 0=成功, 1=推送流尚未收到完整元数据, -1=错误
+ */
+FLAC_API int GetFlacStreamInfo(void* stream_handle, int* out_sample_rate, int* out_channels, unsigned long long* out_total_pcm_frames);
+
+// ========== 注册输出缓冲区 ==========
+
+/**
+ * 为流注册固定的输出缓冲区（每个流注册一次，之后读取只传帧数和偏移）
+ *
+ * 需在读取线程上调用，或在开始读取之前调用。重新注册会替换（并释放 Native 分配的）旧缓冲区。
+ *
+ * @param stream_handle 流句柄（推送流需在解码器就绪后注册）
+ * @param buffer 调用者提供的内存（如固定的托管数组），需容纳 capacity_frames 帧（格式同 ReadFlacFrames，
+ *               平面格式下每个声道平面长 capacity_frames 帧）；NULL 表示由 Native 分配，随流一起释放
+ * @param capacity_frames 缓冲区容量（帧）
+ * @return 缓冲区地址，失败返回 NULL
+ */
+FLAC_API void* RegisterFlacOutputBuffer(void* stream_handle, void* buffer, unsigned long long capacity_frames);
+
+/**
+ * 读取 PCM 帧到注册的输出缓冲区，语义与 ReadFlacFrames 相同
+ *
+ * @param stream_handle 流句柄
+ * @param offset_frames 写入位置（帧）
+ * @param frames_to_read 要读取的帧数
+ * @return 实际读取的帧数，-1表示错误（未注册或超出缓冲区）
+ */
+FLAC_API long long ReadFlacFramesToOutput(void* stream_handle, unsigned long long offset_frames, unsigned long long frames_to_read);
+
+/**
+ * 用 PCM 帧填满注册的输出缓冲区中的一段，不足部分填充静音
+ *
+ * 对应音频回调的一整块：到达末尾、欠载或 seek 尚未落地时调用者无需再清零。
+ *
+ * @param stream_handle 流句柄
+ * @param offset_frames 写入位置（帧）
+ * @param frame_count 要填充的帧数
+ * @return 其中有效音频的帧数（其余为静音），-1表示错误
+ */
+FLAC_API long long FillFlacOutput(void* stream_handle, unsigned long long offset_frames, unsigned long long frame_count);
+
+// ========== 频谱分析 API ==========
+
+#define FLAC_ANALYSIS_MAX_BANDS 256
+#define FLAC_ANALYSIS_FLOOR_DB (-120.0f)
+
+// 频谱分析选项（EnableFlacAnalysis 使用，传 NULL 或字段为 0 时使用默认值）
+typedef struct {
+    int fft_size;          // FFT 点数（2 的幂，256~16384），0=2048
+    int band_count;        // 频带数（1~FLAC_ANALYSIS_MAX_BANDS），0=32
+    float min_frequency;   // 最低频带的下限（Hz），0=20
+    float max_frequency;   // 最高频带的上限（Hz），0=min(20000, 采样率 / 2)
+    int interval_ms;       // 分析间隔（毫秒，最大 1000），0=16
+    float smoothing;       // 相邻两次分析之间的指数平滑系数（0~1，不含 1），0=不平滑
+} FlacAnalysisOptions;
+
+/**
+ * 为预解码流开启频谱分析旁路
+ *
+ * 预解码线程把解码出的帧混为单声道复制到旁路环中，低优先级的分析线程按当前读取位置取最近 fft_size 帧，
+ * 加 Hann 窗做实数 FFT，再按对数频率聚合为频带。ReadFlacFrames 中不做任何额外工作。
+ * 每个流只能开启一次，随 CloseFlacStream 关闭。
+ *
+ * @param stream_handle 流句柄（需以 decode_ahead_ms > 0 打开）
+ * @param options 分析选项，NULL 使用默认值
+ * @return 0=成功，-1=参数无效，-2=不是预解码流（或推送流尚未收到元数据），-3=已经开启
+ */
+FLAC_API int EnableFlacAnalysis(void* stream_handle, const FlacAnalysisOptions* options);
+
+/**
+ * 获取最新的频带能量（无锁，只应在一个线程上调用，通常是主线程）
+ *
+ * @param stream_handle 流句柄
+ * @param out_bands 输出频带能量（dBFS，满幅正弦为 0，不低于 FLAC_ANALYSIS_FLOOR_DB），低频在前
+ * @param capacity 输出数组容量
+ * @param out_frame 输出该结果对应的读取位置（窗口末尾的输出帧），可为 NULL
+ * @return 写入的频带数，-1=参数无效或未开启分析
+ */
+FLAC_API int GetFlacAnalysisBands(void* stream_handle, float* out_bands, int capacity, unsigned long long* out_frame);
+
+// ========== 预加载 API ==========
+
+// 预加载条目的状态（GetFlacPreparedState 返回）
+typedef enum {
+    FLAC_PREPARE_NONE = 0,          // 不在预加载列表中（或已被取走）
+    FLAC_PREPARE_PENDING = 1,       // 等待打开或正在打开
+    FLAC_PREPARE_READY = 2,         // 已打开并预解码，可以取走
+    FLAC_PREPARE_FAILED = -1,       // 打开失败
+    FLAC_PREPARE_OVER_BUDGET = -2   // 超出内存预算，未保留（取走其他流或重新 Prepare 后重试）
+} FlacPrepareState;
+
+/**
+ * 创建预加载器
+ *
+ * 后台线程按列表顺序以给定选项打开本地文件：解析元数据并预解码开头的一段到环形缓冲区，
+ * 之后保持待命，TakeFlacPreparedStream 取走时不需要任何 I/O 或解码。
+ * 待命流的常驻内存（预解码环、解码器、读取缓冲）按列表顺序累计，超出预算的不保留。
+ *
+ * @param options 流打开选项（同 OpenFlacStreamEx），可为 NULL；decode_ahead_ms 为 0 时使用 300 毫秒
+ * @param memory_budget_bytes 待命流的内存预算，0 表示默认值（32MB）
+ * @return 预加载器句柄，选项无效时返回 NULL
+ */
+FLAC_API void* CreateFlacPreloader(const FlacStreamOptions* options, unsigned long long memory_budget_bytes);
+
+/**
+ * 设置需要预加载的文件（通常为播放队列中接下来的几首），按优先级从高到低排列
+ *
+ * 替换之前的列表：仍在列表中的条目保留已打开的流，不在列表中的被取消
+ * （等待中的直接移除，正在打开的在打开完成后关闭，已打开的交给后台线程关闭）。不阻塞调用线程。
+ *
+ * @param preloader 预加载器句柄
+ * @param file_paths 文件路径数组
+ * @param count 路径数量，0 表示取消全部
+ * @return 0=成功，-1=参数无效
+ */
+FLAC_API int PrepareFlacStreams(void* preloader, const wchar_t* const* file_paths, int count);
+
+/**
+ * 查询文件的预加载状态
+ *
+ * @return FlacPrepareState，参数无效时返回 FLAC_PREPARE_NONE
+ */
+FLAC_API int GetFlacPreparedState(void* preloader, const wchar_t* file_path);
+
+/**
+ * 取走已预加载的流，返回的句柄与 OpenFlacStreamEx 返回的相同，由调用者以 CloseFlacStream 关闭
+ *
+ * 条目正在打开时等待打开完成；尚未开始打开、打开失败或不在列表中时返回 NULL（调用者应自行打开）。
+ * 取走后条目从列表中移除，释放的预算用于重试之前超出预算的条目。
+ *
+ * @param preloader 预加载器句柄
+ * @param file_path 文件路径（与 PrepareFlacStreams 传入的完全相同）
+ * @param out_sample_rate 输出采样率
+ * @param out_channels 输出声道数
+ * @param out_total_pcm_frames 输出总帧数
+ * @return 流句柄，没有可用的预加载流时返回 NULL
+ */
+FLAC_API void* TakeFlacPreparedStream(void* preloader, const wchar_t* file_path, int* out_sample_rate, int* out_channels, unsigned long long* out_total_pcm_frames);
+
+/**
+ * 关闭预加载器：停止后台线程并关闭所有未取走的流（已取走的流不受影响）
+ *
+ * @param preloader 预加载器句柄
+ */
+FLAC_API void CloseFlacPreloader(void* preloader);
+
+// ========== 过渡引擎 API ==========
+
+// 曲目之间的衔接方式（SetFlacTransitionMode）
+typedef enum {
+    FLAC_TRANSITION_GAPLESS = 0,    // 无缝：上一首的最后一帧之后紧接下一首的第一帧（默认）
+    FLAC_TRANSITION_CROSSFADE = 1   // 交叉淡化：上一首结尾的 crossfade_ms 内与下一首开头重叠混合
+} FlacTransitionMode;
+
+// 交叉淡化曲线
+typedef enum {
+    FLAC_FADE_SINE = 0,     // 等功率：sin / cos（默认）
+    FLAC_FADE_SQRT = 1,     // 等功率：平方根，两侧的增益变化更集中在开头 / 结尾
+    FLAC_FADE_LINEAR = 2    // 等增益：线性，适合两首相关性高的曲目（同一专辑的连续录音）
+} FlacFadeCurve;
+
+// 排队方式（QueueFlacTransitionStream）
+typedef enum {
+    FLAC_TRANSITION_QUEUE_NEXT = 0, // 当前曲目结束后播放（替换之前排队的下一首）
+    FLAC_TRANSITION_QUEUE_NOW = 1   // 立即切换；交叉淡化模式下当前曲目在 crossfade_ms 内淡出
+} FlacTransitionQueue;
+
+// 引擎状态（FlacTransitionStatus.state）
+typedef enum {
+    FLAC_TRANSITION_IDLE = 0,       // 还没有曲目
+    FLAC_TRANSITION_PLAYING = 1,
+    FLAC_TRANSITION_FADING = 2,     // 正在交叉淡化（position 为淡入的曲目的位置）
+    FLAC_TRANSITION_ENDED = 3       // 当前曲目已播放完，没有排队的下一首（输出静音）
+} FlacTransitionState;
+
+// 编码器填充的裁剪量（输出采样率下的帧数）
+typedef struct {
+    unsigned long long leading_frames;   // 开头跳过的帧数（编码器延迟）
+    unsigned long long trailing_frames;  // 结尾丢弃的帧数（编码器填充）
+} FlacGaplessTrim;
+
+// GetFlacTransitionStatus 输出
+typedef struct {
+    unsigned int serial;                // 曲目序号：每次切换到新的曲目（排队的下一首接上或立即切换）加 1
+    int state;                          // FlacTransitionState
+    unsigned long long position;        // 当前曲目的播放位置（帧，从裁剪后的开头算起）
+    unsigned long long length;          // 当前曲目裁剪后的长度（帧，未知时为 0）
+    int next_queued;                    // 1=有排队的下一首
+} FlacTransitionStatus;
+
+/**
+ * 创建过渡引擎：持有正在播放和排队的流，混合为一路连续的交错 float32 PCM
+ *
+ * 音频线程只调用 ReadFlacTransition，其余函数在同一个控制线程（主线程）上调用。
+ * 读取不分配内存、不加锁：曲目切换、裁剪和交叉淡化都在读取中完成，混合使用 SIMD 内核；
+ * 被替换的流交给控制线程在下一次调用引擎函数时关闭。
+ *
+ * @param sample_rate 输出采样率，排队的流必须与之相同
+ * @param channels 输出声道数（1~8），排队的流必须与之相同
+ * @return 引擎句柄，参数无效时返回 NULL
+ */
+FLAC_API void* CreateFlacTransition(int sample_rate, int channels);
+
+/**
+ * 设置衔接方式（可在播放中修改，从下一次衔接开始生效）
+ *
+ * @param engine 引擎句柄
+ * @param mode FlacTransitionMode
+ * @param crossfade_ms 交叉淡化时长（毫秒，0~20000），无缝模式下只用于 FLAC_TRANSITION_QUEUE_NOW 的淡出（0 为直接切换）
+ * @param curve FlacFadeCurve
+ * @return 0=成功，-1=参数无效
+ */
+FLAC_API int SetFlacTransitionMode(void* engine, int mode, int crossfade_ms, int curve);
+
+/**
+ * 读取文件元数据中的编码器延迟与填充（iTunSMPB 注释），换算到输出采样率
+ *
+ * FLAC 本身是无损的，没有编码器填充；由有损源转码（或按 CD 音轨切分后带有 iTunSMPB）的文件才有记录。
+ * 没有记录时输出全 0 并返回成功。
+ *
+ * @param file_path 文件路径
+ * @param output_sample_rate 输出采样率，0=源采样率
+ * @param out_trim 输出裁剪量
+ * @return 0=成功, -1=参数无效, -2=无法打开文件, -3=不是有效的 FLAC 文件, -4=内存不足
+ */
+FLAC_API int GetFlacGaplessTrim(const wchar_t* file_path, int output_sample_rate, FlacGaplessTrim* out_trim);
+
+/**
+ * 把流交给引擎
+ *
+ * 成功后流归引擎所有（不再由调用者读取或关闭），失败时仍由调用者持有。
+ * 流必须以交错 float32 打开，输出采样率和声道数与引擎一致；开头的裁剪以读取丢弃的方式跳过，不清空预解码环。
+ *
+ * @param engine 引擎句柄
+ * @param stream_handle 流句柄（OpenFlacStream* / TakeFlacPreparedStream 返回）
+ * @param trim 裁剪量，可为 NULL
+ * @param queue FlacTransitionQueue
+ * @return 0=成功，-1=参数无效或流的格式与引擎不一致
+ */
+FLAC_API int QueueFlacTransitionStream(void* engine, void* stream_handle, const FlacGaplessTrim* trim, int queue);
+
+/**
+ * 读取混合后的 PCM（音频线程）
+ *
+ * 总是写满 frames 帧：没有曲目、欠载、seek 尚未落地或播放结束的部分为静音。
+ *
+ * @param engine 引擎句柄
+ * @param buffer 交错 float32 缓冲区，需容纳 frames 帧
+ * @param frames 帧数
+ * @return 写入的帧数，-1表示参数无效
+ */
+FLAC_API long long ReadFlacTransition(void* engine, float* buffer, unsigned long long frames);
+
+/**
+ * 定位当前曲目（从裁剪后的开头算起），同 SeekFlacStream 只投递请求、不等待
+ *
+ * 正在交叉淡化时只定位淡入的曲目，淡出的曲目继续播放到淡化结束。
+ *
+ * @param engine 引擎句柄
+ * @param frame_index 目标帧
+ * @return 0=已投递，-1=参数无效或没有当前曲目
+ */
+FLAC_API int SeekFlacTransition(void* engine, unsigned long long frame_index);
+
+/**
+ * 查询引擎状态（不等待音频线程）
+ *
+ * @param engine 引擎句柄
+ * @param out_status 输出状态
+ * @return 0=成功，-1=参数无效
+ */
+FLAC_API int GetFlacTransitionStatus(void* engine, FlacTransitionStatus* out_status);
+
+/**
+ * 关闭引擎及其持有的所有流（调用前需停止音频线程的读取）
+ *
+ * @param engine 引擎句柄
+ */
+FLAC_API void CloseFlacTransition(void* engine);
+
+// ========== Seek 索引 ==========
+
+/**
+ * 设置 seek 索引缓存目录
+ *
+ * 没有 SEEKTABLE 的文件在 OpenFlacStream / OpenFlacStreamEx 时会在后台扫描帧头生成密集索引，
+ * 之后的 seek 直接跳转到目标附近的帧。设置缓存目录后索引会以旁路文件持久化
+ * （按路径 + 文件大小 + 修改时间识别），再次打开同一文件时直接读取。波形概览的缓存也保存在该目录。
+ *
+ * @param dir_path 已存在的目录，NULL 表示不持久化（索引仍在内存中生成）
+ */
+FLAC_API void SetFlacSeekIndexCacheDir(const wchar_t* dir_path);
+
+// ========== I/O 后端 ==========
+
+// 本地文件的读取方式（流、整文件解码、波形概览和批量响度分析共用）
+typedef enum {
+    FLAC_IO_AUTO = 0,            // 内存映射（默认，异步后端通过 SetFlacIoBackend 开启）
+    FLAC_IO_MAPPED = 1,          // 内存映射，按读取位置提示预读
+    FLAC_IO_THREAD_POOL = 2,     // 异步队列，线程池执行定位读取
+    FLAC_IO_URING = 3            // 异步队列，io_uring 执行（不可用时退回线程池）
+} FlacIoBackend;
+
+/**
+ * 设置本地文件的 I/O 后端
+ *
+ * 异步后端在读取位置前方维持多块并发的预读窗口，读取完成即补发下一块，
+ * 所有流和后台任务的请求提交到同一个队列重叠执行。只影响之后打开的文件。
+ *
+ * @param backend FlacIoBackend
+ * @param latency_us 每个异步请求附加的人为延迟（微秒，用于测试慢速存储），0=关闭；内存映射不受影响
+ * @return 0=成功，-1=参数无效
+ */
+FLAC_API int SetFlacIoBackend(int backend, int latency_us);
+
+/**
+ * 获取新打开的文件实际使用的 I/O 后端
+ *
+ * @return FlacIoBackend（不会是 FLAC_IO_AUTO）
+ */
+FLAC_API int GetFlacIoBackend();
+
+// ========== 内存 ==========
+
+// 解码器内存统计（GetFlacMemoryStats 输出）
+typedef struct {
+    unsigned long long current_bytes;     // 使用中的字节数（按块计，含流的 arena）
+    unsigned long long peak_bytes;        // current_bytes 的峰值
+    unsigned long long cached_bytes;      // 池中保留待复用的空闲块字节数
+    unsigned long long allocations;       // 块池收到的分配请求数
+    unsigned long long heap_allocations;  // 其中向系统堆申请的次数（稳定状态下不再增长）
+    int live_arenas;                      // 存活的流 arena 数
+} FlacMemoryStats;
+
+/**
+ * 获取解码器内存统计
+ *
+ * drflac 实例（流、整文件解码、波形概览、批量响度分析）的内存来自按尺寸分级的块池，
+ * 释放的块留在池中（总量不超过 32MB）供下一次打开复用；每个流另有一个从池中取块的 bump arena。
+ *
+ * @param out_stats 输出统计
+ * @return 0=成功，-1=参数无效
+ */
+FLAC_API int GetFlacMemoryStats(FlacMemoryStats* out_stats);
+
+/**
+ * 把池中保留的空闲块交还系统堆（如长时间不播放时）
+ */
+FLAC_API void TrimFlacMemoryPool();
+
+// ========== 元数据探测 API ==========
+
+// PICTURE 元数据块信息（图片数据本身不读取，需要时按偏移读取文件）
+typedef struct {
+    int picture_type;               // 图片类型（与 ID3v2 APIC 相同，3=封面）
+    unsigned int width;             // 块中声明的宽高（可能为 0）
+    unsigned int height;
+    unsigned long long data_offset; // 图片数据在文件中的绝对偏移
+    unsigned int data_size;         // 图片数据字节数
+    char mime_type[64];             // MIME 类型（以 NUL 结尾，过长时截断）
+} FlacPictureInfo;
+
+// ProbeFlacFile 输出（调用者需要调用 FreeFlacProbeInfo 释放）
+typedef struct {
+    int sample_rate;
+    int channels;
+    int bits_per_sample;
+    unsigned long long total_pcm_frames;  // STREAMINFO 未记录时从文件末尾的帧头推算，仍无法确定时为 0
+    double duration_seconds;
+    unsigned char md5[16];          // 未编码音频的 MD5（全 0 表示编码器未计算）
+    char* tags;                     // Vorbis 注释：tag_count 个以 NUL 结尾的 "KEY=value"（UTF-8）依次排列，无注释时为 NULL
+    size_t tags_size;               // tags 的总字节数（含各个 NUL）
+    int tag_count;
+    FlacPictureInfo* pictures;      // 无图片时为 NULL
+    int picture_count;
+} FlacProbeInfo;
+
+/**
+ * 只读取元数据块获取文件信息，不打开解码器、不解码音频
+ *
+ * 读取 STREAMINFO、VORBIS_COMMENT 和 PICTURE 块头部，其余块（PADDING、SEEKTABLE 等）和图片数据直接跳过；
+ * 只有 STREAMINFO 未记录总帧数时才会读取文件末尾（最多 64KB 或两倍最大帧长）。
+ * 可在任意线程调用，多个线程可同时探测不同的文件。
+ *
+ * @param file_path FLAC 文件路径
+ * @param out_info 输出信息（调用者需要调用 FreeFlacProbeInfo 释放）
+ * @return 0=成功, -1=参数无效, -2=无法打开文件, -3=不是有效的 FLAC 文件, -4=内存不足
+ */
+FLAC_API int ProbeFlacFile(const wchar_t* file_path, FlacProbeInfo* out_info);
+
+/**
+ * 释放 ProbeFlacFile 输出的标签和图片信息
+ *
+ * @param info 要释放的信息
+ */
+FLAC_API void FreeFlacProbeInfo(FlacProbeInfo* info);
+
+// ProbeFlacFiles 结果中的一项。*_offset 均为相对结果缓冲区起始的字节偏移
+typedef struct {
+    int status;                     // 与 ProbeFlacFile 返回值相同，非 0 时其余字段为 0
+    int sample_rate;
+    int channels;
+    int bits_per_sample;
+    unsigned long long total_pcm_frames;
+    double duration_seconds;
+    unsigned char md5[16];
+    unsigned long long tags_offset; // tag_count 个以 NUL 结尾的 "KEY=value"（格式同 FlacProbeInfo::tags）
+    unsigned long long tags_size;
+    unsigned long long pictures_offset; // FlacPictureInfo[picture_count]
+    int tag_count;
+    int picture_count;
+} FlacProbeBatchEntry;
+
+/**
+ * 并行探测多个文件，结果打包在一块连续内存中
+ *
+ * 文件由 Native 线程池并发探测（I/O 密集，线程数可多于 CPU 核心数），
+ * 结果缓冲区布局：FlacProbeBatchEntry[count]（与 file_paths 顺序一致）、所有 FlacPictureInfo、标签字符串区。
+ * 缓冲区内只有偏移没有指针，调用方可以整块复制后再解析。
+ *
+ * @param file_paths 文件路径数组
+ * @param count 路径数
+ * @param thread_count 工作线程数（<= 0 时按 CPU 核心数自动选择）
+ * @param out_size 输出结果缓冲区的总字节数
+ * @return 结果缓冲区（调用者需要调用 FreeFlacProbeBatch 释放），参数无效或内存不足返回 NULL
+ */
+FLAC_API void* ProbeFlacFiles(const wchar_t* const* file_paths, int count, int thread_count, unsigned long long* out_size);
+
+/**
+ * 释放 ProbeFlacFiles 返回的结果缓冲区
+ *
+ * @param batch 结果缓冲区
+ */
+FLAC_API void FreeFlacProbeBatch(void* batch);
+
+// ========== 封面缩略图 API ==========
+
+// 缩略图选项（flags，可按位组合）
+typedef enum {
+    FLAC_COVER_SQUARE = 0,      // 方形
+    FLAC_COVER_CIRCULAR = 1     // 应用抗锯齿圆形遮罩（圆外透明）
+} FlacCoverFlags;
+
+/**
+ * 从文件生成封面缩略图（RGBA32，size×size）
+ *
+ * FLAC 文件读取内嵌 PICTURE 块（优先 3=封面，其次第一张非图标图片），其他文件按图片解码（JPEG / PNG / BMP / GIF）。
+ * 解码、缩放（缩小用面积平均，放大用 Lanczos3）和遮罩都在调用线程上完成，可在任意线程调用。
+ * 输出行序与 Unity 纹理一致（第 0 行为最下面一行），可直接用于 Texture2D.LoadRawTextureData。
+ *
+ * @param file_path FLAC 文件或图片文件路径
+ * @param size 输出边长（1~4096 像素）
+ * @param flags FlacCoverFlags
+ * @param out_rgba 输出缓冲区（size * size * 4 字节）
+ * @return 0=成功, -1=参数无效, -2=无法打开文件, -3=没有封面或图片格式不支持, -4=内存不足
+ */
+FLAC_API int LoadCoverThumbnail(const wchar_t* file_path, int size, int flags, unsigned char* out_rgba);
+
+/**
+ * 从内存中的图片数据（JPEG / PNG / BMP / GIF）生成封面缩略图，其余同 LoadCoverThumbnail
+ *
+ * @param data 图片数据
+ * @param data_size 图片数据字节数
+ * @param size 输出边长（1~4096 像素）
+ * @param flags FlacCoverFlags
+ * @param out_rgba 输出缓冲区（size * size * 4 字节）
+ * @return 0=成功, -1=参数无效, -3=图片格式不支持, -4=内存不足
+ */
+FLAC_API int CreateCoverThumbnail(const void* data, size_t data_size, int size, int flags, unsigned char* out_rgba);
+
+/**
+ * 缩放已解码的 RGBA32 图像（Unity 行序，如 Texture2D.GetPixels32 的结果），其余同 LoadCoverThumbnail
+ *
+ * @param rgba 源像素（width * height * 4 字节）
+ * @param width 源宽度
+ * @param height 源高度
+ * @param size 输出边长（1~4096 像素）
+ * @param flags FlacCoverFlags
+ * @param out_rgba 输出缓冲区（size * size * 4 字节）
+ * @return 0=成功, -1=参数无效, -4=内存不足
+ */
+FLAC_API int ResizeCoverImage(const unsigned char* rgba, int width, int height, int size, int flags, unsigned char* out_rgba);
+
+// ========== 封面占位图 API ==========
+
+#define FLAC_PLACEHOLDER_MAX_COLORS 4
+#define FLAC_PLACEHOLDER_HASH_CAPACITY 32
+
+// 封面占位图：封面加载完成前用于显示的紧凑摘要，可与曲库索引一起保存
+typedef struct {
+    unsigned int colors[FLAC_PLACEHOLDER_MAX_COLORS];   // 主色（0xRRGGBB），按占比从大到小
+    float weights[FLAC_PLACEHOLDER_MAX_COLORS];         // 各主色覆盖的像素比例
+    int color_count;                                    // 主色数量（图片完全透明时为 0）
+    char blurhash[FLAC_PLACEHOLDER_HASH_CAPACITY];      // 4×3 分量的 blurhash（28 个字符，以 NUL 结尾）
+} FlacCoverPlaceholder;
+
+/**
+ * 从文件计算封面占位图（来源与 LoadCoverThumbnail 相同：FLAC 内嵌封面或图片文件）
+ *
+ * 图片先缩小为 32×32（面积平均），再统计主色并计算 blurhash。可在任意线程调用。
+ *
+ * @param file_path FLAC 文件或图片文件路径
+ * @param out_placeholder 输出占位图
+ * @return 0=成功, -1=参数无效, -2=无法打开文件, -3=没有封面或图片格式不支持, -4=内存不足
+ */
+FLAC_API int LoadCoverPlaceholder(const wchar_t* file_path, FlacCoverPlaceholder* out_placeholder);
+
+/**
+ * 从内存中的图片数据计算封面占位图，其余同 LoadCoverPlaceholder
+ *
+ * @return 0=成功, -1=参数无效, -3=图片格式不支持, -4=内存不足
+ */
+FLAC_API int CreateCoverPlaceholder(const void* data, size_t data_size, FlacCoverPlaceholder* out_placeholder);
+
+/**
+ * 把 blurhash 解码为 size×size 的 RGBA32（Unity 行序，不透明），用于显示占位图
+ *
+ * @param blurhash blurhash 字符串
+ * @param size 输出边长（1~256 像素，通常 32 已足够，显示时由纹理过滤放大）
+ * @param out_rgba 输出缓冲区（size * size * 4 字节）
+ * @return 0=成功, -1=参数无效, -3=blurhash 无效
+ */
+FLAC_API int DecodeCoverPlaceholder(const char* blurhash, int size, unsigned char* out_rgba);
+
+// ========== 缩略图缓存 API ==========
+
+// 压缩缩略图格式（块按 Unity 行序排列，可直接用于 Texture2D.LoadRawTextureData）
+typedef enum {
+    FLAC_THUMBNAIL_BC1 = 1,     // DXT1：方形封面，每 4×4 块 8 字节
+    FLAC_THUMBNAIL_BC3 = 2      // DXT5：圆形封面（带 alpha），每 4×4 块 16 字节
+} FlacThumbnailFormat;
+
+/**
+ * 打开（或创建）压缩缩略图缓存文件
+ *
+ * 缓存为单个只追加的文件，按源图片内容去重（整张专辑共用的封面只保存一次），
+ * 另以源文件路径 + 大小 + 修改时间建立别名，未变化的文件命中时不读取图片数据。
+ * 同一个句柄可在多个线程上同时使用。
+ *
+ * @param cache_path 缓存文件路径（所在目录需已存在）
+ * @return 缓存句柄，失败返回 NULL
+ */
+FLAC_API void* OpenThumbnailCache(const wchar_t* cache_path);
+
+/**
+ * 获取 GPU 压缩格式的封面缩略图：命中缓存时直接拷贝块数据，否则按 LoadCoverThumbnail 生成、
+ * 压缩（方形 BC1，圆形 BC3）并追加到缓存。可在任意线程调用。
+ *
+ * @param cache_handle 缓存句柄（NULL 表示不使用缓存，每次都重新生成）
+ * @param file_path FLAC 文件或图片文件路径
+ * @param size 输出边长（4~4096 像素，必须是 4 的倍数）
+ * @param flags FlacCoverFlags
+ * @param out_blocks 输出缓冲区
+ * @param capacity 输出缓冲区字节数（BC1 需 size * size / 2，BC3 需 size * size）
+ * @param out_format 输出 FlacThumbnailFormat
+ * @return 写入的字节数；-1=参数无效, -2=无法打开文件, -3=没有封面或图片格式不支持, -4=内存不足, -5=缓冲区太小
+ */
+FLAC_API int GetCachedCoverThumbnail(void* cache_handle, const wchar_t* file_path, int size, int flags,
+                                     void* out_blocks, size_t capacity, int* out_format);
+
+/**
+ * 关闭缩略图缓存
+ *
+ * @param cache_handle 缓存句柄
+ */
+FLAC_API void CloseThumbnailCache(void* cache_handle);
+
+// ========== 封面加载调度 API ==========
+
+// 已完成的封面任务（被取消的任务不会出现）
+typedef struct {
+    long long job_id;
+    int status;                 // 写入的字节数；< 0 时同 GetCachedCoverThumbnail 的错误码
+    int format;                 // FlacThumbnailFormat
+    const void* data;           // 压缩块数据（status > 0 时有效），在下一次 PollCoverJobs 之前有效
+} FlacCoverJobResult;
+
+/**
+ * 创建封面加载调度器
+ *
+ * 固定数量的工作线程按优先级执行 GetCachedCoverThumbnail，结果进入完成队列，由 PollCoverJobs 取回。
+ * 用于列表滚动时只解码可见 / 即将可见的封面：调用方随可见范围变化批量调整优先级，取消滚出范围的任务。
+ *
+ * @param thumbnail_cache 缩略图缓存句柄（NULL 表示不使用缓存），生命周期需长于调度器
+ * @param threads 工作线程数，<= 0 时使用默认值（CPU 核心数的一半，1~4）
+ * @return 调度器句柄
+ */
+FLAC_API void* CreateCoverScheduler(void* thumbnail_cache, int threads);
+
+/**
+ * 提交封面缩略图任务（参数同 GetCachedCoverThumbnail）。可在任意线程调用
+ *
+ * @param priority 优先级，数值大的先执行；同优先级按提交顺序
+ * @return 任务 ID（> 0），失败返回 -1
+ */
+FLAC_API long long SubmitCoverJob(void* scheduler, const wchar_t* file_path, int size, int flags, int priority);
+
+/**
+ * 批量调整任务优先级，只影响尚未开始执行的任务
+ *
+ * @return 实际调整的任务数量，-1=参数无效
+ */
+FLAC_API int SetCoverJobPriorities(void* scheduler, const long long* job_ids, const int* priorities, int count);
+
+/**
+ * 批量取消任务：等待中的任务直接移除，执行中的任务在下一个开销大的步骤（读取图片、解码压缩）之前停止。
+ * 被取消的任务不会进入完成队列
+ *
+ * @return 找到的任务数量（已完成或未知的 ID 不计入），-1=参数无效
+ */
+FLAC_API int CancelCoverJobs(void* scheduler, const long long* job_ids, int count);
+
+/**
+ * 取出已完成的任务（按完成顺序）。结果中的 data 在下一次调用之前有效，本函数只应在一个线程上调用
+ *
+ * @param out_results 输出数组
+ * @param max_results 输出数组容量
+ * @return 取出的数量（0 表示暂无完成的任务），-1=参数无效
+ */
+FLAC_API int PollCoverJobs(void* scheduler, FlacCoverJobResult* out_results, int max_results);
+
+/**
+ * 销毁调度器：取消全部任务并等待工作线程退出
+ *
+ * @param scheduler 调度器句柄
+ */
+FLAC_API void DestroyCoverScheduler(void* scheduler);
+
+// ========== 波形概览 API ==========
+
+// 第 0 层以外，每层的一个峰值合并下一层的 4 个峰值
+#define FLAC_WAVEFORM_LEVEL_FACTOR 4
+
+// 一个峰值（所有声道合并统计，4 字节）
+typedef struct {
+    signed char min;            // 最小采样值 × 127，向下取整（-127 ~ 127）
+    signed char max;            // 最大采样值 × 127，向上取整（-127 ~ 127）
+    unsigned char rms;          // 均方根 × 255
+    unsigned char ready;        // 1=已生成，0=尚未生成（其余字段为 0）
+} FlacWaveformPeak;
+
+typedef enum {
+    FLAC_WAVEFORM_RUNNING = 0,
+    FLAC_WAVEFORM_COMPLETE = 1,
+    FLAC_WAVEFORM_FAILED = -1   // 解码中途无法读取文件，已生成的部分仍可读取
+} FlacWaveformState;
+
+typedef struct {
+    int sample_rate;
+    int channels;
+    unsigned long long total_pcm_frames;
+    int frames_per_peak;        // 第 0 层每个峰值覆盖的帧数（约 20 毫秒）
+    int level_count;            // 第 L 层每个峰值覆盖 frames_per_peak × 4^L 帧，最后一层只有 1 个峰值
+    int state;                  // FlacWaveformState
+    int from_cache;             // 1=从旁路文件读取，没有重新解码
+    float progress;             // 已生成的比例（0~1）
+} FlacWaveformInfo;
+
+/**
+ * 开始生成波形概览（用于进度条）
+ *
+ * 生成多分辨率的 min / max / RMS 峰值金字塔：文件按约 5 秒一段切分，多个线程各自打开解码器，
+ * 借助 seek 索引跳到段首并行解码。每段完成后其 0~4 层峰值立即可读，更粗的层在全部完成后生成。
+ * 设置了 seek 索引缓存目录（SetFlacSeekIndexCacheDir）时，结果以旁路文件缓存，再次打开同一文件直接读取。
+ *
+ * @param file_path FLAC 文件路径
+ * @param threads 解码线程数，<= 0 时使用 CPU 核心数
+ * @return 波形句柄（需以 CloseFlacWaveform 释放），失败返回 NULL
+ */
+FLAC_API void* StartFlacWaveform(const wchar_t* file_path, int threads);
+
+/**
+ * 获取波形概览的基本信息和生成进度（可在任意线程调用）
+ *
+ * @return 0=成功，-1=参数无效
+ */
+FLAC_API int GetFlacWaveformInfo(void* waveform, FlacWaveformInfo* out_info);
+
+/**
+ * 读取某一层的峰值，尚未生成的峰值 ready 为 0（可在生成过程中调用）
+ *
+ * @param level 层级（0 最精细）
+ * @param start 起始峰值序号
+ * @param count 读取数量
+ * @param out_peaks 输出数组（至少 count 个）
+ * @return 写入的峰值数量（超出该层末尾的部分不写入），-1=参数无效
+ */
+FLAC_API int GetFlacWaveformPeaks(void* waveform, int level, unsigned long long start, int count, FlacWaveformPeak* out_peaks);
+
+/**
+ * 关闭波形概览：停止尚未完成的生成并等待工作线程退出
+ *
+ * @param waveform 波形句柄
+ */
+FLAC_API void CloseFlacWaveform(void* waveform);
+
+// ========== 响度分析 API ==========
+
+// ReplayGain 2.0 参考响度（LUFS）：曲目增益 = 参考响度 - 综合响度
+#define FLAC_LOUDNESS_REFERENCE_LUFS (-18.0)
+
+// StartFlacLoudnessBatch 的 flags
+#define FLAC_LOUDNESS_IGNORE_TAGS 1     // 忽略 REPLAYGAIN 标签，总是解码测量
+
+typedef enum {
+    FLAC_LOUDNESS_PENDING = 0,          // 尚未完成
+    FLAC_LOUDNESS_MEASURED = 1,         // 解码测量（BS.1770）
+    FLAC_LOUDNESS_TAGGED = 2            // 来自 REPLAYGAIN_* 标签
+} FlacLoudnessSource;
+
+typedef struct {
+    int status;                 // 0=成功，-2=无法打开文件，-3=不是有效的 FLAC 文件，-5=解码失败，-6=已取消
+    int source;                 // FlacLoudnessSource
+    int from_cache;             // 1=测量结果读取自旁路缓存
+    int has_album_gain;         // 1=album_gain_db / album_peak 有效（只来自标签）
+    double integrated_lufs;     // 综合响度（LUFS，不低于 -70）；来自标签时由曲目增益反推
+    double loudness_range_lu;   // 响度范围（LU），来自标签时为 0
+    double true_peak;           // 真峰值（线性，1.0=0 dBTP），来自标签时为 REPLAYGAIN_TRACK_PEAK（没有时为 0）
+    double track_gain_db;       // 曲目增益（dB），可直接用于 SetFlacStreamGain
+    double album_gain_db;
+    double album_peak;
+} FlacLoudnessInfo;
+
+/**
+ * 开始批量响度分析（EBU R128 / ReplayGain 2.0）
+ *
+ * 后台线程在多个核心上并行处理：有 REPLAYGAIN_TRACK_GAIN 标签的文件只读取元数据，
+ * 其余文件解码后按 BS.1770 测量综合响度、响度范围和 4 倍过采样真峰值。
+ * 设置了 seek 索引缓存目录（SetFlacSeekIndexCacheDir）时，测量结果以旁路文件缓存，文件未变化时不再解码。
+ *
+ * @param file_paths 文件路径数组（函数返回后即可释放）
+ * @param count 路径数
+ * @param threads 工作线程数，<= 0 时使用 CPU 核心数
+ * @param flags FLAC_LOUDNESS_* 标志
+ * @return 批次句柄（需以 CloseFlacLoudnessBatch 释放），参数无效返回 NULL
+ */
+FLAC_API void* StartFlacLoudnessBatch(const wchar_t* const* file_paths, int count, int threads, int flags);
+
+/**
+ * 已完成（含失败）的文件数，可在任意线程调用
+ *
+ * @return 完成数，-1=参数无效
+ */
+FLAC_API int GetFlacLoudnessProgress(void* batch);
+
+/**
+ * 拷贝结果，尚未完成的项 source 为 FLAC_LOUDNESS_PENDING（可在分析过程中调用）
+ *
+ * @param start 起始序号（与 file_paths 顺序一致）
+ * @param count 拷贝数量
+ * @param out_results 输出数组（至少 count 个）
+ * @return 写入数量（超出末尾的部分不写入），-1=参数无效
+ */
+FLAC_API int GetFlacLoudnessResults(void* batch, int start, int count, FlacLoudnessInfo* out_results);
+
+/**
+ * 关闭批次：取消尚未开始的文件，等待正在处理的文件停止
+ *
+ * @param batch 批次句柄
+ */
+FLAC_API void CloseFlacLoudnessBatch(void* batch);
+
+/**
+ * 设置流的输出增益（可在任意线程调用）
+ *
+ * 增益在解码方写入存储格式之前施加（SIMD 乘法，s16 输出先以 f32 处理），limiter 为 1 时对超过 -1 dBFS 的采样软限幅。
+ * 预解码模式下已经缓冲的数据保持原增益，新的增益从之后解码的数据开始生效。
+ *
+ * @param stream_handle 流句柄
+ * @param gain_db 增益（dB，-60~24）
+ * @param limiter 1=启用软限幅
+ * @return 0=成功，-1=参数无效
+ */
+FLAC_API int SetFlacStreamGain(void* stream_handle, float gain_db, int limiter);
+
 /**
  * 关闭 FLAC 流
  * 
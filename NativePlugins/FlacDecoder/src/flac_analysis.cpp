@@ -0,0 +1,285 @@
+#include "flac_internal.h"
+#include "flac_analysis.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#endif
+
+// 选项的默认值与允许范围
+static const int DEFAULT_FFT_SIZE = 2048;
+static const int MIN_FFT_SIZE = 256;
+static const int MAX_FFT_SIZE = 16384;
+static const int DEFAULT_BAND_COUNT = 32;
+static const float DEFAULT_MIN_FREQUENCY = 20.0f;
+static const float DEFAULT_MAX_FREQUENCY = 20000.0f;
+static const int DEFAULT_INTERVAL_MS = 16;
+static const int MAX_INTERVAL_MS = 1000;
+
+// 三缓冲 state_ 中表示 middle 有新结果的标记位（低 2 位为 middle 的下标）
+static const uint8_t RESULT_FRESH = 4;
+
+static const double PI = 3.14159265358979323846;
+
+FlacAnalyzer::~FlacAnalyzer() {
+    if (!worker_.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        stop_ = true;
+    }
+    wake_cv_.notify_all();
+    worker_.join();
+}
+
+bool FlacAnalyzer::Init(const FlacAnalysisOptions* options, int sample_rate, int channels, int sample_format, uint64_t ahead_frames) {
+    FlacAnalysisOptions o = {};
+    if (options) o = *options;
+
+    int fft_size = o.fft_size > 0 ? o.fft_size : DEFAULT_FFT_SIZE;
+    int band_count = o.band_count > 0 ? o.band_count : DEFAULT_BAND_COUNT;
+    float nyquist = static_cast<float>(sample_rate) / 2.0f;
+    float min_frequency = o.min_frequency > 0.0f ? o.min_frequency : DEFAULT_MIN_FREQUENCY;
+    float max_frequency = o.max_frequency > 0.0f ? o.max_frequency : std::min(DEFAULT_MAX_FREQUENCY, nyquist);
+    int interval_ms = o.interval_ms > 0 ? o.interval_ms : DEFAULT_INTERVAL_MS;
+
+    if (fft_size < MIN_FFT_SIZE || fft_size > MAX_FFT_SIZE || (fft_size & (fft_size - 1)) != 0 ||
+        band_count > FLAC_ANALYSIS_MAX_BANDS || min_frequency >= max_frequency || max_frequency > nyquist ||
+        interval_ms > MAX_INTERVAL_MS || o.smoothing < 0.0f || o.smoothing >= 1.0f) {
+        return false;
+    }
+
+    sample_rate_ = sample_rate;
+    channels_ = channels;
+    sample_format_ = sample_format;
+    band_count_ = band_count;
+    interval_ms_ = interval_ms;
+    smoothing_ = o.smoothing;
+
+    // 历史环容纳解码方的最大领先量加两个窗口，容量为 2 的幂
+    uint64_t capacity = 1;
+    while (capacity < ahead_frames + 2 * static_cast<uint64_t>(fft_size)) capacity <<= 1;
+    history_.reset(new std::atomic<float>[capacity]);
+    history_mask_ = capacity - 1;
+
+    size_t size = static_cast<size_t>(fft_size);
+    fft_.Init(size);
+    window_.resize(size);
+    double window_energy = 0.0;
+    for (size_t i = 0; i < size; i++) {
+        double w = 0.5 - 0.5 * std::cos(2.0 * PI * static_cast<double>(i) / static_cast<double>(size));
+        window_[i] = static_cast<float>(w);
+        window_energy += w * w;
+    }
+    // 满幅正弦加窗后单边功率谱之和约为 N·Σw² / 4
+    power_scale_ = static_cast<float>(4.0 / (static_cast<double>(size) * window_energy));
+    samples_.resize(size);
+    power_.resize(size / 2 + 1);
+
+    // 对数间隔的频带边界（FFT 频点），每个频带至少包含一个频点；低频端相邻频带可能落在同一频点
+    uint32_t last_bin = static_cast<uint32_t>(size / 2);
+    band_edges_.resize(band_count + 1);
+    for (int b = 0; b <= band_count; b++) {
+        double frequency = min_frequency * std::pow(static_cast<double>(max_frequency) / min_frequency, static_cast<double>(b) / band_count);
+        double bin = frequency * static_cast<double>(size) / sample_rate;
+        band_edges_[b] = std::max<uint32_t>(1, std::min(last_bin, static_cast<uint32_t>(bin + 0.5)));
+    }
+
+    smoothed_.assign(band_count, FLAC_ANALYSIS_FLOOR_DB);
+    for (Result& result : results_) {
+        result.bands.assign(band_count, FLAC_ANALYSIS_FLOOR_DB);
+    }
+    return true;
+}
+
+void FlacAnalyzer::Start(const std::atomic<uint64_t>* read_position) {
+    read_position_ = read_position;
+    worker_ = std::thread(&FlacAnalyzer::Run, this);
+}
+
+// ========== 解码方 ==========
+
+void FlacAnalyzer::Write(uint64_t frame, const void* data, uint64_t frames) {
+    if (frames == 0) return;
+
+    uint64_t end = end_.load(std::memory_order_relaxed);
+    if (frame != next_frame_ || end == 0) {
+        // 新的连续段（首次写入或 seek 之后）：更新帧号与环位置的对应关系
+        uint32_t seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        base_frame_.store(frame, std::memory_order_relaxed);
+        base_position_.store(end, std::memory_order_relaxed);
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    // 先发布将要覆盖到的位置，分析线程据此判断拷贝的窗口是否被覆盖
+    limit_.store(end + frames, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    float scale = 1.0f / static_cast<float>(channels_);
+    if (sample_format_ == FLAC_SAMPLE_S16) {
+        const int16_t* in = static_cast<const int16_t*>(data);
+        scale /= 32768.0f;
+        for (uint64_t i = 0; i < frames; i++) {
+            int32_t sum = 0;
+            for (int c = 0; c < channels_; c++) sum += in[i * channels_ + c];
+            history_[(end + i) & history_mask_].store(static_cast<float>(sum) * scale, std::memory_order_relaxed);
+        }
+    } else {
+        // f32 与平面 f32 在预解码环中都以交错 f32 存储
+        const float* in = static_cast<const float*>(data);
+        for (uint64_t i = 0; i < frames; i++) {
+            float sum = 0.0f;
+            for (int c = 0; c < channels_; c++) sum += in[i * channels_ + c];
+            history_[(end + i) & history_mask_].store(sum * scale, std::memory_order_relaxed);
+        }
+    }
+
+    end_.store(end + frames, std::memory_order_release);
+    next_frame_ = frame + frames;
+}
+
+// ========== 分析线程 ==========
+
+bool FlacAnalyzer::CopyWindow(uint64_t end_frame, float* out) {
+    uint32_t seq = seq_.load(std::memory_order_acquire);
+    if (seq & 1) return false;
+    uint64_t base_frame = base_frame_.load(std::memory_order_relaxed);
+    uint64_t base_position = base_position_.load(std::memory_order_relaxed);
+    uint64_t end = end_.load(std::memory_order_acquire);
+
+    // 读取方的位置应落在当前连续段已写入的范围内（seek 刚落地时可能还没有新数据）
+    if (end_frame <= base_frame || end_frame - base_frame > end - base_position) return false;
+
+    // 窗口中早于当前连续段起点的部分补 0
+    uint64_t size = fft_.Size();
+    uint64_t stop = base_position + (end_frame - base_frame);
+    uint64_t available = std::min(size, stop - base_position);
+    uint64_t zeros = size - available;
+    std::fill(out, out + zeros, 0.0f);
+    uint64_t first = stop - available;
+    for (uint64_t i = 0; i < available; i++) {
+        out[zeros + i] = history_[(first + i) & history_mask_].load(std::memory_order_relaxed);
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (seq_.load(std::memory_order_relaxed) != seq) return false;
+    return limit_.load(std::memory_order_relaxed) - first <= history_mask_ + 1;
+}
+
+void FlacAnalyzer::Analyze(uint64_t end_frame) {
+    if (!CopyWindow(end_frame, samples_.data())) return;
+    analyzed_frame_ = end_frame;
+
+    size_t size = fft_.Size();
+    for (size_t i = 0; i < size; i++) samples_[i] *= window_[i];
+    fft_.Power(samples_.data(), power_.data());
+
+    Result& result = results_[back_];
+    for (int b = 0; b < band_count_; b++) {
+        uint32_t lo = band_edges_[b];
+        uint32_t hi = std::max(band_edges_[b + 1], lo + 1);
+        float power = 0.0f;
+        for (uint32_t k = lo; k < hi; k++) power += power_[k];
+
+        float db = 10.0f * std::log10(std::max(power * power_scale_, 1e-12f));
+        db = std::max(FLAC_ANALYSIS_FLOOR_DB, db);
+        smoothed_[b] = smoothing_ * smoothed_[b] + (1.0f - smoothing_) * db;
+        result.bands[b] = smoothed_[b];
+    }
+    result.frame = end_frame;
+
+    back_ = state_.exchange(static_cast<uint8_t>(back_ | RESULT_FRESH), std::memory_order_acq_rel) & 3;
+}
+
+void FlacAnalyzer::Run() {
+#ifdef _WIN32
+    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_LOWEST);
+#endif
+
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+    while (!stop_) {
+        lock.unlock();
+        // 读取位置没有变化（暂停）时不重复计算
+        uint64_t position = read_position_->load(std::memory_order_relaxed);
+        if (position != analyzed_frame_) Analyze(position);
+        lock.lock();
+
+        wake_cv_.wait_for(lock, std::chrono::milliseconds(interval_ms_), [this] { return stop_; });
+    }
+}
+
+// ========== 读取方 ==========
+
+int FlacAnalyzer::Snapshot(float* out_bands, int capacity, uint64_t* out_frame) {
+    if (state_.load(std::memory_order_relaxed) & RESULT_FRESH) {
+        front_ = state_.exchange(front_, std::memory_order_acq_rel) & 3;
+    }
+
+    const Result& result = results_[front_];
+    int count = std::min(capacity, band_count_);
+    std::copy(result.bands.begin(), result.bands.begin() + count, out_bands);
+    if (out_frame) *out_frame = result.frame;
+    return count;
+}
+
+// ========== 导出函数 ==========
+
+extern "C" {
+
+FLAC_API int EnableFlacAnalysis(void* stream_handle, const FlacAnalysisOptions* options) {
+    if (!stream_handle) {
+        FlacSetLastError("Stream handle is NULL");
+        return -1;
+    }
+
+    FlacStream* stream = static_cast<FlacStream*>(stream_handle);
+    if (!stream->decoder_ready.load(std::memory_order_acquire) || !stream->ring) {
+        FlacSetLastError("Analysis requires a decode-ahead stream");
+        return -2;
+    }
+    if (stream->analyzer) {
+        FlacSetLastError("Analysis is already enabled");
+        return -3;
+    }
+
+    std::unique_ptr<FlacAnalyzer> analyzer(new FlacAnalyzer());
+    if (!analyzer->Init(options, stream->sample_rate, stream->channels, stream->options.sample_format, stream->ring->Capacity())) {
+        FlacSetLastError("Invalid analysis options");
+        return -1;
+    }
+    analyzer->Start(&stream->read_position);
+
+    stream->analysis_tap.store(analyzer.get(), std::memory_order_release);
+    stream->analyzer = std::move(analyzer);
+    return 0;
+}
+
+FLAC_API int GetFlacAnalysisBands(void* stream_handle, float* out_bands, int capacity, unsigned long long* out_frame) {
+    if (!stream_handle || !out_bands || capacity <= 0) {
+        FlacSetLastError("Invalid arguments");
+        return -1;
+    }
+
+    FlacStream* stream = static_cast<FlacStream*>(stream_handle);
+    if (!stream->analyzer) {
+        FlacSetLastError("Analysis is not enabled");
+        return -1;
+    }
+
+    uint64_t frame = 0;
+    int count = stream->analyzer->Snapshot(out_bands, capacity, &frame);
+    if (out_frame) *out_frame = frame;
+    return count;
+}
+
+} // extern "C"
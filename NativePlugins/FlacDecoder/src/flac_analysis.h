@@ -0,0 +1,97 @@
+#ifndef CHILL_FLAC_ANALYSIS_H
+#define CHILL_FLAC_ANALYSIS_H
+
+// 频谱分析旁路：解码方（预解码工作线程）把解码出的帧混为单声道写入旁路历史环，
+// 低优先级的分析线程按读取方的播放位置取最近 fft_size 帧，加窗做实数 FFT 后按对数频率聚合为频带，
+// 结果经三缓冲发布，读取方无锁取最新一份。音频线程（ReadFlacFrames）不参与任何一步。
+//
+// 历史环只由解码方写入、从不阻塞：写入前先发布将要覆盖到的位置（limit），写完再发布已写入的末尾（end）；
+// 分析线程拷贝窗口后重新读取 limit，窗口起点已被覆盖时丢弃这一次结果。
+// seek 后解码位置不连续，解码方在 seq 保护下重新设置帧号与环位置的对应关系。
+
+#include "flac_decoder.h"
+#include "flac_fft.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class FlacAnalyzer {
+public:
+    FlacAnalyzer() {}
+    ~FlacAnalyzer();
+
+    FlacAnalyzer(const FlacAnalyzer&) = delete;
+    FlacAnalyzer& operator=(const FlacAnalyzer&) = delete;
+
+    // options 中为 0 的字段使用默认值；ahead_frames 为解码方最多领先读取方的帧数（预解码环容量）
+    bool Init(const FlacAnalysisOptions* options, int sample_rate, int channels, int sample_format, uint64_t ahead_frames);
+
+    // 启动分析线程，read_position 为读取方的播放位置（输出帧），需在分析器销毁前一直有效
+    void Start(const std::atomic<uint64_t>* read_position);
+
+    // 解码方：frame 起的 frames 帧（存储格式、交错）写入历史环
+    void Write(uint64_t frame, const void* data, uint64_t frames);
+
+    // 读取方：拷贝最新的频带（dBFS），返回频带数。只应在一个线程上调用
+    int Snapshot(float* out_bands, int capacity, uint64_t* out_frame);
+
+private:
+    struct Result {
+        std::vector<float> bands;
+        uint64_t frame = 0;
+    };
+
+    void Run();
+
+    // 从历史环拷贝以 end_frame 结尾的窗口，窗口起点已被覆盖或 end_frame 不在当前数据范围内时返回 false
+    bool CopyWindow(uint64_t end_frame, float* out);
+
+    void Analyze(uint64_t end_frame);
+
+    // ========== 配置（Init 之后只读） ==========
+    int sample_rate_ = 0;
+    int channels_ = 0;
+    int sample_format_ = 0;
+    int band_count_ = 0;
+    int interval_ms_ = 0;
+    float smoothing_ = 0.0f;
+
+    // ========== 历史环（解码方写，分析线程读） ==========
+    std::unique_ptr<std::atomic<float>[]> history_;
+    uint64_t history_mask_ = 0;
+    std::atomic<uint32_t> seq_{0};              // 奇数表示正在改变帧号对应关系
+    std::atomic<uint64_t> base_frame_{0};       // 当前连续段起点的帧号
+    std::atomic<uint64_t> base_position_{0};    // 当前连续段起点在环中的位置
+    std::atomic<uint64_t> limit_{0};            // 即将写到的环位置（写入前发布）
+    std::atomic<uint64_t> end_{0};              // 已写入的环位置（写入后发布）
+    uint64_t next_frame_ = 0;                   // 只由解码方访问：下一次连续写入的帧号
+
+    // ========== 分析（只由分析线程访问） ==========
+    FlacRealFft fft_;
+    std::vector<float> window_;                 // Hann 窗
+    std::vector<float> samples_;
+    std::vector<float> power_;
+    std::vector<uint32_t> band_edges_;          // band_count_ + 1 个 FFT 频点边界
+    std::vector<float> smoothed_;
+    float power_scale_ = 0.0f;                  // 满幅正弦 → 0 dBFS
+    uint64_t analyzed_frame_ = UINT64_MAX;
+
+    // ========== 三缓冲：分析线程写 back_，读取方读 front_，middle 与 fresh 标记在 state_ 中交换 ==========
+    Result results_[3];
+    std::atomic<uint8_t> state_{1};
+    uint8_t back_ = 2;
+    uint8_t front_ = 0;
+
+    const std::atomic<uint64_t>* read_position_ = nullptr;
+    std::thread worker_;
+    std::mutex wake_mutex_;
+    std::condition_variable wake_cv_;
+    bool stop_ = false;
+};
+
+#endif // CHILL_FLAC_ANALYSIS_H
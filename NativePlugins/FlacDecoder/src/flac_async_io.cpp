@@ -0,0 +1,565 @@
+#include "flac_async_io.h"
+#include "flac_internal.h"
+#include "flac_parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <thread>
+
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define FLAC_HAS_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+#endif
+
+// io_uring 提交队列长度；同时在途的请求不超过它，完成队列（内核默认为两倍）不会溢出
+static const unsigned URING_ENTRIES = 64;
+
+static std::atomic<int> g_io_backend{FLAC_IO_AUTO};
+static std::atomic<int> g_io_latency_us{0};
+
+static std::chrono::steady_clock::time_point Deadline() {
+    return std::chrono::steady_clock::now() +
+           std::chrono::microseconds(g_io_latency_us.load(std::memory_order_relaxed));
+}
+
+// ========== 线程池后端 ==========
+
+class ThreadPoolIoQueue : public FlacIoQueue {
+public:
+    ThreadPoolIoQueue() {
+        int threads = FlacDefaultIoThreads();
+        for (int i = 0; i < threads; i++) {
+            workers_.emplace_back(&ThreadPoolIoQueue::Worker, this);
+        }
+    }
+
+    ~ThreadPoolIoQueue() override {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        for (std::thread& worker : workers_) worker.join();
+    }
+
+    void Submit(FlacIoRequest* request) override {
+        request->deadline = Deadline();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            pending_.push_back(request);
+        }
+        cv_.notify_one();
+    }
+
+    int Backend() const override { return FLAC_IO_THREAD_POOL; }
+
+private:
+    // 每个线程各自等待自己请求的完成时刻，人为延迟在线程之间重叠
+    void Worker() {
+        for (;;) {
+            FlacIoRequest* request;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this] { return stop_ || !pending_.empty(); });
+                if (pending_.empty()) return;
+                request = pending_.front();
+                pending_.pop_front();
+            }
+            std::this_thread::sleep_until(request->deadline);
+            int64_t result = FlacReadAt(request->file, request->offset, request->buffer, request->bytes);
+            request->on_complete(request, result);
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::deque<FlacIoRequest*> pending_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stop_ = false;
+};
+
+// ========== io_uring 后端 ==========
+
+#ifdef FLAC_HAS_IO_URING
+
+// 直接使用系统调用，不依赖 liburing
+class UringIoQueue : public FlacIoQueue {
+public:
+    UringIoQueue() {}
+
+    ~UringIoQueue() override {
+        if (reaper_.joinable()) {
+            // 用户数据为 0 的空操作通知收割线程退出（此时已没有在途的读取）；
+            // 出错后收割线程改为轮询，看到 stop_ 即退出
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_.store(true, std::memory_order_relaxed);
+            io_uring_sqe* sqe = NextSqe();
+            sqe->opcode = IORING_OP_NOP;
+            sqe->user_data = 0;
+            Publish();
+            Enter(1);
+        }
+        if (reaper_.joinable()) reaper_.join();
+        fallback_.reset();
+
+        if (sqes_) munmap(sqes_, sqes_bytes_);
+        if (cq_ring_ && cq_ring_ != sq_ring_) munmap(cq_ring_, cq_ring_bytes_);
+        if (sq_ring_) munmap(sq_ring_, sq_ring_bytes_);
+        if (ring_fd_ >= 0) close(ring_fd_);
+    }
+
+    // 建立环形队列并启动收割线程，内核不支持（或被 seccomp 禁止）时返回 false
+    bool Init() {
+        io_uring_params params;
+        memset(&params, 0, sizeof(params));
+        int fd = static_cast<int>(syscall(__NR_io_uring_setup, URING_ENTRIES, &params));
+        if (fd < 0) return false;
+        ring_fd_ = fd;
+
+        sq_ring_bytes_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cq_ring_bytes_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single_mmap) sq_ring_bytes_ = cq_ring_bytes_ = std::max(sq_ring_bytes_, cq_ring_bytes_);
+
+        void* sq = mmap(nullptr, sq_ring_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+        if (sq == MAP_FAILED) return false;
+        sq_ring_ = sq;
+        if (single_mmap) {
+            cq_ring_ = sq;
+        } else {
+            void* cq = mmap(nullptr, cq_ring_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+            if (cq == MAP_FAILED) return false;
+            cq_ring_ = cq;
+        }
+        sqes_bytes_ = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqes = mmap(nullptr, sqes_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+        if (sqes == MAP_FAILED) return false;
+        sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+        uint8_t* sq_base = static_cast<uint8_t*>(sq_ring_);
+        sq_head_ = reinterpret_cast<unsigned*>(sq_base + params.sq_off.head);
+        sq_tail_ = reinterpret_cast<unsigned*>(sq_base + params.sq_off.tail);
+        sq_mask_ = *reinterpret_cast<unsigned*>(sq_base + params.sq_off.ring_mask);
+        sq_array_ = reinterpret_cast<unsigned*>(sq_base + params.sq_off.array);
+        uint8_t* cq_base = static_cast<uint8_t*>(cq_ring_);
+        cq_head_ = reinterpret_cast<unsigned*>(cq_base + params.cq_off.head);
+        cq_tail_ = reinterpret_cast<unsigned*>(cq_base + params.cq_off.tail);
+        cq_mask_ = *reinterpret_cast<unsigned*>(cq_base + params.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe*>(cq_base + params.cq_off.cqes);
+        capacity_ = params.sq_entries;
+
+        reaper_ = std::thread(&UringIoQueue::Reap, this);
+        return true;
+    }
+
+    void Submit(FlacIoRequest* request) override {
+        request->deadline = Deadline();
+        request->iov.iov_base = request->buffer;
+        request->iov.iov_len = request->bytes;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (failed_.load(std::memory_order_relaxed)) {
+            fallback_->Submit(request);
+            return;
+        }
+        // 在途数量达到上限时排队，由收割线程在有完成后补交（提交方可能持有字节源的锁，不能在这里等待）
+        if (in_flight_ >= capacity_) {
+            backlog_.push_back(request);
+            return;
+        }
+        Push(request);
+        Enter(1);
+    }
+
+    int Backend() const override { return FLAC_IO_URING; }
+    bool Failed() const override { return failed_.load(std::memory_order_relaxed); }
+
+private:
+    // 以下在持有 mutex_ 时调用（提交队列只有这一个生产者）
+    io_uring_sqe* NextSqe() {
+        unsigned index = *sq_tail_ & sq_mask_;
+        io_uring_sqe* sqe = &sqes_[index];
+        memset(sqe, 0, sizeof(*sqe));
+        sq_array_[index] = index;
+        return sqe;
+    }
+
+    // 条目填写完成后再移动尾指针，内容先于尾指针对内核可见
+    void Publish() {
+        __atomic_store_n(sq_tail_, *sq_tail_ + 1, __ATOMIC_RELEASE);
+    }
+
+    void Push(FlacIoRequest* request) {
+        io_uring_sqe* sqe = NextSqe();
+        sqe->opcode = IORING_OP_READV;
+        sqe->fd = request->file;
+        sqe->off = request->offset;
+        sqe->addr = reinterpret_cast<uint64_t>(&request->iov);
+        sqe->len = 1;
+        sqe->user_data = reinterpret_cast<uint64_t>(request);
+        Publish();
+        in_flight_++;
+    }
+
+    static bool Transient(int error) {
+        return error == EINTR || error == EAGAIN || error == EBUSY;
+    }
+
+    // 提交已放入队列的条目；内核暂时无法接收时重试（条目留在队列中，不会丢失），其他错误时转入失败状态
+    void Enter(unsigned count) {
+        while (count > 0) {
+            long submitted = syscall(__NR_io_uring_enter, ring_fd_, count, 0, 0, nullptr, 0);
+            if (submitted > 0) {
+                count -= static_cast<unsigned>(submitted);
+            } else if (submitted < 0 && !Transient(errno)) {
+                Fail();
+                return;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    // 环形队列出现不可恢复的错误：内核尚未取走的条目收回（不使用 SQPOLL，内核只在 io_uring_enter 时取条目），
+    // 连同排队的请求和之后提交的请求都交给线程池读取。已被内核取走的请求仍由收割线程从完成队列取得
+    void Fail() {
+        if (failed_.load(std::memory_order_relaxed)) return;
+        fallback_.reset(new ThreadPoolIoQueue());
+        failed_.store(true, std::memory_order_relaxed);
+
+        unsigned head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+        for (unsigned i = head; i != *sq_tail_; i++) {
+            const io_uring_sqe& sqe = sqes_[sq_array_[i & sq_mask_]];
+            if (sqe.user_data == 0) continue;
+            fallback_->Submit(reinterpret_cast<FlacIoRequest*>(sqe.user_data));
+            in_flight_--;
+        }
+        __atomic_store_n(sq_tail_, head, __ATOMIC_RELEASE);
+
+        for (FlacIoRequest* request : backlog_) fallback_->Submit(request);
+        backlog_.clear();
+    }
+
+    void Reap() {
+        std::vector<io_uring_cqe> completed;
+        bool polling = false;
+        for (;;) {
+            if (polling) {
+                // 出错后不再进入内核等待：完成队列仍由内核写入，定期检查直到队列销毁
+                if (stop_.load(std::memory_order_relaxed)) return;
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            } else {
+                long waited = syscall(__NR_io_uring_enter, ring_fd_, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+                if (waited < 0 && !Transient(errno)) {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    Fail();
+                    polling = true;
+                    continue;
+                }
+            }
+
+            completed.clear();
+            unsigned head = *cq_head_;
+            unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+            while (head != tail) {
+                completed.push_back(cqes_[head & cq_mask_]);
+                head++;
+            }
+            __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+
+            bool stop = false;
+            unsigned finished = 0;
+            for (const io_uring_cqe& cqe : completed) {
+                if (cqe.user_data == 0) {
+                    stop = true;
+                    continue;
+                }
+                FlacIoRequest* request = reinterpret_cast<FlacIoRequest*>(cqe.user_data);
+                std::this_thread::sleep_until(request->deadline);
+                request->on_complete(request, cqe.res);
+                finished++;
+            }
+            if (stop) return;
+
+            if (finished > 0) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                in_flight_ -= finished;
+                if (failed_.load(std::memory_order_relaxed)) {
+                    polling = true;
+                    continue;
+                }
+                unsigned pushed = 0;
+                while (!backlog_.empty() && in_flight_ < capacity_) {
+                    Push(backlog_.front());
+                    backlog_.pop_front();
+                    pushed++;
+                }
+                if (pushed > 0) Enter(pushed);
+            }
+        }
+    }
+
+    int ring_fd_ = -1;
+    void* sq_ring_ = nullptr;
+    void* cq_ring_ = nullptr;
+    size_t sq_ring_bytes_ = 0;
+    size_t cq_ring_bytes_ = 0;
+    io_uring_sqe* sqes_ = nullptr;
+    size_t sqes_bytes_ = 0;
+
+    unsigned* sq_head_ = nullptr;
+    unsigned* sq_tail_ = nullptr;
+    unsigned sq_mask_ = 0;
+    unsigned* sq_array_ = nullptr;
+    unsigned* cq_head_ = nullptr;
+    unsigned* cq_tail_ = nullptr;
+    unsigned cq_mask_ = 0;
+    io_uring_cqe* cqes_ = nullptr;
+
+    std::mutex mutex_;
+    unsigned capacity_ = 0;
+    unsigned in_flight_ = 0;
+    std::deque<FlacIoRequest*> backlog_;
+    std::thread reaper_;
+    std::atomic<bool> stop_{false};
+
+    // 失败后接手的线程池（fallback_ 在 failed_ 置位前创建，之后不再改变）
+    std::atomic<bool> failed_{false};
+    std::unique_ptr<ThreadPoolIoQueue> fallback_;
+};
+
+#endif // FLAC_HAS_IO_URING
+
+// ========== 队列选择 ==========
+
+int FlacResolveIoBackend() {
+    int backend = g_io_backend.load(std::memory_order_relaxed);
+    if (backend != FLAC_IO_AUTO) return backend;
+    // 本地固定卷上带预读提示的内存映射已足够，异步后端面向慢速存储，由 C# 配置 Advanced.FlacIoBackend 开启
+    return FLAC_IO_MAPPED;
+}
+
+static std::shared_ptr<FlacIoQueue> CreateQueue(int backend) {
+#ifdef FLAC_HAS_IO_URING
+    if (backend == FLAC_IO_URING) {
+        std::shared_ptr<UringIoQueue> uring = std::make_shared<UringIoQueue>();
+        if (uring->Init()) return uring;
+    }
+#endif
+    (void)backend;
+    return std::make_shared<ThreadPoolIoQueue>();
+}
+
+std::shared_ptr<FlacIoQueue> FlacAcquireIoQueue() {
+    int backend = FlacResolveIoBackend();
+    if (backend == FLAC_IO_MAPPED) return nullptr;
+
+    // 每种后端一个共享队列，没有字节源使用时随之释放（不在 DLL 卸载时残留线程）
+    static std::mutex mutex;
+    static std::weak_ptr<FlacIoQueue> queues[FLAC_IO_URING + 1];
+    std::lock_guard<std::mutex> lock(mutex);
+    std::shared_ptr<FlacIoQueue> queue = queues[backend].lock();
+    if (!queue) {
+        queue = CreateQueue(backend);
+        queues[backend] = queue;
+    }
+    // 出错的队列只继续服务已打开的字节源，新打开的文件退回内存映射 / stdio
+    return queue->Failed() ? nullptr : queue;
+}
+
+// ========== AsyncFileByteSource ==========
+
+AsyncFileByteSource::~AsyncFileByteSource() {
+    if (!open_) return;
+    {
+        // 在途的请求完成前不能释放缓冲区，完成回调不再补发新的请求
+        std::unique_lock<std::mutex> lock(mutex_);
+        closing_ = true;
+        done_cv_.wait(lock, [this] {
+            for (const Block& block : blocks_) {
+                if (block.state == BLOCK_PENDING) return false;
+            }
+            return true;
+        });
+    }
+    FlacCloseNativeFile(file_);
+}
+
+bool AsyncFileByteSource::Open(const wchar_t* path, std::shared_ptr<FlacIoQueue> queue) {
+    if (!path || !queue) return false;
+    if (!FlacOpenNativeFileW(path, &file_, &size_)) return false;
+
+    open_ = true;
+    queue_ = std::move(queue);
+    for (Block& block : blocks_) {
+        block.owner = this;
+        block.data.resize(BLOCK_BYTES);
+    }
+
+    // 提前读取文件头（dr_flac 打开时首先读取元数据块）
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (size_ > 0) Issue(SlotFor(0), 0);
+    return true;
+}
+
+void AsyncFileByteSource::Issue(Block& block, uint64_t offset) {
+    block.offset = offset;
+    block.filled = 0;
+    block.state = BLOCK_PENDING;
+    block.request.file = file_;
+    block.request.offset = offset;
+    block.request.buffer = block.data.data();
+    block.request.bytes = BlockLength(offset);
+    block.request.on_complete = &AsyncFileByteSource::OnComplete;
+    block.request.user_data = &block;
+    queue_->Submit(&block.request);
+}
+
+// 补发 current 之后窗口内尚未请求的块；旧位置的读取仍在途的槽位留到它完成时由回调补发
+void AsyncFileByteSource::Refill(uint64_t current) {
+    for (int i = 1; i <= window_; i++) {
+        uint64_t offset = current + static_cast<uint64_t>(i) * BLOCK_BYTES;
+        if (offset >= size_) break;
+        Block& block = SlotFor(offset);
+        if (block.offset == offset || block.state == BLOCK_PENDING) continue;
+        Issue(block, offset);
+    }
+}
+
+void AsyncFileByteSource::OnComplete(FlacIoRequest* request, int64_t result) {
+    Block* block = static_cast<Block*>(request->user_data);
+    AsyncFileByteSource* self = block->owner;
+
+    std::lock_guard<std::mutex> lock(self->mutex_);
+    if (result > 0) {
+        block->filled += static_cast<size_t>(result);
+        size_t wanted = self->BlockLength(block->offset);
+        if (block->filled < wanted) {
+            // 读取不足（信号中断、网络文件系统等）：继续读取剩余部分
+            request->offset = block->offset + block->filled;
+            request->buffer = block->data.data() + block->filled;
+            request->bytes = wanted - block->filled;
+            self->queue_->Submit(request);
+            return;
+        }
+    }
+    // 出错或没有读到数据时不能当作文件末尾：标记失败，由 Read 重新请求
+    block->state = block->filled < self->BlockLength(block->offset) ? BLOCK_FAILED : BLOCK_DONE;
+    self->done_cv_.notify_all();
+
+    // 槽位空出后立即补发窗口内缺少的块，不必等解码线程进入下一块
+    if (!self->closing_ && self->last_block_ != UINT64_MAX) self->Refill(self->last_block_);
+}
+
+size_t AsyncFileByteSource::Read(void* dst, size_t bytes) {
+    uint8_t* out = static_cast<uint8_t*>(dst);
+    size_t total = 0;
+    int retries = 0;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (total < bytes && cursor_ < size_) {
+        uint64_t start = cursor_ / BLOCK_BYTES * BLOCK_BYTES;
+        Block& block = SlotFor(start);
+        if (block.offset != start) {
+            // 槽位属于其他位置：等旧请求完成后改读当前块
+            done_cv_.wait(lock, [&block] { return block.state != BLOCK_PENDING; });
+            Issue(block, start);
+        }
+
+        if (start != last_block_) {
+            // 顺序进入下一块时加倍预读窗口，然后补满窗口
+            if (last_block_ != UINT64_MAX && start == last_block_ + BLOCK_BYTES) {
+                window_ = std::min(window_ * 2, WINDOW_BLOCKS - 1);
+            }
+            last_block_ = start;
+            Refill(start);
+        }
+
+        done_cv_.wait(lock, [&block] { return block.state != BLOCK_PENDING; });
+        size_t in_block = static_cast<size_t>(cursor_ - start);
+        if (in_block >= block.filled) {
+            // 块没有读完整（完整的块一定覆盖 cursor_）：重新请求，多次失败时返回已读取的部分，
+            // 块保持失败状态，之后的读取或 seek 回来时会再次请求
+            if (retries++ < READ_RETRIES) {
+                Issue(block, start);
+                continue;
+            }
+            FlacSetLastError("Async read failed");
+            break;
+        }
+
+        size_t count = std::min(bytes - total, block.filled - in_block);
+        memcpy(out + total, block.data.data() + in_block, count);
+        total += count;
+        cursor_ += count;
+        retries = 0;
+    }
+    return total;
+}
+
+bool AsyncFileByteSource::Seek(int64_t offset, int origin) {
+    int64_t base = origin == SEEK_SET ? 0 : (origin == SEEK_CUR ? static_cast<int64_t>(cursor_) : static_cast<int64_t>(size_));
+    int64_t target = base + offset;
+    // 与 FileByteSource 一致，允许定位到末尾之后（之后的读取返回 0）
+    if (target < 0) return false;
+
+    uint64_t position = static_cast<uint64_t>(target);
+    std::lock_guard<std::mutex> lock(mutex_);
+    cursor_ = position;
+
+    // 落在已请求的窗口之外视为跳转：窗口回到一块，下次读取不算顺序
+    uint64_t block = position / BLOCK_BYTES * BLOCK_BYTES;
+    bool inside = last_block_ != UINT64_MAX && block >= last_block_ &&
+                  block <= last_block_ + static_cast<uint64_t>(window_) * BLOCK_BYTES;
+    if (!inside) {
+        window_ = 1;
+        last_block_ = UINT64_MAX;
+    }
+    return true;
+}
+
+// ========== 导出函数 ==========
+
+extern "C" {
+
+FLAC_API int SetFlacIoBackend(int backend, int latency_us) {
+    if (backend < FLAC_IO_AUTO || backend > FLAC_IO_URING || latency_us < 0) {
+        FlacSetLastError("Invalid I/O backend or latency");
+        return -1;
+    }
+    g_io_backend.store(backend, std::memory_order_relaxed);
+    g_io_latency_us.store(latency_us, std::memory_order_relaxed);
+    return 0;
+}
+
+FLAC_API int GetFlacIoBackend() {
+    int backend = FlacResolveIoBackend();
+    if (backend == FLAC_IO_MAPPED) return backend;
+    std::shared_ptr<FlacIoQueue> queue = FlacAcquireIoQueue();
+    return queue ? queue->Backend() : FLAC_IO_MAPPED;
+}
+
+} // extern "C"
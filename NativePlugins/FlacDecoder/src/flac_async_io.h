@@ -0,0 +1,125 @@
+#ifndef CHILL_FLAC_ASYNC_IO_H
+#define CHILL_FLAC_ASYNC_IO_H
+
+// 异步文件读取：所有流和后台任务的定位读取提交到同一个队列，由后端重叠执行。
+//
+// 后端：io_uring（Linux，以原始系统调用实现，不依赖 liburing）或线程池（可移植，pread / ReadFile）。
+// 队列由使用它的字节源共同持有，最后一个字节源关闭时停止线程并释放。
+// 测试用的人为延迟（SetFlacIoBackend 的 latency_us）按“提交时刻 + 延迟”计算完成时刻，
+// 多个同时在途的请求各自等待，模拟有并发能力的慢速存储。
+
+#include "flac_io.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/uio.h>
+#endif
+
+struct FlacIoRequest;
+
+// 完成回调：result 为读取的字节数（可能少于请求，0 表示末尾），< 0 为错误。在后端线程上调用
+typedef void (*FlacIoCallback)(FlacIoRequest* request, int64_t result);
+
+struct FlacIoRequest {
+    FlacNativeFile file;
+    uint64_t offset;
+    void* buffer;
+    size_t bytes;
+    FlacIoCallback on_complete;
+    void* user_data;
+
+    // 以下由队列填写
+    std::chrono::steady_clock::time_point deadline;   // 人为延迟的完成时刻
+#ifndef _WIN32
+    struct iovec iov;                                 // io_uring READV 的参数
+#endif
+};
+
+class FlacIoQueue {
+public:
+    virtual ~FlacIoQueue() {}
+
+    // 提交请求（任意线程），请求在完成回调返回前必须保持有效
+    virtual void Submit(FlacIoRequest* request) = 0;
+
+    // 实际使用的后端（FlacIoBackend）
+    virtual int Backend() const = 0;
+
+    // 后端出现不可恢复的错误（之后的请求由后备的线程池完成，不会丢失）
+    virtual bool Failed() const { return false; }
+};
+
+// 新打开的文件使用的后端（FLAC_IO_AUTO 已解析为具体后端）
+int FlacResolveIoBackend();
+
+// 取得当前后端的共享队列（没有时创建），FLAC_IO_MAPPED 或队列已出错时返回空
+std::shared_ptr<FlacIoQueue> FlacAcquireIoQueue();
+
+// 经异步队列读取的本地文件
+//
+// 读取位置前方维持一个由若干块组成的预读窗口：读取进入新的一块时补发窗口内尚未请求的块，
+// 每个请求完成时也在回调中补发（槽位被旧位置的读取占用时，解码线程停在一块内也能补满窗口），读取只在所需的块尚未完成时等待。跳转（seek）后窗口从一块开始，顺序读取时逐步加倍到上限，
+// dr_flac 二分查找时不会为每次探测读入整个窗口。只由一个线程读取。
+class AsyncFileByteSource : public FlacByteSource {
+public:
+    static const size_t BLOCK_BYTES = 128 * 1024;
+    static const int WINDOW_BLOCKS = 8;
+    static const int READ_RETRIES = 3;      // Read 没有进展时对失败块的连续重试次数
+
+    AsyncFileByteSource() {}
+    ~AsyncFileByteSource() override;
+
+    AsyncFileByteSource(const AsyncFileByteSource&) = delete;
+    AsyncFileByteSource& operator=(const AsyncFileByteSource&) = delete;
+
+    // 打开文件并取得队列，失败时返回 false
+    bool Open(const wchar_t* path, std::shared_ptr<FlacIoQueue> queue);
+
+    size_t Read(void* dst, size_t bytes) override;
+    bool Seek(int64_t offset, int origin) override;
+    int64_t Tell() const override { return static_cast<int64_t>(cursor_); }
+    size_t ResidentBytes() const override { return static_cast<size_t>(WINDOW_BLOCKS) * BLOCK_BYTES; }
+
+private:
+    enum BlockState { BLOCK_IDLE, BLOCK_PENDING, BLOCK_DONE, BLOCK_FAILED };
+
+    struct Block {
+        AsyncFileByteSource* owner = nullptr;
+        FlacIoRequest request = {};
+        std::vector<uint8_t> data;
+        uint64_t offset = UINT64_MAX;   // 块在文件中的起点（BLOCK_BYTES 对齐）
+        size_t filled = 0;              // 已读入的字节数（BLOCK_DONE 时为块的完整长度，BLOCK_FAILED 时前 filled 字节有效）
+        BlockState state = BLOCK_IDLE;
+    };
+
+    static void OnComplete(FlacIoRequest* request, int64_t result);
+
+    // 以下在持有 mutex_ 时调用
+    Block& SlotFor(uint64_t offset) { return blocks_[(offset / BLOCK_BYTES) % WINDOW_BLOCKS]; }
+    size_t BlockLength(uint64_t offset) const {
+        return size_ - offset < BLOCK_BYTES ? static_cast<size_t>(size_ - offset) : BLOCK_BYTES;
+    }
+    void Issue(Block& block, uint64_t offset);
+    void Refill(uint64_t current);
+
+    FlacNativeFile file_;
+    bool open_ = false;
+    bool closing_ = false;              // 析构中，完成回调不再补发
+    uint64_t size_ = 0;
+    uint64_t cursor_ = 0;
+    uint64_t last_block_ = UINT64_MAX;  // 上一次读取所在的块，用于判断顺序读取
+    int window_ = 1;                    // 当前预读窗口（块数）
+
+    std::shared_ptr<FlacIoQueue> queue_;
+    Block blocks_[WINDOW_BLOCKS];
+    std::mutex mutex_;
+    std::condition_variable done_cv_;
+};
+
+#endif // CHILL_FLAC_ASYNC_IO_H
@@ -0,0 +1,185 @@
+#include "flac_bcn.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FLAC_BCN_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// ========== 颜色块 ==========
+
+static inline uint16_t To565(int r, int g, int b) {
+    return static_cast<uint16_t>((((r * 31 + 127) / 255) << 11) | (((g * 63 + 127) / 255) << 5) | ((b * 31 + 127) / 255));
+}
+
+static inline void From565(uint16_t c, int* rgb) {
+    int r = c >> 11, g = (c >> 5) & 63, b = c & 31;
+    rgb[0] = (r << 3) | (r >> 2);
+    rgb[1] = (g << 2) | (g >> 4);
+    rgb[2] = (b << 3) | (b >> 2);
+}
+
+// 16 个像素的 RGB 包围盒，skip_transparent 时忽略 alpha 为 0 的像素；没有参与的像素时返回 false
+static bool ColorBounds(const uint8_t* block, bool skip_transparent, int* lo, int* hi) {
+    if (!skip_transparent) {
+#ifdef FLAC_BCN_SSE2
+        const __m128i* p = reinterpret_cast<const __m128i*>(block);
+        __m128i a = _mm_loadu_si128(p), b = _mm_loadu_si128(p + 1);
+        __m128i c = _mm_loadu_si128(p + 2), d = _mm_loadu_si128(p + 3);
+        __m128i mn = _mm_min_epu8(_mm_min_epu8(a, b), _mm_min_epu8(c, d));
+        __m128i mx = _mm_max_epu8(_mm_max_epu8(a, b), _mm_max_epu8(c, d));
+        // 4 个像素 → 2 个 → 1 个
+        mn = _mm_min_epu8(mn, _mm_srli_si128(mn, 8));
+        mx = _mm_max_epu8(mx, _mm_srli_si128(mx, 8));
+        mn = _mm_min_epu8(mn, _mm_srli_si128(mn, 4));
+        mx = _mm_max_epu8(mx, _mm_srli_si128(mx, 4));
+        uint32_t min_px = static_cast<uint32_t>(_mm_cvtsi128_si32(mn));
+        uint32_t max_px = static_cast<uint32_t>(_mm_cvtsi128_si32(mx));
+        for (int c3 = 0; c3 < 3; c3++) {
+            lo[c3] = (min_px >> (c3 * 8)) & 0xFF;
+            hi[c3] = (max_px >> (c3 * 8)) & 0xFF;
+        }
+        return true;
+#endif
+    }
+
+    bool any = false;
+    for (int c = 0; c < 3; c++) { lo[c] = 255; hi[c] = 0; }
+    for (int i = 0; i < 16; i++) {
+        const uint8_t* px = block + i * 4;
+        if (skip_transparent && px[3] == 0) continue;
+        any = true;
+        for (int c = 0; c < 3; c++) {
+            lo[c] = std::min(lo[c], static_cast<int>(px[c]));
+            hi[c] = std::max(hi[c], static_cast<int>(px[c]));
+        }
+    }
+    return any;
+}
+
+// dots[i] = (block[i].rgb - base) · axis
+static void ProjectBlock(const uint8_t* block, const int* base, const int* axis, int* dots) {
+#ifdef FLAC_BCN_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i b = _mm_setr_epi16(static_cast<short>(base[0]), static_cast<short>(base[1]), static_cast<short>(base[2]), 0,
+                                     static_cast<short>(base[0]), static_cast<short>(base[1]), static_cast<short>(base[2]), 0);
+    const __m128i d = _mm_setr_epi16(static_cast<short>(axis[0]), static_cast<short>(axis[1]), static_cast<short>(axis[2]), 0,
+                                     static_cast<short>(axis[0]), static_cast<short>(axis[1]), static_cast<short>(axis[2]), 0);
+    for (int i = 0; i < 16; i += 4) {
+        __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i * 4));
+        // 每个像素得到 (r*dr + g*dg, b*db + 0) 两个部分和
+        __m128i lo = _mm_madd_epi16(_mm_sub_epi16(_mm_unpacklo_epi8(px, zero), b), d);
+        __m128i hi = _mm_madd_epi16(_mm_sub_epi16(_mm_unpackhi_epi8(px, zero), b), d);
+        __m128i even = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(lo), _mm_castsi128_ps(hi), _MM_SHUFFLE(2, 0, 2, 0)));
+        __m128i odd = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(lo), _mm_castsi128_ps(hi), _MM_SHUFFLE(3, 1, 3, 1)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dots + i), _mm_add_epi32(even, odd));
+    }
+#else
+    for (int i = 0; i < 16; i++) {
+        const uint8_t* px = block + i * 4;
+        dots[i] = (px[0] - base[0]) * axis[0] + (px[1] - base[1]) * axis[1] + (px[2] - base[2]) * axis[2];
+    }
+#endif
+}
+
+// 颜色块（8 字节）：两个 565 端点（c0 > c1，四色模式）+ 16 个 2 位索引
+static void CompressColorBlock(const uint8_t* block, bool skip_transparent, uint8_t* out) {
+    memset(out, 0, 8);
+    int lo[3], hi[3];
+    if (!ColorBounds(block, skip_transparent, lo, hi)) return;
+
+    // 端点向内收缩 1/16，减小包围盒角点带来的误差
+    for (int c = 0; c < 3; c++) {
+        int inset = (hi[c] - lo[c]) >> 4;
+        lo[c] += inset;
+        hi[c] -= inset;
+    }
+    uint16_t c0 = To565(hi[0], hi[1], hi[2]);
+    uint16_t c1 = To565(lo[0], lo[1], lo[2]);
+    if (c0 < c1) std::swap(c0, c1);
+    out[0] = static_cast<uint8_t>(c0);
+    out[1] = static_cast<uint8_t>(c0 >> 8);
+    out[2] = static_cast<uint8_t>(c1);
+    out[3] = static_cast<uint8_t>(c1 >> 8);
+    if (c0 == c1) return;   // 单色块：全部使用索引 0
+
+    int e0[3], e1[3], axis[3];
+    From565(c0, e0);
+    From565(c1, e1);
+    for (int c = 0; c < 3; c++) axis[c] = e0[c] - e1[c];
+    int length = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+
+    int dots[16];
+    ProjectBlock(block, e1, axis, dots);
+
+    // 投影位置量化为 0..3（0=c1，3=c0），映射到调色板顺序 c0, c1, 2/3 c0 + 1/3 c1, 1/3 c0 + 2/3 c1
+    static const uint32_t LEVEL_TO_INDEX[4] = { 1, 3, 2, 0 };
+    uint32_t indices = 0;
+    for (int i = 0; i < 16; i++) {
+        int level = dots[i] <= 0 ? 0 : std::min(3, (dots[i] * 6 + length) / (length * 2));
+        indices |= LEVEL_TO_INDEX[level] << (i * 2);
+    }
+    for (int i = 0; i < 4; i++) out[4 + i] = static_cast<uint8_t>(indices >> (i * 8));
+}
+
+// ========== Alpha 块 ==========
+
+// Alpha 块（8 字节）：两个端点（a0 > a1，八级插值模式）+ 16 个 3 位索引
+static void CompressAlphaBlock(const uint8_t* block, uint8_t* out) {
+    int a0 = 0, a1 = 255;
+    for (int i = 0; i < 16; i++) {
+        a0 = std::max(a0, static_cast<int>(block[i * 4 + 3]));
+        a1 = std::min(a1, static_cast<int>(block[i * 4 + 3]));
+    }
+    memset(out, 0, 8);
+    out[0] = static_cast<uint8_t>(a0);
+    out[1] = static_cast<uint8_t>(a1);
+    if (a0 == a1) return;
+
+    // 级别 0..7（0=a1，7=a0），调色板索引：7→0，0→1，k→8-k
+    int range = a0 - a1;
+    uint64_t indices = 0;
+    for (int i = 0; i < 16; i++) {
+        int level = ((block[i * 4 + 3] - a1) * 14 + range) / (range * 2);
+        uint64_t index = level == 7 ? 0 : level == 0 ? 1 : static_cast<uint64_t>(8 - level);
+        indices |= index << (i * 3);
+    }
+    for (int i = 0; i < 6; i++) out[2 + i] = static_cast<uint8_t>(indices >> (i * 8));
+}
+
+// ========== 图像 ==========
+
+size_t FlacBcnCompressedSize(int width, int height, bool bc3) {
+    return static_cast<size_t>(width / 4) * static_cast<size_t>(height / 4) * (bc3 ? 16 : 8);
+}
+
+static void LoadBlock(const uint8_t* rgba, int width, int bx, int by, uint8_t* block) {
+    for (int y = 0; y < 4; y++) {
+        memcpy(block + y * 16, rgba + (static_cast<size_t>(by * 4 + y) * width + bx * 4) * 4, 16);
+    }
+}
+
+void FlacCompressBc1(const uint8_t* rgba, int width, int height, uint8_t* out) {
+    uint8_t block[64];
+    for (int by = 0; by < height / 4; by++) {
+        for (int bx = 0; bx < width / 4; bx++) {
+            LoadBlock(rgba, width, bx, by, block);
+            CompressColorBlock(block, false, out);
+            out += 8;
+        }
+    }
+}
+
+void FlacCompressBc3(const uint8_t* rgba, int width, int height, uint8_t* out) {
+    uint8_t block[64];
+    for (int by = 0; by < height / 4; by++) {
+        for (int bx = 0; bx < width / 4; bx++) {
+            LoadBlock(rgba, width, bx, by, block);
+            CompressAlphaBlock(block, out);
+            CompressColorBlock(block, true, out + 8);
+            out += 16;
+        }
+    }
+}
@@ -0,0 +1,19 @@
+#ifndef CHILL_FLAC_BCN_H
+#define CHILL_FLAC_BCN_H
+
+// BC1 / BC3（DXT1 / DXT5）实时块压缩：包围盒端点（向内收缩 1/16）+ 沿端点轴投影选索引。
+// 输入 RGBA8，宽高必须是 4 的倍数；块按内存行序排列，与 Unity 的 LoadRawTextureData 一致。
+
+#include <cstddef>
+#include <cstdint>
+
+// 压缩后的字节数（BC1 每块 8 字节，BC3 每块 16 字节）
+size_t FlacBcnCompressedSize(int width, int height, bool bc3);
+
+// BC1：只有颜色（忽略 alpha）
+void FlacCompressBc1(const uint8_t* rgba, int width, int height, uint8_t* out);
+
+// BC3：插值 alpha 块 + 颜色块；完全透明的像素不参与颜色端点的计算
+void FlacCompressBc3(const uint8_t* rgba, int width, int height, uint8_t* out);
+
+#endif // CHILL_FLAC_BCN_H
@@ -0,0 +1,181 @@
+#include "flac_internal.h"
+#include "flac_cover.h"
+#include "flac_image.h"
+#include "flac_probe.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// 只编译封面需要的格式，图片从内存解码（文件由 FlacOpenFileW 读取，支持宽字符路径）
+#define STB_IMAGE_IMPLEMENTATION
+#define STB_IMAGE_STATIC
+#define STBI_NO_STDIO
+#define STBI_ONLY_JPEG
+#define STBI_ONLY_PNG
+#define STBI_ONLY_BMP
+#define STBI_ONLY_GIF
+#include "stb_image.h"
+
+static const int MAX_THUMBNAIL_SIZE = 4096;
+
+// 图片数据上限（内嵌封面和外部图片文件）
+static const uint64_t MAX_IMAGE_BYTES = 64 * 1024 * 1024;
+
+// PICTURE 类型：3=封面（正面），1/2=32×32 文件图标
+static const int PICTURE_FRONT_COVER = 3;
+static const int PICTURE_FILE_ICON = 1;
+static const int PICTURE_OTHER_FILE_ICON = 2;
+
+// ========== 封面来源 ==========
+
+// 选择用作封面的图片：优先封面（正面），其次第一张非图标图片，最后才用图标
+static const FlacPictureInfo* SelectCover(const FlacProbeInfo& info) {
+    const FlacPictureInfo* fallback = nullptr;
+    const FlacPictureInfo* icon = nullptr;
+    for (int i = 0; i < info.picture_count; i++) {
+        const FlacPictureInfo& picture = info.pictures[i];
+        if (picture.data_size == 0) continue;
+        if (picture.picture_type == PICTURE_FRONT_COVER) return &picture;
+        if (picture.picture_type == PICTURE_FILE_ICON || picture.picture_type == PICTURE_OTHER_FILE_ICON) {
+            if (!icon) icon = &picture;
+        } else if (!fallback) {
+            fallback = &picture;
+        }
+    }
+    return fallback ? fallback : icon;
+}
+
+// 读取 FLAC 内嵌封面的原始数据，返回值同 LoadCoverThumbnail
+static int ReadEmbeddedCover(FileByteSource* source, std::vector<uint8_t>* out) {
+    FlacProbeInfo info;
+    memset(&info, 0, sizeof(info));
+    int result = FlacProbeSource(source, &info);
+    if (result != 0) return result;
+
+    const FlacPictureInfo* cover = SelectCover(info);
+    int status = -3;
+    if (!cover) {
+        FlacSetLastError("No embedded picture");
+    } else if (cover->data_size > MAX_IMAGE_BYTES) {
+        FlacSetLastError("Embedded picture too large");
+    } else {
+        out->resize(cover->data_size);
+        if (source->Seek(static_cast<int64_t>(cover->data_offset), SEEK_SET) &&
+            source->Read(out->data(), out->size()) == out->size()) {
+            status = 0;
+        } else {
+            FlacSetLastError("Truncated PICTURE block");
+        }
+    }
+    FreeFlacProbeInfo(&info);
+    return status;
+}
+
+// 读取整个图片文件
+static int ReadImageFile(FileByteSource* source, std::vector<uint8_t>* out) {
+    if (!source->Seek(0, SEEK_END)) {
+        FlacSetLastError("Failed to read image file");
+        return -2;
+    }
+    int64_t length = source->Tell();
+    if (length <= 0 || static_cast<uint64_t>(length) > MAX_IMAGE_BYTES) {
+        FlacSetLastError("Image file is empty or too large");
+        return -3;
+    }
+    out->resize(static_cast<size_t>(length));
+    if (!source->Seek(0, SEEK_SET) || source->Read(out->data(), out->size()) != out->size()) {
+        FlacSetLastError("Failed to read image file");
+        return -2;
+    }
+    return 0;
+}
+
+int FlacReadCoverData(FileByteSource* source, std::vector<uint8_t>* out_data) {
+    // 按文件头判断：FLAC（可能带 ID3v2 前缀）读取内嵌封面，其余按图片文件处理
+    uint8_t magic[4] = { 0 };
+    size_t got = source->Read(magic, sizeof(magic));
+    bool is_flac = got == sizeof(magic) &&
+                   (memcmp(magic, "fLaC", 4) == 0 || memcmp(magic, "ID3", 3) == 0);
+    if (!source->Seek(0, SEEK_SET)) {
+        FlacSetLastError("Failed to read file");
+        return -2;
+    }
+    return is_flac ? ReadEmbeddedCover(source, out_data) : ReadImageFile(source, out_data);
+}
+
+// ========== 解码与缩放 ==========
+
+static int FinishThumbnail(const uint8_t* rgba, int width, int height, bool top_down, int size, int flags, unsigned char* out_rgba) {
+    if (!FlacResizeRgba(rgba, width, height, static_cast<size_t>(width) * 4, top_down, size, out_rgba)) {
+        FlacSetLastError("Failed to allocate memory for thumbnail");
+        return -4;
+    }
+    if (flags & FLAC_COVER_CIRCULAR) {
+        FlacApplyCircleMask(out_rgba, size);
+    }
+    return 0;
+}
+
+int FlacDecodeCoverThumbnail(const uint8_t* data, size_t data_size, int size, int flags, uint8_t* out_rgba) {
+    if (data_size > static_cast<size_t>(INT32_MAX)) {
+        FlacSetLastError("Image data too large");
+        return -3;
+    }
+
+    int width = 0, height = 0, components = 0;
+    stbi_uc* pixels = stbi_load_from_memory(data, static_cast<int>(data_size), &width, &height, &components, 4);
+    if (!pixels) {
+        FlacSetLastError(stbi_failure_reason());
+        return -3;
+    }
+    int result = FinishThumbnail(pixels, width, height, true, size, flags, out_rgba);
+    stbi_image_free(pixels);
+    return result;
+}
+
+static bool ValidThumbnailArgs(int size, const unsigned char* out_rgba) {
+    return out_rgba && size > 0 && size <= MAX_THUMBNAIL_SIZE;
+}
+
+// ========== 封面缩略图实现 ==========
+
+extern "C" {
+
+FLAC_API int LoadCoverThumbnail(const wchar_t* file_path, int size, int flags, unsigned char* out_rgba) {
+    if (!file_path || !ValidThumbnailArgs(size, out_rgba)) {
+        FlacSetLastError("Invalid arguments");
+        return -1;
+    }
+
+    FILE* file = FlacOpenFileW(file_path);
+    if (!file) {
+        FlacSetLastError("Failed to open file");
+        return -2;
+    }
+    FileByteSource source(file);
+
+    std::vector<uint8_t> data;
+    int result = FlacReadCoverData(&source, &data);
+    if (result != 0) return result;
+
+    return FlacDecodeCoverThumbnail(data.data(), data.size(), size, flags, out_rgba);
+}
+
+FLAC_API int CreateCoverThumbnail(const void* data, size_t data_size, int size, int flags, unsigned char* out_rgba) {
+    if (!data || data_size == 0 || !ValidThumbnailArgs(size, out_rgba)) {
+        FlacSetLastError("Invalid arguments");
+        return -1;
+    }
+    return FlacDecodeCoverThumbnail(static_cast<const uint8_t*>(data), data_size, size, flags, out_rgba);
+}
+
+FLAC_API int ResizeCoverImage(const unsigned char* rgba, int width, int height, int size, int flags, unsigned char* out_rgba) {
+    if (!rgba || width <= 0 || height <= 0 || !ValidThumbnailArgs(size, out_rgba)) {
+        FlacSetLastError("Invalid arguments");
+        return -1;
+    }
+    return FinishThumbnail(rgba, width, height, false, size, flags, out_rgba);
+}
+
+} // extern "C"
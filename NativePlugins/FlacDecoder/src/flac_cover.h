@@ -0,0 +1,18 @@
+#ifndef CHILL_FLAC_COVER_H
+#define CHILL_FLAC_COVER_H
+
+// 封面缩略图管线的内部入口（LoadCoverThumbnail 与缩略图缓存共用）
+
+#include "flac_io.h"
+
+#include <cstdint>
+#include <vector>
+
+// 读取封面的原始图片数据：FLAC 文件（可能带 ID3v2 前缀）取内嵌封面，其他文件按图片文件整体读取。
+// 返回值同 LoadCoverThumbnail
+int FlacReadCoverData(FileByteSource* source, std::vector<uint8_t>* out_data);
+
+// 解码图片数据并生成 size×size 的 RGBA32 缩略图（Unity 行序），返回值同 CreateCoverThumbnail
+int FlacDecodeCoverThumbnail(const uint8_t* data, size_t data_size, int size, int flags, uint8_t* out_rgba);
+
+#endif // CHILL_FLAC_COVER_H
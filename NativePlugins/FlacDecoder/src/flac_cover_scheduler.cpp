@@ -0,0 +1,190 @@
+#include "flac_internal.h"
+#include "flac_bcn.h"
+#include "flac_cover_scheduler.h"
+
+#include <algorithm>
+
+// 封面解码以 CPU 为主（读取多为本地缓存命中），默认线程数取核心数的一半，给主线程和音频线程留出余量
+static const int MAX_DEFAULT_THREADS = 4;
+static const int MAX_THREADS = 16;
+
+static const int MAX_JOB_SIZE = 4096;
+
+// ========== 调度器 ==========
+
+FlacCoverScheduler::FlacCoverScheduler(FlacThumbnailCache* cache, int threads) : cache_(cache) {
+    if (threads <= 0) {
+        int cores = static_cast<int>(std::thread::hardware_concurrency());
+        threads = std::min(MAX_DEFAULT_THREADS, std::max(1, cores / 2));
+    }
+    threads = std::min(threads, MAX_THREADS);
+
+    workers_.reserve(threads);
+    for (int i = 0; i < threads; i++) {
+        workers_.emplace_back(&FlacCoverScheduler::WorkerLoop, this);
+    }
+}
+
+FlacCoverScheduler::~FlacCoverScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        for (auto& entry : jobs_) {
+            entry.second->cancelled.store(true, std::memory_order_relaxed);
+        }
+        queue_.clear();
+    }
+    wake_.notify_all();
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+int64_t FlacCoverScheduler::Submit(const wchar_t* path, int size, int flags, int priority) {
+    std::shared_ptr<Job> job = std::make_shared<Job>();
+    job->path = path;
+    job->size = size;
+    job->flags = flags;
+    job->priority = priority;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        job->id = next_id_++;
+        job->sequence = next_sequence_++;
+        jobs_[job->id] = job;
+        queue_.insert(KeyOf(*job));
+    }
+    wake_.notify_one();
+    return job->id;
+}
+
+int FlacCoverScheduler::SetPriority(int64_t job_id, int priority) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = jobs_.find(job_id);
+    if (it == jobs_.end()) return 0;
+
+    Job& job = *it->second;
+    // 不在队列中说明已经开始执行
+    if (queue_.erase(KeyOf(job)) == 0) return 0;
+    job.priority = priority;
+    queue_.insert(KeyOf(job));
+    return 1;
+}
+
+int FlacCoverScheduler::Cancel(int64_t job_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = jobs_.find(job_id);
+    if (it == jobs_.end()) return 0;
+
+    Job& job = *it->second;
+    job.cancelled.store(true, std::memory_order_relaxed);
+    if (queue_.erase(KeyOf(job)) != 0) {
+        jobs_.erase(it);
+    }
+    return 1;
+}
+
+const std::vector<FlacCoverScheduler::Result>& FlacCoverScheduler::Poll(size_t max_results) {
+    polled_.clear();
+    std::lock_guard<std::mutex> lock(mutex_);
+    while (!completed_.empty() && polled_.size() < max_results) {
+        polled_.push_back(std::move(completed_.front()));
+        completed_.pop_front();
+    }
+    return polled_;
+}
+
+void FlacCoverScheduler::WorkerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        wake_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+        if (stopping_) return;
+
+        int64_t job_id = queue_.begin()->second;
+        queue_.erase(queue_.begin());
+        std::shared_ptr<Job> job = jobs_[job_id];
+        lock.unlock();
+
+        Result result;
+        result.job_id = job->id;
+        result.format = 0;
+        result.data.resize(FlacBcnCompressedSize(job->size, job->size, (job->flags & FLAC_COVER_CIRCULAR) != 0));
+        result.status = FlacLoadCachedThumbnail(cache_, job->path.c_str(), job->size, job->flags,
+                                                result.data.data(), result.data.size(), &result.format,
+                                                &job->cancelled);
+
+        lock.lock();
+        jobs_.erase(job_id);
+        if (!job->cancelled.load(std::memory_order_relaxed)) {
+            if (result.status < 0) result.data.clear();
+            completed_.push_back(std::move(result));
+        }
+    }
+}
+
+// ========== 导出函数 ==========
+
+extern "C" {
+
+FLAC_API void* CreateCoverScheduler(void* thumbnail_cache, int threads) {
+    return new FlacCoverScheduler(static_cast<FlacThumbnailCache*>(thumbnail_cache), threads);
+}
+
+FLAC_API long long SubmitCoverJob(void* scheduler, const wchar_t* file_path, int size, int flags, int priority) {
+    if (!scheduler || !file_path || size <= 0 || size > MAX_JOB_SIZE || size % 4 != 0) {
+        FlacSetLastError("Invalid arguments");
+        return -1;
+    }
+    return static_cast<FlacCoverScheduler*>(scheduler)->Submit(file_path, size, flags, priority);
+}
+
+FLAC_API int SetCoverJobPriorities(void* scheduler, const long long* job_ids, const int* priorities, int count) {
+    if (!scheduler || count < 0 || (count > 0 && (!job_ids || !priorities))) {
+        FlacSetLastError("Invalid arguments");
+        return -1;
+    }
+    FlacCoverScheduler* self = static_cast<FlacCoverScheduler*>(scheduler);
+    int updated = 0;
+    for (int i = 0; i < count; i++) {
+        updated += self->SetPriority(job_ids[i], priorities[i]);
+    }
+    return updated;
+}
+
+FLAC_API int CancelCoverJobs(void* scheduler, const long long* job_ids, int count) {
+    if (!scheduler || count < 0 || (count > 0 && !job_ids)) {
+        FlacSetLastError("Invalid arguments");
+        return -1;
+    }
+    FlacCoverScheduler* self = static_cast<FlacCoverScheduler*>(scheduler);
+    int cancelled = 0;
+    for (int i = 0; i < count; i++) {
+        cancelled += self->Cancel(job_ids[i]);
+    }
+    return cancelled;
+}
+
+FLAC_API int PollCoverJobs(void* scheduler, FlacCoverJobResult* out_results, int max_results) {
+    if (!scheduler || !out_results || max_results <= 0) {
+        FlacSetLastError("Invalid arguments");
+        return -1;
+    }
+
+    const std::vector<FlacCoverScheduler::Result>& results =
+        static_cast<FlacCoverScheduler*>(scheduler)->Poll(static_cast<size_t>(max_results));
+    for (size_t i = 0; i < results.size(); i++) {
+        const FlacCoverScheduler::Result& result = results[i];
+        FlacCoverJobResult& out = out_results[i];
+        out.job_id = result.job_id;
+        out.status = result.status;
+        out.format = result.format;
+        out.data = result.data.empty() ? nullptr : result.data.data();
+    }
+    return static_cast<int>(results.size());
+}
+
+FLAC_API void DestroyCoverScheduler(void* scheduler) {
+    delete static_cast<FlacCoverScheduler*>(scheduler);
+}
+
+} // extern "C"
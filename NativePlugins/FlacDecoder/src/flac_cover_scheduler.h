@@ -0,0 +1,82 @@
+#ifndef CHILL_FLAC_COVER_SCHEDULER_H
+#define CHILL_FLAC_COVER_SCHEDULER_H
+
+// 封面加载调度器：固定数量的工作线程按优先级执行缩略图任务（读取 → 解码 → 缩放 → BC 压缩，经缩略图缓存），
+// 完成的结果放入完成队列，由调用方（主线程）轮询取回。
+//
+// 等待中的任务可以批量调整优先级或取消；执行中的任务被取消时在下一个开销大的步骤之前停止，结果丢弃。
+// 被取消的任务不会出现在完成队列中。
+
+#include "flac_thumbnail_cache.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+class FlacCoverScheduler {
+public:
+    struct Result {
+        int64_t job_id;
+        int status;                 // > 0 为字节数，< 0 同 GetCachedCoverThumbnail
+        int format;                 // FlacThumbnailFormat
+        std::vector<uint8_t> data;
+    };
+
+    // cache 可为 NULL（不持久化）；threads <= 0 时使用默认线程数
+    FlacCoverScheduler(FlacThumbnailCache* cache, int threads);
+    ~FlacCoverScheduler();
+
+    FlacCoverScheduler(const FlacCoverScheduler&) = delete;
+    FlacCoverScheduler& operator=(const FlacCoverScheduler&) = delete;
+
+    int64_t Submit(const wchar_t* path, int size, int flags, int priority);
+
+    // 只影响尚在等待的任务，返回实际调整的数量
+    int SetPriority(int64_t job_id, int priority);
+
+    // 等待中的任务直接移除，执行中的任务置取消标记，返回找到的任务数量
+    int Cancel(int64_t job_id);
+
+    // 取出最多 max_results 个完成的结果（按完成顺序）。返回的结果在下一次 Poll 之前有效，Poll 只应在一个线程上调用
+    const std::vector<Result>& Poll(size_t max_results);
+
+private:
+    struct Job {
+        int64_t id;
+        std::wstring path;
+        int size;
+        int flags;
+        int priority;
+        uint64_t sequence;                  // 同优先级按提交顺序执行
+        std::atomic<bool> cancelled{false};
+    };
+
+    // 排序键：优先级高的在前，同优先级先提交的在前
+    typedef std::pair<std::pair<int, uint64_t>, int64_t> QueueKey;
+    static QueueKey KeyOf(const Job& job) { return QueueKey(std::make_pair(-job.priority, job.sequence), job.id); }
+
+    void WorkerLoop();
+
+    FlacThumbnailCache* cache_;
+    std::mutex mutex_;      // 保护以下全部成员
+    std::condition_variable wake_;
+    bool stopping_ = false;
+    int64_t next_id_ = 1;
+    uint64_t next_sequence_ = 0;
+    std::set<QueueKey> queue_;
+    std::map<int64_t, std::shared_ptr<Job>> jobs_;     // 等待中和执行中的任务
+    std::deque<Result> completed_;
+    std::vector<std::thread> workers_;
+    std::vector<Result> polled_;    // 最近一次 Poll 取出的结果（只由轮询线程访问）
+};
+
+#endif // CHILL_FLAC_COVER_SCHEDULER_H
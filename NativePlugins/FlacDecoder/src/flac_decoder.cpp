@@ -1,29 +1,41 @@
 #define DR_FLAC_IMPLEMENTATION
-#define BUILDING_DLL  // 定义为导出模式
-#include "dr_flac.h"
-#include "flac_decoder.h"
+#include "flac_internal.h"
+#include "flac_parallel.h"
 
+#include <algorithm>
 #include <string>
 #include <cstring>
 #include <cstdlib>
+#include <mutex>
 
 // 线程本地错误消息
 static thread_local std::string g_last_error;
 
-extern "C" {
+// 平面格式整文件解码时每次解交错的帧数
+static const uint64_t PLANAR_DECODE_CHUNK_FRAMES = 4096;
 
-FLAC_API int DecodeFlacFile(const wchar_t* file_path, FlacAudioInfo* out_info) {
-    if (!file_path || !out_info) {
-        g_last_error = "Invalid parameters";
-        return -1;
-    }
+// 并行解码：每个线程平均分到的段数（段长不均时用于负载均衡）与最短段长
+static const int SEGMENTS_PER_THREAD = 4;
+static const uint64_t MIN_SEGMENT_FRAMES = 1 << 18;
 
+void FlacSetLastError(const char* message) {
+    g_last_error = message;
+}
+
+// 整文件解码为指定格式，错误码与 DecodeFlacFile 一致
+static int DecodeWholeFile(const wchar_t* file_path, int sample_format, bool dither, FlacPcmData* out_data) {
     // 清零输出结构
-    memset(out_info, 0, sizeof(FlacAudioInfo));
+    memset(out_data, 0, sizeof(FlacPcmData));
+
+    if (!FlacIsValidSampleFormat(sample_format)) {
+        g_last_error = "Invalid sample format";
+        return -5;
+    }
+
+    // 本地文件经内存映射读取（失败时退回 stdio），宽字符路径由 FlacOpenLocalSource 处理
+    std::unique_ptr<FlacByteSource> source(FlacOpenLocalSource(file_path));
+    drflac* flac = source ? FlacOpenSource(source.get(), FlacPoolAllocationCallbacks()) : nullptr;
 
-    // ✅ 修改点：使用 drflac_open_file_w 支持宽字符路径
-    drflac* flac = drflac_open_file_w(file_path, nullptr);
-    
     if (!flac) {
         // 注意：file_path 是宽字符，不能直接加到 std::string (std::string 是 char)
         // 为了简单起见，这里只记录通用错误，避免字符串转换导致的崩溃
@@ -32,119 +44,334 @@ FLAC_API int DecodeFlacFile(const wchar_t* file_path, FlacAudioInfo* out_info) {
     }
 
     // 获取音频信息
-    out_info->sample_rate = flac->sampleRate;
-    out_info->channels = flac->channels;
-    out_info->total_pcm_frame_count = flac->totalPCMFrameCount;
+    uint64_t total_frames = flac->totalPCMFrameCount;
+    out_data->sample_rate = flac->sampleRate;
+    out_data->channels = flac->channels;
+    out_data->total_pcm_frame_count = total_frames;
+    out_data->sample_format = sample_format;
+
+    FlacGetPcmKernels();
 
     // 计算 PCM 数据大小
-    size_t total_samples = (size_t)flac->totalPCMFrameCount * flac->channels;
-    out_info->pcm_data_size = total_samples * sizeof(float);
+    FlacPcmDecoder decoder;
+    decoder.Reset(sample_format, dither, flac->bitsPerSample, flac->channels);
+    out_data->pcm_data_size = (size_t)total_frames * decoder.FrameBytes();
 
     // 分配内存
-    out_info->pcm_data = static_cast<float*>(malloc(out_info->pcm_data_size));
-    if (!out_info->pcm_data) {
+    out_data->pcm_data = malloc(out_data->pcm_data_size);
+    if (!out_data->pcm_data) {
         g_last_error = "Failed to allocate memory for PCM data";
         drflac_close(flac);
         return -3;
     }
 
-    // 解码为 float PCM
-    drflac_uint64 frames_read = drflac_read_pcm_frames_f32(
-        flac, 
-        flac->totalPCMFrameCount, 
-        out_info->pcm_data
-    );
+    uint64_t frames_read = 0;
+    if (sample_format == FLAC_SAMPLE_F32_PLANAR) {
+        // 分块解码为交错格式，再解交错到各声道平面
+        std::vector<float> chunk(static_cast<size_t>(PLANAR_DECODE_CHUNK_FRAMES) * flac->channels);
+        while (frames_read < total_frames) {
+            uint64_t want = std::min<uint64_t>(total_frames - frames_read, PLANAR_DECODE_CHUNK_FRAMES);
+            uint64_t got = decoder.Decode(flac, chunk.data(), want);
+            FlacDeinterleave(chunk.data(), got, flac->channels,
+                             static_cast<float*>(out_data->pcm_data) + frames_read, total_frames);
+            frames_read += got;
+            if (got < want) break;
+        }
+    } else {
+        frames_read = decoder.Decode(flac, out_data->pcm_data, total_frames);
+    }
 
     drflac_close(flac);
 
-    if (frames_read != flac->totalPCMFrameCount) {
+    if (frames_read != total_frames) {
         g_last_error = "Failed to read all PCM frames";
-        free(out_info->pcm_data);
-        out_info->pcm_data = nullptr;
+        free(out_data->pcm_data);
+        out_data->pcm_data = nullptr;
         return -4;
     }
 
     return 0; // 成功
 }
 
-FLAC_API void FreeFlacData(FlacAudioInfo* info) {
-    if (info && info->pcm_data) {
-        free(info->pcm_data);
-        info->pcm_data = nullptr;
-        info->pcm_data_size = 0;
+// ========== 并行整文件解码 ==========
+
+namespace {
+
+// 单个线程的解码器（在段之间复用）
+struct SegmentDecoder {
+    std::unique_ptr<FlacByteSource> source;
+    drflac* flac = nullptr;
+    FlacPcmDecoder pcm;
+    std::vector<float> chunk;       // 平面格式的交错中转区
+    uint64_t position = 0;
+
+    ~SegmentDecoder() {
+        if (flac) drflac_close(flac);
+    }
+};
+
+struct ParallelDecodeJob {
+    std::wstring path;
+    int sample_format = 0;
+    bool dither = false;
+    int bits_per_sample = 0;
+    int channels = 0;
+    uint64_t total_frames = 0;
+    bool has_seektable = false;
+    std::vector<drflac_seekpoint> seekpoints;   // 文件没有 SEEKTABLE 时安装的持久化 seek 索引
+    std::vector<uint64_t> boundaries;           // 段 i 为 [boundaries[i], boundaries[i + 1])
+    uint8_t* output = nullptr;
+};
+
+} // namespace
+
+// 文件没有 SEEKTABLE 时读取（或扫描生成并保存）持久化 seek 索引，与 OpenFlacStream 共用旁路文件
+static void PrepareSeekpoints(ParallelDecodeJob* job, const FlacFileIdentity* identity) {
+    if (job->has_seektable) return;
+    if (identity && FlacLoadSeekIndex(job->path.c_str(), *identity, &job->seekpoints)) return;
+
+    std::unique_ptr<FlacByteSource> source(FlacOpenLocalSource(job->path.c_str()));
+    if (!source) return;
+    if (FlacBuildSeekIndex(source.get(), nullptr, &job->seekpoints)) {
+        if (identity) FlacSaveSeekIndex(job->path.c_str(), *identity, job->seekpoints);
+    } else {
+        // 扫描失败时退回 dr_flac 的二分查找
+        job->seekpoints.clear();
     }
 }
 
-FLAC_API const char* FlacGetLastError() {
-    return g_last_error.c_str();
+// 均分后把每个边界对齐到不晚于它的 seekpoint，段首正好是 FLAC 帧的第一个采样，seek 后无需丢弃采样
+static void PlanSegments(ParallelDecodeJob* job, drflac* flac, uint64_t segment_count) {
+    const drflac_seekpoint* points = job->has_seektable ? flac->pSeekpoints : job->seekpoints.data();
+    size_t point_count = job->has_seektable ? flac->seekpointCount : job->seekpoints.size();
+
+    job->boundaries.push_back(0);
+    for (uint64_t i = 1; i < segment_count; i++) {
+        uint64_t target = job->total_frames / segment_count * i;
+        const drflac_seekpoint* point = std::upper_bound(points, points + point_count, target,
+            [](uint64_t frame, const drflac_seekpoint& p) { return frame < p.firstPCMFrame; });
+        if (point != points) target = (point - 1)->firstPCMFrame;
+        if (target > job->boundaries.back()) job->boundaries.push_back(target);
+    }
+    job->boundaries.push_back(job->total_frames);
 }
 
-// ========== 流式解码实现 ==========
+static std::unique_ptr<SegmentDecoder> OpenSegmentDecoder(ParallelDecodeJob* job) {
+    std::unique_ptr<SegmentDecoder> decoder(new SegmentDecoder());
+    decoder->source.reset(FlacOpenLocalSource(job->path.c_str()));
+    if (!decoder->source) return nullptr;
+    decoder->flac = FlacOpenSource(decoder->source.get(), FlacPoolAllocationCallbacks());
+    if (!decoder->flac) return nullptr;
 
-FLAC_API void* OpenFlacStream(const wchar_t* file_path, int* out_sample_rate, int* out_channels, unsigned long long* out_total_pcm_frames) {
-    if (!file_path) {
-        g_last_error = "File path is NULL";
-        return nullptr;
+    if (!job->has_seektable && !job->seekpoints.empty()) {
+        decoder->flac->pSeekpoints = job->seekpoints.data();
+        decoder->flac->seekpointCount = static_cast<drflac_uint32>(job->seekpoints.size());
     }
+    decoder->pcm.Reset(job->sample_format, job->dither, job->bits_per_sample, job->channels);
+    if (job->sample_format == FLAC_SAMPLE_F32_PLANAR) {
+        decoder->chunk.resize(static_cast<size_t>(PLANAR_DECODE_CHUNK_FRAMES) * job->channels);
+    }
+    return decoder;
+}
 
-    // ✅ 修改点：使用 drflac_open_file_w 支持宽字符路径
-    drflac* flac = drflac_open_file_w(file_path, nullptr);
-    
-    if (!flac) {
-        g_last_error = "Failed to open FLAC file for streaming";
-        return nullptr;
+// 解码一段到输出缓冲区中的最终位置
+static bool DecodeSegment(ParallelDecodeJob* job, SegmentDecoder* decoder, size_t segment) {
+    uint64_t start = job->boundaries[segment];
+    uint64_t frames = job->boundaries[segment + 1] - start;
+
+    if (decoder->position != start) {
+        if (!drflac_seek_to_pcm_frame(decoder->flac, start)) {
+            decoder->position = UINT64_MAX;
+            return false;
+        }
+        decoder->position = start;
     }
+    decoder->pcm.SeekDither(start * job->channels);
 
-    // 输出音频信息
-    if (out_sample_rate) *out_sample_rate = flac->sampleRate;
-    if (out_channels) *out_channels = flac->channels;
-    if (out_total_pcm_frames) *out_total_pcm_frames = flac->totalPCMFrameCount;
+    uint64_t decoded = 0;
+    if (job->sample_format == FLAC_SAMPLE_F32_PLANAR) {
+        float* planes = reinterpret_cast<float*>(job->output);
+        while (decoded < frames) {
+            uint64_t want = std::min<uint64_t>(frames - decoded, PLANAR_DECODE_CHUNK_FRAMES);
+            uint64_t got = decoder->pcm.Decode(decoder->flac, decoder->chunk.data(), want);
+            FlacDeinterleave(decoder->chunk.data(), got, job->channels, planes + start + decoded, job->total_frames);
+            decoded += got;
+            if (got < want) break;
+        }
+    } else {
+        decoded = decoder->pcm.Decode(decoder->flac, job->output + start * decoder->pcm.FrameBytes(), frames);
+    }
 
-    return static_cast<void*>(flac);
+    decoder->position += decoded;
+    return decoded == frames;
 }
 
-FLAC_API long long ReadFlacFrames(void* stream_handle, float* buffer, unsigned long long frames_to_read) {
-    if (!stream_handle) {
-        g_last_error = "Stream handle is NULL";
-        return -1;
+static int DecodeWholeFileParallel(const wchar_t* file_path, int sample_format, bool dither, int threads, FlacPcmData* out_data) {
+    memset(out_data, 0, sizeof(FlacPcmData));
+
+    if (!FlacIsValidSampleFormat(sample_format)) {
+        g_last_error = "Invalid sample format";
+        return -5;
+    }
+    if (threads <= 0) threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+
+    FILE* file = FlacOpenFileW(file_path);
+    if (!file) {
+        g_last_error = "Failed to open FLAC file (Path resolution failed)";
+        return -2;
+    }
+    FlacFileIdentity identity = {};
+    bool has_identity = FlacGetFileIdentity(file, &identity);
+    fclose(file);
+
+    // 第一个解码器同时用于读取流信息和规划分段
+    ParallelDecodeJob job;
+    job.path = file_path;
+    job.sample_format = sample_format;
+    job.dither = dither;
+
+    std::unique_ptr<SegmentDecoder> first(new SegmentDecoder());
+    first->source.reset(FlacOpenLocalSource(file_path));
+    first->flac = first->source ? FlacOpenSource(first->source.get(), FlacPoolAllocationCallbacks()) : nullptr;
+    if (!first->flac) {
+        g_last_error = "Failed to open FLAC file (Path resolution failed)";
+        return -2;
+    }
+
+    job.bits_per_sample = first->flac->bitsPerSample;
+    job.channels = first->flac->channels;
+    job.total_frames = first->flac->totalPCMFrameCount;
+    job.has_seektable = first->flac->seekpointCount > 0;
+
+    // 总帧数未知或太短时分段没有收益
+    uint64_t segment_count = std::min<uint64_t>(static_cast<uint64_t>(threads) * SEGMENTS_PER_THREAD,
+                                                job.total_frames / MIN_SEGMENT_FRAMES);
+    if (threads == 1 || segment_count < 2) {
+        first.reset();
+        return DecodeWholeFile(file_path, sample_format, dither, out_data);
+    }
+
+    PrepareSeekpoints(&job, has_identity ? &identity : nullptr);
+    if (!job.has_seektable && !job.seekpoints.empty()) {
+        first->flac->pSeekpoints = job.seekpoints.data();
+        first->flac->seekpointCount = static_cast<drflac_uint32>(job.seekpoints.size());
     }
-    if (!buffer) {
-        g_last_error = "Buffer is NULL";
+    PlanSegments(&job, first->flac, segment_count);
+
+    FlacGetPcmKernels();
+    first->pcm.Reset(sample_format, dither, job.bits_per_sample, job.channels);
+    if (sample_format == FLAC_SAMPLE_F32_PLANAR) {
+        first->chunk.resize(static_cast<size_t>(PLANAR_DECODE_CHUNK_FRAMES) * job.channels);
+    }
+
+    out_data->sample_rate = first->flac->sampleRate;
+    out_data->channels = job.channels;
+    out_data->total_pcm_frame_count = job.total_frames;
+    out_data->sample_format = sample_format;
+    out_data->pcm_data_size = static_cast<size_t>(job.total_frames) * first->pcm.FrameBytes();
+
+    out_data->pcm_data = malloc(out_data->pcm_data_size);
+    if (!out_data->pcm_data) {
+        g_last_error = "Failed to allocate memory for PCM data";
+        return -3;
+    }
+    job.output = static_cast<uint8_t*>(out_data->pcm_data);
+
+    // 解码器在段之间复用：按需打开，最多与线程数相同
+    std::mutex idle_mutex;
+    std::vector<std::unique_ptr<SegmentDecoder>> idle;
+    idle.push_back(std::move(first));
+    std::atomic<bool> failed{false};
+
+    FlacParallelFor(job.boundaries.size() - 1, threads, [&](size_t segment) {
+        if (failed.load(std::memory_order_relaxed)) return;
+
+        std::unique_ptr<SegmentDecoder> decoder;
+        {
+            std::lock_guard<std::mutex> lock(idle_mutex);
+            if (!idle.empty()) {
+                decoder = std::move(idle.back());
+                idle.pop_back();
+            }
+        }
+        if (!decoder) decoder = OpenSegmentDecoder(&job);
+        if (!decoder || !DecodeSegment(&job, decoder.get(), segment)) {
+            failed.store(true, std::memory_order_relaxed);
+            if (!decoder) return;
+        }
+
+        std::lock_guard<std::mutex> lock(idle_mutex);
+        idle.push_back(std::move(decoder));
+    });
+
+    if (failed.load(std::memory_order_relaxed)) {
+        g_last_error = "Failed to read all PCM frames";
+        free(out_data->pcm_data);
+        out_data->pcm_data = nullptr;
+        return -4;
+    }
+    return 0;
+}
+
+extern "C" {
+
+FLAC_API int DecodeFlacFile(const wchar_t* file_path, FlacAudioInfo* out_info) {
+    if (!file_path || !out_info) {
+        g_last_error = "Invalid parameters";
         return -1;
     }
 
-    drflac* flac = static_cast<drflac*>(stream_handle);
-    
-    // dr_flac 返回实际读取的帧数
-    drflac_uint64 frames_read = drflac_read_pcm_frames_f32(flac, frames_to_read, buffer);
-    
-    return static_cast<long long>(frames_read);
+    // 清零输出结构
+    memset(out_info, 0, sizeof(FlacAudioInfo));
+
+    FlacPcmData data;
+    int result = DecodeWholeFile(file_path, FLAC_SAMPLE_F32, false, &data);
+    if (result != 0) return result;
+
+    out_info->sample_rate = data.sample_rate;
+    out_info->channels = data.channels;
+    out_info->total_pcm_frame_count = data.total_pcm_frame_count;
+    out_info->pcm_data = static_cast<float*>(data.pcm_data);
+    out_info->pcm_data_size = data.pcm_data_size;
+    return 0;
 }
 
-FLAC_API int SeekFlacStream(void* stream_handle, unsigned long long frame_index) {
-    if (!stream_handle) {
-        g_last_error = "Stream handle is NULL";
+FLAC_API int DecodeFlacFileEx(const wchar_t* file_path, int sample_format, int dither, FlacPcmData* out_data) {
+    if (!file_path || !out_data) {
+        g_last_error = "Invalid parameters";
         return -1;
     }
 
-    drflac* flac = static_cast<drflac*>(stream_handle);
-    
-    // drflac_seek_to_pcm_frame 返回 DRFLAC_TRUE/DRFLAC_FALSE
-    drflac_bool32 success = drflac_seek_to_pcm_frame(flac, frame_index);
-    
-    if (!success) {
-        g_last_error = "Failed to seek to specified frame";
+    return DecodeWholeFile(file_path, sample_format, dither != 0, out_data);
+}
+
+FLAC_API int DecodeFlacFileParallel(const wchar_t* file_path, int sample_format, int dither, int threads, FlacPcmData* out_data) {
+    if (!file_path || !out_data) {
+        g_last_error = "Invalid parameters";
         return -1;
     }
 
-    return 0;
+    return DecodeWholeFileParallel(file_path, sample_format, dither != 0, threads, out_data);
 }
 
-FLAC_API void CloseFlacStream(void* stream_handle) {
-    if (stream_handle) {
-        drflac* flac = static_cast<drflac*>(stream_handle);
-        drflac_close(flac);
+FLAC_API void FreeFlacPcmData(FlacPcmData* data) {
+    if (data && data->pcm_data) {
+        free(data->pcm_data);
+        data->pcm_data = nullptr;
+        data->pcm_data_size = 0;
     }
 }
 
+FLAC_API void FreeFlacData(FlacAudioInfo* info) {
+    if (info && info->pcm_data) {
+        free(info->pcm_data);
+        info->pcm_data = nullptr;
+        info->pcm_data_size = 0;
+    }
+}
+
+FLAC_API const char* FlacGetLastError() {
+    return g_last_error.c_str();
+}
+
 } // extern "C"
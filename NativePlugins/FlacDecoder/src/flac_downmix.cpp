@@ -0,0 +1,88 @@
+#include "flac_downmix.h"
+
+#include <cmath>
+
+// -3dB（中置、环绕声道混入前置左右声道的系数）
+static const double MINUS_3DB = 0.70710678118654752;
+
+// FLAC 声道顺序（按声道数）中每个声道对左、右输出的贡献，LFE 不参与缩混：
+//   3: L R C
+//   4: L R BL BR
+//   5: L R C BL BR
+//   6: L R C LFE BL BR
+//   7: L R C LFE BC SL SR
+//   8: L R C LFE BL BR SL SR
+static void StereoCoefficients(int channels, double* left, double* right) {
+    for (int c = 0; c < channels; c++) left[c] = right[c] = 0.0;
+    left[0] = 1.0;
+    right[1] = 1.0;
+
+    switch (channels) {
+    case 3:
+        left[2] = right[2] = MINUS_3DB;
+        break;
+    case 4:
+        left[2] = right[3] = MINUS_3DB;
+        break;
+    case 5:
+        left[2] = right[2] = MINUS_3DB;
+        left[3] = right[4] = MINUS_3DB;
+        break;
+    case 6:
+        left[2] = right[2] = MINUS_3DB;
+        left[4] = right[5] = MINUS_3DB;
+        break;
+    case 7:
+        left[2] = right[2] = MINUS_3DB;
+        left[4] = right[4] = 0.5;   // 后中置分到两侧环绕，再按环绕系数混入
+        left[5] = right[6] = MINUS_3DB;
+        break;
+    case 8:
+        left[2] = right[2] = MINUS_3DB;
+        left[4] = right[5] = MINUS_3DB;
+        left[6] = right[7] = MINUS_3DB;
+        break;
+    default:
+        break;
+    }
+}
+
+// 每行除以系数绝对值之和：所有声道同时满幅时输出也不会超过 [-1, 1]
+static void Normalize(double* row, int channels) {
+    double sum = 0.0;
+    for (int c = 0; c < channels; c++) sum += std::fabs(row[c]);
+    if (sum <= 0.0) return;
+    for (int c = 0; c < channels; c++) row[c] /= sum;
+}
+
+bool FlacDownmixer::Init(int input_channels, int output_channels) {
+    if (output_channels < 1 || output_channels > 2 || input_channels <= output_channels || input_channels > 8) {
+        return false;
+    }
+
+    input_channels_ = input_channels;
+    output_channels_ = output_channels;
+    kernels_ = &FlacGetPcmKernels();
+
+    double left[8];
+    double right[8];
+    StereoCoefficients(input_channels, left, right);
+    Normalize(left, input_channels);
+    Normalize(right, input_channels);
+
+    matrix_.assign(static_cast<size_t>(output_channels) * input_channels, 0.0f);
+    for (int c = 0; c < input_channels; c++) {
+        if (output_channels == 1) {
+            // 单声道为立体声缩混结果的平均
+            matrix_[c] = static_cast<float>((left[c] + right[c]) * 0.5);
+        } else {
+            matrix_[c] = static_cast<float>(left[c]);
+            matrix_[input_channels + c] = static_cast<float>(right[c]);
+        }
+    }
+    return true;
+}
+
+void FlacDownmixer::Process(const float* in, uint64_t frames, float* out) const {
+    kernels_->mix_f32(in, frames, input_channels_, matrix_.data(), output_channels_, out);
+}
@@ -0,0 +1,30 @@
+#ifndef CHILL_FLAC_DOWNMIX_H
+#define CHILL_FLAC_DOWNMIX_H
+
+// 多声道 → 立体声 / 单声道缩混：按 FLAC 规定的声道顺序使用 ITU-R BS.775 系数，
+// 矩阵乘法由 SIMD 内核完成（见 flac_simd.h）。
+
+#include "flac_simd.h"
+
+#include <cstdint>
+#include <vector>
+
+class FlacDownmixer {
+public:
+    // output_channels 为 1 或 2；源声道数不多于目标时不需要缩混，返回 false
+    bool Init(int input_channels, int output_channels);
+
+    int InputChannels() const { return input_channels_; }
+    int OutputChannels() const { return output_channels_; }
+
+    // 交错 input_channels → 交错 output_channels，in 与 out 不能重叠
+    void Process(const float* in, uint64_t frames, float* out) const;
+
+private:
+    int input_channels_ = 0;
+    int output_channels_ = 0;
+    std::vector<float> matrix_;   // 行主序，output_channels × input_channels
+    const FlacPcmKernels* kernels_ = nullptr;
+};
+
+#endif // CHILL_FLAC_DOWNMIX_H
@@ -0,0 +1,103 @@
+#include "flac_fft.h"
+
+#include <cmath>
+
+static const double PI = 3.14159265358979323846;
+
+void FlacRealFft::Init(size_t size, const FlacPcmKernels* kernels) {
+    kernels_ = kernels ? kernels : &FlacGetPcmKernels();
+    size_ = size;
+    half_ = size / 2;
+
+    // 各级：长 length 的块做 radix-4，剩余长度为 2 时末级做 radix-2
+    stages_.clear();
+    twiddles_.clear();
+    std::vector<size_t> radices;
+    size_t length = half_;
+    while (length >= 4) {
+        size_t quarter = length / 4;
+        Stage stage = { quarter, twiddles_.size() };
+        stages_.push_back(stage);
+        radices.push_back(4);
+
+        twiddles_.resize(twiddles_.size() + 6 * quarter);
+        float* w = twiddles_.data() + stage.twiddle_offset;
+        for (size_t j = 0; j < quarter; j++) {
+            for (int m = 1; m <= 3; m++) {
+                double angle = -2.0 * PI * static_cast<double>(m * j) / static_cast<double>(length);
+                w[(2 * m - 2) * quarter + j] = static_cast<float>(std::cos(angle));
+                w[(2 * m - 1) * quarter + j] = static_cast<float>(std::sin(angle));
+            }
+        }
+        length = quarter;
+    }
+    if (length == 2) {
+        Stage stage = { 0, 0 };
+        stages_.push_back(stage);
+        radices.push_back(2);
+    }
+
+    // 按频率抽取的输出顺序：位置的各级数位（从高到低）依次是频率的各级数位（从低到高）
+    order_.assign(half_, 0);
+    for (size_t position = 0; position < half_; position++) {
+        size_t remaining = position;
+        size_t weight = half_;
+        size_t frequency = 0;
+        size_t scale = 1;
+        for (size_t radix : radices) {
+            weight /= radix;
+            frequency += (remaining / weight) * scale;
+            remaining %= weight;
+            scale *= radix;
+        }
+        order_[frequency] = position;
+    }
+
+    split_cos_.resize(half_);
+    split_sin_.resize(half_);
+    for (size_t k = 0; k < half_; k++) {
+        double angle = 2.0 * PI * static_cast<double>(k) / static_cast<double>(size_);
+        split_cos_[k] = static_cast<float>(std::cos(angle));
+        split_sin_[k] = static_cast<float>(std::sin(angle));
+    }
+
+    scratch_.resize(size_);
+}
+
+void FlacRealFft::Power(const float* in, float* out_power) {
+    // 偶数位采样作为实部、奇数位作为虚部
+    float* re = scratch_.data();
+    float* im = scratch_.data() + half_;
+    kernels_->deinterleave_f32(in, half_, 2, scratch_.data(), half_);
+
+    for (const Stage& stage : stages_) {
+        if (stage.quarter > 0) {
+            kernels_->radix4_f32(re, im, half_, stage.quarter, twiddles_.data() + stage.twiddle_offset);
+        } else {
+            for (size_t i = 0; i < half_; i += 2) {
+                float ar = re[i], ai = im[i];
+                re[i] = ar + re[i + 1];
+                im[i] = ai + im[i + 1];
+                re[i + 1] = ar - re[i + 1];
+                im[i + 1] = ai - im[i + 1];
+            }
+        }
+    }
+
+    // Z = FFT(z)，X[k] = E[k] + e^{-2πik/N}·O[k]，其中 E = (Z[k] + conj(Z[M-k])) / 2，O = (Z[k] - conj(Z[M-k])) / 2i
+    float z0r = re[order_[0]], z0i = im[order_[0]];
+    out_power[0] = (z0r + z0i) * (z0r + z0i);
+    out_power[half_] = (z0r - z0i) * (z0r - z0i);
+    for (size_t k = 1; k < half_; k++) {
+        size_t a = order_[k];
+        size_t b = order_[half_ - k];
+        float er = 0.5f * (re[a] + re[b]);
+        float ei = 0.5f * (im[a] - im[b]);
+        float or_ = 0.5f * (im[a] + im[b]);
+        float oi = -0.5f * (re[a] - re[b]);
+        // e^{-iθ} = cos θ - i sin θ
+        float xr = er + or_ * split_cos_[k] + oi * split_sin_[k];
+        float xi = ei + oi * split_cos_[k] - or_ * split_sin_[k];
+        out_power[k] = xr * xr + xi * xi;
+    }
+}
@@ -0,0 +1,40 @@
+#ifndef CHILL_FLAC_FFT_H
+#define CHILL_FLAC_FFT_H
+
+// 实数 FFT：size 点实数序列打包为 size / 2 点复数序列，经 radix-4（末级按需 radix-2）按频率抽取变换后
+// 拆分出实数序列的频谱。蝶形使用 FlacPcmKernels::radix4_f32，只输出功率谱。
+
+#include "flac_simd.h"
+
+#include <cstddef>
+#include <vector>
+
+class FlacRealFft {
+public:
+    // size 为 2 的幂（>= 8）；kernels 为 NULL 时使用当前 CPU 的最快实现
+    void Init(size_t size, const FlacPcmKernels* kernels = nullptr);
+
+    size_t Size() const { return size_; }
+
+    // in：size 个实数采样；out_power：size / 2 + 1 个 |X[k]|²（k = 0 ~ size / 2）
+    void Power(const float* in, float* out_power);
+
+private:
+    struct Stage {
+        size_t quarter;         // 0 表示末级 radix-2
+        size_t twiddle_offset;  // 在 twiddles_ 中的位置
+    };
+
+    const FlacPcmKernels* kernels_ = nullptr;
+    size_t size_ = 0;
+    size_t half_ = 0;                   // 复数 FFT 点数
+
+    std::vector<Stage> stages_;
+    std::vector<float> twiddles_;
+    std::vector<size_t> order_;         // 频率序号 → 变换后的位置（按数位倒序）
+    std::vector<float> split_cos_;      // 拆分实数频谱用的 cos / sin(2πk / size)
+    std::vector<float> split_sin_;
+    std::vector<float> scratch_;        // 实部 half_ 个 + 虚部 half_ 个
+};
+
+#endif // CHILL_FLAC_FFT_H
@@ -0,0 +1,176 @@
+#include "flac_format.h"
+
+#include <cstring>
+
+static uint32_t ReadBE24(const uint8_t* p) {
+    return (static_cast<uint32_t>(p[0]) << 16) | (static_cast<uint32_t>(p[1]) << 8) | p[2];
+}
+
+void FlacParseBlockHeader(const uint8_t* data, FlacBlockHeader* out) {
+    out->is_last = (data[0] & 0x80) != 0;
+    out->type = data[0] & 0x7F;
+    out->length = ReadBE24(data + 1);
+}
+
+bool FlacParseStreamInfo(const uint8_t* data, size_t size, FlacStreamInfo* out) {
+    if (size < 34) return false;
+
+    out->min_block_size = (static_cast<uint32_t>(data[0]) << 8) | data[1];
+    out->max_block_size = (static_cast<uint32_t>(data[2]) << 8) | data[3];
+    out->min_frame_size = ReadBE24(data + 4);
+    out->max_frame_size = ReadBE24(data + 7);
+
+    // 20 位采样率 | 3 位声道数-1 | 5 位位深-1 | 36 位总采样数
+    uint64_t packed = 0;
+    for (int i = 0; i < 8; i++) {
+        packed = (packed << 8) | data[10 + i];
+    }
+    out->sample_rate = static_cast<uint32_t>(packed >> 44);
+    out->channels = static_cast<uint32_t>((packed >> 41) & 0x07) + 1;
+    out->bits_per_sample = static_cast<uint32_t>((packed >> 36) & 0x1F) + 1;
+    out->total_pcm_frames = packed & 0xFFFFFFFFFULL;
+    memcpy(out->md5, data + 18, 16);
+
+    return out->sample_rate != 0 && out->max_block_size >= 16;
+}
+
+uint64_t FlacId3v2Size(const uint8_t* data, size_t size) {
+    if (size < 10 || data[0] != 'I' || data[1] != 'D' || data[2] != '3') return 0;
+
+    // 同步安全整数（每字节 7 位）
+    uint64_t tag_size = (static_cast<uint64_t>(data[6] & 0x7F) << 21) |
+                        (static_cast<uint64_t>(data[7] & 0x7F) << 14) |
+                        (static_cast<uint64_t>(data[8] & 0x7F) << 7) |
+                        static_cast<uint64_t>(data[9] & 0x7F);
+    bool has_footer = (data[5] & 0x10) != 0;
+    return 10 + tag_size + (has_footer ? 10 : 0);
+}
+
+namespace {
+struct Crc8Table {
+    uint8_t values[256];
+    Crc8Table() {
+        for (int i = 0; i < 256; i++) {
+            uint8_t crc = static_cast<uint8_t>(i);
+            for (int bit = 0; bit < 8; bit++) {
+                crc = static_cast<uint8_t>((crc & 0x80) ? (crc << 1) ^ 0x07 : (crc << 1));
+            }
+            values[i] = crc;
+        }
+    }
+};
+}
+
+uint8_t FlacCrc8(const uint8_t* data, size_t size) {
+    static const Crc8Table table;
+
+    uint8_t crc = 0;
+    for (size_t i = 0; i < size; i++) {
+        crc = table.values[crc ^ data[i]];
+    }
+    return crc;
+}
+
+int FlacParseFrameHeader(const uint8_t* data, size_t size, const FlacStreamInfo& info, FlacFrameHeader* out) {
+    if (size < 4) return FLAC_FRAME_HEADER_NEED_MORE;
+
+    // 14 位同步码 + 1 位保留（必须为 0）
+    if (data[0] != 0xFF || (data[1] & 0xFE) != 0xF8) return FLAC_FRAME_HEADER_INVALID;
+    bool variable = (data[1] & 0x01) != 0;
+
+    int block_size_code = data[2] >> 4;
+    int sample_rate_code = data[2] & 0x0F;
+    int channel_code = data[3] >> 4;
+    int sample_size_code = (data[3] >> 1) & 0x07;
+
+    if (block_size_code == 0 || sample_rate_code == 15 || (data[3] & 0x01) != 0) {
+        return FLAC_FRAME_HEADER_INVALID;
+    }
+
+    // 声道必须与 STREAMINFO 一致
+    uint32_t channels;
+    if (channel_code < 8) {
+        channels = static_cast<uint32_t>(channel_code) + 1;
+    } else if (channel_code <= 10) {
+        channels = 2;
+    } else {
+        return FLAC_FRAME_HEADER_INVALID;
+    }
+    if (channels != info.channels) return FLAC_FRAME_HEADER_INVALID;
+
+    static const uint32_t SAMPLE_SIZES[8] = {0, 8, 12, 0, 16, 20, 24, 32};
+    if (sample_size_code == 3) return FLAC_FRAME_HEADER_INVALID;
+    if (sample_size_code != 0 && SAMPLE_SIZES[sample_size_code] != info.bits_per_sample) {
+        return FLAC_FRAME_HEADER_INVALID;
+    }
+
+    // UTF-8 编码的帧号（固定块大小）或采样号（可变块大小）
+    size_t pos = 4;
+    if (size <= pos) return FLAC_FRAME_HEADER_NEED_MORE;
+    uint8_t lead = data[pos];
+    int extra;
+    uint64_t number;
+    if ((lead & 0x80) == 0) { number = lead; extra = 0; }
+    else if ((lead & 0xE0) == 0xC0) { number = lead & 0x1F; extra = 1; }
+    else if ((lead & 0xF0) == 0xE0) { number = lead & 0x0F; extra = 2; }
+    else if ((lead & 0xF8) == 0xF0) { number = lead & 0x07; extra = 3; }
+    else if ((lead & 0xFC) == 0xF8) { number = lead & 0x03; extra = 4; }
+    else if ((lead & 0xFE) == 0xFC) { number = lead & 0x01; extra = 5; }
+    else if (lead == 0xFE && variable) { number = 0; extra = 6; }
+    else return FLAC_FRAME_HEADER_INVALID;
+    pos++;
+
+    if (size < pos + extra) return FLAC_FRAME_HEADER_NEED_MORE;
+    for (int i = 0; i < extra; i++) {
+        uint8_t b = data[pos++];
+        if ((b & 0xC0) != 0x80) return FLAC_FRAME_HEADER_INVALID;
+        number = (number << 6) | (b & 0x3F);
+    }
+
+    // 块大小
+    uint32_t block_size;
+    if (block_size_code == 1) {
+        block_size = 192;
+    } else if (block_size_code <= 5) {
+        block_size = 576u << (block_size_code - 2);
+    } else if (block_size_code == 6) {
+        if (size < pos + 1) return FLAC_FRAME_HEADER_NEED_MORE;
+        block_size = static_cast<uint32_t>(data[pos]) + 1;
+        pos += 1;
+    } else if (block_size_code == 7) {
+        if (size < pos + 2) return FLAC_FRAME_HEADER_NEED_MORE;
+        block_size = ((static_cast<uint32_t>(data[pos]) << 8) | data[pos + 1]) + 1;
+        pos += 2;
+    } else {
+        block_size = 256u << (block_size_code - 8);
+    }
+    if (block_size > info.max_block_size) return FLAC_FRAME_HEADER_INVALID;
+
+    // 采样率
+    static const uint32_t SAMPLE_RATES[12] = {0, 88200, 176400, 192000, 8000, 16000, 22050, 24000, 32000, 44100, 48000, 96000};
+    uint32_t sample_rate;
+    if (sample_rate_code < 12) {
+        sample_rate = SAMPLE_RATES[sample_rate_code];
+    } else if (sample_rate_code == 12) {
+        if (size < pos + 1) return FLAC_FRAME_HEADER_NEED_MORE;
+        sample_rate = static_cast<uint32_t>(data[pos]) * 1000;
+        pos += 1;
+    } else {
+        if (size < pos + 2) return FLAC_FRAME_HEADER_NEED_MORE;
+        sample_rate = (static_cast<uint32_t>(data[pos]) << 8) | data[pos + 1];
+        if (sample_rate_code == 14) sample_rate *= 10;
+        pos += 2;
+    }
+    if (sample_rate != 0 && sample_rate != info.sample_rate) return FLAC_FRAME_HEADER_INVALID;
+
+    if (size < pos + 1) return FLAC_FRAME_HEADER_NEED_MORE;
+    if (FlacCrc8(data, pos) != data[pos]) return FLAC_FRAME_HEADER_INVALID;
+    pos += 1;
+
+    out->variable_block_size = variable;
+    out->block_size = block_size;
+    out->header_bytes = static_cast<uint32_t>(pos);
+    // 固定块大小流中帧号乘以块大小即为采样位置（只有最后一帧可能更短）
+    out->pcm_frame = variable ? number : number * info.max_block_size;
+    return FLAC_FRAME_HEADER_OK;
+}
@@ -0,0 +1,73 @@
+#ifndef CHILL_FLAC_FORMAT_H
+#define CHILL_FLAC_FORMAT_H
+
+// FLAC 原生容器的位级格式解析（不依赖 dr_flac，不解码音频）
+
+#include <cstddef>
+#include <cstdint>
+
+// 元数据块类型
+enum FlacMetadataType {
+    FLAC_METADATA_STREAMINFO = 0,
+    FLAC_METADATA_PADDING = 1,
+    FLAC_METADATA_APPLICATION = 2,
+    FLAC_METADATA_SEEKTABLE = 3,
+    FLAC_METADATA_VORBIS_COMMENT = 4,
+    FLAC_METADATA_CUESHEET = 5,
+    FLAC_METADATA_PICTURE = 6,
+};
+
+// 元数据块头（4 字节）
+struct FlacBlockHeader {
+    bool is_last;
+    int type;
+    uint32_t length;
+};
+
+// STREAMINFO 块内容
+struct FlacStreamInfo {
+    uint32_t min_block_size;
+    uint32_t max_block_size;
+    uint32_t min_frame_size;
+    uint32_t max_frame_size;
+    uint32_t sample_rate;
+    uint32_t channels;
+    uint32_t bits_per_sample;
+    uint64_t total_pcm_frames;   // 0 表示未知
+    uint8_t md5[16];
+};
+
+// 音频帧头
+struct FlacFrameHeader {
+    bool variable_block_size;
+    uint64_t pcm_frame;          // 本帧第一个采样的 PCM 帧索引
+    uint32_t block_size;         // 本帧包含的 PCM 帧数
+    uint32_t header_bytes;       // 帧头长度（含 CRC-8）
+};
+
+// 帧头最大长度（同步码 + 7 字节 UTF-8 + 2 字节块大小 + 2 字节采样率 + CRC-8）
+static const size_t FLAC_MAX_FRAME_HEADER_BYTES = 16;
+
+// 解析 4 字节的元数据块头
+void FlacParseBlockHeader(const uint8_t* data, FlacBlockHeader* out);
+
+// 解析 34 字节的 STREAMINFO 块内容
+bool FlacParseStreamInfo(const uint8_t* data, size_t size, FlacStreamInfo* out);
+
+// 若 data 以 ID3v2 标签开头，返回标签总长度（需要至少 10 字节），否则返回 0
+uint64_t FlacId3v2Size(const uint8_t* data, size_t size);
+
+// 帧头解析结果
+enum FlacFrameHeaderResult {
+    FLAC_FRAME_HEADER_OK = 0,
+    FLAC_FRAME_HEADER_INVALID = -1,     // 不是合法帧头（误同步）
+    FLAC_FRAME_HEADER_NEED_MORE = -2,   // 数据不足，无法判断
+};
+
+// 在 data 处解析帧头并用 STREAMINFO 校验（声道、位深、采样率、CRC-8）
+int FlacParseFrameHeader(const uint8_t* data, size_t size, const FlacStreamInfo& info, FlacFrameHeader* out);
+
+// CRC-8（多项式 0x07），用于帧头校验
+uint8_t FlacCrc8(const uint8_t* data, size_t size);
+
+#endif // CHILL_FLAC_FORMAT_H
@@ -0,0 +1,98 @@
+#include "flac_frame_index.h"
+
+bool FlacReadStreamLayout(FlacByteSource* source, FlacStreamInfo* out_info, uint64_t* out_first_frame_offset) {
+    if (!source->Seek(0, SEEK_SET)) return false;
+
+    uint8_t header[10];
+    if (source->Read(header, 10) != 10) return false;
+
+    // 跳过 ID3v2 标签
+    uint64_t offset = FlacId3v2Size(header, sizeof(header));
+    if (offset > 0) {
+        if (!source->Seek(static_cast<int64_t>(offset), SEEK_SET)) return false;
+        if (source->Read(header, 4) != 4) return false;
+    }
+
+    if (header[0] != 'f' || header[1] != 'L' || header[2] != 'a' || header[3] != 'C') return false;
+    offset += 4;
+    if (!source->Seek(static_cast<int64_t>(offset), SEEK_SET)) return false;
+
+    bool have_stream_info = false;
+    for (;;) {
+        uint8_t raw[4];
+        if (source->Read(raw, 4) != 4) return false;
+        offset += 4;
+
+        FlacBlockHeader block;
+        FlacParseBlockHeader(raw, &block);
+
+        if (block.type == FLAC_METADATA_STREAMINFO) {
+            uint8_t body[34];
+            if (block.length < sizeof(body) || source->Read(body, sizeof(body)) != sizeof(body)) return false;
+            if (!FlacParseStreamInfo(body, sizeof(body), out_info)) return false;
+            have_stream_info = true;
+        }
+
+        offset += block.length;
+        if (!source->Seek(static_cast<int64_t>(offset), SEEK_SET)) return false;
+
+        if (block.is_last) break;
+    }
+
+    *out_first_frame_offset = offset;
+    return have_stream_info;
+}
+
+void FlacFrameIndex::Reset(const FlacStreamInfo& info, uint64_t first_frame_offset) {
+    info_ = info;
+    first_frame_offset_ = first_frame_offset;
+    scan_offset_ = first_frame_offset;
+    decodable_frames_ = 0;
+    complete_ = false;
+    entries_.clear();
+}
+
+size_t FlacFrameIndex::Scan(const uint8_t* data, size_t size, bool at_end) {
+    if (complete_) return size;
+
+    size_t i = 0;
+    while (i < size) {
+        if (data[i] != 0xFF) {
+            i++;
+            continue;
+        }
+        if (i + 1 >= size && !at_end) break;
+
+        FlacFrameHeader header;
+        int result = FlacParseFrameHeader(data + i, size - i, info_, &header);
+        if (result == FLAC_FRAME_HEADER_NEED_MORE && !at_end) break;
+
+        // 只接受帧号与上一帧连续的帧头，排除音频数据中的误同步
+        uint64_t expected = entries_.empty() ? 0 : entries_.back().pcm_frame + entries_.back().block_size;
+        if (result == FLAC_FRAME_HEADER_OK && header.pcm_frame == expected) {
+            FlacFrameEntry entry;
+            entry.pcm_frame = header.pcm_frame;
+            entry.byte_offset = scan_offset_ + i;
+            entry.block_size = header.block_size;
+            entries_.push_back(entry);
+
+            // 找到下一帧的帧头意味着之前的帧都已完整
+            decodable_frames_ = header.pcm_frame;
+            i += header.header_bytes;
+            continue;
+        }
+
+        i++;
+    }
+
+    scan_offset_ += i;
+
+    if (at_end && i >= size) {
+        if (!entries_.empty()) {
+            decodable_frames_ = entries_.back().pcm_frame + entries_.back().block_size;
+        }
+        complete_ = true;
+    }
+
+    return i;
+}
@@ -0,0 +1,52 @@
+#ifndef CHILL_FLAC_FRAME_INDEX_H
+#define CHILL_FLAC_FRAME_INDEX_H
+
+// 音频帧索引：通过扫描帧头（同步码 + CRC-8 + 连续的帧号）定位每一帧的字节偏移，
+// 不需要解码音频数据。
+
+#include "flac_format.h"
+#include "flac_io.h"
+
+#include <cstdint>
+#include <vector>
+
+struct FlacFrameEntry {
+    uint64_t pcm_frame;      // 帧内第一个采样的 PCM 帧索引
+    uint64_t byte_offset;    // 帧头的绝对字节偏移
+    uint32_t block_size;     // 帧包含的 PCM 帧数
+};
+
+// 读取 "fLaC" 标记和元数据块，返回 STREAMINFO 及第一个音频帧的绝对偏移
+// 源中数据不足（如文件仍在下载）时返回 false
+bool FlacReadStreamLayout(FlacByteSource* source, FlacStreamInfo* out_info, uint64_t* out_first_frame_offset);
+
+class FlacFrameIndex {
+public:
+    void Reset(const FlacStreamInfo& info, uint64_t first_frame_offset);
+
+    // 增量扫描。data 必须从 NextScanOffset() 开始；at_end 表示文件已经完整。
+    // 返回已处理的字节数，剩余部分需要在下次调用时与新数据一起重新传入。
+    size_t Scan(const uint8_t* data, size_t size, bool at_end);
+
+    uint64_t NextScanOffset() const { return scan_offset_; }
+
+    // 已确认完整的帧所覆盖的 PCM 帧数（即可安全解码的上限，不含）
+    uint64_t DecodableFrames() const { return decodable_frames_; }
+
+    // 文件末尾已扫描完成
+    bool IsComplete() const { return complete_; }
+
+    uint64_t FirstFrameOffset() const { return first_frame_offset_; }
+    const FlacStreamInfo& StreamInfo() const { return info_; }
+    const std::vector<FlacFrameEntry>& Entries() const { return entries_; }
+
+private:
+    FlacStreamInfo info_ = {};
+    uint64_t first_frame_offset_ = 0;
+    uint64_t scan_offset_ = 0;
+    uint64_t decodable_frames_ = 0;
+    bool complete_ = false;
+    std::vector<FlacFrameEntry> entries_;
+};
+
+#endif // CHILL_FLAC_FRAME_INDEX_H
@@ -0,0 +1,199 @@
+#include "flac_image.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FLAC_IMAGE_SSE2 1
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64) || defined(__ARM_NEON)
+#define FLAC_IMAGE_NEON 1
+#include <arm_neon.h>
+#endif
+
+static const double PI = 3.14159265358979323846;
+static const int LANCZOS_RADIUS = 3;
+
+// 一个维度上的滤波系数：输出 i 由输入 [first[i], first[i] + count[i]) 加权求和，
+// 系数从 weights[i * max_taps] 开始
+struct ResampleTaps {
+    std::vector<int> first;
+    std::vector<int> count;
+    std::vector<float> weights;
+    int max_taps = 0;
+};
+
+static double Lanczos3(double x) {
+    x = std::fabs(x);
+    if (x < 1e-9) return 1.0;
+    if (x >= LANCZOS_RADIUS) return 0.0;
+    double px = PI * x;
+    return LANCZOS_RADIUS * std::sin(px) * std::sin(px / LANCZOS_RADIUS) / (px * px);
+}
+
+static void BuildTaps(int src, int dst, ResampleTaps* taps) {
+    double scale = static_cast<double>(src) / dst;
+    bool area = src > dst;
+    taps->max_taps = area ? static_cast<int>(std::ceil(scale)) + 1 : LANCZOS_RADIUS * 2;
+    taps->first.assign(dst, 0);
+    taps->count.assign(dst, 0);
+    taps->weights.assign(static_cast<size_t>(dst) * taps->max_taps, 0.0f);
+
+    std::vector<double> w(taps->max_taps);
+    for (int i = 0; i < dst; i++) {
+        int lo, hi;   // 输入范围 [lo, hi]
+        std::fill(w.begin(), w.end(), 0.0);
+        if (area) {
+            // 输出像素覆盖输入区间 [i * scale, (i + 1) * scale)，权重为每个输入像素被覆盖的长度
+            double begin = i * scale;
+            double end = begin + scale;
+            lo = static_cast<int>(begin);
+            hi = std::min(src - 1, static_cast<int>(std::ceil(end)) - 1);
+            for (int s = lo; s <= hi; s++) {
+                w[s - lo] = std::min(end, s + 1.0) - std::max(begin, static_cast<double>(s));
+            }
+        } else {
+            // 超出边缘的抽头并入边缘像素
+            double center = (i + 0.5) * scale - 0.5;
+            int base = static_cast<int>(std::floor(center));
+            lo = std::max(0, base - LANCZOS_RADIUS + 1);
+            hi = std::min(src - 1, base + LANCZOS_RADIUS);
+            for (int s = base - LANCZOS_RADIUS + 1; s <= base + LANCZOS_RADIUS; s++) {
+                int clamped = std::min(hi, std::max(lo, s));
+                w[clamped - lo] += Lanczos3(center - s);
+            }
+        }
+
+        double sum = 0.0;
+        for (int k = 0; k <= hi - lo; k++) sum += w[k];
+        float* dst_weights = taps->weights.data() + static_cast<size_t>(i) * taps->max_taps;
+        for (int k = 0; k <= hi - lo; k++) {
+            dst_weights[k] = static_cast<float>(w[k] / sum);
+        }
+        taps->first[i] = lo;
+        taps->count[i] = hi - lo + 1;
+    }
+}
+
+// out4 = Σ weights[k] * pixels[k]（每个像素 4 个 float）
+static inline void AccumulatePixels(const float* pixels, const float* weights, int count, float* out4) {
+#if defined(FLAC_IMAGE_SSE2)
+    __m128 acc = _mm_setzero_ps();
+    for (int k = 0; k < count; k++) {
+        acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(pixels + k * 4), _mm_set1_ps(weights[k])));
+    }
+    _mm_storeu_ps(out4, acc);
+#elif defined(FLAC_IMAGE_NEON)
+    float32x4_t acc = vdupq_n_f32(0.0f);
+    for (int k = 0; k < count; k++) {
+        acc = vmlaq_n_f32(acc, vld1q_f32(pixels + k * 4), weights[k]);
+    }
+    vst1q_f32(out4, acc);
+#else
+    float acc[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    for (int k = 0; k < count; k++) {
+        for (int c = 0; c < 4; c++) acc[c] += pixels[k * 4 + c] * weights[k];
+    }
+    for (int c = 0; c < 4; c++) out4[c] = acc[c];
+#endif
+}
+
+// acc[i] += weight * row[i]
+static inline void AccumulateRow(float* acc, const float* row, float weight, size_t count) {
+    size_t i = 0;
+#if defined(FLAC_IMAGE_SSE2)
+    const __m128 w = _mm_set1_ps(weight);
+    for (; i + 8 <= count; i += 8) {
+        _mm_storeu_ps(acc + i, _mm_add_ps(_mm_loadu_ps(acc + i), _mm_mul_ps(_mm_loadu_ps(row + i), w)));
+        _mm_storeu_ps(acc + i + 4, _mm_add_ps(_mm_loadu_ps(acc + i + 4), _mm_mul_ps(_mm_loadu_ps(row + i + 4), w)));
+    }
+#elif defined(FLAC_IMAGE_NEON)
+    for (; i + 8 <= count; i += 8) {
+        vst1q_f32(acc + i, vmlaq_n_f32(vld1q_f32(acc + i), vld1q_f32(row + i), weight));
+        vst1q_f32(acc + i + 4, vmlaq_n_f32(vld1q_f32(acc + i + 4), vld1q_f32(row + i + 4), weight));
+    }
+#endif
+    for (; i < count; i++) acc[i] += row[i] * weight;
+}
+
+static inline uint8_t ToByte(float value) {
+    return static_cast<uint8_t>(std::min(255.0f, std::max(0.0f, value + 0.5f)));
+}
+
+bool FlacResizeRgba(const uint8_t* src, int width, int height, size_t stride, bool top_down, int size, uint8_t* dst) {
+    if (!src || !dst || width <= 0 || height <= 0 || size <= 0) return false;
+
+    ResampleTaps horizontal, vertical;
+    std::vector<float> row;         // 当前输入行（预乘 alpha 的 float）
+    std::vector<float> columns;     // 横向缩放后的所有输入行：height × size × 4
+    std::vector<float> acc;
+    const size_t out_floats = static_cast<size_t>(size) * 4;
+    // 中间结果上限 1GB（防止损坏的图片尺寸导致巨量分配）
+    if (static_cast<uint64_t>(height) * out_floats * sizeof(float) > (static_cast<uint64_t>(1) << 30)) return false;
+
+    BuildTaps(width, size, &horizontal);
+    BuildTaps(height, size, &vertical);
+    row.resize(static_cast<size_t>(width) * 4);
+    columns.resize(static_cast<size_t>(height) * out_floats);
+    acc.resize(out_floats);
+
+    // 第一遍：每一行横向缩放到 size 列
+    for (int y = 0; y < height; y++) {
+        const uint8_t* p = src + static_cast<size_t>(y) * stride;
+        for (int x = 0; x < width; x++) {
+            float a = p[x * 4 + 3];
+            float k = a / 255.0f;
+            row[x * 4 + 0] = p[x * 4 + 0] * k;
+            row[x * 4 + 1] = p[x * 4 + 1] * k;
+            row[x * 4 + 2] = p[x * 4 + 2] * k;
+            row[x * 4 + 3] = a;
+        }
+        float* out = columns.data() + static_cast<size_t>(y) * out_floats;
+        for (int x = 0; x < size; x++) {
+            AccumulatePixels(row.data() + horizontal.first[x] * 4,
+                             horizontal.weights.data() + static_cast<size_t>(x) * horizontal.max_taps,
+                             horizontal.count[x], out + x * 4);
+        }
+    }
+
+    // 第二遍：纵向缩放并还原为非预乘的 RGBA8
+    for (int y = 0; y < size; y++) {
+        std::fill(acc.begin(), acc.end(), 0.0f);
+        const float* weights = vertical.weights.data() + static_cast<size_t>(y) * vertical.max_taps;
+        for (int k = 0; k < vertical.count[y]; k++) {
+            AccumulateRow(acc.data(), columns.data() + static_cast<size_t>(vertical.first[y] + k) * out_floats,
+                          weights[k], out_floats);
+        }
+
+        int out_row = top_down ? size - 1 - y : y;
+        uint8_t* out = dst + static_cast<size_t>(out_row) * size * 4;
+        for (int x = 0; x < size; x++) {
+            const float* px = acc.data() + x * 4;
+            float a = std::min(255.0f, std::max(0.0f, px[3]));
+            float k = a > 0.0f ? 255.0f / a : 0.0f;
+            out[x * 4 + 0] = ToByte(px[0] * k);
+            out[x * 4 + 1] = ToByte(px[1] * k);
+            out[x * 4 + 2] = ToByte(px[2] * k);
+            out[x * 4 + 3] = ToByte(a);
+        }
+    }
+    return true;
+}
+
+void FlacApplyCircleMask(uint8_t* rgba, int size) {
+    float radius = size / 2.0f;
+    for (int y = 0; y < size; y++) {
+        float dy = y + 0.5f - radius;
+        for (int x = 0; x < size; x++) {
+            float dx = x + 0.5f - radius;
+            float distance = std::sqrt(dx * dx + dy * dy);
+            uint8_t* px = rgba + (static_cast<size_t>(y) * size + x) * 4;
+            if (distance > radius) {
+                px[0] = px[1] = px[2] = px[3] = 0;
+            } else if (distance > radius - 1.0f) {
+                px[3] = ToByte(px[3] * (radius - distance));
+            }
+        }
+    }
+}
@@ -0,0 +1,19 @@
+#ifndef CHILL_FLAC_IMAGE_H
+#define CHILL_FLAC_IMAGE_H
+
+// 封面缩略图的像素处理：RGBA8 缩放（缩小用面积平均，放大用 Lanczos3，分离式两遍滤波）和圆形遮罩。
+// 输出行序与 Unity 纹理一致（第 0 行为最下面一行），可直接用于 Texture2D.LoadRawTextureData。
+
+#include <cstddef>
+#include <cstdint>
+
+// 把 width×height 的 RGBA8 图像缩放为 size×size（长宽比不同时拉伸，与托管实现一致）。
+// 滤波在预乘 alpha 的浮点域中进行。top_down 为 true 表示 src 第 0 行是最上面一行（解码器输出），
+// 为 false 表示已是 Unity 行序（Texture2D.GetPixels32）。dst 需有 size * size * 4 字节。
+// 内存不足时返回 false
+bool FlacResizeRgba(const uint8_t* src, int width, int height, size_t stride, bool top_down, int size, uint8_t* dst);
+
+// 对 size×size 的 RGBA8 图像应用圆形遮罩：圆外透明，边缘 1 像素内按距离线性衰减 alpha
+void FlacApplyCircleMask(uint8_t* rgba, int size);
+
+#endif // CHILL_FLAC_IMAGE_H
@@ -0,0 +1,173 @@
+#ifndef CHILL_FLAC_INTERNAL_H
+#define CHILL_FLAC_INTERNAL_H
+
+// 库内部共享的声明（不导出）
+
+#ifndef BUILDING_DLL
+#define BUILDING_DLL  // 定义为导出模式
+#endif
+#include "dr_flac.h"
+#include "flac_decoder.h"
+
+#include "flac_analysis.h"
+#include "flac_downmix.h"
+#include "flac_frame_index.h"
+#include "flac_io.h"
+#include "flac_memory.h"
+#include "flac_pcm.h"
+#include "flac_resampler.h"
+#include "flac_seek_index.h"
+#include "flac_simd.h"
+#include "spsc_ring.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct FlacStream;
+
+// 设置当前线程的错误消息（FlacGetLastError 读取）
+void FlacSetLastError(const char* message);
+
+#ifndef _WIN32
+// 非 Windows 平台：wchar_t 为 UTF-32，转换为 UTF-8 路径（POSIX 文件 API 使用）
+std::string FlacWideToUtf8(const wchar_t* path);
+#endif
+
+// 检查流打开选项（NULL 视为有效），无效时设置错误消息并返回 false
+bool FlacValidateStreamOptions(const FlacStreamOptions* options);
+
+// 读取方在 ReadFlacFrames 读取不足之后调用：流中可解码的数据是否已全部读出
+// （区分到达末尾与预解码欠载 / seek 尚未落地 / 边写边读等待写入），不加锁
+bool FlacStreamDrained(FlacStream* stream);
+
+// 边写边读模式的状态（OpenFlacGrowingStream / CreateFlacPushStream）
+struct FlacGrowingState {
+    FlacGrowingSource* decode_source = nullptr;     // 解码器使用的字节源（由 FlacStream::source 持有）
+    std::unique_ptr<FlacGrowingSource> scan_source; // 独立的读取游标，用于扫描帧头
+
+    // 以下成员由 mutex 保护（写入线程更新，seek 时读取）
+    std::mutex mutex;
+    FlacFrameIndex index;
+    std::vector<uint8_t> pending;               // 尚未扫描完的尾部字节
+    std::vector<drflac_seekpoint> seekpoints;   // 由帧索引生成，安装到 drflac 上
+
+    // 已确认完整的帧覆盖的 PCM 帧数（解码不会越过此位置）
+    std::atomic<uint64_t> decodable_frames{0};
+    std::atomic<bool> complete{false};
+};
+
+// 后台 seek 索引（文件没有 SEEKTABLE 时由 OpenFlacStream* 创建）
+struct FlacSeekIndexState {
+    std::wstring file_path;
+    FlacFileIdentity identity = {};
+    bool has_identity = false;
+
+    std::thread builder;
+    std::atomic<bool> cancel{false};
+
+    // ready 以 release 发布后 points 不再修改，解码方可直接安装到 drflac
+    std::vector<drflac_seekpoint> points;
+    std::atomic<bool> ready{false};
+
+    // 已安装到 drflac（只由解码方访问）
+    bool installed = false;
+};
+
+// 流句柄（OpenFlacStream* / CreateFlacPushStream 返回的 void*）
+struct FlacStream {
+    // drflac 实例的分配来源（需比 flac 活得更久，关闭流时整块归还块池）
+    FlacArena arena;
+    drflac* flac = nullptr;
+    int sample_rate = 0;            // 输出采样率（重采样时为目标采样率）
+    int channels = 0;               // 输出声道数（缩混时为目标声道数）
+    uint64_t total_pcm_frames = 0;  // 输出采样率下的总帧数
+
+    // 解码器已打开（推送流在收到完整元数据后才打开解码器）
+    std::atomic<bool> decoder_ready{false};
+    FlacStreamOptions options = {};
+
+    // 推送流的数据缓冲区（需比读取它的字节源活得更久，所以声明在前）
+    std::unique_ptr<PushBuffer> push_buffer;
+
+    // 解码器当前位置（只由解码方访问：同步模式下为调用线程，预解码模式下为工作线程）
+    // next_frame 为源采样率下 drflac 的位置，out_frame 为输出采样率下的位置（未重采样时二者相同）
+    uint64_t next_frame = 0;
+    uint64_t out_frame = 0;
+
+    // 缩混（options.output_channels 少于源声道数时启用，只由解码方访问）
+    std::unique_ptr<FlacDownmixer> downmixer;
+    std::vector<float> downmix_scratch;     // 源声道数的 f32 解码中转区
+
+    // 重采样（options.output_sample_rate 与源采样率不同时启用，只由解码方访问）
+    std::unique_ptr<FlacResampler> resampler;
+
+    // 输出 s16 且经过缩混 / 重采样 / 增益时的 f32 中转区
+    std::vector<float> process_scratch;
+
+    // 输出增益（线性）与软限幅，任意线程写入，解码方每块读取一次
+    std::atomic<float> gain{1.0f};
+    std::atomic<bool> limiter{false};
+
+    // 按 options.sample_format 解码为存储格式（只由解码方访问）
+    FlacPcmDecoder pcm;
+
+    // 平面格式的解交错中转区（只由读取方访问）
+    std::vector<float> planar_scratch;
+
+    // drflac 读取的字节源（本地文件 / 边写边读 / 回调，需在 drflac_close 之后释放）
+    std::unique_ptr<FlacByteSource> source;
+
+    // 边写边读模式
+    std::unique_ptr<FlacGrowingState> growing;
+
+    // 持久化 seek 索引
+    std::unique_ptr<FlacSeekIndexState> seek_index;
+
+    // 注册的输出缓冲区（只由读取方访问）：调用者提供的内存，或 owned_output 持有的 Native 内存
+    // 布局与 options.sample_format 一致，平面格式每个声道平面长 output_frames 帧
+    void* output = nullptr;
+    uint64_t output_frames = 0;
+    std::unique_ptr<uint8_t[]> owned_output;
+
+    // ========== 预解码（decode_ahead_ms > 0 时启用） ==========
+    std::unique_ptr<SpscRing> ring;
+    std::thread worker;
+    std::mutex wake_mutex;
+    std::condition_variable wake_cv;
+    std::atomic<bool> stop{false};
+    int wake_interval_ms = 0;
+
+    // Seek 落地：工作线程完成 seek 后发布新数据在环中的起点及其 PCM 帧位置
+    std::atomic<uint64_t> flush_pos{0};
+    std::atomic<uint64_t> flush_frame{0};
+    std::atomic<uint32_t> flush_serial{0};
+
+    // 工作线程已解码到末尾的 serial（EOF 只对该 serial 的数据有效）
+    std::atomic<uint32_t> eof_serial{UINT32_MAX};
+
+    // ========== Seek 信箱（两种模式共用） ==========
+    // 请求方（主线程）写 target 后以 release 递增 serial，不加锁、不等待；
+    // 解码方在下一个读取边界取最新的请求执行，中间被覆盖的请求直接丢弃。
+    std::atomic<uint64_t> seek_target{0};
+    std::atomic<uint32_t> seek_serial{0};
+
+    // 读取方（ReadFlacFrames 的调用线程）已落地的 serial 及当前读取位置
+    std::atomic<uint32_t> read_serial{0};
+    std::atomic<uint64_t> read_position{0};
+
+    // 执行失败的 seek 的 serial（之后读取返回 0，直到下一次 seek）
+    std::atomic<uint32_t> failed_serial{UINT32_MAX};
+
+    // ========== 频谱分析旁路（EnableFlacAnalysis，只用于预解码模式） ==========
+    // analyzer 持有分析器，analysis_tap 以 release 发布给预解码线程
+    std::unique_ptr<FlacAnalyzer> analyzer;
+    std::atomic<FlacAnalyzer*> analysis_tap{nullptr};
+};
+
+#endif // CHILL_FLAC_INTERNAL_H
@@ -0,0 +1,623 @@
+#include "flac_io.h"
+#include "flac_async_io.h"
+#include "flac_internal.h"
+
+#include <algorithm>
+#include <cstring>
+#include <cwchar>
+#include <string>
+#include <vector>
+
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <share.h>
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/vfs.h>
+#elif defined(__APPLE__)
+#include <sys/mount.h>
+#include <sys/param.h>
+#endif
+#endif
+
+// 内存映射：顺序读取时保持游标前方至少半个预读窗口已提示
+static const uint64_t MAP_READAHEAD_BYTES = 1024 * 1024;
+
+// 跳转后在目标处预读的窗口：向前不超过它的 seek 视为顺序跳过，跳转后连续读完它恢复顺序模式
+static const uint64_t MAP_SEEK_WINDOW_BYTES = 64 * 1024;
+
+// 游标之后保留的已读页面（小幅回退不必重新缺页），每累积一步交还一次
+static const uint64_t MAP_KEEP_BEHIND_BYTES = 1024 * 1024;
+static const uint64_t MAP_RELEASE_STEP_BYTES = 4 * 1024 * 1024;
+
+#ifndef _WIN32
+std::string FlacWideToUtf8(const wchar_t* path) {
+    std::string utf8;
+    for (const wchar_t* p = path; *p; ++p) {
+        uint32_t c = static_cast<uint32_t>(*p);
+        if (c < 0x80) {
+            utf8 += static_cast<char>(c);
+        } else if (c < 0x800) {
+            utf8 += static_cast<char>(0xC0 | (c >> 6));
+            utf8 += static_cast<char>(0x80 | (c & 0x3F));
+        } else if (c < 0x10000) {
+            utf8 += static_cast<char>(0xE0 | (c >> 12));
+            utf8 += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+            utf8 += static_cast<char>(0x80 | (c & 0x3F));
+        } else {
+            utf8 += static_cast<char>(0xF0 | (c >> 18));
+            utf8 += static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+            utf8 += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+            utf8 += static_cast<char>(0x80 | (c & 0x3F));
+        }
+    }
+    return utf8;
+}
+#endif
+
+FILE* FlacOpenFileW(const wchar_t* path) {
+    if (!path) return nullptr;
+
+#ifdef _WIN32
+    return _wfsopen(path, L"rb", _SH_DENYNO);
+#else
+    return fopen(FlacWideToUtf8(path).c_str(), "rb");
+#endif
+}
+
+FILE* FlacCreateFileW(const wchar_t* path) {
+    if (!path) return nullptr;
+
+#ifdef _WIN32
+    return _wfsopen(path, L"wb", _SH_DENYWR);
+#else
+    return fopen(FlacWideToUtf8(path).c_str(), "wb");
+#endif
+}
+
+FILE* FlacOpenFileForUpdateW(const wchar_t* path) {
+    if (!path) return nullptr;
+
+#ifdef _WIN32
+    FILE* file = _wfsopen(path, L"r+b", _SH_DENYWR);
+    return file ? file : _wfsopen(path, L"w+b", _SH_DENYWR);
+#else
+    std::string utf8 = FlacWideToUtf8(path);
+    FILE* file = fopen(utf8.c_str(), "r+b");
+    return file ? file : fopen(utf8.c_str(), "w+b");
+#endif
+}
+
+bool FlacReplaceFileW(const wchar_t* from, const wchar_t* to) {
+#ifdef _WIN32
+    // _wrename 不会覆盖已存在的文件；先删除再重命名在并发写入时会互相打断
+    return MoveFileExW(from, to, MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    return rename(FlacWideToUtf8(from).c_str(), FlacWideToUtf8(to).c_str()) == 0;
+#endif
+}
+
+static void RemoveFileW(const wchar_t* path) {
+#ifdef _WIN32
+    _wremove(path);
+#else
+    remove(FlacWideToUtf8(path).c_str());
+#endif
+}
+
+bool FlacWriteFileAtomicW(const wchar_t* path, const void* data, size_t bytes) {
+    if (!path) return false;
+
+    static std::atomic<uint32_t> s_temp_serial(0);
+#ifdef _WIN32
+    unsigned long pid = GetCurrentProcessId();
+#else
+    unsigned long pid = static_cast<unsigned long>(getpid());
+#endif
+    wchar_t suffix[48];
+    swprintf(suffix, sizeof(suffix) / sizeof(suffix[0]), L".%lu-%u.tmp", pid,
+             static_cast<unsigned>(s_temp_serial.fetch_add(1, std::memory_order_relaxed)));
+    std::wstring temp = std::wstring(path) + suffix;
+
+    FILE* file = FlacCreateFileW(temp.c_str());
+    if (!file) return false;
+
+    bool ok = fwrite(data, 1, bytes, file) == bytes;
+    ok = fclose(file) == 0 && ok;
+    ok = ok && FlacReplaceFileW(temp.c_str(), path);
+    if (!ok) RemoveFileW(temp.c_str());
+    return ok;
+}
+
+bool FlacFileSeek(FILE* file, int64_t offset, int origin) {
+#ifdef _WIN32
+    return _fseeki64(file, offset, origin) == 0;
+#else
+    return fseeko(file, static_cast<off_t>(offset), origin) == 0;
+#endif
+}
+
+int64_t FlacFileTell(FILE* file) {
+#ifdef _WIN32
+    return _ftelli64(file);
+#else
+    return static_cast<int64_t>(ftello(file));
+#endif
+}
+
+bool FlacGetFileIdentity(FILE* file, FlacFileIdentity* out_identity) {
+#ifdef _WIN32
+    struct _stat64 st;
+    if (_fstat64(_fileno(file), &st) != 0) return false;
+#else
+    struct stat st;
+    if (fstat(fileno(file), &st) != 0) return false;
+#endif
+    out_identity->size = static_cast<uint64_t>(st.st_size);
+    out_identity->mtime = static_cast<int64_t>(st.st_mtime);
+    return true;
+}
+
+// ========== 原生句柄 ==========
+
+bool FlacOpenNativeFileW(const wchar_t* path, FlacNativeFile* out_file, uint64_t* out_size) {
+    if (!path) return false;
+
+#ifdef _WIN32
+    HANDLE file = CreateFileW(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                              nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart < 0) {
+        CloseHandle(file);
+        return false;
+    }
+    *out_file = file;
+    if (out_size) *out_size = static_cast<uint64_t>(size.QuadPart);
+#else
+    int fd = open(FlacWideToUtf8(path).c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        close(fd);
+        return false;
+    }
+    *out_file = fd;
+    if (out_size) *out_size = static_cast<uint64_t>(st.st_size);
+#endif
+    return true;
+}
+
+void FlacCloseNativeFile(FlacNativeFile file) {
+#ifdef _WIN32
+    CloseHandle(static_cast<HANDLE>(file));
+#else
+    close(file);
+#endif
+}
+
+int64_t FlacReadAt(FlacNativeFile file, uint64_t offset, void* buffer, size_t bytes) {
+#ifdef _WIN32
+    // 同步句柄上带偏移的 ReadFile 即定位读取，多个线程可以同时对同一句柄发出
+    OVERLAPPED overlapped = {};
+    overlapped.Offset = static_cast<DWORD>(offset);
+    overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+    DWORD read = 0;
+    DWORD request = static_cast<DWORD>(std::min<size_t>(bytes, 0x7FFFFFFF));
+    if (!ReadFile(static_cast<HANDLE>(file), buffer, request, &read, &overlapped)) {
+        return GetLastError() == ERROR_HANDLE_EOF ? 0 : -1;
+    }
+    return static_cast<int64_t>(read);
+#else
+    for (;;) {
+        ssize_t read = pread(file, buffer, bytes, static_cast<off_t>(offset));
+        if (read >= 0) return static_cast<int64_t>(read);
+        if (errno != EINTR) return -1;
+    }
+#endif
+}
+
+// ========== FileByteSource ==========
+
+FileByteSource::~FileByteSource() {
+    if (file_) fclose(file_);
+}
+
+size_t FileByteSource::Read(void* dst, size_t bytes) {
+    uint64_t watermark = Watermark();
+    uint64_t cursor = static_cast<uint64_t>(cursor_);
+    if (cursor >= watermark) return 0;
+    if (bytes > watermark - cursor) bytes = static_cast<size_t>(watermark - cursor);
+
+    if (!file_pos_valid_) {
+        if (!FlacFileSeek(file_, cursor_, SEEK_SET)) return 0;
+        file_pos_valid_ = true;
+    }
+
+    // 文件可能仍在增长：清除上次读到末尾留下的 EOF 标志
+    clearerr(file_);
+    size_t read = fread(dst, 1, bytes, file_);
+    cursor_ += static_cast<int64_t>(read);
+    return read;
+}
+
+bool FileByteSource::Seek(int64_t offset, int origin) {
+    int64_t target;
+    if (origin == SEEK_SET) {
+        target = offset;
+    } else if (origin == SEEK_CUR) {
+        target = cursor_ + offset;
+    } else {
+        // 仍在写入的文件没有确定的末尾
+        if (Watermark() != UINT64_MAX) return false;
+        if (!FlacFileSeek(file_, 0, SEEK_END)) return false;
+        target = FlacFileTell(file_) + offset;
+    }
+
+    if (target < 0 || static_cast<uint64_t>(target) > Watermark()) return false;
+
+    cursor_ = target;
+    file_pos_valid_ = false;
+    return true;
+}
+
+// ========== MappedByteSource ==========
+
+static uint64_t PageSize() {
+#ifdef _WIN32
+    static const uint64_t size = [] {
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        return static_cast<uint64_t>(info.dwPageSize);
+    }();
+#else
+    static const uint64_t size = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+#endif
+    return size;
+}
+
+#ifdef _WIN32
+// PrefetchVirtualMemory 从 Windows 8 开始提供，按名称查找以免旧系统上无法加载
+struct MemoryRangeEntry {
+    PVOID address;
+    SIZE_T bytes;
+};
+typedef BOOL(WINAPI* PrefetchVirtualMemoryProc)(HANDLE, ULONG_PTR, MemoryRangeEntry*, ULONG);
+
+static PrefetchVirtualMemoryProc GetPrefetchVirtualMemory() {
+    static const PrefetchVirtualMemoryProc proc = reinterpret_cast<PrefetchVirtualMemoryProc>(
+        reinterpret_cast<void*>(GetProcAddress(GetModuleHandleW(L"kernel32.dll"), "PrefetchVirtualMemory")));
+    return proc;
+}
+#endif
+
+// 文件是否位于本机固定磁盘上。网络卷断开、可移动盘被拔出时，访问映射中尚未读入的页面会
+// 触发 EXCEPTION_IN_PAGE_ERROR / SIGBUS 使整个进程崩溃，这些卷上的文件不映射
+#ifdef _WIN32
+static bool IsLocalFixedVolume(const wchar_t* path) {
+    std::vector<wchar_t> volume(wcslen(path) + 2);
+    if (!GetVolumePathNameW(path, volume.data(), static_cast<DWORD>(volume.size()))) return false;
+    UINT type = GetDriveTypeW(volume.data());
+    return type == DRIVE_FIXED || type == DRIVE_RAMDISK;
+}
+#else
+static bool IsLocalFixedVolume(int fd) {
+#if defined(__linux__)
+    struct statfs fs;
+    if (fstatfs(fd, &fs) != 0) return false;
+    switch (static_cast<uint32_t>(fs.f_type)) {
+    case 0x6969u:       // NFS
+    case 0x517Bu:       // SMB
+    case 0xFF534D42u:   // CIFS
+    case 0xFE534D42u:   // SMB2
+    case 0x65735546u:   // FUSE（sshfs、rclone、ntfs-3g 等）
+    case 0x01021997u:   // 9P（WSL 的 Windows 盘符、虚拟机共享目录）
+    case 0x00C36400u:   // Ceph
+    case 0x73757245u:   // Coda
+    case 0x5346414Fu:   // AFS
+        return false;
+    default:
+        return true;
+    }
+#elif defined(__APPLE__)
+    struct statfs fs;
+    return fstatfs(fd, &fs) == 0 && (fs.f_flags & MNT_LOCAL) != 0;
+#else
+    (void)fd;
+    return true;
+#endif
+}
+#endif
+
+MappedByteSource::~MappedByteSource() {
+    if (!data_) return;
+#ifdef _WIN32
+    UnmapViewOfFile(data_);
+#else
+    munmap(const_cast<uint8_t*>(data_), static_cast<size_t>(size_));
+#endif
+}
+
+bool MappedByteSource::Open(const wchar_t* path) {
+    if (!path) return false;
+
+#ifdef _WIN32
+    if (!IsLocalFixedVolume(path)) return false;
+
+    // 与 FlacOpenFileW 相同，不阻止其他进程读写（映射期间文件不能被截断）
+    HANDLE file = CreateFileW(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                              nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0 || static_cast<uint64_t>(size.QuadPart) > SIZE_MAX) {
+        CloseHandle(file);
+        return false;
+    }
+
+    // 视图持有映射对象的引用，文件和映射句柄可以立即关闭
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping) return false;
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!view) return false;
+
+    data_ = static_cast<const uint8_t*>(view);
+    size_ = static_cast<uint64_t>(size.QuadPart);
+#else
+    int fd = open(FlacWideToUtf8(path).c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0 ||
+        static_cast<uint64_t>(st.st_size) > SIZE_MAX || !IsLocalFixedVolume(fd)) {
+        close(fd);
+        return false;
+    }
+
+    // 映射建立后即可关闭文件描述符
+    void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (view == MAP_FAILED) return false;
+
+    data_ = static_cast<const uint8_t*>(view);
+    size_ = static_cast<uint64_t>(st.st_size);
+#endif
+
+    SetRandomAccess(false);
+    Prefetch(0, MAP_READAHEAD_BYTES);
+    prefetched_ = std::min(size_, MAP_READAHEAD_BYTES);
+    return true;
+}
+
+size_t MappedByteSource::Read(void* dst, size_t bytes) {
+    if (cursor_ >= size_) return 0;
+    if (bytes > size_ - cursor_) bytes = static_cast<size_t>(size_ - cursor_);
+
+    memcpy(dst, data_ + cursor_, bytes);
+    cursor_ += bytes;
+
+    if (random_ && cursor_ - sequential_from_ >= MAP_SEEK_WINDOW_BYTES) {
+        SetRandomAccess(false);
+    }
+    if (!random_ && cursor_ + MAP_READAHEAD_BYTES / 2 > prefetched_ && prefetched_ < size_) {
+        uint64_t from = std::max(prefetched_, cursor_);
+        Prefetch(from, MAP_READAHEAD_BYTES);
+        prefetched_ = std::min(size_, from + MAP_READAHEAD_BYTES);
+    }
+    if (cursor_ >= released_ + MAP_KEEP_BEHIND_BYTES + MAP_RELEASE_STEP_BYTES) {
+        uint64_t end = cursor_ - MAP_KEEP_BEHIND_BYTES;
+        Release(released_, end);
+        released_ = end;
+    }
+    return bytes;
+}
+
+bool MappedByteSource::Seek(int64_t offset, int origin) {
+    int64_t base = origin == SEEK_SET ? 0 : (origin == SEEK_CUR ? static_cast<int64_t>(cursor_) : static_cast<int64_t>(size_));
+    int64_t target = base + offset;
+    // 与 FileByteSource 一致，允许定位到末尾之后（之后的读取返回 0）
+    if (target < 0) return false;
+
+    uint64_t position = static_cast<uint64_t>(target);
+    bool jump = position < cursor_ || position - cursor_ > MAP_SEEK_WINDOW_BYTES;
+    cursor_ = position;
+    if (!jump) return true;
+
+    // 跳转（seek 时 dr_flac 的二分查找 / 帧头同步）：停止顺序预读，只取目标附近的小窗口
+    if (!random_) SetRandomAccess(true);
+    sequential_from_ = position;
+    Prefetch(position, MAP_SEEK_WINDOW_BYTES);
+    prefetched_ = std::min(size_, position + MAP_SEEK_WINDOW_BYTES);
+    if (position < released_) released_ = position;
+    return true;
+}
+
+void MappedByteSource::Prefetch(uint64_t offset, uint64_t bytes) {
+    if (offset >= size_) return;
+    uint64_t page = PageSize();
+    uint64_t begin = offset / page * page;
+    uint64_t end = std::min(size_, offset + bytes);
+    if (end <= begin) return;
+
+#ifdef _WIN32
+    PrefetchVirtualMemoryProc prefetch = GetPrefetchVirtualMemory();
+    if (!prefetch) return;
+    MemoryRangeEntry range = { const_cast<uint8_t*>(data_ + begin), static_cast<SIZE_T>(end - begin) };
+    prefetch(GetCurrentProcess(), 1, &range, 0);
+#else
+    madvise(const_cast<uint8_t*>(data_ + begin), static_cast<size_t>(end - begin), MADV_WILLNEED);
+#endif
+}
+
+// 交还 [begin, end) 内的整页：只读的文件映射页面随时可以从页缓存（或文件）重新读入
+void MappedByteSource::Release(uint64_t begin, uint64_t end) {
+    uint64_t page = PageSize();
+    begin = (begin + page - 1) / page * page;
+    end = end / page * page;
+    if (end <= begin) return;
+
+#ifdef _WIN32
+    // 对未锁定的页面调用 VirtualUnlock 会把它们移出工作集
+    VirtualUnlock(const_cast<uint8_t*>(data_ + begin), static_cast<SIZE_T>(end - begin));
+#else
+    madvise(const_cast<uint8_t*>(data_ + begin), static_cast<size_t>(end - begin), MADV_DONTNEED);
+#endif
+}
+
+void MappedByteSource::SetRandomAccess(bool random) {
+    random_ = random;
+#ifndef _WIN32
+    // 顺序模式下内核预读更激进，随机模式下缺页只读入所在的页面
+    madvise(const_cast<uint8_t*>(data_), static_cast<size_t>(size_), random ? MADV_RANDOM : MADV_SEQUENTIAL);
+#endif
+}
+
+FlacByteSource* FlacOpenLocalSource(const wchar_t* path) {
+    if (FlacResolveIoBackend() != FLAC_IO_MAPPED) {
+        AsyncFileByteSource* async = new AsyncFileByteSource();
+        if (async->Open(path, FlacAcquireIoQueue())) return async;
+        delete async;
+    }
+
+    MappedByteSource* mapped = new MappedByteSource();
+    if (mapped->Open(path)) return mapped;
+    delete mapped;
+
+    FILE* file = FlacOpenFileW(path);
+    return file ? new FileByteSource(file) : nullptr;
+}
+
+// ========== PushBuffer ==========
+
+PushBuffer::PushBuffer() : chunks_(new uint8_t*[MAX_CHUNKS]()) {
+}
+
+PushBuffer::~PushBuffer() {
+    for (size_t i = 0; i < MAX_CHUNKS && chunks_[i]; i++) {
+        delete[] chunks_[i];
+    }
+    delete[] chunks_;
+}
+
+bool PushBuffer::Append(const void* data, size_t size) {
+    uint64_t written = size_.load(std::memory_order_relaxed);
+    if (written + size > static_cast<uint64_t>(CHUNK_BYTES) * MAX_CHUNKS) return false;
+
+    const uint8_t* in = static_cast<const uint8_t*>(data);
+    uint64_t pos = written;
+    size_t remaining = size;
+    while (remaining > 0) {
+        size_t chunk = static_cast<size_t>(pos / CHUNK_BYTES);
+        size_t offset = static_cast<size_t>(pos % CHUNK_BYTES);
+        if (!chunks_[chunk]) chunks_[chunk] = new uint8_t[CHUNK_BYTES];
+
+        size_t count = CHUNK_BYTES - offset;
+        if (count > remaining) count = remaining;
+        memcpy(chunks_[chunk] + offset, in, count);
+
+        in += count;
+        pos += count;
+        remaining -= count;
+    }
+
+    size_.store(written + size, std::memory_order_release);
+    return true;
+}
+
+size_t PushBuffer::CopyOut(uint64_t offset, void* dst, size_t bytes) const {
+    uint64_t size = Size();
+    if (offset >= size) return 0;
+    if (bytes > size - offset) bytes = static_cast<size_t>(size - offset);
+
+    uint8_t* out = static_cast<uint8_t*>(dst);
+    size_t remaining = bytes;
+    while (remaining > 0) {
+        size_t chunk = static_cast<size_t>(offset / CHUNK_BYTES);
+        size_t chunk_offset = static_cast<size_t>(offset % CHUNK_BYTES);
+        size_t count = CHUNK_BYTES - chunk_offset;
+        if (count > remaining) count = remaining;
+        memcpy(out, chunks_[chunk] + chunk_offset, count);
+
+        out += count;
+        offset += count;
+        remaining -= count;
+    }
+    return bytes;
+}
+
+size_t PushByteSource::Read(void* dst, size_t bytes) {
+    size_t read = buffer_->CopyOut(static_cast<uint64_t>(cursor_), dst, bytes);
+    cursor_ += static_cast<int64_t>(read);
+    return read;
+}
+
+bool PushByteSource::Seek(int64_t offset, int origin) {
+    // 推送流的总长度未知，不支持相对末尾定位
+    if (origin == SEEK_END) return false;
+
+    int64_t target = origin == SEEK_SET ? offset : cursor_ + offset;
+    if (target < 0 || static_cast<uint64_t>(target) > buffer_->Size()) return false;
+
+    cursor_ = target;
+    return true;
+}
+
+// ========== CallbackByteSource ==========
+
+size_t CallbackByteSource::Read(void* dst, size_t bytes) {
+    size_t read = on_read_(user_data_, dst, bytes);
+    cursor_ += static_cast<int64_t>(read);
+    return read;
+}
+
+bool CallbackByteSource::Seek(int64_t offset, int origin) {
+    if (!on_seek_) return false;
+
+    long long position = on_seek_(user_data_, offset, origin);
+    if (position < 0) return false;
+
+    cursor_ = position;
+    return true;
+}
+
+// ========== dr_flac 回调适配 ==========
+// dr_flac 0.13 起 drflac_open 多了 onTell 参数，seek origin 枚举也改了名字，
+// 但 SET/CUR 的数值保持 0/1 不变，这里统一按数值转换。
+
+static size_t OnSourceRead(void* user_data, void* buffer_out, size_t bytes_to_read) {
+    return static_cast<FlacByteSource*>(user_data)->Read(buffer_out, bytes_to_read);
+}
+
+static drflac_bool32 OnSourceSeek(void* user_data, int offset, drflac_seek_origin origin) {
+    int whence = static_cast<int>(origin) == 0 ? SEEK_SET : (static_cast<int>(origin) == 1 ? SEEK_CUR : SEEK_END);
+    return static_cast<FlacByteSource*>(user_data)->Seek(offset, whence) ? DRFLAC_TRUE : DRFLAC_FALSE;
+}
+
+#if DRFLAC_VERSION_MAJOR > 0 || DRFLAC_VERSION_MINOR >= 13
+static drflac_bool32 OnSourceTell(void* user_data, drflac_int64* cursor) {
+    *cursor = static_cast<FlacByteSource*>(user_data)->Tell();
+    return DRFLAC_TRUE;
+}
+#endif
+
+drflac* FlacOpenSource(FlacByteSource* source, const drflac_allocation_callbacks* allocation_callbacks) {
+#if DRFLAC_VERSION_MAJOR > 0 || DRFLAC_VERSION_MINOR >= 13
+    return drflac_open(OnSourceRead, OnSourceSeek, OnSourceTell, source, allocation_callbacks);
+#else
+    return drflac_open(OnSourceRead, OnSourceSeek, source, allocation_callbacks);
+#endif
+}
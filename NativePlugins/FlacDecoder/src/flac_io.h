@@ -0,0 +1,209 @@
+#ifndef CHILL_FLAC_IO_H
+#define CHILL_FLAC_IO_H
+
+// 文件访问与 dr_flac 读取回调的适配层
+
+#include "dr_flac.h"
+#include "flac_decoder.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+
+// 字节源：dr_flac 与格式解析共用的顺序读取 + 定位接口
+class FlacByteSource {
+public:
+    virtual ~FlacByteSource() {}
+
+    // 读取最多 bytes 字节，返回实际读取数（0 表示末尾或暂无数据）
+    virtual size_t Read(void* dst, size_t bytes) = 0;
+
+    // origin 取 SEEK_SET / SEEK_CUR / SEEK_END
+    virtual bool Seek(int64_t offset, int origin) = 0;
+
+    virtual int64_t Tell() const = 0;
+
+    // 字节源自身持有的缓冲内存（上限估计，用于预加载的内存预算），内存映射等不占堆内存的为 0
+    virtual size_t ResidentBytes() const { return 0; }
+};
+
+// 带水位线的字节源：水位线之后的内容视为尚不存在（用于仍在写入的数据）
+class FlacGrowingSource : public FlacByteSource {
+public:
+    virtual void SetWatermark(uint64_t bytes) = 0;
+    virtual uint64_t Watermark() const = 0;
+};
+
+// 以共享读方式打开文件（允许其他进程/线程同时写入）
+FILE* FlacOpenFileW(const wchar_t* path);
+
+// 创建（覆盖）文件用于写入
+FILE* FlacCreateFileW(const wchar_t* path);
+
+// 以读写方式打开文件（不存在时创建），其他进程只能读取
+FILE* FlacOpenFileForUpdateW(const wchar_t* path);
+
+// 重命名文件，目标已存在时覆盖
+bool FlacReplaceFileW(const wchar_t* from, const wchar_t* to);
+
+// 原子写入整个文件：先写入本次调用独有的临时文件（路径 + 进程号 + 序号）再重命名覆盖，
+// 多个线程 / 进程同时写同一路径时，读者只会看到某一次完整的写入；失败时删除临时文件
+bool FlacWriteFileAtomicW(const wchar_t* path, const void* data, size_t bytes);
+
+// 64 位文件定位
+bool FlacFileSeek(FILE* file, int64_t offset, int origin);
+int64_t FlacFileTell(FILE* file);
+
+// 文件身份（大小 + 修改时间），用于判断缓存是否仍然对应同一个文件
+struct FlacFileIdentity {
+    uint64_t size;
+    int64_t mtime;
+};
+
+bool FlacGetFileIdentity(FILE* file, FlacFileIdentity* out_identity);
+
+// 原生文件句柄（Windows 上为 HANDLE，其余平台为文件描述符）
+#ifdef _WIN32
+typedef void* FlacNativeFile;
+#else
+typedef int FlacNativeFile;
+#endif
+
+// 以共享读方式打开普通文件的原生句柄（与 FlacOpenFileW 相同，不阻止其他进程读写），out_size 可为 NULL
+bool FlacOpenNativeFileW(const wchar_t* path, FlacNativeFile* out_file, uint64_t* out_size);
+void FlacCloseNativeFile(FlacNativeFile file);
+
+// 定位读取（不使用也不依赖文件指针，多个线程可以同时对同一句柄调用），
+// 返回读取的字节数（可能少于请求，0 表示末尾），错误时返回 -1
+int64_t FlacReadAt(FlacNativeFile file, uint64_t offset, void* buffer, size_t bytes);
+
+// 基于 FILE* 的字节源
+//
+// 设置了水位线（watermark）时，读取和定位都不会越过该字节位置，
+// 用于仍在被写入的文件：水位线之后的内容视为尚不存在。
+class FileByteSource : public FlacGrowingSource {
+public:
+    explicit FileByteSource(FILE* file) : file_(file) {}
+    ~FileByteSource() override;
+
+    size_t Read(void* dst, size_t bytes) override;
+    bool Seek(int64_t offset, int origin) override;
+    int64_t Tell() const override { return cursor_; }
+
+    // 水位线：UINT64_MAX 表示不限制
+    void SetWatermark(uint64_t bytes) override { watermark_.store(bytes, std::memory_order_release); }
+    uint64_t Watermark() const override { return watermark_.load(std::memory_order_acquire); }
+
+private:
+    FILE* file_;
+    int64_t cursor_ = 0;
+    bool file_pos_valid_ = true;
+    std::atomic<uint64_t> watermark_{UINT64_MAX};
+};
+
+// 内存映射的本地文件（Linux 上 mmap，Windows 上文件映射），读取只是 memcpy，不经过 stdio 缓冲和锁
+//
+// 按读取位置给出访问模式提示：顺序读取时在游标前方预读，跳转（seek）后只预读目标附近的小窗口，
+// 游标之后已读过的页面（保留最近一段以便小幅回退）交还给系统。只由一个线程使用。
+// 映射期间文件被其他进程截断时，访问已不存在的页面会触发 SIGBUS（Windows 上映射期间不能截断），
+// 因此只用于已完整存在的文件，仍在写入的文件使用 FileByteSource。
+// 网络卷（SMB / NFS / FUSE 等）和 Windows 上的可移动盘断开时缺页同样会使进程崩溃，这些文件不映射。
+class MappedByteSource : public FlacByteSource {
+public:
+    MappedByteSource() {}
+    ~MappedByteSource() override;
+
+    MappedByteSource(const MappedByteSource&) = delete;
+    MappedByteSource& operator=(const MappedByteSource&) = delete;
+
+    // 映射整个文件，空文件、不在本机固定磁盘上或映射失败时返回 false
+    bool Open(const wchar_t* path);
+
+    size_t Read(void* dst, size_t bytes) override;
+    bool Seek(int64_t offset, int origin) override;
+    int64_t Tell() const override { return static_cast<int64_t>(cursor_); }
+
+private:
+    void Prefetch(uint64_t offset, uint64_t bytes);
+    void Release(uint64_t begin, uint64_t end);
+    void SetRandomAccess(bool random);
+
+    const uint8_t* data_ = nullptr;
+    uint64_t size_ = 0;
+    uint64_t cursor_ = 0;
+
+    uint64_t prefetched_ = 0;       // 已提示预读到的位置
+    uint64_t released_ = 0;         // 之前的页面已交还
+    uint64_t sequential_from_ = 0;  // 最近一次跳转的目标，从这里连续读完预读窗口后恢复顺序模式
+    bool random_ = false;
+};
+
+// 打开本地文件的字节源：按 I/O 后端使用异步队列或内存映射，失败时退回 FileByteSource，都失败时返回 NULL
+FlacByteSource* FlacOpenLocalSource(const wchar_t* path);
+
+// 推送缓冲区：写入方分块追加字节，读取方无锁访问已发布的部分
+//
+// 块指针表预先分配且从不移动，写入方先写块内容、再以 release 发布总长度，
+// 读取方以 acquire 读取总长度后即可安全访问其范围内的所有块。
+class PushBuffer {
+public:
+    static const size_t CHUNK_BYTES = 256 * 1024;
+    static const size_t MAX_CHUNKS = 4096;   // 单个流最多 1GB
+
+    PushBuffer();
+    ~PushBuffer();
+
+    PushBuffer(const PushBuffer&) = delete;
+    PushBuffer& operator=(const PushBuffer&) = delete;
+
+    // 追加数据（只能由单个写入线程调用），超出容量返回 false
+    bool Append(const void* data, size_t size);
+
+    uint64_t Size() const { return size_.load(std::memory_order_acquire); }
+
+    // 从 offset 拷贝最多 bytes 字节（不超过已发布的长度），返回实际字节数
+    size_t CopyOut(uint64_t offset, void* dst, size_t bytes) const;
+
+private:
+    uint8_t** chunks_;
+    std::atomic<uint64_t> size_{0};
+};
+
+// 推送缓冲区上的读取游标，水位线即已推送的长度
+class PushByteSource : public FlacGrowingSource {
+public:
+    explicit PushByteSource(const PushBuffer* buffer) : buffer_(buffer) {}
+
+    size_t Read(void* dst, size_t bytes) override;
+    bool Seek(int64_t offset, int origin) override;
+    int64_t Tell() const override { return cursor_; }
+
+    void SetWatermark(uint64_t) override {}
+    uint64_t Watermark() const override { return buffer_->Size(); }
+
+private:
+    const PushBuffer* buffer_;
+    int64_t cursor_ = 0;
+};
+
+// 调用者提供的读取/定位回调
+class CallbackByteSource : public FlacByteSource {
+public:
+    CallbackByteSource(FlacReadCallback on_read, FlacSeekCallback on_seek, void* user_data)
+        : on_read_(on_read), on_seek_(on_seek), user_data_(user_data) {}
+
+    size_t Read(void* dst, size_t bytes) override;
+    bool Seek(int64_t offset, int origin) override;
+    int64_t Tell() const override { return cursor_; }
+
+private:
+    FlacReadCallback on_read_;
+    FlacSeekCallback on_seek_;
+    void* user_data_;
+    int64_t cursor_ = 0;
+};
+
+// 通过字节源打开 dr_flac 解码器（source 的生命周期需覆盖返回的 drflac）
+drflac* FlacOpenSource(FlacByteSource* source, const drflac_allocation_callbacks* allocation_callbacks);
+
+#endif // CHILL_FLAC_IO_H
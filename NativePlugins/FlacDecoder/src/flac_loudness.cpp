@@ -0,0 +1,291 @@
+#include "flac_loudness.h"
+
+#include "flac_simd.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// 每次解交错 / 滤波的最大帧数（不跨越子块边界）
+static const uint64_t CHUNK_FRAMES = 1024;
+
+// 真峰值过采样滤波器每个相位的抽头数（BS.1770-4 附件 2：4 倍过采样共 48 抽头）
+static const int TRUE_PEAK_TAPS = 12;
+
+// 真峰值按此长度分段估计上界，上界不超过当前真峰值的段不做过采样
+static const size_t TRUE_PEAK_SPAN = 64;
+
+// 400 毫秒块 / 3 秒短期窗口包含的子块数
+static const int BLOCK_SUBBLOCKS = 4;
+static const int SHORT_TERM_SUBBLOCKS = 30;
+
+static const double RELATIVE_GATE_LU = -10.0;
+static const double RANGE_RELATIVE_GATE_LU = -20.0;
+static const double RANGE_LOW_PERCENTILE = 0.10;
+static const double RANGE_HIGH_PERCENTILE = 0.95;
+
+static const double PI = 3.14159265358979323846;
+
+// 状态绝对值低于此值时清零，避免静音段产生非规格化数
+static const double DENORMAL_LIMIT = 1e-30;
+
+static double EnergyToLufs(double energy) {
+    return -0.691 + 10.0 * std::log10(energy);
+}
+
+static double LufsToEnergy(double lufs) {
+    return std::pow(10.0, (lufs + 0.691) / 10.0);
+}
+
+// FLAC 声道顺序中各声道的 BS.1770 权重：环绕声道 1.41，LFE 不计入
+//   4: L R BL BR / 5: L R C BL BR / 6: L R C LFE BL BR / 7: L R C LFE BC SL SR / 8: L R C LFE BL BR SL SR
+static void ChannelWeights(int channels, double* weights) {
+    for (int c = 0; c < channels; c++) weights[c] = 1.0;
+    switch (channels) {
+    case 4:
+        weights[2] = weights[3] = 1.41;
+        break;
+    case 5:
+        weights[3] = weights[4] = 1.41;
+        break;
+    case 6:
+        weights[3] = 0.0;
+        weights[4] = weights[5] = 1.41;
+        break;
+    case 7:
+        weights[3] = 0.0;
+        weights[4] = weights[5] = weights[6] = 1.41;
+        break;
+    case 8:
+        weights[3] = 0.0;
+        weights[4] = weights[5] = weights[6] = weights[7] = 1.41;
+        break;
+    default:
+        break;
+    }
+}
+
+// 门限内块能量的平均值；没有块通过时返回 0
+static double GatedMean(const std::vector<double>& energies, double threshold) {
+    double sum = 0.0;
+    size_t count = 0;
+    for (double energy : energies) {
+        if (energy > threshold) {
+            sum += energy;
+            count++;
+        }
+    }
+    return count > 0 ? sum / static_cast<double>(count) : 0.0;
+}
+
+bool FlacLoudnessMeter::Init(int sample_rate, int channels) {
+    if (sample_rate <= 0 || channels < 1 || channels > 8) return false;
+    channels_ = channels;
+    ChannelWeights(channels, weights_);
+
+    // K 计权系数按采样率由模拟原型双线性变换得到（48kHz 时与 BS.1770 给出的系数一致）
+    double k = std::tan(PI * 1681.974450955533 / sample_rate);
+    double q = 0.7071752369554196;
+    double vh = std::pow(10.0, 3.999843853973347 / 20.0);
+    double vb = std::pow(vh, 0.4996667741545416);
+    double a0 = 1.0 + k / q + k * k;
+    shelf_.b0 = (vh + vb * k / q + k * k) / a0;
+    shelf_.b1 = 2.0 * (k * k - vh) / a0;
+    shelf_.b2 = (vh - vb * k / q + k * k) / a0;
+    shelf_.a1 = 2.0 * (k * k - 1.0) / a0;
+    shelf_.a2 = (1.0 - k / q + k * k) / a0;
+
+    k = std::tan(PI * 38.13547087602444 / sample_rate);
+    q = 0.5003270373238773;
+    a0 = 1.0 + k / q + k * k;
+    highpass_.b0 = 1.0;
+    highpass_.b1 = -2.0;
+    highpass_.b2 = 1.0;
+    highpass_.a1 = 2.0 * (k * k - 1.0) / a0;
+    highpass_.a2 = (1.0 - k / q + k * k) / a0;
+
+    filter_state_.assign(static_cast<size_t>(channels) * 4, 0.0);
+    planar_.resize(static_cast<size_t>(CHUNK_FRAMES) * channels);
+
+    // 过采样插值滤波器：Hann 窗 sinc，截止于原采样率的奈奎斯特频率，每个相位归一化为单位直流增益
+    oversample_ = sample_rate < 96000 ? 4 : sample_rate < 192000 ? 2 : 1;
+    phases_.assign(static_cast<size_t>(oversample_) * TRUE_PEAK_TAPS, 0.0f);
+    phase_gain_ = 1.0f;
+    if (oversample_ > 1) {
+        int length = oversample_ * TRUE_PEAK_TAPS;
+        double center = (length - 1) / 2.0;
+        phase_gain_ = 0.0f;
+        for (int p = 0; p < oversample_; p++) {
+            double coefficients[TRUE_PEAK_TAPS];
+            double sum = 0.0;
+            for (int t = 0; t < TRUE_PEAK_TAPS; t++) {
+                // 输出 y_p(i) = Σ h[p + oversample × t] · x[i - t]，这里按 x 的时间正序存放
+                int n = p + oversample_ * (TRUE_PEAK_TAPS - 1 - t);
+                double x = (n - center) / oversample_;
+                double sinc = x == 0.0 ? 1.0 : std::sin(PI * x) / (PI * x);
+                double window = 0.5 - 0.5 * std::cos(2.0 * PI * (n + 1) / (length + 1));
+                coefficients[t] = sinc * window;
+                sum += coefficients[t];
+            }
+            float magnitude = 0.0f;
+            for (int t = 0; t < TRUE_PEAK_TAPS; t++) {
+                float c = static_cast<float>(coefficients[t] / sum);
+                phases_[static_cast<size_t>(p) * TRUE_PEAK_TAPS + t] = c;
+                magnitude += std::fabs(c);
+            }
+            phase_gain_ = std::max(phase_gain_, magnitude);
+        }
+    }
+    history_.assign(static_cast<size_t>(TRUE_PEAK_TAPS - 1 + CHUNK_FRAMES) * channels, 0.0f);
+    true_peak_ = 0.0f;
+
+    subblock_frames_ = std::max<uint64_t>(1, static_cast<uint64_t>(sample_rate / 10.0 + 0.5));
+    subblock_filled_ = 0;
+    subblock_energy_ = 0.0;
+    recent_.assign(SHORT_TERM_SUBBLOCKS, 0.0);
+    subblock_count_ = 0;
+    blocks_.clear();
+    short_terms_.clear();
+    return true;
+}
+
+// ========== 处理 ==========
+
+void FlacLoudnessMeter::Process(const float* in, uint64_t frames) {
+    const FlacPcmKernels& kernels = FlacGetPcmKernels();
+    while (frames > 0) {
+        uint64_t chunk = std::min(std::min(frames, CHUNK_FRAMES), subblock_frames_ - subblock_filled_);
+        kernels.deinterleave_f32(in, chunk, channels_, planar_.data(), CHUNK_FRAMES);
+
+        double energy = 0.0;
+        for (int c = 0; c < channels_; c++) {
+            const float* samples = planar_.data() + static_cast<size_t>(c) * CHUNK_FRAMES;
+            TrackTruePeak(c, samples, static_cast<size_t>(chunk));
+            if (weights_[c] > 0.0) {
+                energy += weights_[c] * FilterChannel(c, samples, static_cast<size_t>(chunk));
+            }
+        }
+        subblock_energy_ += energy;
+        subblock_filled_ += chunk;
+        if (subblock_filled_ == subblock_frames_) FinishSubblock();
+
+        in += chunk * channels_;
+        frames -= chunk;
+    }
+}
+
+double FlacLoudnessMeter::FilterChannel(int channel, const float* in, size_t count) {
+    double* state = filter_state_.data() + static_cast<size_t>(channel) * 4;
+    double s1 = state[0], s2 = state[1], t1 = state[2], t2 = state[3];
+    const Biquad f = shelf_;
+    const Biquad h = highpass_;
+
+    double sum = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        double x = in[i];
+        double y = f.b0 * x + s1;
+        s1 = f.b1 * x - f.a1 * y + s2;
+        s2 = f.b2 * x - f.a2 * y;
+        double z = h.b0 * y + t1;
+        t1 = h.b1 * y - h.a1 * z + t2;
+        t2 = h.b2 * y - h.a2 * z;
+        sum += z * z;
+    }
+
+    state[0] = std::fabs(s1) < DENORMAL_LIMIT ? 0.0 : s1;
+    state[1] = std::fabs(s2) < DENORMAL_LIMIT ? 0.0 : s2;
+    state[2] = std::fabs(t1) < DENORMAL_LIMIT ? 0.0 : t1;
+    state[3] = std::fabs(t2) < DENORMAL_LIMIT ? 0.0 : t2;
+    return sum;
+}
+
+// 一段采样的最大绝对值（SIMD 峰值内核）
+static float MaxAbs(const FlacPcmKernels& kernels, const float* in, size_t count) {
+    float lo = 0.0f, hi = 0.0f, sum_squares = 0.0f;
+    kernels.peak_f32(in, count, &lo, &hi, &sum_squares);
+    return std::max(-lo, hi);
+}
+
+void FlacLoudnessMeter::TrackTruePeak(int channel, const float* in, size_t count) {
+    const FlacPcmKernels& kernels = FlacGetPcmKernels();
+    float* buffer = history_.data() + static_cast<size_t>(channel) * (TRUE_PEAK_TAPS - 1 + CHUNK_FRAMES);
+    memcpy(buffer + TRUE_PEAK_TAPS - 1, in, count * sizeof(float));
+
+    float peak = true_peak_;
+    for (size_t start = 0; start < count; start += TRUE_PEAK_SPAN) {
+        size_t length = std::min(count - start, TRUE_PEAK_SPAN);
+
+        // 这一段的输出只依赖 buffer[start, start + length + TAPS - 1)，其最大绝对值 × phase_gain_ 是输出的上界
+        if (MaxAbs(kernels, buffer + start, length + TRUE_PEAK_TAPS - 1) * phase_gain_ <= peak) continue;
+
+        // 原始采样本身也计入（不过采样时即为采样峰值）
+        peak = std::max(peak, MaxAbs(kernels, in + start, length));
+        if (oversample_ == 1) continue;
+
+        // 按输出位置连续累加（固定长度，内循环可由编译器向量化）。CHUNK_FRAMES 是 TRUE_PEAK_SPAN 的整数倍，
+        // 最后一段不足 TRUE_PEAK_SPAN 时多算的输出读取的仍是 buffer 内的旧数据，不计入峰值
+        float outputs[TRUE_PEAK_SPAN];
+        for (int p = 0; p < oversample_; p++) {
+            const float* coefficients = phases_.data() + static_cast<size_t>(p) * TRUE_PEAK_TAPS;
+            std::fill(outputs, outputs + TRUE_PEAK_SPAN, 0.0f);
+            for (int t = 0; t < TRUE_PEAK_TAPS; t++) {
+                const float c = coefficients[t];
+                const float* window = buffer + start + t;
+                for (size_t i = 0; i < TRUE_PEAK_SPAN; i++) outputs[i] += c * window[i];
+            }
+            peak = std::max(peak, MaxAbs(kernels, outputs, length));
+        }
+    }
+    true_peak_ = peak;
+
+    memmove(buffer, buffer + count, (TRUE_PEAK_TAPS - 1) * sizeof(float));
+}
+
+void FlacLoudnessMeter::FinishSubblock() {
+    recent_[subblock_count_ % SHORT_TERM_SUBBLOCKS] = subblock_energy_ / static_cast<double>(subblock_frames_);
+    subblock_count_++;
+    subblock_energy_ = 0.0;
+    subblock_filled_ = 0;
+
+    if (subblock_count_ >= BLOCK_SUBBLOCKS) {
+        double sum = 0.0;
+        for (int i = 1; i <= BLOCK_SUBBLOCKS; i++) sum += recent_[(subblock_count_ - i) % SHORT_TERM_SUBBLOCKS];
+        blocks_.push_back(sum / BLOCK_SUBBLOCKS);
+    }
+    if (subblock_count_ >= SHORT_TERM_SUBBLOCKS) {
+        double sum = 0.0;
+        for (double energy : recent_) sum += energy;
+        short_terms_.push_back(sum / SHORT_TERM_SUBBLOCKS);
+    }
+}
+
+// ========== 结果 ==========
+
+double FlacLoudnessMeter::IntegratedLoudness() const {
+    double absolute = LufsToEnergy(FLAC_LOUDNESS_ABSOLUTE_GATE_LUFS);
+    double mean = GatedMean(blocks_, absolute);
+    if (mean <= 0.0) return FLAC_LOUDNESS_ABSOLUTE_GATE_LUFS;
+
+    double relative = mean * std::pow(10.0, RELATIVE_GATE_LU / 10.0);
+    mean = GatedMean(blocks_, std::max(absolute, relative));
+    return std::max(FLAC_LOUDNESS_ABSOLUTE_GATE_LUFS, EnergyToLufs(mean));
+}
+
+double FlacLoudnessMeter::LoudnessRange() const {
+    double absolute = LufsToEnergy(FLAC_LOUDNESS_ABSOLUTE_GATE_LUFS);
+    double mean = GatedMean(short_terms_, absolute);
+    if (mean <= 0.0) return 0.0;
+
+    double gate = std::max(absolute, mean * std::pow(10.0, RANGE_RELATIVE_GATE_LU / 10.0));
+    std::vector<double> gated;
+    for (double energy : short_terms_) {
+        if (energy > gate) gated.push_back(energy);
+    }
+    if (gated.size() < 2) return 0.0;
+
+    std::sort(gated.begin(), gated.end());
+    size_t last = gated.size() - 1;
+    double low = gated[static_cast<size_t>(RANGE_LOW_PERCENTILE * last + 0.5)];
+    double high = gated[static_cast<size_t>(RANGE_HIGH_PERCENTILE * last + 0.5)];
+    return EnergyToLufs(high) - EnergyToLufs(low);
+}
@@ -0,0 +1,69 @@
+#ifndef CHILL_FLAC_LOUDNESS_H
+#define CHILL_FLAC_LOUDNESS_H
+
+// 响度测量（ITU-R BS.1770-4 / EBU R128）：
+//   K 计权（高架 + 高通两级双二阶）后按 100 毫秒子块累计各声道加权均方；
+//   400 毫秒块（75% 重叠）经 -70 LUFS 绝对门限与 -10 LU 相对门限得到综合响度；
+//   3 秒短期响度经 -70 LUFS 与 -20 LU 门限后取 10%~95% 分位差得到响度范围（EBU Tech 3342）；
+//   真峰值为过采样（采样率 < 96kHz 时 4 倍，< 192kHz 时 2 倍）后的最大绝对值。
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 绝对门限（LUFS）：没有块高于该值时综合响度记为该值
+static const double FLAC_LOUDNESS_ABSOLUTE_GATE_LUFS = -70.0;
+
+class FlacLoudnessMeter {
+public:
+    // 最多 8 声道（FLAC 声道顺序），失败时返回 false
+    bool Init(int sample_rate, int channels);
+
+    // 送入交错 f32 采样
+    void Process(const float* in, uint64_t frames);
+
+    // 综合响度（LUFS）/ 响度范围（LU）/ 真峰值（线性），可在任意时刻调用，只统计已完成的子块
+    double IntegratedLoudness() const;
+    double LoudnessRange() const;
+    double TruePeak() const { return true_peak_; }
+
+private:
+    struct Biquad {
+        double b0, b1, b2, a1, a2;
+    };
+
+    // K 计权并返回平方和（只处理一个声道，状态保存在 filter_state_ 中）
+    double FilterChannel(int channel, const float* in, size_t count);
+    void TrackTruePeak(int channel, const float* in, size_t count);
+    void FinishSubblock();
+
+    int channels_ = 0;
+    double weights_[8] = {};
+
+    // K 计权：每个声道两级转置直接 II 型的 4 个状态
+    Biquad shelf_ = {};
+    Biquad highpass_ = {};
+    std::vector<double> filter_state_;
+
+    // 解交错后的当前块（每声道 CHUNK_FRAMES 帧）
+    std::vector<float> planar_;
+
+    // 真峰值：每个相位的系数按时间正序排列，history_ 为每声道前 TAPS - 1 个采样 + 当前块
+    int oversample_ = 1;
+    std::vector<float> phases_;
+    float phase_gain_ = 1.0f;       // 各相位系数绝对值之和的最大值（输出上界 = 输入最大绝对值 × phase_gain_）
+    std::vector<float> history_;
+    float true_peak_ = 0.0f;
+
+    // 100 毫秒子块
+    uint64_t subblock_frames_ = 0;
+    uint64_t subblock_filled_ = 0;
+    double subblock_energy_ = 0.0;
+    std::vector<double> recent_;    // 最近 30 个子块的能量（环形）
+    uint64_t subblock_count_ = 0;
+
+    std::vector<double> blocks_;        // 400 毫秒块能量
+    std::vector<double> short_terms_;   // 3 秒短期能量（每 100 毫秒一个）
+};
+
+#endif // CHILL_FLAC_LOUDNESS_H
@@ -0,0 +1,329 @@
+#include "flac_internal.h"
+#include "flac_loudness.h"
+#include "flac_loudness_batch.h"
+#include "flac_parallel.h"
+#include "flac_probe.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// 测量时每次解码的帧数
+static const uint64_t MEASURE_CHUNK_FRAMES = 4096;
+
+static const char LOUDNESS_MAGIC[4] = { 'C', 'F', 'L', 'N' };
+static const uint32_t LOUDNESS_VERSION = 1;
+static const size_t LOUDNESS_FILE_BYTES = 4 + 4 + 8 + 8 + 8 * 3;
+
+static const int STATUS_DECODE_FAILED = -5;
+static const int STATUS_CANCELLED = -6;
+
+// ========== 旁路缓存 ==========
+
+static void PutU32(uint8_t*& p, uint32_t v) { for (int i = 0; i < 4; i++) *p++ = static_cast<uint8_t>(v >> (i * 8)); }
+static void PutU64(uint8_t*& p, uint64_t v) { for (int i = 0; i < 8; i++) *p++ = static_cast<uint8_t>(v >> (i * 8)); }
+
+static uint64_t GetLE(const uint8_t*& p, int bytes) {
+    uint64_t v = 0;
+    for (int i = 0; i < bytes; i++) v |= static_cast<uint64_t>(*p++) << (i * 8);
+    return v;
+}
+
+static void PutDouble(uint8_t*& p, double v) {
+    uint64_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    PutU64(p, bits);
+}
+
+static double GetDouble(const uint8_t*& p) {
+    uint64_t bits = GetLE(p, 8);
+    double v;
+    memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+static bool LoadCachedLoudness(const std::wstring& path, const FlacFileIdentity& identity, FlacLoudnessInfo* info) {
+    std::wstring sidecar = FlacSidecarPath(path.c_str(), L".loudness");
+    if (sidecar.empty()) return false;
+
+    FILE* file = FlacOpenFileW(sidecar.c_str());
+    if (!file) return false;
+    uint8_t data[LOUDNESS_FILE_BYTES];
+    bool ok = fread(data, 1, sizeof(data), file) == sizeof(data) && memcmp(data, LOUDNESS_MAGIC, 4) == 0;
+    fclose(file);
+    if (!ok) return false;
+
+    const uint8_t* p = data + 4;
+    uint32_t version = static_cast<uint32_t>(GetLE(p, 4));
+    uint64_t size = GetLE(p, 8);
+    int64_t mtime = static_cast<int64_t>(GetLE(p, 8));
+    if (version != LOUDNESS_VERSION || size != identity.size || mtime != identity.mtime) return false;
+
+    info->integrated_lufs = GetDouble(p);
+    info->loudness_range_lu = GetDouble(p);
+    info->true_peak = GetDouble(p);
+    return true;
+}
+
+static void SaveCachedLoudness(const std::wstring& path, const FlacFileIdentity& identity, const FlacLoudnessInfo& info) {
+    std::wstring sidecar = FlacSidecarPath(path.c_str(), L".loudness");
+    if (sidecar.empty()) return;
+
+    uint8_t data[LOUDNESS_FILE_BYTES];
+    uint8_t* p = data;
+    memcpy(p, LOUDNESS_MAGIC, 4);
+    p += 4;
+    PutU32(p, LOUDNESS_VERSION);
+    PutU64(p, identity.size);
+    PutU64(p, static_cast<uint64_t>(identity.mtime));
+    PutDouble(p, info.integrated_lufs);
+    PutDouble(p, info.loudness_range_lu);
+    PutDouble(p, info.true_peak);
+
+    // 同时分析同一文件的其他批次不会读到写了一半的内容
+    FlacWriteFileAtomicW(sidecar.c_str(), data, sizeof(data));
+}
+
+// ========== ReplayGain 标签 ==========
+
+// 不区分大小写比较标签名（ASCII）
+static bool TagKeyEquals(const char* tag, size_t key_length, const char* key) {
+    if (strlen(key) != key_length) return false;
+    for (size_t i = 0; i < key_length; i++) {
+        char c = tag[i];
+        if (c >= 'a' && c <= 'z') c = static_cast<char>(c - 'a' + 'A');
+        if (c != key[i]) return false;
+    }
+    return true;
+}
+
+// 解析 "-6.54 dB" / "0.988525" 开头的十进制数（不依赖 C 运行库的区域设置）
+static bool ParseDecimal(const char* s, double* out) {
+    while (*s == ' ' || *s == '\t') s++;
+    double sign = 1.0;
+    if (*s == '+' || *s == '-') {
+        if (*s == '-') sign = -1.0;
+        s++;
+    }
+
+    double value = 0.0;
+    bool has_digits = false;
+    for (; *s >= '0' && *s <= '9'; s++) {
+        value = value * 10.0 + (*s - '0');
+        has_digits = true;
+    }
+    if (*s == '.') {
+        double scale = 0.1;
+        for (s++; *s >= '0' && *s <= '9'; s++) {
+            value += (*s - '0') * scale;
+            scale *= 0.1;
+            has_digits = true;
+        }
+    }
+    if (!has_digits) return false;
+    *out = sign * value;
+    return true;
+}
+
+bool FlacLoudnessBatch::ReadTags(const std::wstring& path, FlacLoudnessInfo* info) const {
+    FILE* file = FlacOpenFileW(path.c_str());
+    if (!file) return false;
+
+    FileByteSource source(file);
+    FlacProbeInfo probe = {};
+    if (FlacProbeSource(&source, &probe) != 0) return false;
+
+    bool has_track_gain = false, has_album_gain = false;
+    double track_gain = 0.0, track_peak = 0.0, album_gain = 0.0, album_peak = 0.0;
+    const char* tag = probe.tags;
+    for (int i = 0; i < probe.tag_count; i++) {
+        size_t length = strlen(tag);
+        const char* separator = static_cast<const char*>(memchr(tag, '=', length));
+        if (separator) {
+            size_t key_length = static_cast<size_t>(separator - tag);
+            const char* value = separator + 1;
+            if (TagKeyEquals(tag, key_length, "REPLAYGAIN_TRACK_GAIN")) {
+                has_track_gain = ParseDecimal(value, &track_gain);
+            } else if (TagKeyEquals(tag, key_length, "REPLAYGAIN_TRACK_PEAK")) {
+                ParseDecimal(value, &track_peak);
+            } else if (TagKeyEquals(tag, key_length, "REPLAYGAIN_ALBUM_GAIN")) {
+                has_album_gain = ParseDecimal(value, &album_gain);
+            } else if (TagKeyEquals(tag, key_length, "REPLAYGAIN_ALBUM_PEAK")) {
+                ParseDecimal(value, &album_peak);
+            }
+        }
+        tag += length + 1;
+    }
+    FreeFlacProbeInfo(&probe);
+
+    if (!has_track_gain) return false;
+    info->source = FLAC_LOUDNESS_TAGGED;
+    info->integrated_lufs = FLAC_LOUDNESS_REFERENCE_LUFS - track_gain;
+    info->true_peak = track_peak;
+    info->track_gain_db = track_gain;
+    if (has_album_gain) {
+        info->has_album_gain = 1;
+        info->album_gain_db = album_gain;
+        info->album_peak = album_peak;
+    }
+    return true;
+}
+
+// ========== 测量 ==========
+
+int FlacLoudnessBatch::Measure(const std::wstring& path, FlacLoudnessInfo* info) const {
+    FILE* file = FlacOpenFileW(path.c_str());
+    if (!file) return -2;
+
+    FlacFileIdentity identity = {};
+    bool has_identity = FlacGetFileIdentity(file, &identity);
+    if (has_identity && LoadCachedLoudness(path, identity, info)) {
+        fclose(file);
+        info->from_cache = 1;
+        return 0;
+    }
+    fclose(file);
+
+    // 解码经 I/O 后端读取（异步队列上多个文件的预读相互重叠）
+    std::unique_ptr<FlacByteSource> source(FlacOpenLocalSource(path.c_str()));
+    if (!source) return -2;
+    drflac* flac = FlacOpenSource(source.get(), FlacPoolAllocationCallbacks());
+    if (!flac) return -3;
+
+    FlacLoudnessMeter meter;
+    if (!meter.Init(static_cast<int>(flac->sampleRate), flac->channels)) {
+        drflac_close(flac);
+        return -3;
+    }
+
+    std::vector<float> buffer(static_cast<size_t>(MEASURE_CHUNK_FRAMES) * flac->channels);
+    uint64_t total = 0;
+    int status = 0;
+    for (;;) {
+        if (cancel_.load(std::memory_order_relaxed)) {
+            status = STATUS_CANCELLED;
+            break;
+        }
+        uint64_t decoded = drflac_read_pcm_frames_f32(flac, MEASURE_CHUNK_FRAMES, buffer.data());
+        meter.Process(buffer.data(), decoded);
+        total += decoded;
+        if (decoded < MEASURE_CHUNK_FRAMES) break;
+    }
+    // STREAMINFO 记录了总帧数却没有解码完，视为文件损坏
+    if (status == 0 && flac->totalPCMFrameCount > 0 && total < flac->totalPCMFrameCount) {
+        status = STATUS_DECODE_FAILED;
+    }
+    drflac_close(flac);
+    if (status != 0) return status;
+
+    info->integrated_lufs = meter.IntegratedLoudness();
+    info->loudness_range_lu = meter.LoudnessRange();
+    info->true_peak = meter.TruePeak();
+    if (has_identity) SaveCachedLoudness(path, identity, *info);
+    return 0;
+}
+
+// ========== 批次 ==========
+
+FlacLoudnessBatch::FlacLoudnessBatch(const wchar_t* const* file_paths, int count, int flags)
+    : flags_(flags), results_(static_cast<size_t>(count)), ready_(new std::atomic<uint8_t>[count]()) {
+    paths_.reserve(static_cast<size_t>(count));
+    for (int i = 0; i < count; i++) {
+        paths_.emplace_back(file_paths[i] ? file_paths[i] : L"");
+    }
+}
+
+FlacLoudnessBatch::~FlacLoudnessBatch() {
+    cancel_.store(true, std::memory_order_relaxed);
+    if (runner_.joinable()) runner_.join();
+}
+
+void FlacLoudnessBatch::Start(int threads) {
+    if (threads <= 0) threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    runner_ = std::thread(&FlacLoudnessBatch::Run, this, threads);
+}
+
+void FlacLoudnessBatch::Run(int threads) {
+    FlacParallelFor(paths_.size(), threads, [this](size_t index) { Analyze(index); });
+}
+
+void FlacLoudnessBatch::Analyze(size_t index) {
+    FlacLoudnessInfo info = {};
+    const std::wstring& path = paths_[index];
+    if (cancel_.load(std::memory_order_relaxed)) {
+        info.status = STATUS_CANCELLED;
+    } else if (path.empty()) {
+        info.status = -2;
+    } else if ((flags_ & FLAC_LOUDNESS_IGNORE_TAGS) || !ReadTags(path, &info)) {
+        info.status = Measure(path, &info);
+        if (info.status == 0) {
+            info.source = FLAC_LOUDNESS_MEASURED;
+            // 没有块高于绝对门限（静音）时不调整
+            info.track_gain_db = info.integrated_lufs > FLAC_LOUDNESS_ABSOLUTE_GATE_LUFS
+                                     ? FLAC_LOUDNESS_REFERENCE_LUFS - info.integrated_lufs
+                                     : 0.0;
+        }
+    }
+    if (info.status != 0) {
+        int status = info.status;
+        info = FlacLoudnessInfo();
+        info.status = status;
+    }
+
+    results_[index] = info;
+    ready_[index].store(1, std::memory_order_release);
+    completed_.fetch_add(1, std::memory_order_acq_rel);
+}
+
+int FlacLoudnessBatch::GetResults(int start, int count, FlacLoudnessInfo* out_results) const {
+    int total = static_cast<int>(results_.size());
+    if (start >= total) return 0;
+    int written = std::min(count, total - start);
+    for (int i = 0; i < written; i++) {
+        size_t index = static_cast<size_t>(start + i);
+        if (ready_[index].load(std::memory_order_acquire)) {
+            out_results[i] = results_[index];
+        } else {
+            out_results[i] = FlacLoudnessInfo();
+            out_results[i].source = FLAC_LOUDNESS_PENDING;
+        }
+    }
+    return written;
+}
+
+// ========== 导出函数 ==========
+
+extern "C" {
+
+FLAC_API void* StartFlacLoudnessBatch(const wchar_t* const* file_paths, int count, int threads, int flags) {
+    if (!file_paths || count <= 0) {
+        FlacSetLastError("Invalid arguments");
+        return nullptr;
+    }
+
+    FlacLoudnessBatch* batch = new FlacLoudnessBatch(file_paths, count, flags);
+    batch->Start(threads);
+    return batch;
+}
+
+FLAC_API int GetFlacLoudnessProgress(void* batch) {
+    if (!batch) {
+        FlacSetLastError("Batch handle is NULL");
+        return -1;
+    }
+    return static_cast<FlacLoudnessBatch*>(batch)->Completed();
+}
+
+FLAC_API int GetFlacLoudnessResults(void* batch, int start, int count, FlacLoudnessInfo* out_results) {
+    if (!batch || start < 0 || count < 0 || (count > 0 && !out_results)) {
+        FlacSetLastError("Invalid arguments");
+        return -1;
+    }
+    return static_cast<FlacLoudnessBatch*>(batch)->GetResults(start, count, out_results);
+}
+
+FLAC_API void CloseFlacLoudnessBatch(void* batch) {
+    delete static_cast<FlacLoudnessBatch*>(batch);
+}
+
+} // extern "C"
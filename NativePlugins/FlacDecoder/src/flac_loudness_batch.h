@@ -0,0 +1,58 @@
+#ifndef CHILL_FLAC_LOUDNESS_BATCH_H
+#define CHILL_FLAC_LOUDNESS_BATCH_H
+
+// 批量响度分析：后台线程以 FlacParallelFor 在多个核心上逐个文件处理。
+//
+// 每个文件：先经元数据探测读取 REPLAYGAIN_* 标签（有曲目增益时直接采用），
+// 否则查找旁路缓存，仍没有时解码整个文件送入 FlacLoudnessMeter 测量并写入缓存。
+//
+// 旁路文件（小端，<缓存目录>/<路径哈希>.loudness）：
+//   { "CFLN", 版本, 文件大小, 修改时间, 综合响度, 响度范围, 真峰值（后三项为 double 的位模式） }
+
+#include "flac_decoder.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+class FlacLoudnessBatch {
+public:
+    FlacLoudnessBatch(const wchar_t* const* file_paths, int count, int flags);
+    ~FlacLoudnessBatch();
+
+    FlacLoudnessBatch(const FlacLoudnessBatch&) = delete;
+    FlacLoudnessBatch& operator=(const FlacLoudnessBatch&) = delete;
+
+    void Start(int threads);
+
+    int Completed() const { return completed_.load(std::memory_order_acquire); }
+
+    // 拷贝 [start, start + count) 的结果，未完成的项 source 为 FLAC_LOUDNESS_PENDING，返回写入数量
+    int GetResults(int start, int count, FlacLoudnessInfo* out_results) const;
+
+private:
+    void Run(int threads);
+    void Analyze(size_t index);
+
+    // 读取标签中的 ReplayGain，有曲目增益时返回 true
+    bool ReadTags(const std::wstring& path, FlacLoudnessInfo* info) const;
+
+    // 解码测量，返回状态码（同 FlacLoudnessInfo::status）
+    int Measure(const std::wstring& path, FlacLoudnessInfo* info) const;
+
+    std::vector<std::wstring> paths_;
+    int flags_ = 0;
+
+    // results_[i] 在 ready_[i] 以 release 置位后不再修改
+    std::vector<FlacLoudnessInfo> results_;
+    std::unique_ptr<std::atomic<uint8_t>[]> ready_;
+    std::atomic<int> completed_{0};
+
+    std::thread runner_;
+    std::atomic<bool> cancel_{false};
+};
+
+#endif // CHILL_FLAC_LOUDNESS_BATCH_H
@@ -0,0 +1,305 @@
+#include "flac_memory.h"
+#include "flac_internal.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+// 块头：级别 + 可用字节数，16 字节保持系统堆返回地址的对齐
+struct PoolBlockHeader {
+    uint32_t size_class;
+    uint32_t reserved;
+    uint64_t usable;
+};
+static_assert(sizeof(PoolBlockHeader) == 16, "Block header must keep 16-byte alignment");
+
+static const size_t HEADER_BYTES = sizeof(PoolBlockHeader);
+static const size_t MIN_CLASS_BYTES = 64;
+static const size_t MAX_CLASS_BYTES = 4 * 1024 * 1024;
+static const uint32_t LARGE_CLASS = UINT32_MAX;
+
+// 池中保留的空闲块总量上限，超出时释放的块直接交还系统堆
+static const uint64_t POOL_RETAIN_BYTES = 32 * 1024 * 1024;
+
+static PoolBlockHeader* HeaderOf(const void* block) {
+    return reinterpret_cast<PoolBlockHeader*>(const_cast<uint8_t*>(static_cast<const uint8_t*>(block)) - HEADER_BYTES);
+}
+
+static size_t RoundUp16(size_t bytes) {
+    return (bytes + 15) & ~static_cast<size_t>(15);
+}
+
+// ========== 块池 ==========
+
+namespace {
+
+// 空闲块的第一个字（块头之后）链接到同级别的下一个空闲块
+struct FreeBlock {
+    FreeBlock* next;
+};
+
+class BlockPool {
+public:
+    BlockPool() {
+        for (size_t base = MIN_CLASS_BYTES; base < MAX_CLASS_BYTES; base *= 2) {
+            for (size_t step = 0; step < 4; step++) class_bytes_.push_back(base + base / 4 * step);
+        }
+        class_bytes_.push_back(MAX_CLASS_BYTES);
+        free_.assign(class_bytes_.size(), nullptr);
+    }
+
+    void* Alloc(size_t bytes) {
+        if (bytes > SIZE_MAX - HEADER_BYTES - MIN_CLASS_BYTES) return nullptr;
+        size_t total = bytes + HEADER_BYTES;
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        stats_.allocations++;
+
+        uint32_t size_class = LARGE_CLASS;
+        uint8_t* raw = nullptr;
+        if (total <= MAX_CLASS_BYTES) {
+            size_class = static_cast<uint32_t>(
+                std::lower_bound(class_bytes_.begin(), class_bytes_.end(), total) - class_bytes_.begin());
+            total = class_bytes_[size_class];
+            if (free_[size_class]) {
+                FreeBlock* reused = free_[size_class];
+                free_[size_class] = reused->next;
+                stats_.cached_bytes -= total;
+                raw = reinterpret_cast<uint8_t*>(reused) - HEADER_BYTES;
+            }
+        }
+        if (!raw) {
+            stats_.heap_allocations++;
+            lock.unlock();
+            raw = static_cast<uint8_t*>(malloc(total));
+            if (!raw) return nullptr;
+            lock.lock();
+        }
+
+        stats_.current_bytes += total;
+        stats_.peak_bytes = std::max(stats_.peak_bytes, stats_.current_bytes);
+        lock.unlock();
+
+        PoolBlockHeader* header = reinterpret_cast<PoolBlockHeader*>(raw);
+        header->size_class = size_class;
+        header->reserved = 0;
+        header->usable = total - HEADER_BYTES;
+        return raw + HEADER_BYTES;
+    }
+
+    void Free(void* block) {
+        PoolBlockHeader* header = HeaderOf(block);
+        size_t total = static_cast<size_t>(header->usable) + HEADER_BYTES;
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        stats_.current_bytes -= total;
+        if (header->size_class != LARGE_CLASS && stats_.cached_bytes + total <= POOL_RETAIN_BYTES) {
+            FreeBlock* freed = static_cast<FreeBlock*>(block);
+            freed->next = free_[header->size_class];
+            free_[header->size_class] = freed;
+            stats_.cached_bytes += total;
+            return;
+        }
+        lock.unlock();
+        free(header);
+    }
+
+    void Trim() {
+        std::vector<FreeBlock*> lists;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            lists.swap(free_);
+            free_.assign(class_bytes_.size(), nullptr);
+            stats_.cached_bytes = 0;
+        }
+        for (FreeBlock* block : lists) {
+            while (block) {
+                FreeBlock* next = block->next;
+                free(reinterpret_cast<uint8_t*>(block) - HEADER_BYTES);
+                block = next;
+            }
+        }
+    }
+
+    void AddArena(int delta) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.live_arenas += delta;
+    }
+
+    FlacMemoryStats Stats() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stats_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<size_t> class_bytes_;   // 各级别的块尺寸（含块头），递增
+    std::vector<FreeBlock*> free_;
+    FlacMemoryStats stats_ = {};
+};
+
+} // namespace
+
+// 不随进程退出析构：其他静态对象析构时仍可能释放 drflac 实例
+static BlockPool& Pool() {
+    static BlockPool* pool = new BlockPool();
+    return *pool;
+}
+
+void* FlacPoolAlloc(size_t bytes) {
+    return Pool().Alloc(bytes);
+}
+
+void* FlacPoolRealloc(void* block, size_t bytes) {
+    if (!block) return FlacPoolAlloc(bytes);
+    size_t usable = FlacPoolUsableSize(block);
+    if (bytes <= usable) return block;
+
+    void* grown = FlacPoolAlloc(bytes);
+    if (!grown) return nullptr;
+    memcpy(grown, block, usable);
+    FlacPoolFree(block);
+    return grown;
+}
+
+void FlacPoolFree(void* block) {
+    if (block) Pool().Free(block);
+}
+
+size_t FlacPoolUsableSize(const void* block) {
+    return static_cast<size_t>(HeaderOf(block)->usable);
+}
+
+static void* OnPoolMalloc(size_t bytes, void*) {
+    return FlacPoolAlloc(bytes);
+}
+
+static void* OnPoolRealloc(void* block, size_t bytes, void*) {
+    return FlacPoolRealloc(block, bytes);
+}
+
+static void OnPoolFree(void* block, void*) {
+    FlacPoolFree(block);
+}
+
+const drflac_allocation_callbacks* FlacPoolAllocationCallbacks() {
+    static const drflac_allocation_callbacks callbacks = { nullptr, OnPoolMalloc, OnPoolRealloc, OnPoolFree };
+    return &callbacks;
+}
+
+void FlacGetMemoryStats(FlacMemoryStats* out_stats) {
+    *out_stats = Pool().Stats();
+}
+
+void FlacTrimMemoryPool() {
+    Pool().Trim();
+}
+
+// ========== FlacArena ==========
+
+FlacArena::FlacArena() {
+    callbacks_.pUserData = this;
+    callbacks_.onMalloc = OnMalloc;
+    callbacks_.onRealloc = OnRealloc;
+    callbacks_.onFree = OnFree;
+    Pool().AddArena(1);
+}
+
+FlacArena::~FlacArena() {
+    FlacPoolFree(chunk_);
+    Pool().AddArena(-1);
+}
+
+void* FlacArena::OnMalloc(size_t bytes, void* user_data) {
+    return static_cast<FlacArena*>(user_data)->Alloc(bytes);
+}
+
+void* FlacArena::OnRealloc(void* block, size_t bytes, void* user_data) {
+    return static_cast<FlacArena*>(user_data)->Realloc(block, bytes);
+}
+
+void FlacArena::OnFree(void* block, void* user_data) {
+    static_cast<FlacArena*>(user_data)->Free(block);
+}
+
+bool FlacArena::Owns(const void* block) const {
+    const uint8_t* p = static_cast<const uint8_t*>(block);
+    return chunk_ && p >= chunk_ && p < chunk_ + capacity_;
+}
+
+void* FlacArena::Alloc(size_t bytes) {
+    if (bytes > SIZE_MAX / 2) return nullptr;
+    size_t need = HEADER_BYTES + RoundUp16(bytes);
+    if (!chunk_) {
+        size_t chunk_bytes = MIN_CHUNK_BYTES;
+        if (need > chunk_bytes) chunk_bytes = need;
+        chunk_ = static_cast<uint8_t*>(FlacPoolAlloc(chunk_bytes));
+        if (!chunk_) return nullptr;
+        capacity_ = FlacPoolUsableSize(chunk_);
+    }
+    if (need > capacity_ - used_) return FlacPoolAlloc(bytes);
+
+    PoolBlockHeader* header = reinterpret_cast<PoolBlockHeader*>(chunk_ + used_);
+    header->size_class = LARGE_CLASS;
+    header->reserved = 0;
+    header->usable = bytes;
+    last_ = used_;
+    used_ += need;
+    return chunk_ + last_ + HEADER_BYTES;
+}
+
+void* FlacArena::Realloc(void* block, size_t bytes) {
+    if (!block) return Alloc(bytes);
+    if (!Owns(block)) return FlacPoolRealloc(block, bytes);
+
+    PoolBlockHeader* header = HeaderOf(block);
+    if (bytes <= header->usable) return block;
+
+    // 最近一次的分配在原地扩展
+    size_t offset = static_cast<size_t>(reinterpret_cast<uint8_t*>(header) - chunk_);
+    if (offset == last_ && bytes <= SIZE_MAX / 2 && HEADER_BYTES + RoundUp16(bytes) <= capacity_ - offset) {
+        header->usable = bytes;
+        used_ = offset + HEADER_BYTES + RoundUp16(bytes);
+        return block;
+    }
+
+    void* grown = Alloc(bytes);
+    if (!grown) return nullptr;
+    memcpy(grown, block, static_cast<size_t>(header->usable));
+    Free(block);
+    return grown;
+}
+
+void FlacArena::Free(void* block) {
+    if (!block) return;
+    if (!Owns(block)) {
+        FlacPoolFree(block);
+        return;
+    }
+    size_t offset = static_cast<size_t>(static_cast<uint8_t*>(block) - HEADER_BYTES - chunk_);
+    if (offset == last_) {
+        used_ = last_;
+        last_ = SIZE_MAX;
+    }
+}
+
+// ========== 导出函数 ==========
+
+extern "C" {
+
+FLAC_API int GetFlacMemoryStats(FlacMemoryStats* out_stats) {
+    if (!out_stats) {
+        FlacSetLastError("Output pointer is NULL");
+        return -1;
+    }
+    FlacGetMemoryStats(out_stats);
+    return 0;
+}
+
+FLAC_API void TrimFlacMemoryPool() {
+    FlacTrimMemoryPool();
+}
+
+} // extern "C"
@@ -0,0 +1,71 @@
+#ifndef CHILL_FLAC_MEMORY_H
+#define CHILL_FLAC_MEMORY_H
+
+// dr_flac 实例的内存：分配回调由按尺寸分级的块池提供，释放的块留在池中供下一次同级别的请求复用。
+//
+// drflac 实例的主要分配（结构体 + 解码缓冲，随最大块长和声道数变化）在切歌、整文件解码和后台扫描中反复发生，
+// 经池复用后稳定状态下不再向系统堆申请，长时间运行的游戏进程中也不会因此产生堆碎片。
+// 每级尺寸为 2 的幂的 1 / 1.25 / 1.5 / 1.75 倍（含 16 字节块头），超过 4MB 的请求直接向系统堆申请。
+//
+// 每个流另有一个 bump arena：首次分配时从池中取一块，流内的分配依次切分，流关闭时整块归还。
+
+#include "dr_flac.h"
+#include "flac_decoder.h"
+
+#include <cstddef>
+#include <cstdint>
+
+// 块池（线程安全），返回地址的对齐与系统堆相同（64 位上为 16 字节）
+void* FlacPoolAlloc(size_t bytes);
+void* FlacPoolRealloc(void* block, size_t bytes);
+void FlacPoolFree(void* block);
+
+// 块的可用字节数（不小于申请的字节数）
+size_t FlacPoolUsableSize(const void* block);
+
+// 直接使用块池的 dr_flac 分配回调（整文件解码、波形概览、批量响度分析）
+const drflac_allocation_callbacks* FlacPoolAllocationCallbacks();
+
+// 单个流的 bump arena：只由打开 / 关闭该流的 drflac 实例的线程使用
+//
+// 释放最近一次的分配时回退切分位置，其余释放在整块归还时一并回收；放不下的请求转交块池。
+class FlacArena {
+public:
+    // 块的最小尺寸，足够容纳双声道、最大块长 4096 的 drflac 实例（更大的首次请求按请求尺寸取块）
+    static const size_t MIN_CHUNK_BYTES = 64 * 1024;
+
+    FlacArena();
+    ~FlacArena();
+
+    FlacArena(const FlacArena&) = delete;
+    FlacArena& operator=(const FlacArena&) = delete;
+
+    const drflac_allocation_callbacks* Callbacks() const { return &callbacks_; }
+
+    // 已从块池取得的块的字节数（尚未分配时为 0）
+    size_t ChunkBytes() const { return capacity_; }
+
+private:
+    static void* OnMalloc(size_t bytes, void* user_data);
+    static void* OnRealloc(void* block, size_t bytes, void* user_data);
+    static void OnFree(void* block, void* user_data);
+
+    void* Alloc(size_t bytes);
+    void* Realloc(void* block, size_t bytes);
+    void Free(void* block);
+    bool Owns(const void* block) const;
+
+    drflac_allocation_callbacks callbacks_;
+    uint8_t* chunk_ = nullptr;
+    size_t capacity_ = 0;
+    size_t used_ = 0;
+    size_t last_ = SIZE_MAX;    // 最近一次分配的块头位置
+};
+
+// 填写 FlacMemoryStats
+void FlacGetMemoryStats(FlacMemoryStats* out_stats);
+
+// 把池中保留的空闲块交还系统堆
+void FlacTrimMemoryPool();
+
+#endif // CHILL_FLAC_MEMORY_H
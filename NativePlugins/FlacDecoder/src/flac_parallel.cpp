@@ -0,0 +1,38 @@
+#include "flac_parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+static const int MIN_IO_THREADS = 4;
+static const int MAX_IO_THREADS = 32;
+
+int FlacDefaultIoThreads() {
+    int cores = static_cast<int>(std::thread::hardware_concurrency());
+    return std::min(MAX_IO_THREADS, std::max(MIN_IO_THREADS, cores * 2));
+}
+
+void FlacParallelFor(size_t count, int threads, const std::function<void(size_t)>& task) {
+    if (count == 0) return;
+    if (threads <= 0) threads = FlacDefaultIoThreads();
+    size_t workers = std::min(static_cast<size_t>(threads), count);
+
+    std::atomic<size_t> next{0};
+    auto run = [&]() {
+        for (size_t i = next.fetch_add(1, std::memory_order_relaxed); i < count;
+             i = next.fetch_add(1, std::memory_order_relaxed)) {
+            task(i);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for (size_t i = 1; i < workers; i++) {
+        pool.emplace_back(run);
+    }
+    run();
+    for (std::thread& thread : pool) {
+        thread.join();
+    }
+}
@@ -0,0 +1,15 @@
+#ifndef CHILL_FLAC_PARALLEL_H
+#define CHILL_FLAC_PARALLEL_H
+
+// 简单的并行 for：任务按原子计数器逐个领取，调用线程也参与执行，全部完成后返回。
+
+#include <cstddef>
+#include <functional>
+
+// I/O 密集任务（打开 / 读取大量小文件）的默认线程数：多于 CPU 核心数以掩盖网络存储的延迟
+int FlacDefaultIoThreads();
+
+// 以最多 threads 个线程（含调用线程）执行 task(0) ... task(count - 1)，threads <= 0 时使用 FlacDefaultIoThreads()
+void FlacParallelFor(size_t count, int threads, const std::function<void(size_t)>& task);
+
+#endif // CHILL_FLAC_PARALLEL_H
@@ -0,0 +1,170 @@
+#include "flac_pcm.h"
+
+#include "flac_decoder.h"
+#include "flac_simd.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// 抖动路径每次通过 s32 中转解码的最大帧数
+static const uint64_t DITHER_CHUNK_FRAMES = 1024;
+
+// 软限幅拐点：-1 dBFS
+static const float LIMITER_THRESHOLD = 0.891251f;
+
+bool FlacIsValidSampleFormat(int sample_format) {
+    return sample_format == FLAC_SAMPLE_F32 ||
+           sample_format == FLAC_SAMPLE_S16 ||
+           sample_format == FLAC_SAMPLE_F32_PLANAR;
+}
+
+size_t FlacStorageFrameBytes(int sample_format, int channels) {
+    size_t sample_bytes = sample_format == FLAC_SAMPLE_S16 ? sizeof(int16_t) : sizeof(float);
+    return sample_bytes * static_cast<size_t>(channels);
+}
+
+// ========== 解码 ==========
+
+void FlacPcmDecoder::Reset(int sample_format, bool dither, int bits_per_sample, int channels) {
+    format_ = sample_format;
+    channels_ = channels;
+    dither_ = sample_format == FLAC_SAMPLE_S16 && dither && bits_per_sample > 16;
+    // 经过缩混 / 重采样 / 增益的数据不再是整数采样，与源位深无关
+    float_dither_ = sample_format == FLAC_SAMPLE_S16 && dither;
+    scratch_.clear();
+    if (dither_) {
+        scratch_.resize(static_cast<size_t>(DITHER_CHUNK_FRAMES) * channels);
+    }
+}
+
+uint64_t FlacPcmDecoder::Decode(drflac* flac, void* out, uint64_t frames) {
+    if (format_ != FLAC_SAMPLE_S16) {
+        return drflac_read_pcm_frames_f32(flac, frames, static_cast<float*>(out));
+    }
+    if (dither_) {
+        return DecodeDithered(flac, static_cast<int16_t*>(out), frames);
+    }
+    // 源位深 <= 16 时无损；高位深源直接截断低位
+    return drflac_read_pcm_frames_s16(flac, frames, static_cast<drflac_int16*>(out));
+}
+
+// 高位深源 → s16：先解码为左对齐的 s32，加 TPDF 抖动（两个均匀分布之差，±1 LSB）后舍入
+uint64_t FlacPcmDecoder::DecodeDithered(drflac* flac, int16_t* out, uint64_t frames) {
+    uint64_t total = 0;
+    while (total < frames) {
+        uint64_t chunk = std::min(frames - total, DITHER_CHUNK_FRAMES);
+        uint64_t decoded = drflac_read_pcm_frames_s32(flac, chunk, scratch_.data());
+
+        size_t samples = static_cast<size_t>(decoded) * channels_;
+        int16_t* dst = out + static_cast<size_t>(total) * channels_;
+        for (size_t i = 0; i < samples; i++) {
+            uint32_t r = NextRandom();
+            int64_t noise = static_cast<int64_t>(r & 0xFFFF) - static_cast<int64_t>(r >> 16);
+
+            int64_t value = (static_cast<int64_t>(scratch_[i]) + noise + 0x8000) >> 16;
+            dst[i] = static_cast<int16_t>(std::max<int64_t>(-32768, std::min<int64_t>(32767, value)));
+        }
+
+        total += decoded;
+        if (decoded < chunk) break;
+    }
+    return total;
+}
+
+void FlacPcmDecoder::FromFloat(const float* in, void* out, size_t samples) {
+    if (format_ != FLAC_SAMPLE_S16) {
+        memcpy(out, in, samples * sizeof(float));
+        return;
+    }
+
+    int16_t* dst = static_cast<int16_t*>(out);
+    for (size_t i = 0; i < samples; i++) {
+        float scaled = in[i] * 32768.0f;
+        if (float_dither_) {
+            uint32_t r = NextRandom();
+            scaled += static_cast<float>(static_cast<int32_t>(r & 0xFFFF) - static_cast<int32_t>(r >> 16)) * (1.0f / 65536.0f);
+        }
+        float rounded = std::floor(scaled + 0.5f);
+        dst[i] = static_cast<int16_t>(std::max(-32768.0f, std::min(32767.0f, rounded)));
+    }
+}
+
+// xorshift32：高低 16 位作为两个独立的均匀分布，相减得到三角分布（TPDF）
+uint32_t FlacPcmDecoder::NextRandom() {
+    rng_state_ ^= rng_state_ << 13;
+    rng_state_ ^= rng_state_ >> 17;
+    rng_state_ ^= rng_state_ << 5;
+    return rng_state_;
+}
+
+// xorshift32 是 GF(2) 上的线性变换：matrix[i] 为基向量 1 << i 的像，按位异或即矩阵乘向量
+static uint32_t ApplyMatrix(const uint32_t* matrix, uint32_t v) {
+    uint32_t result = 0;
+    for (int i = 0; v != 0; i++, v >>= 1) {
+        if (v & 1) result ^= matrix[i];
+    }
+    return result;
+}
+
+// out = a × b（先 b 后 a）
+static void MultiplyMatrix(const uint32_t* a, const uint32_t* b, uint32_t* out) {
+    uint32_t product[32];
+    for (int i = 0; i < 32; i++) product[i] = ApplyMatrix(a, b[i]);
+    memcpy(out, product, sizeof(product));
+}
+
+// 按平方求幂跳过 samples 步，O(log samples) 次 32×32 矩阵乘法
+void FlacPcmDecoder::SeekDither(uint64_t samples) {
+    uint32_t step[32], jump[32];
+    for (int i = 0; i < 32; i++) {
+        uint32_t x = 1u << i;
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        step[i] = x;
+        jump[i] = 1u << i;
+    }
+    for (; samples != 0; samples >>= 1) {
+        if (samples & 1) MultiplyMatrix(step, jump, jump);
+        MultiplyMatrix(step, step, step);
+    }
+    rng_state_ = ApplyMatrix(jump, FLAC_DITHER_SEED);
+}
+
+// ========== 增益 ==========
+
+void FlacApplyGain(float* data, size_t samples, float gain, bool limiter) {
+    float peak = FlacGetPcmKernels().gain_f32(data, samples, gain);
+    if (!limiter || peak <= LIMITER_THRESHOLD) return;
+
+    // 拐点以上：T + (1 - T) * tanh((|x| - T) / (1 - T))，斜率在拐点处连续，渐近 1.0
+    const float knee = 1.0f - LIMITER_THRESHOLD;
+    for (size_t i = 0; i < samples; i++) {
+        float magnitude = std::fabs(data[i]);
+        if (magnitude <= LIMITER_THRESHOLD) continue;
+        float limited = LIMITER_THRESHOLD + knee * std::tanh((magnitude - LIMITER_THRESHOLD) / knee);
+        data[i] = data[i] < 0.0f ? -limited : limited;
+    }
+}
+
+// ========== 输出布局 ==========
+
+void FlacDeinterleave(const float* in, uint64_t frames, int channels, float* out, uint64_t plane_stride) {
+    FlacGetPcmKernels().deinterleave_f32(in, frames, channels, out, plane_stride);
+}
+
+void FlacFillSilence(void* out, int sample_format, int channels, uint64_t offset, uint64_t frames, uint64_t plane_stride) {
+    if (frames == 0) return;
+
+    if (sample_format == FLAC_SAMPLE_F32_PLANAR) {
+        float* base = static_cast<float*>(out);
+        for (int c = 0; c < channels; c++) {
+            memset(base + static_cast<uint64_t>(c) * plane_stride + offset, 0, frames * sizeof(float));
+        }
+        return;
+    }
+
+    size_t frame_bytes = FlacStorageFrameBytes(sample_format, channels);
+    memset(static_cast<uint8_t*>(out) + offset * frame_bytes, 0, frames * frame_bytes);
+}
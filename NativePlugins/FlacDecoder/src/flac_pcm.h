@@ -0,0 +1,59 @@
+#ifndef CHILL_FLAC_PCM_H
+#define CHILL_FLAC_PCM_H
+
+// PCM 输出格式：解码器和预解码环使用交错的存储格式（f32 或 s16），
+// 平面格式在交给调用者时才解交错。
+
+#include "dr_flac.h"
+
+#include <cstdint>
+#include <vector>
+
+// 是否为 FlacSampleFormat 中定义的格式
+bool FlacIsValidSampleFormat(int sample_format);
+
+// 存储格式（交错）每帧字节数：s16 为 2 * 声道数，其余为 4 * 声道数
+size_t FlacStorageFrameBytes(int sample_format, int channels);
+
+// 抖动随机数的初始状态
+static const uint32_t FLAC_DITHER_SEED = 0x9E3779B9u;
+
+// 解码为存储格式。只由解码方使用（线程不安全）
+class FlacPcmDecoder {
+public:
+    // dither 在输出 s16 且源位深 > 16 时作用于解码，输出 s16 时总是作用于 FromFloat
+    void Reset(int sample_format, bool dither, int bits_per_sample, int channels);
+
+    // 返回实际解码的帧数
+    uint64_t Decode(drflac* flac, void* out, uint64_t frames);
+
+    // 已在 Native 侧处理过的 f32 数据（如重采样 / 增益输出）转换为存储格式
+    void FromFloat(const float* in, void* out, size_t samples);
+
+    size_t FrameBytes() const { return FlacStorageFrameBytes(format_, channels_); }
+
+    // 把抖动随机数置于第 samples 个采样处，从该位置开始解码的结果与从头顺序解码逐位一致（并行分段解码）
+    void SeekDither(uint64_t samples);
+
+private:
+    uint64_t DecodeDithered(drflac* flac, int16_t* out, uint64_t frames);
+    uint32_t NextRandom();
+
+    int format_ = 0;
+    int channels_ = 0;
+    bool dither_ = false;
+    bool float_dither_ = false;
+    uint32_t rng_state_ = FLAC_DITHER_SEED;
+    std::vector<int32_t> scratch_;
+};
+
+// 原地施加线性增益；limiter 为 true 时超过 -1 dBFS 的采样经 tanh 软拐点压缩到 1.0 以内
+void FlacApplyGain(float* data, size_t samples, float gain, bool limiter);
+
+// 交错 f32 → 平面 f32：声道 c 的第 i 帧写到 out[c * plane_stride + i]（SIMD 内核，见 flac_simd.h）
+void FlacDeinterleave(const float* in, uint64_t frames, int channels, float* out, uint64_t plane_stride);
+
+// 以静音填充输出格式的 [offset, offset + frames)，平面格式按 plane_stride 定位各声道
+void FlacFillSilence(void* out, int sample_format, int channels, uint64_t offset, uint64_t frames, uint64_t plane_stride);
+
+#endif // CHILL_FLAC_PCM_H
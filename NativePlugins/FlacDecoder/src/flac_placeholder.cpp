@@ -0,0 +1,311 @@
+#include "flac_internal.h"
+#include "flac_cover.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+// 占位图从 32×32 的缩略图计算：缩小时已按面积平均，足以代表整张封面的颜色分布
+static const int SAMPLE_SIZE = 32;
+
+// blurhash 分量数（横向 × 纵向），输出 4 + 2 * 4 * 3 = 28 个字符
+static const int HASH_COMPONENTS_X = 4;
+static const int HASH_COMPONENTS_Y = 3;
+
+// 主色之间的最小距离（RGB 欧氏距离的平方），更接近的直方图格子视为同一种颜色
+static const int MIN_COLOR_DISTANCE_SQ = 48 * 48;
+
+static const double PI = 3.14159265358979323846;
+
+static const char BASE83[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz#$%*+,-.:;=?@[]^_{|}~";
+
+// ========== 颜色空间 ==========
+
+static float SrgbToLinear(int value) {
+    double v = value / 255.0;
+    return static_cast<float>(v <= 0.04045 ? v / 12.92 : std::pow((v + 0.055) / 1.055, 2.4));
+}
+
+static int LinearToSrgb(float value) {
+    double v = std::max(0.0, std::min(1.0, static_cast<double>(value)));
+    double srgb = v <= 0.0031308 ? v * 12.92 : 1.055 * std::pow(v, 1.0 / 2.4) - 0.055;
+    return static_cast<int>(srgb * 255.0 + 0.5);
+}
+
+static const float* SrgbToLinearTable() {
+    static const std::vector<float> table = [] {
+        std::vector<float> t(256);
+        for (int i = 0; i < 256; i++) t[i] = SrgbToLinear(i);
+        return t;
+    }();
+    return table.data();
+}
+
+static float SignPow(float value, float exponent) {
+    return std::copysign(std::pow(std::fabs(value), exponent), value);
+}
+
+// ========== 主色 ==========
+
+struct ColorBin {
+    int count = 0;
+    int sum[3] = { 0, 0, 0 };
+};
+
+static int DistanceSq(const int* a, const int* b) {
+    int dr = a[0] - b[0], dg = a[1] - b[1], db = a[2] - b[2];
+    return dr * dr + dg * dg + db * db;
+}
+
+// 每通道 4 位的直方图，按像素数从多到少选出彼此距离足够远的格子（格子内取平均色），
+// 再把每个像素归入最近的主色统计占比。alpha < 128 的像素不参与
+static void ComputeDominantColors(const uint8_t* rgba, int pixels, FlacCoverPlaceholder* out) {
+    std::vector<ColorBin> bins(4096);
+    int opaque = 0;
+    for (int i = 0; i < pixels; i++) {
+        const uint8_t* p = rgba + i * 4;
+        if (p[3] < 128) continue;
+        ColorBin& bin = bins[((p[0] >> 4) << 8) | ((p[1] >> 4) << 4) | (p[2] >> 4)];
+        bin.count++;
+        for (int c = 0; c < 3; c++) bin.sum[c] += p[c];
+        opaque++;
+    }
+    if (opaque == 0) return;
+
+    std::vector<int> order;
+    for (int i = 0; i < 4096; i++) {
+        if (bins[i].count > 0) order.push_back(i);
+    }
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return bins[a].count > bins[b].count; });
+
+    int colors[FLAC_PLACEHOLDER_MAX_COLORS][3];
+    int count = 0;
+    for (int index : order) {
+        const ColorBin& bin = bins[index];
+        int mean[3];
+        for (int c = 0; c < 3; c++) mean[c] = (bin.sum[c] + bin.count / 2) / bin.count;
+
+        bool distinct = true;
+        for (int k = 0; k < count && distinct; k++) {
+            distinct = DistanceSq(mean, colors[k]) >= MIN_COLOR_DISTANCE_SQ;
+        }
+        if (!distinct) continue;
+        memcpy(colors[count], mean, sizeof(mean));
+        if (++count == FLAC_PLACEHOLDER_MAX_COLORS) break;
+    }
+
+    int members[FLAC_PLACEHOLDER_MAX_COLORS] = { 0 };
+    for (int i = 0; i < pixels; i++) {
+        const uint8_t* p = rgba + i * 4;
+        if (p[3] < 128) continue;
+        int px[3] = { p[0], p[1], p[2] };
+        int nearest = 0;
+        for (int k = 1; k < count; k++) {
+            if (DistanceSq(px, colors[k]) < DistanceSq(px, colors[nearest])) nearest = k;
+        }
+        members[nearest]++;
+    }
+
+    // 按占比重新排序（归并后第一个格子不一定占比最大）
+    int rank[FLAC_PLACEHOLDER_MAX_COLORS];
+    for (int k = 0; k < count; k++) rank[k] = k;
+    std::stable_sort(rank, rank + count, [&](int a, int b) { return members[a] > members[b]; });
+
+    for (int k = 0; k < count; k++) {
+        const int* c = colors[rank[k]];
+        out->colors[k] = (static_cast<unsigned int>(c[0]) << 16) | (static_cast<unsigned int>(c[1]) << 8) | static_cast<unsigned int>(c[2]);
+        out->weights[k] = static_cast<float>(members[rank[k]]) / static_cast<float>(opaque);
+    }
+    out->color_count = count;
+}
+
+// ========== blurhash ==========
+
+static char* EncodeBase83(int value, int length, char* dst) {
+    for (int i = 1; i <= length; i++) {
+        int digit = value;
+        for (int k = 0; k < length - i; k++) digit /= 83;
+        *dst++ = BASE83[digit % 83];
+    }
+    return dst;
+}
+
+static bool DecodeBase83(const char* src, int length, int* value) {
+    *value = 0;
+    for (int i = 0; i < length; i++) {
+        const char* digit = strchr(BASE83, src[i]);
+        if (!src[i] || !digit) return false;
+        *value = *value * 83 + static_cast<int>(digit - BASE83);
+    }
+    return true;
+}
+
+// rgba 为 Unity 行序（第 0 行在最下面），blurhash 的 y 从上往下
+static void EncodeBlurhash(const uint8_t* rgba, int size, char* out) {
+    const float* to_linear = SrgbToLinearTable();
+    float basis_x[HASH_COMPONENTS_X][SAMPLE_SIZE];
+    float basis_y[HASH_COMPONENTS_Y][SAMPLE_SIZE];
+    for (int i = 0; i < HASH_COMPONENTS_X; i++) {
+        for (int x = 0; x < size; x++) basis_x[i][x] = static_cast<float>(std::cos(PI * i * x / size));
+    }
+    for (int j = 0; j < HASH_COMPONENTS_Y; j++) {
+        for (int y = 0; y < size; y++) basis_y[j][y] = static_cast<float>(std::cos(PI * j * y / size));
+    }
+
+    float factors[HASH_COMPONENTS_X * HASH_COMPONENTS_Y][3] = {};
+    for (int row = 0; row < size; row++) {
+        int y = size - 1 - row;
+        for (int x = 0; x < size; x++) {
+            const uint8_t* p = rgba + (static_cast<size_t>(row) * size + x) * 4;
+            float linear[3] = { to_linear[p[0]], to_linear[p[1]], to_linear[p[2]] };
+            for (int j = 0; j < HASH_COMPONENTS_Y; j++) {
+                for (int i = 0; i < HASH_COMPONENTS_X; i++) {
+                    float basis = basis_x[i][x] * basis_y[j][y];
+                    float* f = factors[j * HASH_COMPONENTS_X + i];
+                    for (int c = 0; c < 3; c++) f[c] += basis * linear[c];
+                }
+            }
+        }
+    }
+    for (int k = 0; k < HASH_COMPONENTS_X * HASH_COMPONENTS_Y; k++) {
+        float scale = (k == 0 ? 1.0f : 2.0f) / static_cast<float>(size * size);
+        for (int c = 0; c < 3; c++) factors[k][c] *= scale;
+    }
+
+    char* dst = EncodeBase83((HASH_COMPONENTS_X - 1) + (HASH_COMPONENTS_Y - 1) * 9, 1, out);
+
+    float max_ac = 0.0f;
+    for (int k = 1; k < HASH_COMPONENTS_X * HASH_COMPONENTS_Y; k++) {
+        for (int c = 0; c < 3; c++) max_ac = std::max(max_ac, std::fabs(factors[k][c]));
+    }
+    int quantised_max = std::max(0, std::min(82, static_cast<int>(std::floor(max_ac * 166.0f - 0.5f))));
+    float max_value = (quantised_max + 1) / 166.0f;
+    dst = EncodeBase83(quantised_max, 1, dst);
+
+    int dc = (LinearToSrgb(factors[0][0]) << 16) | (LinearToSrgb(factors[0][1]) << 8) | LinearToSrgb(factors[0][2]);
+    dst = EncodeBase83(dc, 4, dst);
+
+    for (int k = 1; k < HASH_COMPONENTS_X * HASH_COMPONENTS_Y; k++) {
+        int q[3];
+        for (int c = 0; c < 3; c++) {
+            float v = std::floor(SignPow(factors[k][c] / max_value, 0.5f) * 9.0f + 9.5f);
+            q[c] = std::max(0, std::min(18, static_cast<int>(v)));
+        }
+        dst = EncodeBase83(q[0] * 19 * 19 + q[1] * 19 + q[2], 2, dst);
+    }
+    *dst = '\0';
+}
+
+// 解码 blurhash 为 size×size 的 RGBA32（Unity 行序，alpha 为 255），格式无效时返回 false
+static bool DecodeBlurhash(const char* hash, int size, uint8_t* out_rgba) {
+    int size_flag = 0;
+    if (!DecodeBase83(hash, 1, &size_flag)) return false;
+    int nx = size_flag % 9 + 1;
+    int ny = size_flag / 9 + 1;
+    if (strlen(hash) != static_cast<size_t>(4 + 2 * nx * ny)) return false;
+
+    int quantised_max = 0;
+    int dc = 0;
+    if (!DecodeBase83(hash + 1, 1, &quantised_max) || !DecodeBase83(hash + 2, 4, &dc)) return false;
+    float max_value = (quantised_max + 1) / 166.0f;
+
+    std::vector<float> colors(static_cast<size_t>(nx) * ny * 3);
+    colors[0] = SrgbToLinear(dc >> 16);
+    colors[1] = SrgbToLinear((dc >> 8) & 0xFF);
+    colors[2] = SrgbToLinear(dc & 0xFF);
+    for (int k = 1; k < nx * ny; k++) {
+        int value = 0;
+        if (!DecodeBase83(hash + 4 + k * 2, 2, &value)) return false;
+        int q[3] = { value / (19 * 19), (value / 19) % 19, value % 19 };
+        for (int c = 0; c < 3; c++) {
+            colors[k * 3 + c] = SignPow((q[c] - 9) / 9.0f, 2.0f) * max_value;
+        }
+    }
+
+    std::vector<float> basis_x(static_cast<size_t>(nx) * size);
+    std::vector<float> basis_y(static_cast<size_t>(ny) * size);
+    for (int i = 0; i < nx; i++) {
+        for (int x = 0; x < size; x++) basis_x[i * size + x] = static_cast<float>(std::cos(PI * i * x / size));
+    }
+    for (int j = 0; j < ny; j++) {
+        for (int y = 0; y < size; y++) basis_y[j * size + y] = static_cast<float>(std::cos(PI * j * y / size));
+    }
+
+    for (int row = 0; row < size; row++) {
+        int y = size - 1 - row;
+        for (int x = 0; x < size; x++) {
+            float pixel[3] = { 0.0f, 0.0f, 0.0f };
+            for (int j = 0; j < ny; j++) {
+                for (int i = 0; i < nx; i++) {
+                    float basis = basis_x[i * size + x] * basis_y[j * size + y];
+                    for (int c = 0; c < 3; c++) pixel[c] += colors[(j * nx + i) * 3 + c] * basis;
+                }
+            }
+            uint8_t* p = out_rgba + (static_cast<size_t>(row) * size + x) * 4;
+            for (int c = 0; c < 3; c++) p[c] = static_cast<uint8_t>(LinearToSrgb(pixel[c]));
+            p[3] = 255;
+        }
+    }
+    return true;
+}
+
+// ========== 占位图 ==========
+
+static int ComputePlaceholder(const uint8_t* data, size_t data_size, FlacCoverPlaceholder* out) {
+    std::vector<uint8_t> sample(static_cast<size_t>(SAMPLE_SIZE) * SAMPLE_SIZE * 4);
+    int result = FlacDecodeCoverThumbnail(data, data_size, SAMPLE_SIZE, FLAC_COVER_SQUARE, sample.data());
+    if (result != 0) return result;
+
+    ComputeDominantColors(sample.data(), SAMPLE_SIZE * SAMPLE_SIZE, out);
+    EncodeBlurhash(sample.data(), SAMPLE_SIZE, out->blurhash);
+    return 0;
+}
+
+// ========== 封面占位图实现 ==========
+
+extern "C" {
+
+FLAC_API int LoadCoverPlaceholder(const wchar_t* file_path, FlacCoverPlaceholder* out_placeholder) {
+    if (!file_path || !out_placeholder) {
+        FlacSetLastError("Invalid arguments");
+        return -1;
+    }
+    memset(out_placeholder, 0, sizeof(*out_placeholder));
+
+    FILE* file = FlacOpenFileW(file_path);
+    if (!file) {
+        FlacSetLastError("Failed to open file");
+        return -2;
+    }
+    FileByteSource source(file);
+
+    std::vector<uint8_t> data;
+    int result = FlacReadCoverData(&source, &data);
+    if (result != 0) return result;
+
+    return ComputePlaceholder(data.data(), data.size(), out_placeholder);
+}
+
+FLAC_API int CreateCoverPlaceholder(const void* data, size_t data_size, FlacCoverPlaceholder* out_placeholder) {
+    if (!data || data_size == 0 || !out_placeholder) {
+        FlacSetLastError("Invalid arguments");
+        return -1;
+    }
+    memset(out_placeholder, 0, sizeof(*out_placeholder));
+    return ComputePlaceholder(static_cast<const uint8_t*>(data), data_size, out_placeholder);
+}
+
+FLAC_API int DecodeCoverPlaceholder(const char* blurhash, int size, unsigned char* out_rgba) {
+    if (!blurhash || !out_rgba || size <= 0 || size > 256) {
+        FlacSetLastError("Invalid arguments");
+        return -1;
+    }
+    if (!DecodeBlurhash(blurhash, size, out_rgba)) {
+        FlacSetLastError("Invalid blurhash");
+        return -3;
+    }
+    return 0;
+}
+
+} // extern "C"
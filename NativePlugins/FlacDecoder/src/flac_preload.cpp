@@ -0,0 +1,267 @@
+#include "flac_internal.h"
+#include "flac_preload.h"
+
+// 未指定预解码时长时，待命流预解码开头的时长（毫秒）：足够覆盖取走后第一个音频回调之前的调度延迟
+static const int DEFAULT_PRELOAD_MS = 300;
+
+static const uint64_t DEFAULT_BUDGET_BYTES = 32 * 1024 * 1024;
+
+// 待命流的常驻内存估计：预解码环 + drflac 的 arena 块 + 字节源的读取缓冲 + 各中转区
+static uint64_t EstimateFootprint(const FlacStream* stream) {
+    uint64_t bytes = stream->arena.ChunkBytes();
+    if (stream->ring) bytes += stream->ring->Capacity() * stream->ring->FrameBytes();
+    if (stream->source) bytes += stream->source->ResidentBytes();
+    bytes += (stream->downmix_scratch.capacity() + stream->process_scratch.capacity() +
+              stream->planar_scratch.capacity()) * sizeof(float);
+    return bytes;
+}
+
+// ========== 预加载器 ==========
+
+FlacPreloader::FlacPreloader(const FlacStreamOptions& options, uint64_t budget_bytes)
+    : options_(options), budget_bytes_(budget_bytes > 0 ? budget_bytes : DEFAULT_BUDGET_BYTES) {
+    if (options_.decode_ahead_ms <= 0) options_.decode_ahead_ms = DEFAULT_PRELOAD_MS;
+    worker_ = std::thread(&FlacPreloader::WorkerLoop, this);
+}
+
+FlacPreloader::~FlacPreloader() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    worker_.join();
+
+    // 后台线程已退出，不再需要加锁
+    for (const std::shared_ptr<Entry>& entry : entries_) {
+        if (entry->stream) CloseFlacStream(entry->stream);
+    }
+    for (void* stream : retired_) {
+        CloseFlacStream(stream);
+    }
+}
+
+std::shared_ptr<FlacPreloader::Entry> FlacPreloader::Find(const std::wstring& path) const {
+    for (const std::shared_ptr<Entry>& entry : entries_) {
+        if (entry->path == path) return entry;
+    }
+    return nullptr;
+}
+
+void FlacPreloader::Retire(Entry& entry) {
+    if (entry.stream) retired_.push_back(entry.stream);
+    entry.stream = nullptr;
+    entry.bytes = 0;
+}
+
+void FlacPreloader::Prepare(const std::vector<std::wstring>& paths) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<std::shared_ptr<Entry>> next;
+        next.reserve(paths.size());
+        for (const std::wstring& path : paths) {
+            bool duplicate = false;
+            for (const std::shared_ptr<Entry>& kept : next) {
+                if (kept->path == path) duplicate = true;
+            }
+            if (duplicate) continue;
+
+            std::shared_ptr<Entry> entry = Find(path);
+            if (!entry) {
+                entry = std::make_shared<Entry>();
+                entry->path = path;
+            } else if (entry->state == FLAC_PREPARE_OVER_BUDGET) {
+                entry->state = FLAC_PREPARE_PENDING;
+            }
+            next.push_back(entry);
+        }
+
+        // 移出列表的条目：正在打开的由后台线程在打开完成后关闭
+        for (const std::shared_ptr<Entry>& entry : entries_) {
+            bool kept = false;
+            for (const std::shared_ptr<Entry>& other : next) {
+                if (other == entry) kept = true;
+            }
+            if (kept) continue;
+            if (entry->opening) {
+                entry->cancelled = true;
+            } else {
+                Retire(*entry);
+            }
+        }
+
+        entries_.swap(next);
+        EnforceBudget();
+    }
+    wake_.notify_all();
+}
+
+int FlacPreloader::State(const std::wstring& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::shared_ptr<Entry> entry = Find(path);
+    return entry ? entry->state : FLAC_PREPARE_NONE;
+}
+
+void* FlacPreloader::Take(const std::wstring& path, int* out_sample_rate, int* out_channels, unsigned long long* out_total_pcm_frames) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    std::shared_ptr<Entry> entry = Find(path);
+    if (!entry) return nullptr;
+
+    opened_.wait(lock, [&entry] { return !entry->opening; });
+    if (entry->cancelled) return nullptr;
+
+    // 尚未开始打开或打开失败的条目也移除：调用者会自行打开
+    void* stream = entry->stream;
+    if (stream) {
+        if (out_sample_rate) *out_sample_rate = entry->sample_rate;
+        if (out_channels) *out_channels = entry->channels;
+        if (out_total_pcm_frames) *out_total_pcm_frames = entry->total_pcm_frames;
+    }
+    entry->stream = nullptr;
+    for (size_t i = 0; i < entries_.size(); i++) {
+        if (entries_[i] == entry) {
+            entries_.erase(entries_.begin() + i);
+            break;
+        }
+    }
+
+    // 释放的预算留给之前超出预算的条目
+    for (const std::shared_ptr<Entry>& other : entries_) {
+        if (other->state == FLAC_PREPARE_OVER_BUDGET) other->state = FLAC_PREPARE_PENDING;
+    }
+    lock.unlock();
+    wake_.notify_all();
+    return stream;
+}
+
+void FlacPreloader::EnforceBudget() {
+    uint64_t used = 0;
+    for (const std::shared_ptr<Entry>& entry : entries_) {
+        if (entry->state != FLAC_PREPARE_READY) continue;
+        if (used + entry->bytes > budget_bytes_) {
+            Retire(*entry);
+            entry->state = FLAC_PREPARE_OVER_BUDGET;
+        } else {
+            used += entry->bytes;
+        }
+    }
+}
+
+std::shared_ptr<FlacPreloader::Entry> FlacPreloader::NextPending() {
+    uint64_t used = 0;
+    for (const std::shared_ptr<Entry>& entry : entries_) {
+        if (entry->state == FLAC_PREPARE_READY) used += entry->bytes;
+        if (entry->state != FLAC_PREPARE_PENDING || entry->opening) continue;
+
+        // 优先级更高的待命流已用完预算：之后的条目打开后也会被关闭，不再尝试
+        if (used >= budget_bytes_) {
+            entry->state = FLAC_PREPARE_OVER_BUDGET;
+            continue;
+        }
+        return entry;
+    }
+    return nullptr;
+}
+
+void FlacPreloader::WorkerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        std::shared_ptr<Entry> entry;
+        wake_.wait(lock, [this, &entry] {
+            if (stopping_ || !retired_.empty()) return true;
+            entry = NextPending();
+            return entry != nullptr;
+        });
+        if (stopping_) return;
+
+        // 关闭移出列表的流（停止预解码线程和 seek 索引扫描），不占用调用者的线程
+        if (!retired_.empty()) {
+            std::vector<void*> closing;
+            closing.swap(retired_);
+            lock.unlock();
+            for (void* stream : closing) {
+                CloseFlacStream(stream);
+            }
+            lock.lock();
+            continue;
+        }
+
+        entry->opening = true;
+        lock.unlock();
+
+        int sample_rate = 0;
+        int channels = 0;
+        unsigned long long total_pcm_frames = 0;
+        void* stream = OpenFlacStreamEx(entry->path.c_str(), &options_, &sample_rate, &channels, &total_pcm_frames);
+        uint64_t bytes = stream ? EstimateFootprint(static_cast<FlacStream*>(stream)) : 0;
+
+        lock.lock();
+        entry->opening = false;
+        if (entry->cancelled || stopping_) {
+            if (stream) retired_.push_back(stream);
+        } else if (!stream) {
+            entry->state = FLAC_PREPARE_FAILED;
+        } else {
+            entry->stream = stream;
+            entry->bytes = bytes;
+            entry->sample_rate = sample_rate;
+            entry->channels = channels;
+            entry->total_pcm_frames = total_pcm_frames;
+            entry->state = FLAC_PREPARE_READY;
+            EnforceBudget();
+        }
+        opened_.notify_all();
+    }
+}
+
+// ========== 导出函数 ==========
+
+extern "C" {
+
+FLAC_API void* CreateFlacPreloader(const FlacStreamOptions* options, unsigned long long memory_budget_bytes) {
+    if (!FlacValidateStreamOptions(options)) return nullptr;
+    FlacStreamOptions resolved = {};
+    if (options) resolved = *options;
+    return new FlacPreloader(resolved, memory_budget_bytes);
+}
+
+FLAC_API int PrepareFlacStreams(void* preloader, const wchar_t* const* file_paths, int count) {
+    if (!preloader || count < 0 || (count > 0 && !file_paths)) {
+        FlacSetLastError("Invalid arguments");
+        return -1;
+    }
+
+    std::vector<std::wstring> paths;
+    paths.reserve(count);
+    for (int i = 0; i < count; i++) {
+        if (!file_paths[i]) {
+            FlacSetLastError("File path is NULL");
+            return -1;
+        }
+        paths.push_back(file_paths[i]);
+    }
+    static_cast<FlacPreloader*>(preloader)->Prepare(paths);
+    return 0;
+}
+
+FLAC_API int GetFlacPreparedState(void* preloader, const wchar_t* file_path) {
+    if (!preloader || !file_path) return FLAC_PREPARE_NONE;
+    return static_cast<FlacPreloader*>(preloader)->State(file_path);
+}
+
+FLAC_API void* TakeFlacPreparedStream(void* preloader, const wchar_t* file_path, int* out_sample_rate, int* out_channels, unsigned long long* out_total_pcm_frames) {
+    if (!preloader || !file_path) {
+        FlacSetLastError("Invalid arguments");
+        return nullptr;
+    }
+
+    void* stream = static_cast<FlacPreloader*>(preloader)->Take(file_path, out_sample_rate, out_channels, out_total_pcm_frames);
+    if (!stream) FlacSetLastError("Stream is not prepared");
+    return stream;
+}
+
+FLAC_API void CloseFlacPreloader(void* preloader) {
+    delete static_cast<FlacPreloader*>(preloader);
+}
+
+} // extern "C"
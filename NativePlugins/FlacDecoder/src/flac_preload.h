@@ -0,0 +1,71 @@
+#ifndef CHILL_FLAC_PRELOAD_H
+#define CHILL_FLAC_PRELOAD_H
+
+// 流预加载：一个后台线程按优先级打开播放队列中接下来的文件并预解码开头，保持待命，切歌时直接取走。
+//
+// 打开一个流的主要耗时（打开文件、解析元数据、解码第一帧、填满预解码环）都在后台线程上完成，
+// 取走只是把句柄交给调用者。待命流的常驻内存按列表顺序累计，超出预算的流被关闭，
+// 列表变化（Prepare）或取走释放预算后重试。被移出列表的流交给后台线程关闭，调用线程不等待。
+
+#include "flac_decoder.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class FlacPreloader {
+public:
+    // options 中的 decode_ahead_ms 为 0 时改为默认的预解码时长；budget_bytes 为 0 时使用默认预算
+    FlacPreloader(const FlacStreamOptions& options, uint64_t budget_bytes);
+    ~FlacPreloader();
+
+    FlacPreloader(const FlacPreloader&) = delete;
+    FlacPreloader& operator=(const FlacPreloader&) = delete;
+
+    // 替换预加载列表（按优先级从高到低，重复的路径只保留第一个）
+    void Prepare(const std::vector<std::wstring>& paths);
+
+    // FlacPrepareState
+    int State(const std::wstring& path);
+
+    // 取走已打开的流（正在打开时等待），没有时返回空
+    void* Take(const std::wstring& path, int* out_sample_rate, int* out_channels, unsigned long long* out_total_pcm_frames);
+
+private:
+    struct Entry {
+        std::wstring path;
+        int state = FLAC_PREPARE_PENDING;
+        bool opening = false;       // 后台线程正在打开（期间不持有锁）
+        bool cancelled = false;     // 打开期间被移出列表，打开完成后关闭
+        void* stream = nullptr;
+        uint64_t bytes = 0;         // 估计的常驻内存
+        int sample_rate = 0;
+        int channels = 0;
+        unsigned long long total_pcm_frames = 0;
+    };
+
+    // 以下在持有 mutex_ 时调用
+    std::shared_ptr<Entry> Find(const std::wstring& path) const;
+    std::shared_ptr<Entry> NextPending();
+    void EnforceBudget();
+    void Retire(Entry& entry);
+
+    void WorkerLoop();
+
+    FlacStreamOptions options_;
+    uint64_t budget_bytes_;
+
+    std::mutex mutex_;      // 保护以下全部成员
+    std::condition_variable wake_;      // 通知后台线程
+    std::condition_variable opened_;    // 通知等待打开完成的 Take
+    bool stopping_ = false;
+    std::vector<std::shared_ptr<Entry>> entries_;   // 按优先级排列
+    std::vector<void*> retired_;                     // 等待后台线程关闭的流
+    std::thread worker_;
+};
+
+#endif // CHILL_FLAC_PRELOAD_H
@@ -0,0 +1,365 @@
+#include "flac_internal.h"
+#include "flac_parallel.h"
+#include "flac_probe.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// STREAMINFO 没有记录总帧数时，从文件末尾这么多字节中查找最后一帧
+static const uint64_t TAIL_SCAN_MIN_BYTES = 64 * 1024;
+
+// ========== 元数据块解析 ==========
+
+static uint32_t ReadBe32(const uint8_t* p) {
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+           (static_cast<uint32_t>(p[2]) << 8) | p[3];
+}
+
+static uint32_t ReadLe32(const uint8_t* p) {
+    return (static_cast<uint32_t>(p[3]) << 24) | (static_cast<uint32_t>(p[2]) << 16) |
+           (static_cast<uint32_t>(p[1]) << 8) | p[0];
+}
+
+// VORBIS_COMMENT：厂商字符串 + 若干 "KEY=value"（长度均为小端 32 位），打包为以 NUL 分隔的字符串
+static void ParseVorbisComment(const uint8_t* data, size_t size, std::string* tags, int* count) {
+    if (size < 4) return;
+    uint64_t pos = 4 + static_cast<uint64_t>(ReadLe32(data));   // 跳过厂商字符串
+    if (pos + 4 > size) return;
+    uint32_t declared = ReadLe32(data + pos);
+    pos += 4;
+
+    for (uint32_t i = 0; i < declared && pos + 4 <= size; i++) {
+        uint32_t length = ReadLe32(data + pos);
+        pos += 4;
+        if (length > size - pos) break;
+
+        const char* comment = reinterpret_cast<const char*>(data + pos);
+        pos += length;
+        // 没有 '=' 的注释不合法；值中若含 NUL 则在此截断
+        const void* equals = memchr(comment, '=', length);
+        if (!equals || equals == comment) continue;
+        size_t visible = strnlen(comment, length);
+        if (visible <= static_cast<size_t>(static_cast<const char*>(equals) - comment)) continue;
+
+        tags->append(comment, visible);
+        tags->push_back('\0');
+        (*count)++;
+    }
+}
+
+// PICTURE 块头部：类型、MIME、描述、尺寸、数据长度。只读取头部，返回 false 表示块损坏
+static bool ReadPictureHeader(FlacByteSource* source, uint64_t block_offset, uint32_t block_length, FlacPictureInfo* out) {
+    memset(out, 0, sizeof(FlacPictureInfo));
+    uint8_t field[8];
+
+    if (block_length < 32 || source->Read(field, 8) != 8) return false;
+    out->picture_type = static_cast<int>(ReadBe32(field));
+    uint32_t mime_length = ReadBe32(field + 4);
+    if (mime_length > block_length - 32) return false;
+
+    std::string mime(mime_length, '\0');
+    if (mime_length > 0 && source->Read(&mime[0], mime_length) != mime_length) return false;
+    size_t copied = std::min(mime.size(), sizeof(out->mime_type) - 1);
+    memcpy(out->mime_type, mime.data(), copied);
+    out->mime_type[copied] = '\0';
+
+    if (source->Read(field, 4) != 4) return false;
+    uint32_t description_length = ReadBe32(field);
+    uint64_t used = 8 + static_cast<uint64_t>(mime_length) + 4;
+    if (description_length > block_length - used || block_length - used - description_length < 20) return false;
+    if (!source->Seek(static_cast<int64_t>(description_length), SEEK_CUR)) return false;
+    used += description_length;
+
+    uint8_t dimensions[20];
+    if (source->Read(dimensions, sizeof(dimensions)) != sizeof(dimensions)) return false;
+    used += sizeof(dimensions);
+    out->width = ReadBe32(dimensions);
+    out->height = ReadBe32(dimensions + 4);
+    out->data_size = ReadBe32(dimensions + 16);
+    if (out->data_size > block_length - used) return false;
+    out->data_offset = block_offset + used;
+    return true;
+}
+
+// ========== 总帧数 ==========
+
+// STREAMINFO 未记录总帧数：扫描文件末尾的帧头，取最后一个与前一帧衔接的帧的结束位置
+static uint64_t FindTotalFromTail(FlacByteSource* source, const FlacStreamInfo& info, uint64_t first_frame_offset) {
+    if (!source->Seek(0, SEEK_END)) return 0;
+    int64_t file_size = source->Tell();
+    if (file_size <= static_cast<int64_t>(first_frame_offset)) return 0;
+
+    uint64_t window = std::max<uint64_t>(TAIL_SCAN_MIN_BYTES, static_cast<uint64_t>(info.max_frame_size) * 2);
+    uint64_t start = static_cast<uint64_t>(file_size) > first_frame_offset + window
+        ? static_cast<uint64_t>(file_size) - window : first_frame_offset;
+
+    std::vector<uint8_t> tail(static_cast<size_t>(static_cast<uint64_t>(file_size) - start));
+    if (!source->Seek(static_cast<int64_t>(start), SEEK_SET)) return 0;
+    if (source->Read(tail.data(), tail.size()) != tail.size()) return 0;
+
+    // 同步码 + CRC-8 仍可能误判，要求帧号与窗口内更早的某一帧衔接
+    std::vector<uint64_t> ends;
+    uint64_t total = 0;
+    for (size_t i = 0; i + 1 < tail.size(); i++) {
+        if (tail[i] != 0xFF) continue;
+        FlacFrameHeader header;
+        if (FlacParseFrameHeader(tail.data() + i, tail.size() - i, info, &header) != FLAC_FRAME_HEADER_OK) continue;
+
+        uint64_t end = header.pcm_frame + header.block_size;
+        bool chained = std::find(ends.begin(), ends.end(), header.pcm_frame) != ends.end();
+        if (chained || (start == first_frame_offset && header.pcm_frame == 0)) {
+            total = std::max(total, end);
+        }
+        ends.push_back(end);
+    }
+    return total;
+}
+
+// ========== 探测 ==========
+
+static bool CopyOut(const std::string& tags, int tag_count, const std::vector<FlacPictureInfo>& pictures, FlacProbeInfo* out_info) {
+    if (!tags.empty()) {
+        out_info->tags = static_cast<char*>(malloc(tags.size()));
+        if (!out_info->tags) return false;
+        memcpy(out_info->tags, tags.data(), tags.size());
+        out_info->tags_size = tags.size();
+        out_info->tag_count = tag_count;
+    }
+    if (!pictures.empty()) {
+        size_t bytes = pictures.size() * sizeof(FlacPictureInfo);
+        out_info->pictures = static_cast<FlacPictureInfo*>(malloc(bytes));
+        if (!out_info->pictures) return false;
+        memcpy(out_info->pictures, pictures.data(), bytes);
+        out_info->picture_count = static_cast<int>(pictures.size());
+    }
+    return true;
+}
+
+int FlacProbeSource(FlacByteSource* source, FlacProbeInfo* out_info) {
+    memset(out_info, 0, sizeof(FlacProbeInfo));
+
+    uint8_t header[10];
+    if (!source->Seek(0, SEEK_SET) || source->Read(header, sizeof(header)) != sizeof(header)) {
+        FlacSetLastError("File is too short to be FLAC");
+        return -3;
+    }
+
+    // 跳过 ID3v2 标签
+    uint64_t offset = FlacId3v2Size(header, sizeof(header));
+    if (offset > 0) {
+        if (!source->Seek(static_cast<int64_t>(offset), SEEK_SET) || source->Read(header, 4) != 4) {
+            FlacSetLastError("Truncated ID3v2 tag");
+            return -3;
+        }
+    }
+    if (header[0] != 'f' || header[1] != 'L' || header[2] != 'a' || header[3] != 'C') {
+        FlacSetLastError("Missing fLaC marker");
+        return -3;
+    }
+    offset += 4;
+
+    FlacStreamInfo info = {};
+    bool have_stream_info = false;
+    std::string tags;
+    int tag_count = 0;
+    std::vector<FlacPictureInfo> pictures;
+    std::vector<uint8_t> body;
+
+    for (;;) {
+        uint8_t raw[4];
+        if (!source->Seek(static_cast<int64_t>(offset), SEEK_SET) || source->Read(raw, 4) != 4) {
+            FlacSetLastError("Truncated metadata block");
+            return -3;
+        }
+        offset += 4;
+
+        FlacBlockHeader block;
+        FlacParseBlockHeader(raw, &block);
+
+        if (block.type == FLAC_METADATA_STREAMINFO) {
+            uint8_t stream_info[34];
+            if (block.length < sizeof(stream_info) || source->Read(stream_info, sizeof(stream_info)) != sizeof(stream_info) ||
+                !FlacParseStreamInfo(stream_info, sizeof(stream_info), &info)) {
+                FlacSetLastError("Invalid STREAMINFO block");
+                return -3;
+            }
+            have_stream_info = true;
+        } else if (block.type == FLAC_METADATA_VORBIS_COMMENT && tag_count == 0) {
+            body.resize(block.length);
+            if (source->Read(body.data(), body.size()) != body.size()) {
+                FlacSetLastError("Truncated VORBIS_COMMENT block");
+                return -3;
+            }
+            ParseVorbisComment(body.data(), body.size(), &tags, &tag_count);
+        } else if (block.type == FLAC_METADATA_PICTURE) {
+            // 损坏的图片块只忽略该图片，不影响其余元数据
+            FlacPictureInfo picture;
+            if (ReadPictureHeader(source, offset, block.length, &picture)) {
+                pictures.push_back(picture);
+            }
+        }
+        // 其余块（PADDING / SEEKTABLE / APPLICATION / CUESHEET）只跳过，不读取
+
+        offset += block.length;
+        if (block.is_last) break;
+    }
+
+    if (!have_stream_info) {
+        FlacSetLastError("Missing STREAMINFO block");
+        return -3;
+    }
+
+    out_info->sample_rate = static_cast<int>(info.sample_rate);
+    out_info->channels = static_cast<int>(info.channels);
+    out_info->bits_per_sample = static_cast<int>(info.bits_per_sample);
+    out_info->total_pcm_frames = info.total_pcm_frames;
+    if (out_info->total_pcm_frames == 0) {
+        out_info->total_pcm_frames = FindTotalFromTail(source, info, offset);
+    }
+    if (info.sample_rate > 0) {
+        out_info->duration_seconds = static_cast<double>(out_info->total_pcm_frames) / info.sample_rate;
+    }
+    memcpy(out_info->md5, info.md5, sizeof(out_info->md5));
+
+    if (!CopyOut(tags, tag_count, pictures, out_info)) {
+        FreeFlacProbeInfo(out_info);
+        FlacSetLastError("Failed to allocate memory for metadata");
+        return -4;
+    }
+    return 0;
+}
+
+static int ProbePath(const wchar_t* file_path, FlacProbeInfo* out_info) {
+    memset(out_info, 0, sizeof(FlacProbeInfo));
+
+    FILE* file = FlacOpenFileW(file_path);
+    if (!file) {
+        FlacSetLastError("Failed to open FLAC file");
+        return -2;
+    }
+
+    FileByteSource source(file);
+    return FlacProbeSource(&source, out_info);
+}
+
+// ========== 批量探测 ==========
+
+static uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+// 把各文件的探测结果打包为 条目区 + 图片区 + 标签区，返回 NULL 表示内存不足
+static uint8_t* PackBatch(const std::vector<int>& status, const std::vector<FlacProbeInfo>& infos, uint64_t* out_size) {
+    size_t count = infos.size();
+    uint64_t pictures_offset = AlignUp(count * sizeof(FlacProbeBatchEntry), alignof(FlacPictureInfo));
+    uint64_t picture_count = 0;
+    uint64_t tags_size = 0;
+    for (const FlacProbeInfo& info : infos) {
+        picture_count += static_cast<uint64_t>(info.picture_count);
+        tags_size += info.tags_size;
+    }
+    uint64_t tags_offset = pictures_offset + picture_count * sizeof(FlacPictureInfo);
+    uint64_t total = tags_offset + tags_size;
+
+    uint8_t* buffer = static_cast<uint8_t*>(calloc(1, static_cast<size_t>(std::max<uint64_t>(total, 1))));
+    if (!buffer) return nullptr;
+
+    FlacProbeBatchEntry* entries = reinterpret_cast<FlacProbeBatchEntry*>(buffer);
+    uint64_t picture_cursor = pictures_offset;
+    uint64_t tag_cursor = tags_offset;
+    for (size_t i = 0; i < count; i++) {
+        const FlacProbeInfo& info = infos[i];
+        FlacProbeBatchEntry& entry = entries[i];
+        entry.status = status[i];
+        if (status[i] != 0) continue;
+
+        entry.sample_rate = info.sample_rate;
+        entry.channels = info.channels;
+        entry.bits_per_sample = info.bits_per_sample;
+        entry.total_pcm_frames = info.total_pcm_frames;
+        entry.duration_seconds = info.duration_seconds;
+        memcpy(entry.md5, info.md5, sizeof(entry.md5));
+
+        entry.tags_offset = tag_cursor;
+        entry.tags_size = info.tags_size;
+        entry.tag_count = info.tag_count;
+        if (info.tags_size > 0) {
+            memcpy(buffer + tag_cursor, info.tags, info.tags_size);
+            tag_cursor += info.tags_size;
+        }
+
+        entry.pictures_offset = picture_cursor;
+        entry.picture_count = info.picture_count;
+        if (info.picture_count > 0) {
+            size_t bytes = static_cast<size_t>(info.picture_count) * sizeof(FlacPictureInfo);
+            memcpy(buffer + picture_cursor, info.pictures, bytes);
+            picture_cursor += bytes;
+        }
+    }
+
+    *out_size = total;
+    return buffer;
+}
+
+// ========== 元数据探测实现 ==========
+
+extern "C" {
+
+FLAC_API int ProbeFlacFile(const wchar_t* file_path, FlacProbeInfo* out_info) {
+    if (!file_path || !out_info) {
+        FlacSetLastError("Invalid arguments");
+        return -1;
+    }
+    return ProbePath(file_path, out_info);
+}
+
+FLAC_API void FreeFlacProbeInfo(FlacProbeInfo* info) {
+    if (!info) return;
+    free(info->tags);
+    free(info->pictures);
+    info->tags = nullptr;
+    info->tags_size = 0;
+    info->tag_count = 0;
+    info->pictures = nullptr;
+    info->picture_count = 0;
+}
+
+FLAC_API void* ProbeFlacFiles(const wchar_t* const* file_paths, int count, int thread_count, unsigned long long* out_size) {
+    if (!file_paths || count < 0 || !out_size) {
+        FlacSetLastError("Invalid arguments");
+        return nullptr;
+    }
+    *out_size = 0;
+
+    // 每个文件由一个工作线程独立探测，各自只写自己的槽位
+    size_t total = static_cast<size_t>(count);
+    std::vector<int> status(total, -1);
+    std::vector<FlacProbeInfo> infos(total);
+    FlacParallelFor(total, thread_count, [&](size_t i) {
+        if (file_paths[i]) {
+            status[i] = ProbePath(file_paths[i], &infos[i]);
+        }
+    });
+
+    uint64_t size = 0;
+    uint8_t* batch = PackBatch(status, infos, &size);
+    for (FlacProbeInfo& info : infos) {
+        FreeFlacProbeInfo(&info);
+    }
+    if (!batch) {
+        FlacSetLastError("Failed to allocate memory for probe results");
+        return nullptr;
+    }
+
+    *out_size = size;
+    return batch;
+}
+
+FLAC_API void FreeFlacProbeBatch(void* batch) {
+    free(batch);
+}
+
+} // extern "C"
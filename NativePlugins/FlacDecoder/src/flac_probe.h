@@ -0,0 +1,14 @@
+#ifndef CHILL_FLAC_PROBE_H
+#define CHILL_FLAC_PROBE_H
+
+// 元数据探测：只读取元数据块（STREAMINFO / VORBIS_COMMENT / PICTURE 头部），
+// 其余块和图片数据直接跳过，不打开解码器。
+
+#include "flac_decoder.h"
+#include "flac_io.h"
+
+// 探测字节源，结果写入 out_info（需以 FreeFlacProbeInfo 释放）。
+// 返回值与 ProbeFlacFile 一致：0=成功，-3=不是有效的 FLAC，-4=内存不足
+int FlacProbeSource(FlacByteSource* source, FlacProbeInfo* out_info);
+
+#endif // CHILL_FLAC_PROBE_H
@@ -0,0 +1,204 @@
+#include "flac_resampler.h"
+
+#include "flac_decoder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// 系数表最多保存的相位数，L 更大时（罕见的采样率组合）在相邻相位之间插值
+static const uint64_t MAX_TABLE_PHASES = 512;
+
+// 降采样时抽头数随比例增加，此为上限
+static const int MAX_TAPS = 512;
+
+// 每次从输入源读取的帧数
+static const uint64_t INPUT_CHUNK_FRAMES = 1024;
+
+static const double PI = 3.14159265358979323846;
+
+struct QualityParams {
+    int taps;          // 不降采样时每个相位的抽头数
+    double beta;       // Kaiser 窗参数（阻带衰减约 60 / 90 / 120 dB）
+    double rolloff;    // 通带截止相对于奈奎斯特频率的比例
+};
+
+static QualityParams GetQualityParams(int quality) {
+    switch (quality) {
+    case FLAC_RESAMPLE_FAST: return { 16, 6.0, 0.85 };
+    case FLAC_RESAMPLE_HIGH: return { 64, 12.0, 0.94 };
+    default:                 return { 32, 8.6, 0.90 };
+    }
+}
+
+// 第一类零阶修正贝塞尔函数（级数展开）
+static double BesselI0(double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    double half = x / 2.0;
+    for (int k = 1; k < 64; k++) {
+        term *= (half / k) * (half / k);
+        sum += term;
+        if (term < sum * 1e-17) break;
+    }
+    return sum;
+}
+
+static uint64_t Gcd(uint64_t a, uint64_t b) {
+    while (b != 0) {
+        uint64_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+bool FlacResampler::Init(int channels, int input_rate, int output_rate, int quality) {
+    if (channels <= 0 || input_rate <= 0 || output_rate <= 0) return false;
+
+    uint64_t g = Gcd(static_cast<uint64_t>(input_rate), static_cast<uint64_t>(output_rate));
+    channels_ = channels;
+    up_ = static_cast<uint64_t>(output_rate) / g;
+    down_ = static_cast<uint64_t>(input_rate) / g;
+    kernels_ = &FlacGetPcmKernels();
+
+    // 降采样时截止频率随输出奈奎斯特频率降低，抽头数按比例增加以保持过渡带宽度
+    QualityParams params = GetQualityParams(quality);
+    double ratio = std::min(1.0, static_cast<double>(up_) / static_cast<double>(down_));
+    int scale = static_cast<int>((down_ + up_ - 1) / up_);
+    taps_ = std::min(MAX_TAPS, params.taps * std::max(1, scale));
+    double cutoff = 0.5 * ratio * params.rolloff;   // 以输入采样率为单位（周期/采样）
+
+    interpolate_ = up_ > MAX_TABLE_PHASES;
+    table_phases_ = interpolate_ ? MAX_TABLE_PHASES : up_;
+    coefficients_.assign(static_cast<size_t>(table_phases_ + 1) * taps_, 0.0f);
+    interpolated_.assign(taps_, 0.0f);
+
+    // 行 i：输出位于第一个抽头之后 (taps/2 - 1 + i/P) 个输入帧处
+    double half = taps_ / 2.0;
+    double i0_beta = BesselI0(params.beta);
+    for (uint64_t row = 0; row <= table_phases_; row++) {
+        double frac = static_cast<double>(row) / static_cast<double>(table_phases_);
+        std::vector<double> h(taps_);
+        double sum = 0.0;
+        for (int k = 0; k < taps_; k++) {
+            double d = (k - (half - 1.0)) - frac;
+            double x = 2.0 * cutoff * d;
+            double sinc = std::fabs(x) < 1e-12 ? 1.0 : std::sin(PI * x) / (PI * x);
+            double w = d / half;
+            double window = std::fabs(w) >= 1.0 ? 0.0 : BesselI0(params.beta * std::sqrt(1.0 - w * w)) / i0_beta;
+            h[k] = 2.0 * cutoff * sinc * window;
+            sum += h[k];
+        }
+        // 每个相位归一化为单位直流增益，避免相位间的增益起伏
+        float* dst = coefficients_.data() + row * taps_;
+        for (int k = 0; k < taps_; k++) {
+            dst[k] = static_cast<float>(h[k] / sum);
+        }
+    }
+
+    capacity_ = static_cast<uint64_t>(taps_) + INPUT_CHUNK_FRAMES;
+    input_.assign(static_cast<size_t>(capacity_) * channels_, 0.0f);
+    chunk_.assign(static_cast<size_t>(INPUT_CHUNK_FRAMES) * channels_, 0.0f);
+    Reset(0);
+    return true;
+}
+
+uint64_t FlacResampler::OutputFramesFor(uint64_t input_frames) const {
+    return (input_frames * up_ + down_ - 1) / down_;
+}
+
+uint64_t FlacResampler::InputFrameFor(uint64_t output_frame) const {
+    return output_frame * down_ / up_;
+}
+
+uint64_t FlacResampler::Reset(uint64_t output_frame) {
+    uint64_t center = InputFrameFor(output_frame);
+    phase_ = (output_frame * down_) % up_;
+
+    // 第一个抽头位于 center - (taps/2 - 1)，文件开头之前的历史用静音补齐
+    uint64_t history = static_cast<uint64_t>(taps_ / 2 - 1);
+    uint64_t first = center >= history ? center - history : 0;
+    uint64_t pad = history - (center - first);
+
+    for (int c = 0; c < channels_; c++) {
+        memset(input_.data() + c * capacity_, 0, pad * sizeof(float));
+    }
+    pos_ = 0;
+    filled_ = pad;
+    ended_ = false;
+    return first;
+}
+
+// 补充输入，返回 false 表示暂时（或永远）没有更多输入
+bool FlacResampler::EnsureInput(FlacFrameSource* source) {
+    if (ended_) return false;
+
+    // 丢弃已不再需要的输入帧
+    if (pos_ > 0) {
+        uint64_t keep = filled_ - pos_;
+        for (int c = 0; c < channels_; c++) {
+            float* plane = input_.data() + c * capacity_;
+            memmove(plane, plane + pos_, keep * sizeof(float));
+        }
+        pos_ = 0;
+        filled_ = keep;
+    }
+
+    uint64_t want = std::min(INPUT_CHUNK_FRAMES, capacity_ - filled_);
+    bool end_of_stream = false;
+    uint64_t got = source->ReadFrames(chunk_.data(), want, &end_of_stream);
+    if (got > 0) {
+        kernels_->deinterleave_f32(chunk_.data(), got, channels_, input_.data() + filled_, capacity_);
+        filled_ += got;
+        return true;
+    }
+    if (!end_of_stream) return false;
+
+    // 输入结束：补 taps/2 帧静音，使最后一个输入帧之前的输出都能算出
+    uint64_t tail = static_cast<uint64_t>(taps_ / 2);
+    for (int c = 0; c < channels_; c++) {
+        memset(input_.data() + c * capacity_ + filled_, 0, tail * sizeof(float));
+    }
+    filled_ += tail;
+    ended_ = true;
+    return true;
+}
+
+const float* FlacResampler::PhaseCoefficients(uint64_t phase) {
+    if (!interpolate_) {
+        return coefficients_.data() + phase * taps_;
+    }
+
+    uint64_t scaled = phase * table_phases_;
+    uint64_t row = scaled / up_;
+    float t = static_cast<float>(scaled % up_) / static_cast<float>(up_);
+    const float* a = coefficients_.data() + row * taps_;
+    const float* b = a + taps_;
+    for (int k = 0; k < taps_; k++) {
+        interpolated_[k] = a[k] + t * (b[k] - a[k]);
+    }
+    return interpolated_.data();
+}
+
+uint64_t FlacResampler::Process(FlacFrameSource* source, float* out, uint64_t frames) {
+    uint64_t produced = 0;
+    while (produced < frames) {
+        if (filled_ - pos_ < static_cast<uint64_t>(taps_)) {
+            if (!EnsureInput(source)) break;
+            continue;
+        }
+
+        const float* h = PhaseCoefficients(phase_);
+        float* dst = out + produced * channels_;
+        for (int c = 0; c < channels_; c++) {
+            dst[c] = kernels_->dot_f32(input_.data() + c * capacity_ + pos_, h, static_cast<size_t>(taps_));
+        }
+        produced++;
+
+        phase_ += down_;
+        pos_ += phase_ / up_;
+        phase_ %= up_;
+    }
+    return produced;
+}
@@ -0,0 +1,69 @@
+#ifndef CHILL_FLAC_RESAMPLER_H
+#define CHILL_FLAC_RESAMPLER_H
+
+// 多相加窗 sinc 重采样器（Kaiser 窗）：按有理数比 L/M 转换采样率，
+// 跨多次读取保持状态，seek 时按输出位置重置。
+
+#include "flac_simd.h"
+
+#include <cstdint>
+#include <vector>
+
+// 重采样器的输入（交错 f32）
+class FlacFrameSource {
+public:
+    virtual ~FlacFrameSource() {}
+
+    // 读取最多 frames 帧，返回实际帧数；end_of_stream 置为 true 表示之后不会再有数据
+    // （返回 0 且 end_of_stream 为 false 表示数据暂时不可用，如文件仍在写入）
+    virtual uint64_t ReadFrames(float* out, uint64_t frames, bool* end_of_stream) = 0;
+};
+
+class FlacResampler {
+public:
+    // quality 取 FlacResampleQuality，失败时（采样率无效）返回 false
+    bool Init(int channels, int input_rate, int output_rate, int quality);
+
+    // 输入帧数 → 对应的输出帧数（向上取整，即输入完整时输出的总帧数）
+    uint64_t OutputFramesFor(uint64_t input_frames) const;
+
+    // 输出帧在输入中对应的位置（向下取整）
+    uint64_t InputFrameFor(uint64_t output_frame) const;
+
+    // 定位到输出帧 output_frame：清空历史，返回输入源需要定位到的输入帧
+    uint64_t Reset(uint64_t output_frame);
+
+    // 产生最多 frames 个输出帧（交错），返回实际帧数。
+    // 输入暂时不足时返回较少的帧数，之后可继续调用；输入结束后输出尾部直到总帧数。
+    uint64_t Process(FlacFrameSource* source, float* out, uint64_t frames);
+
+private:
+    bool EnsureInput(FlacFrameSource* source);
+    const float* PhaseCoefficients(uint64_t phase);
+
+    int channels_ = 0;
+    uint64_t up_ = 1;      // L
+    uint64_t down_ = 1;    // M
+    int taps_ = 0;         // 每个相位的抽头数（偶数）
+
+    // 系数表：table_phases_ + 1 行 × taps_，行 i 对应小数延迟 i / table_phases_
+    // 相位数超过上限时在相邻两行之间线性插值
+    std::vector<float> coefficients_;
+    uint64_t table_phases_ = 0;
+    bool interpolate_ = false;
+    std::vector<float> interpolated_;
+
+    // 平面输入缓冲区：每个声道 capacity_ 帧，[pos_, filled_) 为尚未丢弃的数据
+    // pos_ 处是当前输出第一个抽头对应的输入帧
+    std::vector<float> input_;
+    uint64_t capacity_ = 0;
+    uint64_t pos_ = 0;
+    uint64_t filled_ = 0;
+    uint64_t phase_ = 0;   // 当前输出在 [0, L) 中的相位
+    bool ended_ = false;   // 输入已结束且已补齐尾部
+
+    std::vector<float> chunk_;   // 交错输入中转区
+    const FlacPcmKernels* kernels_ = nullptr;
+};
+
+#endif // CHILL_FLAC_RESAMPLER_H
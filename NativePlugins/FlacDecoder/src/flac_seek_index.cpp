@@ -0,0 +1,176 @@
+#include "flac_seek_index.h"
+
+#include "flac_frame_index.h"
+
+#include <cstring>
+#include <mutex>
+
+// 每次读取用于扫描帧头的块大小
+static const size_t SEEK_INDEX_SCAN_CHUNK_BYTES = 256 * 1024;
+
+// 旁路文件格式：头部 + count 个 (first_pcm_frame u64, frame_offset u64, pcm_frame_count u16)
+static const char SEEK_INDEX_MAGIC[4] = { 'C', 'F', 'S', 'I' };
+static const uint32_t SEEK_INDEX_VERSION = 1;
+static const size_t SEEK_INDEX_HEADER_BYTES = 4 + 4 + 8 + 8 + 4;
+static const size_t SEEK_INDEX_ENTRY_BYTES = 8 + 8 + 2;
+
+// 旁路文件数量上限对应的 seekpoint 数（约 2 万小时音频），防止损坏的文件导致巨量分配
+static const uint32_t SEEK_INDEX_MAX_POINTS = 1u << 24;
+
+static std::mutex g_index_dir_mutex;
+static std::wstring g_index_dir;
+
+void FlacSetSeekIndexDir(const wchar_t* dir) {
+    std::lock_guard<std::mutex> lock(g_index_dir_mutex);
+    g_index_dir = dir ? dir : L"";
+    while (!g_index_dir.empty() && (g_index_dir.back() == L'/' || g_index_dir.back() == L'\\')) {
+        g_index_dir.pop_back();
+    }
+}
+
+std::wstring FlacSidecarPath(const wchar_t* file_path, const wchar_t* extension) {
+    std::wstring dir;
+    {
+        std::lock_guard<std::mutex> lock(g_index_dir_mutex);
+        dir = g_index_dir;
+    }
+    if (dir.empty() || !file_path) return std::wstring();
+
+    uint64_t hash = 14695981039346656037ull;
+    for (const wchar_t* p = file_path; *p; ++p) {
+        uint32_t c = static_cast<uint32_t>(*p);
+        for (int i = 0; i < 4; i++) {
+            hash ^= (c >> (i * 8)) & 0xFF;
+            hash *= 1099511628211ull;
+        }
+    }
+
+    wchar_t name[32];
+    static const wchar_t HEX[] = L"0123456789abcdef";
+    for (int i = 0; i < 16; i++) {
+        name[i] = HEX[(hash >> ((15 - i) * 4)) & 0xF];
+    }
+    name[16] = L'\0';
+
+    return dir + L"/" + name + extension;
+}
+
+// ========== 构建 ==========
+
+bool FlacBuildSeekIndex(FlacByteSource* source, const std::atomic<bool>* cancel, std::vector<drflac_seekpoint>* out_points) {
+    FlacStreamInfo info;
+    uint64_t first_frame_offset = 0;
+    if (!FlacReadStreamLayout(source, &info, &first_frame_offset)) return false;
+    if (!source->Seek(static_cast<int64_t>(first_frame_offset), SEEK_SET)) return false;
+
+    FlacFrameIndex index;
+    index.Reset(info, first_frame_offset);
+
+    std::vector<uint8_t> pending;
+    for (;;) {
+        if (cancel && cancel->load(std::memory_order_relaxed)) return false;
+
+        size_t old_size = pending.size();
+        pending.resize(old_size + SEEK_INDEX_SCAN_CHUNK_BYTES);
+        size_t read = source->Read(pending.data() + old_size, SEEK_INDEX_SCAN_CHUNK_BYTES);
+        pending.resize(old_size + read);
+
+        bool at_end = read < SEEK_INDEX_SCAN_CHUNK_BYTES;
+        size_t consumed = index.Scan(pending.data(), pending.size(), at_end);
+        pending.erase(pending.begin(), pending.begin() + consumed);
+
+        if (at_end) break;
+    }
+
+    // 按固定间隔抽取帧作为 seekpoint，保持索引文件小巧
+    uint64_t spacing = static_cast<uint64_t>(info.sample_rate) * FLAC_SEEK_INDEX_SPACING_MS / 1000;
+    const std::vector<FlacFrameEntry>& entries = index.Entries();
+
+    out_points->clear();
+    for (size_t i = 0; i < entries.size(); i++) {
+        if (!out_points->empty() && entries[i].pcm_frame < out_points->back().firstPCMFrame + spacing) continue;
+
+        drflac_seekpoint point;
+        point.firstPCMFrame = entries[i].pcm_frame;
+        point.flacFrameOffset = entries[i].byte_offset - first_frame_offset;
+        point.pcmFrameCount = static_cast<drflac_uint16>(entries[i].block_size);
+        out_points->push_back(point);
+    }
+
+    return !out_points->empty();
+}
+
+// ========== 持久化 ==========
+
+static void PutU16(uint8_t*& p, uint16_t v) { for (int i = 0; i < 2; i++) *p++ = static_cast<uint8_t>(v >> (i * 8)); }
+static void PutU32(uint8_t*& p, uint32_t v) { for (int i = 0; i < 4; i++) *p++ = static_cast<uint8_t>(v >> (i * 8)); }
+static void PutU64(uint8_t*& p, uint64_t v) { for (int i = 0; i < 8; i++) *p++ = static_cast<uint8_t>(v >> (i * 8)); }
+
+static uint64_t GetLE(const uint8_t*& p, int bytes) {
+    uint64_t v = 0;
+    for (int i = 0; i < bytes; i++) v |= static_cast<uint64_t>(*p++) << (i * 8);
+    return v;
+}
+
+bool FlacLoadSeekIndex(const wchar_t* file_path, const FlacFileIdentity& identity, std::vector<drflac_seekpoint>* out_points) {
+    std::wstring sidecar = FlacSidecarPath(file_path, L".seekidx");
+    if (sidecar.empty()) return false;
+
+    FILE* file = FlacOpenFileW(sidecar.c_str());
+    if (!file) return false;
+
+    uint8_t header[SEEK_INDEX_HEADER_BYTES];
+    bool ok = fread(header, 1, sizeof(header), file) == sizeof(header) &&
+              memcmp(header, SEEK_INDEX_MAGIC, 4) == 0;
+
+    uint32_t count = 0;
+    if (ok) {
+        const uint8_t* p = header + 4;
+        uint32_t version = static_cast<uint32_t>(GetLE(p, 4));
+        uint64_t size = GetLE(p, 8);
+        int64_t mtime = static_cast<int64_t>(GetLE(p, 8));
+        count = static_cast<uint32_t>(GetLE(p, 4));
+        ok = version == SEEK_INDEX_VERSION && size == identity.size && mtime == identity.mtime &&
+             count > 0 && count <= SEEK_INDEX_MAX_POINTS;
+    }
+
+    std::vector<uint8_t> body;
+    if (ok) {
+        body.resize(static_cast<size_t>(count) * SEEK_INDEX_ENTRY_BYTES);
+        ok = fread(body.data(), 1, body.size(), file) == body.size();
+    }
+    fclose(file);
+    if (!ok) return false;
+
+    out_points->resize(count);
+    const uint8_t* p = body.data();
+    for (uint32_t i = 0; i < count; i++) {
+        drflac_seekpoint& point = (*out_points)[i];
+        point.firstPCMFrame = GetLE(p, 8);
+        point.flacFrameOffset = GetLE(p, 8);
+        point.pcmFrameCount = static_cast<drflac_uint16>(GetLE(p, 2));
+    }
+    return true;
+}
+
+bool FlacSaveSeekIndex(const wchar_t* file_path, const FlacFileIdentity& identity, const std::vector<drflac_seekpoint>& points) {
+    std::wstring sidecar = FlacSidecarPath(file_path, L".seekidx");
+    if (sidecar.empty() || points.empty() || points.size() > SEEK_INDEX_MAX_POINTS) return false;
+
+    std::vector<uint8_t> data(SEEK_INDEX_HEADER_BYTES + points.size() * SEEK_INDEX_ENTRY_BYTES);
+    uint8_t* p = data.data();
+    memcpy(p, SEEK_INDEX_MAGIC, 4);
+    p += 4;
+    PutU32(p, SEEK_INDEX_VERSION);
+    PutU64(p, identity.size);
+    PutU64(p, static_cast<uint64_t>(identity.mtime));
+    PutU32(p, static_cast<uint32_t>(points.size()));
+    for (const drflac_seekpoint& point : points) {
+        PutU64(p, point.firstPCMFrame);
+        PutU64(p, point.flacFrameOffset);
+        PutU16(p, point.pcmFrameCount);
+    }
+
+    // 流、并行解码和波形的工作线程可能同时保存同一个索引，每次写入使用独立的临时文件
+    return FlacWriteFileAtomicW(sidecar.c_str(), data.data(), data.size());
+}
@@ -0,0 +1,32 @@
+#ifndef CHILL_FLAC_SEEK_INDEX_H
+#define CHILL_FLAC_SEEK_INDEX_H
+
+// 持久化 seek 索引：为没有 SEEKTABLE 的文件扫描帧头生成密集的 seekpoint，
+// 以旁路文件（sidecar）形式缓存，之后每次 seek 都可以直接跳转。
+
+#include "dr_flac.h"
+#include "flac_io.h"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 相邻 seekpoint 的最小间隔（毫秒）：seek 落到 seekpoint 后最多向前解码这么长的音频
+static const int FLAC_SEEK_INDEX_SPACING_MS = 500;
+
+// 设置索引缓存目录（NULL 或空字符串表示不持久化）
+void FlacSetSeekIndexDir(const wchar_t* dir);
+
+// 扫描整个文件生成 seekpoint（偏移相对于第一个音频帧，与 dr_flac 的 SEEKTABLE 一致）
+// cancel 置位时提前返回 false
+bool FlacBuildSeekIndex(FlacByteSource* source, const std::atomic<bool>* cancel, std::vector<drflac_seekpoint>* out_points);
+
+// 旁路文件路径：<缓存目录>/<源路径的 FNV-1a 哈希><extension>，未设置缓存目录时返回空
+std::wstring FlacSidecarPath(const wchar_t* file_path, const wchar_t* extension);
+
+// 从缓存目录读取 / 写入 file_path 对应的索引，文件身份（大小 + 修改时间）不匹配时读取失败
+bool FlacLoadSeekIndex(const wchar_t* file_path, const FlacFileIdentity& identity, std::vector<drflac_seekpoint>* out_points);
+bool FlacSaveSeekIndex(const wchar_t* file_path, const FlacFileIdentity& identity, const std::vector<drflac_seekpoint>& points);
+
+#endif // CHILL_FLAC_SEEK_INDEX_H
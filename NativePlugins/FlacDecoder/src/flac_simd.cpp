@@ -0,0 +1,611 @@
+#include "flac_simd.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FLAC_HAVE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+#define FLAC_HAVE_X86 1
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64) || defined(__ARM_NEON)
+#define FLAC_HAVE_NEON 1
+#include <arm_neon.h>
+#endif
+
+// ========== 标量 ==========
+
+void FlacScalarDeinterleaveF32(const float* in, uint64_t frames, int channels, float* out, uint64_t plane_stride) {
+    for (int c = 0; c < channels; c++) {
+        float* plane = out + static_cast<uint64_t>(c) * plane_stride;
+        for (uint64_t i = 0; i < frames; i++) {
+            plane[i] = in[i * channels + c];
+        }
+    }
+}
+
+float FlacScalarDotF32(const float* a, const float* b, size_t count) {
+    float sum = 0.0f;
+    for (size_t i = 0; i < count; i++) sum += a[i] * b[i];
+    return sum;
+}
+
+void FlacScalarMixF32(const float* in, uint64_t frames, int in_channels, const float* matrix, int out_channels, float* out) {
+    for (uint64_t i = 0; i < frames; i++) {
+        const float* frame = in + i * in_channels;
+        for (int o = 0; o < out_channels; o++) {
+            const float* row = matrix + o * in_channels;
+            float sum = 0.0f;
+            for (int c = 0; c < in_channels; c++) sum += frame[c] * row[c];
+            out[i * out_channels + o] = sum;
+        }
+    }
+}
+
+void FlacScalarPeakF32(const float* in, size_t count, float* min, float* max, float* sum_squares) {
+    float lo = *min;
+    float hi = *max;
+    float sum = 0.0f;
+    for (size_t i = 0; i < count; i++) {
+        lo = std::min(lo, in[i]);
+        hi = std::max(hi, in[i]);
+        sum += in[i] * in[i];
+    }
+    *min = lo;
+    *max = hi;
+    *sum_squares += sum;
+}
+
+// 复数乘法的运算顺序（先两个乘积再加减）在各实现中保持一致，结果逐位相同
+void FlacScalarRadix4F32(float* re, float* im, size_t n, size_t quarter, const float* twiddles) {
+    const size_t q = quarter;
+    const float* w1r = twiddles;
+    const float* w1i = twiddles + q;
+    const float* w2r = twiddles + 2 * q;
+    const float* w2i = twiddles + 3 * q;
+    const float* w3r = twiddles + 4 * q;
+    const float* w3i = twiddles + 5 * q;
+
+    for (size_t block = 0; block < n; block += 4 * q) {
+        float* r0 = re + block;
+        float* i0 = im + block;
+        for (size_t j = 0; j < q; j++) {
+            float t0r = r0[j] + r0[j + 2 * q], t0i = i0[j] + i0[j + 2 * q];
+            float t1r = r0[j] - r0[j + 2 * q], t1i = i0[j] - i0[j + 2 * q];
+            float t2r = r0[j + q] + r0[j + 3 * q], t2i = i0[j + q] + i0[j + 3 * q];
+            // (a1 - a3) × (-i)
+            float t3r = i0[j + q] - i0[j + 3 * q], t3i = r0[j + 3 * q] - r0[j + q];
+
+            float y1r = t1r + t3r, y1i = t1i + t3i;
+            float y2r = t0r - t2r, y2i = t0i - t2i;
+            float y3r = t1r - t3r, y3i = t1i - t3i;
+            r0[j] = t0r + t2r;
+            i0[j] = t0i + t2i;
+            r0[j + q] = y1r * w1r[j] - y1i * w1i[j];
+            i0[j + q] = y1r * w1i[j] + y1i * w1r[j];
+            r0[j + 2 * q] = y2r * w2r[j] - y2i * w2i[j];
+            i0[j + 2 * q] = y2r * w2i[j] + y2i * w2r[j];
+            r0[j + 3 * q] = y3r * w3r[j] - y3i * w3i[j];
+            i0[j + 3 * q] = y3r * w3i[j] + y3i * w3r[j];
+        }
+    }
+}
+
+float FlacScalarGainF32(float* data, size_t count, float gain) {
+    float peak = 0.0f;
+    for (size_t i = 0; i < count; i++) {
+        data[i] *= gain;
+        peak = std::max(peak, std::fabs(data[i]));
+    }
+    return peak;
+}
+
+// 两个乘积先分别舍入再相加，SIMD 实现保持同样的顺序
+void FlacScalarCrossfadeF32(const float* a, const float* b, const float* gain_a, const float* gain_b, uint64_t frames, int channels, float* out) {
+    for (uint64_t i = 0; i < frames; i++) {
+        const float ga = gain_a[i];
+        const float gb = gain_b[i];
+        for (int c = 0; c < channels; c++) {
+            const uint64_t k = i * channels + c;
+            out[k] = a[k] * ga + b[k] * gb;
+        }
+    }
+}
+
+static const FlacPcmKernels SCALAR_KERNELS = {
+    "scalar",
+    FlacScalarDeinterleaveF32,
+    FlacScalarDotF32,
+    FlacScalarMixF32,
+    FlacScalarPeakF32,
+    FlacScalarRadix4F32,
+    FlacScalarGainF32,
+    FlacScalarCrossfadeF32,
+};
+
+// ========== SSE2 ==========
+
+#ifdef FLAC_HAVE_SSE2
+
+static void Sse2DeinterleaveF32(const float* in, uint64_t frames, int channels, float* out, uint64_t plane_stride) {
+    if (channels != 2) {
+        FlacScalarDeinterleaveF32(in, frames, channels, out, plane_stride);
+        return;
+    }
+
+    float* left = out;
+    float* right = out + plane_stride;
+    uint64_t i = 0;
+    for (; i + 4 <= frames; i += 4) {
+        __m128 a = _mm_loadu_ps(in + i * 2);       // L0 R0 L1 R1
+        __m128 b = _mm_loadu_ps(in + i * 2 + 4);   // L2 R2 L3 R3
+        _mm_storeu_ps(left + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(right + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+    }
+    for (; i < frames; i++) {
+        left[i] = in[i * 2];
+        right[i] = in[i * 2 + 1];
+    }
+}
+
+static float Sse2DotF32(const float* a, const float* b, size_t count) {
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+    }
+    __m128 acc = _mm_add_ps(acc0, acc1);
+    acc = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));
+    acc = _mm_add_ss(acc, _mm_shuffle_ps(acc, acc, _MM_SHUFFLE(1, 1, 1, 1)));
+    float sum = _mm_cvtss_f32(acc);
+    for (; i < count; i++) sum += a[i] * b[i];
+    return sum;
+}
+
+// 每次处理 4 帧：按 4 个声道一组读入后转置，得到每个声道跨 4 帧的向量。
+// 声道数不是 4 的倍数时最后一组向前重叠，已累加过的声道跳过，累加顺序与标量一致
+static void Sse2MixF32(const float* in, uint64_t frames, int in_channels, const float* matrix, int out_channels, float* out) {
+    if (in_channels < 4 || out_channels > 2) {
+        FlacScalarMixF32(in, frames, in_channels, matrix, out_channels, out);
+        return;
+    }
+
+    const float* right_row = matrix + (out_channels == 2 ? in_channels : 0);
+    uint64_t i = 0;
+    for (; i + 4 <= frames; i += 4) {
+        const float* f = in + i * in_channels;
+        __m128 acc0 = _mm_setzero_ps();
+        __m128 acc1 = _mm_setzero_ps();
+        for (int g = 0; g < in_channels; g += 4) {
+            int start = std::min(g, in_channels - 4);
+            __m128 col[4] = {
+                _mm_loadu_ps(f + start),
+                _mm_loadu_ps(f + in_channels + start),
+                _mm_loadu_ps(f + in_channels * 2 + start),
+                _mm_loadu_ps(f + in_channels * 3 + start),
+            };
+            _MM_TRANSPOSE4_PS(col[0], col[1], col[2], col[3]);
+            for (int k = g - start; k < 4; k++) {
+                acc0 = _mm_add_ps(acc0, _mm_mul_ps(col[k], _mm_set1_ps(matrix[start + k])));
+                acc1 = _mm_add_ps(acc1, _mm_mul_ps(col[k], _mm_set1_ps(right_row[start + k])));
+            }
+        }
+        if (out_channels == 1) {
+            _mm_storeu_ps(out + i, acc0);
+        } else {
+            _mm_storeu_ps(out + i * 2, _mm_unpacklo_ps(acc0, acc1));
+            _mm_storeu_ps(out + i * 2 + 4, _mm_unpackhi_ps(acc0, acc1));
+        }
+    }
+    FlacScalarMixF32(in + i * in_channels, frames - i, in_channels, matrix, out_channels, out + i * out_channels);
+}
+
+static void Sse2PeakF32(const float* in, size_t count, float* min, float* max, float* sum_squares) {
+    __m128 lo = _mm_set1_ps(*min);
+    __m128 hi = _mm_set1_ps(*max);
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128 a = _mm_loadu_ps(in + i);
+        __m128 b = _mm_loadu_ps(in + i + 4);
+        lo = _mm_min_ps(lo, _mm_min_ps(a, b));
+        hi = _mm_max_ps(hi, _mm_max_ps(a, b));
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(a, a));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(b, b));
+    }
+    lo = _mm_min_ps(lo, _mm_movehl_ps(lo, lo));
+    lo = _mm_min_ss(lo, _mm_shuffle_ps(lo, lo, _MM_SHUFFLE(1, 1, 1, 1)));
+    hi = _mm_max_ps(hi, _mm_movehl_ps(hi, hi));
+    hi = _mm_max_ss(hi, _mm_shuffle_ps(hi, hi, _MM_SHUFFLE(1, 1, 1, 1)));
+    __m128 acc = _mm_add_ps(acc0, acc1);
+    acc = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));
+    acc = _mm_add_ss(acc, _mm_shuffle_ps(acc, acc, _MM_SHUFFLE(1, 1, 1, 1)));
+
+    *min = _mm_cvtss_f32(lo);
+    *max = _mm_cvtss_f32(hi);
+    *sum_squares += _mm_cvtss_f32(acc);
+    FlacScalarPeakF32(in + i, count - i, min, max, sum_squares);
+}
+
+// 每次处理同一块内相邻的 4 组蝶形，quarter < 4 的最后几级交给标量实现
+static void Sse2Radix4F32(float* re, float* im, size_t n, size_t quarter, const float* twiddles) {
+    const size_t q = quarter;
+    if (q < 4) {
+        FlacScalarRadix4F32(re, im, n, quarter, twiddles);
+        return;
+    }
+
+    for (size_t block = 0; block < n; block += 4 * q) {
+        float* r0 = re + block;
+        float* i0 = im + block;
+        for (size_t j = 0; j + 4 <= q; j += 4) {
+            __m128 a0r = _mm_loadu_ps(r0 + j), a0i = _mm_loadu_ps(i0 + j);
+            __m128 a1r = _mm_loadu_ps(r0 + j + q), a1i = _mm_loadu_ps(i0 + j + q);
+            __m128 a2r = _mm_loadu_ps(r0 + j + 2 * q), a2i = _mm_loadu_ps(i0 + j + 2 * q);
+            __m128 a3r = _mm_loadu_ps(r0 + j + 3 * q), a3i = _mm_loadu_ps(i0 + j + 3 * q);
+
+            __m128 t0r = _mm_add_ps(a0r, a2r), t0i = _mm_add_ps(a0i, a2i);
+            __m128 t1r = _mm_sub_ps(a0r, a2r), t1i = _mm_sub_ps(a0i, a2i);
+            __m128 t2r = _mm_add_ps(a1r, a3r), t2i = _mm_add_ps(a1i, a3i);
+            __m128 t3r = _mm_sub_ps(a1i, a3i), t3i = _mm_sub_ps(a3r, a1r);
+
+            __m128 y1r = _mm_add_ps(t1r, t3r), y1i = _mm_add_ps(t1i, t3i);
+            __m128 y2r = _mm_sub_ps(t0r, t2r), y2i = _mm_sub_ps(t0i, t2i);
+            __m128 y3r = _mm_sub_ps(t1r, t3r), y3i = _mm_sub_ps(t1i, t3i);
+            __m128 w1r = _mm_loadu_ps(twiddles + j), w1i = _mm_loadu_ps(twiddles + q + j);
+            __m128 w2r = _mm_loadu_ps(twiddles + 2 * q + j), w2i = _mm_loadu_ps(twiddles + 3 * q + j);
+            __m128 w3r = _mm_loadu_ps(twiddles + 4 * q + j), w3i = _mm_loadu_ps(twiddles + 5 * q + j);
+
+            _mm_storeu_ps(r0 + j, _mm_add_ps(t0r, t2r));
+            _mm_storeu_ps(i0 + j, _mm_add_ps(t0i, t2i));
+            _mm_storeu_ps(r0 + j + q, _mm_sub_ps(_mm_mul_ps(y1r, w1r), _mm_mul_ps(y1i, w1i)));
+            _mm_storeu_ps(i0 + j + q, _mm_add_ps(_mm_mul_ps(y1r, w1i), _mm_mul_ps(y1i, w1r)));
+            _mm_storeu_ps(r0 + j + 2 * q, _mm_sub_ps(_mm_mul_ps(y2r, w2r), _mm_mul_ps(y2i, w2i)));
+            _mm_storeu_ps(i0 + j + 2 * q, _mm_add_ps(_mm_mul_ps(y2r, w2i), _mm_mul_ps(y2i, w2r)));
+            _mm_storeu_ps(r0 + j + 3 * q, _mm_sub_ps(_mm_mul_ps(y3r, w3r), _mm_mul_ps(y3i, w3i)));
+            _mm_storeu_ps(i0 + j + 3 * q, _mm_add_ps(_mm_mul_ps(y3r, w3i), _mm_mul_ps(y3i, w3r)));
+        }
+    }
+}
+
+static float Sse2GainF32(float* data, size_t count, float gain) {
+    const __m128 g = _mm_set1_ps(gain);
+    const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    __m128 peak = _mm_setzero_ps();
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128 a = _mm_mul_ps(_mm_loadu_ps(data + i), g);
+        __m128 b = _mm_mul_ps(_mm_loadu_ps(data + i + 4), g);
+        _mm_storeu_ps(data + i, a);
+        _mm_storeu_ps(data + i + 4, b);
+        peak = _mm_max_ps(peak, _mm_max_ps(_mm_and_ps(a, abs_mask), _mm_and_ps(b, abs_mask)));
+    }
+    peak = _mm_max_ps(peak, _mm_movehl_ps(peak, peak));
+    peak = _mm_max_ss(peak, _mm_shuffle_ps(peak, peak, _MM_SHUFFLE(1, 1, 1, 1)));
+    return std::max(_mm_cvtss_f32(peak), FlacScalarGainF32(data + i, count - i, gain));
+}
+
+// 每次处理 4 帧的增益：单声道直接对应，立体声把每帧的增益复制到左右两个声道
+static void Sse2CrossfadeF32(const float* a, const float* b, const float* gain_a, const float* gain_b, uint64_t frames, int channels, float* out) {
+    if (channels > 2) {
+        FlacScalarCrossfadeF32(a, b, gain_a, gain_b, frames, channels, out);
+        return;
+    }
+
+    uint64_t i = 0;
+    for (; i + 4 <= frames; i += 4) {
+        const __m128 ga = _mm_loadu_ps(gain_a + i);
+        const __m128 gb = _mm_loadu_ps(gain_b + i);
+        if (channels == 1) {
+            _mm_storeu_ps(out + i, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(a + i), ga), _mm_mul_ps(_mm_loadu_ps(b + i), gb)));
+        } else {
+            const uint64_t k = i * 2;
+            __m128 lo = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(a + k), _mm_unpacklo_ps(ga, ga)),
+                                   _mm_mul_ps(_mm_loadu_ps(b + k), _mm_unpacklo_ps(gb, gb)));
+            __m128 hi = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(a + k + 4), _mm_unpackhi_ps(ga, ga)),
+                                   _mm_mul_ps(_mm_loadu_ps(b + k + 4), _mm_unpackhi_ps(gb, gb)));
+            _mm_storeu_ps(out + k, lo);
+            _mm_storeu_ps(out + k + 4, hi);
+        }
+    }
+    FlacScalarCrossfadeF32(a + i * channels, b + i * channels, gain_a + i, gain_b + i, frames - i, channels, out + i * channels);
+}
+
+static const FlacPcmKernels SSE2_KERNELS = {
+    "sse2",
+    Sse2DeinterleaveF32,
+    Sse2DotF32,
+    Sse2MixF32,
+    Sse2PeakF32,
+    Sse2Radix4F32,
+    Sse2GainF32,
+    Sse2CrossfadeF32,
+};
+
+#endif // FLAC_HAVE_SSE2
+
+// ========== NEON ==========
+
+#ifdef FLAC_HAVE_NEON
+
+static void NeonDeinterleaveF32(const float* in, uint64_t frames, int channels, float* out, uint64_t plane_stride) {
+    if (channels != 2) {
+        FlacScalarDeinterleaveF32(in, frames, channels, out, plane_stride);
+        return;
+    }
+
+    float* left = out;
+    float* right = out + plane_stride;
+    uint64_t i = 0;
+    for (; i + 4 <= frames; i += 4) {
+        float32x4x2_t lr = vld2q_f32(in + i * 2);
+        vst1q_f32(left + i, lr.val[0]);
+        vst1q_f32(right + i, lr.val[1]);
+    }
+    for (; i < frames; i++) {
+        left[i] = in[i * 2];
+        right[i] = in[i * 2 + 1];
+    }
+}
+
+static float NeonDotF32(const float* a, const float* b, size_t count) {
+    float32x4_t acc0 = vdupq_n_f32(0.0f);
+    float32x4_t acc1 = vdupq_n_f32(0.0f);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        acc0 = vmlaq_f32(acc0, vld1q_f32(a + i), vld1q_f32(b + i));
+        acc1 = vmlaq_f32(acc1, vld1q_f32(a + i + 4), vld1q_f32(b + i + 4));
+    }
+    float32x4_t acc = vaddq_f32(acc0, acc1);
+    float32x2_t pair = vadd_f32(vget_low_f32(acc), vget_high_f32(acc));
+    float sum = vget_lane_f32(vpadd_f32(pair, pair), 0);
+    for (; i < count; i++) sum += a[i] * b[i];
+    return sum;
+}
+
+// 与 SSE2 版本相同的 4 帧转置方案
+static void NeonMixF32(const float* in, uint64_t frames, int in_channels, const float* matrix, int out_channels, float* out) {
+    if (in_channels < 4 || out_channels > 2) {
+        FlacScalarMixF32(in, frames, in_channels, matrix, out_channels, out);
+        return;
+    }
+
+    const float* right_row = matrix + (out_channels == 2 ? in_channels : 0);
+    uint64_t i = 0;
+    for (; i + 4 <= frames; i += 4) {
+        const float* f = in + i * in_channels;
+        float32x4_t acc0 = vdupq_n_f32(0.0f);
+        float32x4_t acc1 = vdupq_n_f32(0.0f);
+        for (int g = 0; g < in_channels; g += 4) {
+            int start = std::min(g, in_channels - 4);
+            float32x4x2_t t01 = vtrnq_f32(vld1q_f32(f + start), vld1q_f32(f + in_channels + start));
+            float32x4x2_t t23 = vtrnq_f32(vld1q_f32(f + in_channels * 2 + start), vld1q_f32(f + in_channels * 3 + start));
+            float32x4_t col[4] = {
+                vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0])),
+                vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1])),
+                vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0])),
+                vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1])),
+            };
+            // 乘加分开写，避免融合乘加改变舍入
+            for (int k = g - start; k < 4; k++) {
+                acc0 = vaddq_f32(acc0, vmulq_f32(col[k], vdupq_n_f32(matrix[start + k])));
+                acc1 = vaddq_f32(acc1, vmulq_f32(col[k], vdupq_n_f32(right_row[start + k])));
+            }
+        }
+        if (out_channels == 1) {
+            vst1q_f32(out + i, acc0);
+        } else {
+            float32x4x2_t lr = { { acc0, acc1 } };
+            vst2q_f32(out + i * 2, lr);
+        }
+    }
+    FlacScalarMixF32(in + i * in_channels, frames - i, in_channels, matrix, out_channels, out + i * out_channels);
+}
+
+static void NeonPeakF32(const float* in, size_t count, float* min, float* max, float* sum_squares) {
+    float32x4_t lo = vdupq_n_f32(*min);
+    float32x4_t hi = vdupq_n_f32(*max);
+    float32x4_t acc0 = vdupq_n_f32(0.0f);
+    float32x4_t acc1 = vdupq_n_f32(0.0f);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        float32x4_t a = vld1q_f32(in + i);
+        float32x4_t b = vld1q_f32(in + i + 4);
+        lo = vminq_f32(lo, vminq_f32(a, b));
+        hi = vmaxq_f32(hi, vmaxq_f32(a, b));
+        acc0 = vmlaq_f32(acc0, a, a);
+        acc1 = vmlaq_f32(acc1, b, b);
+    }
+    float32x2_t lo2 = vpmin_f32(vget_low_f32(lo), vget_high_f32(lo));
+    float32x2_t hi2 = vpmax_f32(vget_low_f32(hi), vget_high_f32(hi));
+    float32x4_t acc = vaddq_f32(acc0, acc1);
+    float32x2_t pair = vadd_f32(vget_low_f32(acc), vget_high_f32(acc));
+
+    *min = vget_lane_f32(vpmin_f32(lo2, lo2), 0);
+    *max = vget_lane_f32(vpmax_f32(hi2, hi2), 0);
+    *sum_squares += vget_lane_f32(vpadd_f32(pair, pair), 0);
+    FlacScalarPeakF32(in + i, count - i, min, max, sum_squares);
+}
+
+// 与 SSE2 版本相同；乘加分开执行（不使用 vmla / vfma），与标量结果逐位一致
+static void NeonRadix4F32(float* re, float* im, size_t n, size_t quarter, const float* twiddles) {
+    const size_t q = quarter;
+    if (q < 4) {
+        FlacScalarRadix4F32(re, im, n, quarter, twiddles);
+        return;
+    }
+
+    for (size_t block = 0; block < n; block += 4 * q) {
+        float* r0 = re + block;
+        float* i0 = im + block;
+        for (size_t j = 0; j + 4 <= q; j += 4) {
+            float32x4_t a0r = vld1q_f32(r0 + j), a0i = vld1q_f32(i0 + j);
+            float32x4_t a1r = vld1q_f32(r0 + j + q), a1i = vld1q_f32(i0 + j + q);
+            float32x4_t a2r = vld1q_f32(r0 + j + 2 * q), a2i = vld1q_f32(i0 + j + 2 * q);
+            float32x4_t a3r = vld1q_f32(r0 + j + 3 * q), a3i = vld1q_f32(i0 + j + 3 * q);
+
+            float32x4_t t0r = vaddq_f32(a0r, a2r), t0i = vaddq_f32(a0i, a2i);
+            float32x4_t t1r = vsubq_f32(a0r, a2r), t1i = vsubq_f32(a0i, a2i);
+            float32x4_t t2r = vaddq_f32(a1r, a3r), t2i = vaddq_f32(a1i, a3i);
+            float32x4_t t3r = vsubq_f32(a1i, a3i), t3i = vsubq_f32(a3r, a1r);
+
+            float32x4_t y1r = vaddq_f32(t1r, t3r), y1i = vaddq_f32(t1i, t3i);
+            float32x4_t y2r = vsubq_f32(t0r, t2r), y2i = vsubq_f32(t0i, t2i);
+            float32x4_t y3r = vsubq_f32(t1r, t3r), y3i = vsubq_f32(t1i, t3i);
+            float32x4_t w1r = vld1q_f32(twiddles + j), w1i = vld1q_f32(twiddles + q + j);
+            float32x4_t w2r = vld1q_f32(twiddles + 2 * q + j), w2i = vld1q_f32(twiddles + 3 * q + j);
+            float32x4_t w3r = vld1q_f32(twiddles + 4 * q + j), w3i = vld1q_f32(twiddles + 5 * q + j);
+
+            vst1q_f32(r0 + j, vaddq_f32(t0r, t2r));
+            vst1q_f32(i0 + j, vaddq_f32(t0i, t2i));
+            vst1q_f32(r0 + j + q, vsubq_f32(vmulq_f32(y1r, w1r), vmulq_f32(y1i, w1i)));
+            vst1q_f32(i0 + j + q, vaddq_f32(vmulq_f32(y1r, w1i), vmulq_f32(y1i, w1r)));
+            vst1q_f32(r0 + j + 2 * q, vsubq_f32(vmulq_f32(y2r, w2r), vmulq_f32(y2i, w2i)));
+            vst1q_f32(i0 + j + 2 * q, vaddq_f32(vmulq_f32(y2r, w2i), vmulq_f32(y2i, w2r)));
+            vst1q_f32(r0 + j + 3 * q, vsubq_f32(vmulq_f32(y3r, w3r), vmulq_f32(y3i, w3i)));
+            vst1q_f32(i0 + j + 3 * q, vaddq_f32(vmulq_f32(y3r, w3i), vmulq_f32(y3i, w3r)));
+        }
+    }
+}
+
+static float NeonGainF32(float* data, size_t count, float gain) {
+    float32x4_t peak = vdupq_n_f32(0.0f);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        float32x4_t a = vmulq_n_f32(vld1q_f32(data + i), gain);
+        float32x4_t b = vmulq_n_f32(vld1q_f32(data + i + 4), gain);
+        vst1q_f32(data + i, a);
+        vst1q_f32(data + i + 4, b);
+        peak = vmaxq_f32(peak, vmaxq_f32(vabsq_f32(a), vabsq_f32(b)));
+    }
+    float32x2_t peak2 = vpmax_f32(vget_low_f32(peak), vget_high_f32(peak));
+    return std::max(vget_lane_f32(vpmax_f32(peak2, peak2), 0), FlacScalarGainF32(data + i, count - i, gain));
+}
+
+// 与 SSE2 版本相同：每次 4 帧，立体声用 vzip 复制每帧的增益
+static void NeonCrossfadeF32(const float* a, const float* b, const float* gain_a, const float* gain_b, uint64_t frames, int channels, float* out) {
+    if (channels > 2) {
+        FlacScalarCrossfadeF32(a, b, gain_a, gain_b, frames, channels, out);
+        return;
+    }
+
+    uint64_t i = 0;
+    for (; i + 4 <= frames; i += 4) {
+        const float32x4_t ga = vld1q_f32(gain_a + i);
+        const float32x4_t gb = vld1q_f32(gain_b + i);
+        // 乘加分开写，避免融合乘加改变舍入
+        if (channels == 1) {
+            vst1q_f32(out + i, vaddq_f32(vmulq_f32(vld1q_f32(a + i), ga), vmulq_f32(vld1q_f32(b + i), gb)));
+        } else {
+            const uint64_t k = i * 2;
+            float32x4x2_t za = vzipq_f32(ga, ga);
+            float32x4x2_t zb = vzipq_f32(gb, gb);
+            float32x4_t lo = vaddq_f32(vmulq_f32(vld1q_f32(a + k), za.val[0]), vmulq_f32(vld1q_f32(b + k), zb.val[0]));
+            float32x4_t hi = vaddq_f32(vmulq_f32(vld1q_f32(a + k + 4), za.val[1]), vmulq_f32(vld1q_f32(b + k + 4), zb.val[1]));
+            vst1q_f32(out + k, lo);
+            vst1q_f32(out + k + 4, hi);
+        }
+    }
+    FlacScalarCrossfadeF32(a + i * channels, b + i * channels, gain_a + i, gain_b + i, frames - i, channels, out + i * channels);
+}
+
+static const FlacPcmKernels NEON_KERNELS = {
+    "neon",
+    NeonDeinterleaveF32,
+    NeonDotF32,
+    NeonMixF32,
+    NeonPeakF32,
+    NeonRadix4F32,
+    NeonGainF32,
+    NeonCrossfadeF32,
+};
+
+#endif // FLAC_HAVE_NEON
+
+// ========== CPU 检测与分发 ==========
+
+#ifdef FLAC_HAVE_X86
+
+static void Cpuid(int leaf, int subleaf, unsigned int regs[4]) {
+#ifdef _MSC_VER
+    int info[4];
+    __cpuidex(info, leaf, subleaf);
+    for (int i = 0; i < 4; i++) regs[i] = static_cast<unsigned int>(info[i]);
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+static bool CpuSupportsAvx2() {
+    unsigned int regs[4];
+    Cpuid(0, 0, regs);
+    if (regs[0] < 7) return false;
+
+    // 需要 CPU 支持 AVX 且操作系统保存 YMM 寄存器（OSXSAVE + XCR0 的 SSE/AVX 位）
+    Cpuid(1, 0, regs);
+    bool osxsave = (regs[2] & (1u << 27)) != 0;
+    bool avx = (regs[2] & (1u << 28)) != 0;
+    if (!osxsave || !avx) return false;
+
+#ifdef _MSC_VER
+    unsigned long long xcr0 = _xgetbv(0);
+#else
+    unsigned int xcr0_lo = 0, xcr0_hi = 0;
+    __asm__ volatile("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+    unsigned long long xcr0 = (static_cast<unsigned long long>(xcr0_hi) << 32) | xcr0_lo;
+#endif
+    if ((xcr0 & 0x6) != 0x6) return false;
+
+    Cpuid(7, 0, regs);
+    return (regs[1] & (1u << 5)) != 0;
+}
+
+#endif // FLAC_HAVE_X86
+
+const FlacPcmKernels* FlacGetPcmKernelsForLevel(FlacSimdLevel level) {
+    switch (level) {
+    case FLAC_SIMD_SCALAR:
+        return &SCALAR_KERNELS;
+#ifdef FLAC_HAVE_SSE2
+    case FLAC_SIMD_SSE2:
+        return &SSE2_KERNELS;
+#endif
+#ifdef FLAC_HAVE_X86
+    case FLAC_SIMD_AVX2:
+        return CpuSupportsAvx2() ? FlacGetAvx2Kernels() : nullptr;
+#endif
+#ifdef FLAC_HAVE_NEON
+    case FLAC_SIMD_NEON:
+        return &NEON_KERNELS;
+#endif
+    default:
+        return nullptr;
+    }
+}
+
+static const FlacPcmKernels* SelectKernels() {
+    static const FlacSimdLevel PREFERENCE[] = { FLAC_SIMD_AVX2, FLAC_SIMD_NEON, FLAC_SIMD_SSE2 };
+    for (FlacSimdLevel level : PREFERENCE) {
+        const FlacPcmKernels* kernels = FlacGetPcmKernelsForLevel(level);
+        if (kernels) return kernels;
+    }
+    return &SCALAR_KERNELS;
+}
+
+const FlacPcmKernels& FlacGetPcmKernels() {
+    // 函数内静态变量的初始化是线程安全的，CPUID 只执行一次
+    static const FlacPcmKernels* kernels = SelectKernels();
+    return *kernels;
+}
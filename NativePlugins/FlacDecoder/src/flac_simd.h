@@ -0,0 +1,67 @@
+#ifndef CHILL_FLAC_SIMD_H
+#define CHILL_FLAC_SIMD_H
+
+// 解交错 / 缩混 / 峰值统计 / FFT / 增益 / 交叉淡化内核：标量、SSE2、AVX2、NEON 实现，首次打开流时按 CPUID 选择一次。
+// 除点积和平方和外，所有实现与标量版本逐位一致。
+
+#include <cstddef>
+#include <cstdint>
+
+enum FlacSimdLevel {
+    FLAC_SIMD_SCALAR = 0,
+    FLAC_SIMD_SSE2,
+    FLAC_SIMD_AVX2,
+    FLAC_SIMD_NEON,
+    FLAC_SIMD_LEVEL_COUNT
+};
+
+struct FlacPcmKernels {
+    const char* name;
+
+    // 交错 f32 → 平面 f32：声道 c 的第 i 帧写到 out[c * plane_stride + i]
+    void (*deinterleave_f32)(const float* in, uint64_t frames, int channels, float* out, uint64_t plane_stride);
+
+    // 点积（重采样滤波器内循环）。累加顺序因实现而异，结果只在舍入误差内一致
+    float (*dot_f32)(const float* a, const float* b, size_t count);
+
+    // 声道矩阵（缩混）：交错 in_channels → 交错 out_channels，
+    // out[o] = Σ matrix[o * in_channels + c] * in[c]（按 c 递增累加）。SIMD 实现只加速 out_channels <= 2
+    void (*mix_f32)(const float* in, uint64_t frames, int in_channels, const float* matrix, int out_channels, float* out);
+
+    // 峰值统计（波形概览）：count 个采样的最小值、最大值与平方和，与 *min / *max / *sum_squares 中已有的值合并。
+    // 最小 / 最大值与标量逐位一致；平方和的累加顺序因实现而异，只在舍入误差内一致
+    void (*peak_f32)(const float* in, size_t count, float* min, float* max, float* sum_squares);
+
+    // 复数 FFT 的一级 radix-4 蝶形（按频率抽取，实部 / 虚部分开存放）：n 点分为长 4 × quarter 的块，
+    // 每块的第 j 组 (j, j + q, j + 2q, j + 3q) 做 4 点 DFT，后三路分别乘以 w^j、w^2j、w^3j。
+    // twiddles 依次为 w^j 实部、w^j 虚部、w^2j 实部、w^2j 虚部、w^3j 实部、w^3j 虚部，各 quarter 个
+    void (*radix4_f32)(float* re, float* im, size_t n, size_t quarter, const float* twiddles);
+
+    // 增益（流输出级的响度归一化）：data 原地乘以 gain，返回处理后的最大绝对值（用于判断是否需要限幅）
+    float (*gain_f32)(float* data, size_t count, float gain);
+
+    // 交叉淡化（过渡引擎）：交错的 a、b 按每帧的增益相加，out[f * channels + c] = a[..] * gain_a[f] + b[..] * gain_b[f]。
+    // out 可以与 a 或 b 相同。SIMD 实现只加速 channels <= 2
+    void (*crossfade_f32)(const float* a, const float* b, const float* gain_a, const float* gain_b, uint64_t frames, int channels, float* out);
+};
+
+// 当前 CPU 支持的最快实现（首次调用时检测，之后直接返回）
+const FlacPcmKernels& FlacGetPcmKernels();
+
+// 指定级别的实现，当前 CPU 或编译目标不支持时返回 NULL（测试与基准程序使用）
+const FlacPcmKernels* FlacGetPcmKernelsForLevel(FlacSimdLevel level);
+
+// AVX2 实现位于单独编译的 flac_simd_avx2.cpp，编译器不支持时返回 NULL
+const FlacPcmKernels* FlacGetAvx2Kernels();
+
+// ========== 标量实现（其他实现处理尾部时复用） ==========
+
+void FlacScalarDeinterleaveF32(const float* in, uint64_t frames, int channels, float* out, uint64_t plane_stride);
+float FlacScalarDotF32(const float* a, const float* b, size_t count);
+void FlacScalarMixF32(const float* in, uint64_t frames, int in_channels, const float* matrix, int out_channels, float* out);
+void FlacScalarPeakF32(const float* in, size_t count, float* min, float* max, float* sum_squares);
+void FlacScalarRadix4F32(float* re, float* im, size_t n, size_t quarter, const float* twiddles);
+float FlacScalarGainF32(float* data, size_t count, float gain);
+void FlacScalarCrossfadeF32(const float* a, const float* b, const float* gain_a, const float* gain_b, uint64_t frames, int channels, float* out);
+
+#endif // CHILL_FLAC_SIMD_H
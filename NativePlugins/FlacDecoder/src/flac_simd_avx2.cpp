@@ -0,0 +1,230 @@
+// AVX2 内核：本文件单独以 AVX2 编译（见 CMakeLists.txt），只在 CPUID 确认支持后调用
+
+#include "flac_simd.h"
+
+#ifdef __AVX2__
+
+#include <algorithm>
+#include <immintrin.h>
+
+static void Avx2DeinterleaveF32(const float* in, uint64_t frames, int channels, float* out, uint64_t plane_stride) {
+    if (channels != 2) {
+        FlacScalarDeinterleaveF32(in, frames, channels, out, plane_stride);
+        return;
+    }
+
+    float* left = out;
+    float* right = out + plane_stride;
+    uint64_t i = 0;
+    for (; i + 8 <= frames; i += 8) {
+        __m256 a = _mm256_loadu_ps(in + i * 2);       // L0 R0 L1 R1 | L2 R2 L3 R3
+        __m256 b = _mm256_loadu_ps(in + i * 2 + 8);   // L4 R4 L5 R5 | L6 R6 L7 R7
+        // 按 128 位通道内重排得到 L0 L1 L4 L5 | L2 L3 L6 L7，再跨通道交换中间两个 64 位块
+        __m256 l = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+        __m256 r = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+        l = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(l), _MM_SHUFFLE(3, 1, 2, 0)));
+        r = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(r), _MM_SHUFFLE(3, 1, 2, 0)));
+        _mm256_storeu_ps(left + i, l);
+        _mm256_storeu_ps(right + i, r);
+    }
+    for (; i < frames; i++) {
+        left[i] = in[i * 2];
+        right[i] = in[i * 2 + 1];
+    }
+}
+
+static float Avx2DotF32(const float* a, const float* b, size_t count) {
+    // 不使用 FMA：CPUID 只检查了 AVX2
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+        acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8)));
+    }
+    __m256 acc256 = _mm256_add_ps(acc0, acc1);
+    __m128 acc = _mm_add_ps(_mm256_castps256_ps128(acc256), _mm256_extractf128_ps(acc256, 1));
+    acc = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));
+    acc = _mm_add_ss(acc, _mm_shuffle_ps(acc, acc, _MM_SHUFFLE(1, 1, 1, 1)));
+    float sum = _mm_cvtss_f32(acc);
+    for (; i < count; i++) sum += a[i] * b[i];
+    return sum;
+}
+
+// 每次处理 8 帧：用 gather 按帧间距取出同一声道的 8 个采样
+static void Avx2MixF32(const float* in, uint64_t frames, int in_channels, const float* matrix, int out_channels, float* out) {
+    if (out_channels > 2) {
+        FlacScalarMixF32(in, frames, in_channels, matrix, out_channels, out);
+        return;
+    }
+
+    const float* right_row = matrix + (out_channels == 2 ? in_channels : 0);
+    const __m256i offsets = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(in_channels));
+    uint64_t i = 0;
+    for (; i + 8 <= frames; i += 8) {
+        const float* f = in + i * in_channels;
+        __m256 acc0 = _mm256_setzero_ps();
+        __m256 acc1 = _mm256_setzero_ps();
+        for (int c = 0; c < in_channels; c++) {
+            __m256 col = _mm256_i32gather_ps(f + c, offsets, 4);
+            acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(col, _mm256_set1_ps(matrix[c])));
+            acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(col, _mm256_set1_ps(right_row[c])));
+        }
+        if (out_channels == 1) {
+            _mm256_storeu_ps(out + i, acc0);
+        } else {
+            // unpack 在 128 位通道内交错：lo = L0 R0 L1 R1 | L4 R4 L5 R5，hi = L2 R2 L3 R3 | L6 R6 L7 R7
+            __m256 lo = _mm256_unpacklo_ps(acc0, acc1);
+            __m256 hi = _mm256_unpackhi_ps(acc0, acc1);
+            _mm256_storeu_ps(out + i * 2, _mm256_permute2f128_ps(lo, hi, 0x20));
+            _mm256_storeu_ps(out + i * 2 + 8, _mm256_permute2f128_ps(lo, hi, 0x31));
+        }
+    }
+    FlacScalarMixF32(in + i * in_channels, frames - i, in_channels, matrix, out_channels, out + i * out_channels);
+}
+
+static void Avx2PeakF32(const float* in, size_t count, float* min, float* max, float* sum_squares) {
+    __m256 lo = _mm256_set1_ps(*min);
+    __m256 hi = _mm256_set1_ps(*max);
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256 a = _mm256_loadu_ps(in + i);
+        __m256 b = _mm256_loadu_ps(in + i + 8);
+        lo = _mm256_min_ps(lo, _mm256_min_ps(a, b));
+        hi = _mm256_max_ps(hi, _mm256_max_ps(a, b));
+        acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(a, a));
+        acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(b, b));
+    }
+    __m128 lo4 = _mm_min_ps(_mm256_castps256_ps128(lo), _mm256_extractf128_ps(lo, 1));
+    lo4 = _mm_min_ps(lo4, _mm_movehl_ps(lo4, lo4));
+    lo4 = _mm_min_ss(lo4, _mm_shuffle_ps(lo4, lo4, _MM_SHUFFLE(1, 1, 1, 1)));
+    __m128 hi4 = _mm_max_ps(_mm256_castps256_ps128(hi), _mm256_extractf128_ps(hi, 1));
+    hi4 = _mm_max_ps(hi4, _mm_movehl_ps(hi4, hi4));
+    hi4 = _mm_max_ss(hi4, _mm_shuffle_ps(hi4, hi4, _MM_SHUFFLE(1, 1, 1, 1)));
+    __m256 acc256 = _mm256_add_ps(acc0, acc1);
+    __m128 acc = _mm_add_ps(_mm256_castps256_ps128(acc256), _mm256_extractf128_ps(acc256, 1));
+    acc = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));
+    acc = _mm_add_ss(acc, _mm_shuffle_ps(acc, acc, _MM_SHUFFLE(1, 1, 1, 1)));
+
+    *min = _mm_cvtss_f32(lo4);
+    *max = _mm_cvtss_f32(hi4);
+    *sum_squares += _mm_cvtss_f32(acc);
+    FlacScalarPeakF32(in + i, count - i, min, max, sum_squares);
+}
+
+// 每次处理同一块内相邻的 8 组蝶形，quarter < 8 的最后几级交给标量实现
+static void Avx2Radix4F32(float* re, float* im, size_t n, size_t quarter, const float* twiddles) {
+    const size_t q = quarter;
+    if (q < 8) {
+        FlacScalarRadix4F32(re, im, n, quarter, twiddles);
+        return;
+    }
+
+    for (size_t block = 0; block < n; block += 4 * q) {
+        float* r0 = re + block;
+        float* i0 = im + block;
+        for (size_t j = 0; j + 8 <= q; j += 8) {
+            __m256 a0r = _mm256_loadu_ps(r0 + j), a0i = _mm256_loadu_ps(i0 + j);
+            __m256 a1r = _mm256_loadu_ps(r0 + j + q), a1i = _mm256_loadu_ps(i0 + j + q);
+            __m256 a2r = _mm256_loadu_ps(r0 + j + 2 * q), a2i = _mm256_loadu_ps(i0 + j + 2 * q);
+            __m256 a3r = _mm256_loadu_ps(r0 + j + 3 * q), a3i = _mm256_loadu_ps(i0 + j + 3 * q);
+
+            __m256 t0r = _mm256_add_ps(a0r, a2r), t0i = _mm256_add_ps(a0i, a2i);
+            __m256 t1r = _mm256_sub_ps(a0r, a2r), t1i = _mm256_sub_ps(a0i, a2i);
+            __m256 t2r = _mm256_add_ps(a1r, a3r), t2i = _mm256_add_ps(a1i, a3i);
+            __m256 t3r = _mm256_sub_ps(a1i, a3i), t3i = _mm256_sub_ps(a3r, a1r);
+
+            __m256 y1r = _mm256_add_ps(t1r, t3r), y1i = _mm256_add_ps(t1i, t3i);
+            __m256 y2r = _mm256_sub_ps(t0r, t2r), y2i = _mm256_sub_ps(t0i, t2i);
+            __m256 y3r = _mm256_sub_ps(t1r, t3r), y3i = _mm256_sub_ps(t1i, t3i);
+            __m256 w1r = _mm256_loadu_ps(twiddles + j), w1i = _mm256_loadu_ps(twiddles + q + j);
+            __m256 w2r = _mm256_loadu_ps(twiddles + 2 * q + j), w2i = _mm256_loadu_ps(twiddles + 3 * q + j);
+            __m256 w3r = _mm256_loadu_ps(twiddles + 4 * q + j), w3i = _mm256_loadu_ps(twiddles + 5 * q + j);
+
+            _mm256_storeu_ps(r0 + j, _mm256_add_ps(t0r, t2r));
+            _mm256_storeu_ps(i0 + j, _mm256_add_ps(t0i, t2i));
+            _mm256_storeu_ps(r0 + j + q, _mm256_sub_ps(_mm256_mul_ps(y1r, w1r), _mm256_mul_ps(y1i, w1i)));
+            _mm256_storeu_ps(i0 + j + q, _mm256_add_ps(_mm256_mul_ps(y1r, w1i), _mm256_mul_ps(y1i, w1r)));
+            _mm256_storeu_ps(r0 + j + 2 * q, _mm256_sub_ps(_mm256_mul_ps(y2r, w2r), _mm256_mul_ps(y2i, w2i)));
+            _mm256_storeu_ps(i0 + j + 2 * q, _mm256_add_ps(_mm256_mul_ps(y2r, w2i), _mm256_mul_ps(y2i, w2r)));
+            _mm256_storeu_ps(r0 + j + 3 * q, _mm256_sub_ps(_mm256_mul_ps(y3r, w3r), _mm256_mul_ps(y3i, w3i)));
+            _mm256_storeu_ps(i0 + j + 3 * q, _mm256_add_ps(_mm256_mul_ps(y3r, w3i), _mm256_mul_ps(y3i, w3r)));
+        }
+    }
+}
+
+static float Avx2GainF32(float* data, size_t count, float gain) {
+    const __m256 g = _mm256_set1_ps(gain);
+    const __m256 abs_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+    __m256 peak = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256 a = _mm256_mul_ps(_mm256_loadu_ps(data + i), g);
+        __m256 b = _mm256_mul_ps(_mm256_loadu_ps(data + i + 8), g);
+        _mm256_storeu_ps(data + i, a);
+        _mm256_storeu_ps(data + i + 8, b);
+        peak = _mm256_max_ps(peak, _mm256_max_ps(_mm256_and_ps(a, abs_mask), _mm256_and_ps(b, abs_mask)));
+    }
+    __m128 peak4 = _mm_max_ps(_mm256_castps256_ps128(peak), _mm256_extractf128_ps(peak, 1));
+    peak4 = _mm_max_ps(peak4, _mm_movehl_ps(peak4, peak4));
+    peak4 = _mm_max_ss(peak4, _mm_shuffle_ps(peak4, peak4, _MM_SHUFFLE(1, 1, 1, 1)));
+    return std::max(_mm_cvtss_f32(peak4), FlacScalarGainF32(data + i, count - i, gain));
+}
+
+// 每次处理 8 帧的增益；立体声时 unpack 在每个 128 位半边内复制增益，再用 permute2f128 拼回帧顺序
+static void Avx2CrossfadeF32(const float* a, const float* b, const float* gain_a, const float* gain_b, uint64_t frames, int channels, float* out) {
+    if (channels > 2) {
+        FlacScalarCrossfadeF32(a, b, gain_a, gain_b, frames, channels, out);
+        return;
+    }
+
+    uint64_t i = 0;
+    for (; i + 8 <= frames; i += 8) {
+        const __m256 ga = _mm256_loadu_ps(gain_a + i);
+        const __m256 gb = _mm256_loadu_ps(gain_b + i);
+        if (channels == 1) {
+            _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(a + i), ga),
+                                                    _mm256_mul_ps(_mm256_loadu_ps(b + i), gb)));
+        } else {
+            const uint64_t k = i * 2;
+            __m256 ga_lo = _mm256_unpacklo_ps(ga, ga);
+            __m256 ga_hi = _mm256_unpackhi_ps(ga, ga);
+            __m256 gb_lo = _mm256_unpacklo_ps(gb, gb);
+            __m256 gb_hi = _mm256_unpackhi_ps(gb, gb);
+            __m256 ga0 = _mm256_permute2f128_ps(ga_lo, ga_hi, 0x20);
+            __m256 ga1 = _mm256_permute2f128_ps(ga_lo, ga_hi, 0x31);
+            __m256 gb0 = _mm256_permute2f128_ps(gb_lo, gb_hi, 0x20);
+            __m256 gb1 = _mm256_permute2f128_ps(gb_lo, gb_hi, 0x31);
+            _mm256_storeu_ps(out + k, _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(a + k), ga0),
+                                                    _mm256_mul_ps(_mm256_loadu_ps(b + k), gb0)));
+            _mm256_storeu_ps(out + k + 8, _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(a + k + 8), ga1),
+                                                        _mm256_mul_ps(_mm256_loadu_ps(b + k + 8), gb1)));
+        }
+    }
+    FlacScalarCrossfadeF32(a + i * channels, b + i * channels, gain_a + i, gain_b + i, frames - i, channels, out + i * channels);
+}
+
+static const FlacPcmKernels AVX2_KERNELS = {
+    "avx2",
+    Avx2DeinterleaveF32,
+    Avx2DotF32,
+    Avx2MixF32,
+    Avx2PeakF32,
+    Avx2Radix4F32,
+    Avx2GainF32,
+    Avx2CrossfadeF32,
+};
+
+const FlacPcmKernels* FlacGetAvx2Kernels() {
+    return &AVX2_KERNELS;
+}
+
+#else
+
+const FlacPcmKernels* FlacGetAvx2Kernels() {
+    return nullptr;
+}
+
+#endif // __AVX2__
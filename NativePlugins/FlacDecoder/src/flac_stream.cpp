@@ -0,0 +1,964 @@
+#include "flac_internal.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+// 预解码缓冲的允许范围（毫秒）
+static const int MIN_DECODE_AHEAD_MS = 20;
+static const int MAX_DECODE_AHEAD_MS = 10000;
+
+// 工作线程每次解码的最大帧数
+static const uint64_t DECODE_AHEAD_CHUNK_FRAMES = 4096;
+
+// 边写边读模式下每次从文件读取用于扫描帧头的块大小
+static const size_t GROWING_SCAN_CHUNK_BYTES = 64 * 1024;
+
+// 平面格式每次解交错的最大帧数
+static const uint64_t PLANAR_CHUNK_FRAMES = 1024;
+
+// 经过缩混 / 重采样 / 增益且输出 s16 时每次经 f32 中转的帧数
+static const uint64_t PROCESS_CHUNK_FRAMES = 1024;
+
+// 缩混时每次以源声道数解码的最大帧数
+static const uint64_t DOWNMIX_CHUNK_FRAMES = 1024;
+
+// 输出采样率的允许范围
+static const int MIN_OUTPUT_SAMPLE_RATE = 8000;
+static const int MAX_OUTPUT_SAMPLE_RATE = 384000;
+
+// 输出增益的允许范围（dB）
+static const float MIN_GAIN_DB = -60.0f;
+static const float MAX_GAIN_DB = 24.0f;
+
+// 本次最多可解码的源帧数（边写边读模式下不越过已完整写入的最后一帧）
+static uint64_t LimitToDecodable(FlacStream* stream, uint64_t frames) {
+    if (!stream->growing) return frames;
+    uint64_t limit = stream->growing->decodable_frames.load(std::memory_order_acquire);
+    uint64_t available = limit > stream->next_frame ? limit - stream->next_frame : 0;
+    return std::min(frames, available);
+}
+
+// 解码不足时是否真的到达末尾（边写边读模式下可能只是数据还没写到）
+static bool IsEndOfStream(FlacStream* stream) {
+    if (!stream->growing) return true;
+    return stream->growing->complete.load(std::memory_order_acquire) &&
+           stream->next_frame >= stream->growing->decodable_frames.load(std::memory_order_acquire);
+}
+
+// 以源采样率解码为输出声道数的 f32（缩混在解码之后立即进行），推进 next_frame
+static uint64_t DecodeSourceFrames(FlacStream* stream, float* out, uint64_t frames) {
+    frames = LimitToDecodable(stream, frames);
+    if (frames == 0) return 0;
+
+    uint64_t total = 0;
+    if (!stream->downmixer) {
+        total = drflac_read_pcm_frames_f32(stream->flac, frames, out);
+    } else {
+        while (total < frames) {
+            uint64_t chunk = std::min(frames - total, DOWNMIX_CHUNK_FRAMES);
+            uint64_t decoded = drflac_read_pcm_frames_f32(stream->flac, chunk, stream->downmix_scratch.data());
+            stream->downmixer->Process(stream->downmix_scratch.data(), decoded, out + total * stream->channels);
+            total += decoded;
+            if (decoded < chunk) break;
+        }
+    }
+
+    stream->next_frame += total;
+    return total;
+}
+
+// 重采样器的输入：源采样率、输出声道数的 f32
+class DecoderFrameSource : public FlacFrameSource {
+public:
+    explicit DecoderFrameSource(FlacStream* stream) : stream_(stream) {}
+
+    uint64_t ReadFrames(float* out, uint64_t frames, bool* end_of_stream) override {
+        uint64_t decoded = DecodeSourceFrames(stream_, out, frames);
+        *end_of_stream = decoded < frames && IsEndOfStream(stream_);
+        return decoded;
+    }
+
+private:
+    FlacStream* stream_;
+};
+
+// 经过 Native 处理（缩混 → 重采样）的 f32
+static uint64_t ProcessFrames(FlacStream* stream, float* out, uint64_t frames) {
+    if (!stream->resampler) return DecodeSourceFrames(stream, out, frames);
+    DecoderFrameSource source(stream);
+    return stream->resampler->Process(&source, out, frames);
+}
+
+static uint64_t DecodeProcessedFrames(FlacStream* stream, void* out, uint64_t frames, float gain, bool limiter) {
+    bool apply_gain = gain != 1.0f || limiter;
+    if (stream->options.sample_format != FLAC_SAMPLE_S16) {
+        uint64_t got = ProcessFrames(stream, static_cast<float*>(out), frames);
+        if (apply_gain) FlacApplyGain(static_cast<float*>(out), static_cast<size_t>(got) * stream->channels, gain, limiter);
+        return got;
+    }
+
+    // s16：先以 f32 处理再转换
+    int16_t* dst = static_cast<int16_t*>(out);
+    uint64_t total = 0;
+    while (total < frames) {
+        uint64_t chunk = std::min(frames - total, PROCESS_CHUNK_FRAMES);
+        uint64_t got = ProcessFrames(stream, stream->process_scratch.data(), chunk);
+        if (apply_gain) FlacApplyGain(stream->process_scratch.data(), static_cast<size_t>(got) * stream->channels, gain, limiter);
+        stream->pcm.FromFloat(stream->process_scratch.data(), dst + total * stream->channels, got * stream->channels);
+        total += got;
+        if (got < chunk) break;
+    }
+    return total;
+}
+
+// 解码 PCM 帧为输出采样率下的存储格式（由解码方调用：同步模式为调用线程，预解码模式为工作线程）
+static uint64_t DecodeFrames(FlacStream* stream, void* out, uint64_t frames) {
+    uint64_t first_frame = stream->out_frame;
+    uint64_t decoded = 0;
+    float gain = stream->gain.load(std::memory_order_relaxed);
+    bool limiter = stream->limiter.load(std::memory_order_relaxed);
+    if (stream->downmixer || stream->resampler || gain != 1.0f || limiter) {
+        decoded = DecodeProcessedFrames(stream, out, frames, gain, limiter);
+    } else {
+        frames = LimitToDecodable(stream, frames);
+        if (frames == 0) return 0;
+        decoded = stream->pcm.Decode(stream->flac, out, frames);
+        stream->next_frame += decoded;
+    }
+
+    stream->out_frame += decoded;
+
+    // 频谱分析旁路只在预解码模式下开启，此时解码方是工作线程，数据在提交到环之前复制
+    FlacAnalyzer* tap = stream->analysis_tap.load(std::memory_order_acquire);
+    if (tap) tap->Write(first_frame, out, decoded);
+    return decoded;
+}
+
+// 源采样率下的帧数 → 输出采样率下的帧数
+static uint64_t ToOutputFrames(FlacStream* stream, uint64_t source_frames) {
+    return stream->resampler ? stream->resampler->OutputFramesFor(source_frames) : source_frames;
+}
+
+// 目标位置（输出帧）的数据是否已经写入（非边写边读模式总是 true）
+static bool IsSeekTargetAvailable(FlacStream* stream, uint64_t frame_index) {
+    if (!stream->growing) return true;
+    uint64_t source_frame = stream->resampler ? stream->resampler->InputFrameFor(frame_index) : frame_index;
+    return source_frame < stream->growing->decodable_frames.load(std::memory_order_acquire) ||
+           stream->growing->complete.load(std::memory_order_acquire);
+}
+
+// 定位到输出帧 frame_index（重采样时先换算为源帧，并清空重采样器的历史）
+static bool SeekDecoder(FlacStream* stream, uint64_t frame_index) {
+    if (stream->total_pcm_frames > 0 && frame_index > stream->total_pcm_frames) return false;
+    FlacSeekIndexState* seek_index = stream->seek_index.get();
+    if (seek_index && !seek_index->installed && seek_index->ready.load(std::memory_order_acquire)) {
+        // 索引已就绪：作为 seektable 安装，之后的 seek 都是直接跳转
+        stream->flac->pSeekpoints = seek_index->points.data();
+        stream->flac->seekpointCount = static_cast<drflac_uint32>(seek_index->points.size());
+        seek_index->installed = true;
+    }
+
+    if (stream->growing) {
+        // 用扫描得到的帧索引作为 seektable，dr_flac 直接跳到目标帧，不会越过水位线去二分查找
+        FlacGrowingState* growing = stream->growing.get();
+        std::lock_guard<std::mutex> lock(growing->mutex);
+        const std::vector<FlacFrameEntry>& entries = growing->index.Entries();
+        growing->seekpoints.resize(entries.size());
+        for (size_t i = 0; i < entries.size(); i++) {
+            growing->seekpoints[i].firstPCMFrame = entries[i].pcm_frame;
+            growing->seekpoints[i].flacFrameOffset = entries[i].byte_offset - growing->index.FirstFrameOffset();
+            growing->seekpoints[i].pcmFrameCount = static_cast<drflac_uint16>(entries[i].block_size);
+        }
+        stream->flac->pSeekpoints = growing->seekpoints.empty() ? nullptr : growing->seekpoints.data();
+        stream->flac->seekpointCount = static_cast<drflac_uint32>(growing->seekpoints.size());
+    }
+
+    uint64_t source_frame = stream->resampler ? stream->resampler->Reset(frame_index) : frame_index;
+    if (!drflac_seek_to_pcm_frame(stream->flac, source_frame)) return false;
+    stream->next_frame = source_frame;
+    stream->out_frame = frame_index;
+    return true;
+}
+
+// ========== 持久化 seek 索引 ==========
+
+static void SeekIndexWorker(FlacSeekIndexState* state) {
+    // 整个文件的帧头扫描经 I/O 后端读取（内存映射 / 异步队列），不经过 stdio
+    std::unique_ptr<FlacByteSource> source(FlacOpenLocalSource(state->file_path.c_str()));
+    if (!source || !FlacBuildSeekIndex(source.get(), &state->cancel, &state->points)) return;
+
+    state->ready.store(true, std::memory_order_release);
+    if (state->has_identity) {
+        FlacSaveSeekIndex(state->file_path.c_str(), state->identity, state->points);
+    }
+}
+
+// 文件没有 SEEKTABLE 时：读取旁路索引，没有则在后台线程扫描生成
+static void StartSeekIndex(FlacStream* stream, const wchar_t* file_path) {
+    if (stream->flac->seekpointCount > 0) return;
+
+    FILE* file = FlacOpenFileW(file_path);
+    if (!file) return;
+
+    std::unique_ptr<FlacSeekIndexState> state(new FlacSeekIndexState());
+    state->file_path = file_path;
+    state->has_identity = FlacGetFileIdentity(file, &state->identity);
+    fclose(file);
+
+    if (state->has_identity && FlacLoadSeekIndex(file_path, state->identity, &state->points)) {
+        state->ready.store(true, std::memory_order_release);
+    } else {
+        state->builder = std::thread(SeekIndexWorker, state.get());
+    }
+
+    stream->seek_index = std::move(state);
+}
+
+static void StopSeekIndex(FlacStream* stream) {
+    if (!stream->seek_index || !stream->seek_index->builder.joinable()) return;
+    stream->seek_index->cancel.store(true, std::memory_order_relaxed);
+    stream->seek_index->builder.join();
+}
+
+// ========== 预解码工作线程 ==========
+
+// 向环中解码一块数据，返回 false 表示已到末尾
+static bool FillRingOnce(FlacStream* stream) {
+    uint64_t region_frames = 0;
+    uint8_t* region = stream->ring->WriteRegion(&region_frames);
+    if (region_frames == 0) return true;
+
+    uint64_t frames = std::min(region_frames, DECODE_AHEAD_CHUNK_FRAMES);
+    uint64_t decoded = DecodeFrames(stream, region, frames);
+    stream->ring->CommitWrite(decoded);
+    return decoded == frames || !IsEndOfStream(stream);
+}
+
+static void DecodeAheadWorker(FlacStream* stream) {
+    uint32_t applied_serial = stream->flush_serial.load(std::memory_order_relaxed);
+    bool at_end = stream->eof_serial.load(std::memory_order_relaxed) == applied_serial;
+
+    while (!stream->stop.load(std::memory_order_acquire)) {
+        // 应用最新的 seek 请求
+        uint32_t requested = stream->seek_serial.load(std::memory_order_acquire);
+        uint64_t target = stream->seek_target.load(std::memory_order_relaxed);
+        if (requested != applied_serial && IsSeekTargetAvailable(stream, target)) {
+            at_end = !SeekDecoder(stream, target);
+            applied_serial = requested;
+
+            stream->flush_pos.store(stream->ring->WritePosition(), std::memory_order_relaxed);
+            stream->flush_frame.store(target, std::memory_order_relaxed);
+            if (at_end) {
+                stream->failed_serial.store(applied_serial, std::memory_order_relaxed);
+            }
+            stream->flush_serial.store(applied_serial, std::memory_order_release);
+            if (at_end) {
+                stream->eof_serial.store(applied_serial, std::memory_order_release);
+            }
+        }
+
+        bool seek_pending = requested != applied_serial;
+        uint64_t before = stream->next_frame;
+        if (!at_end && !seek_pending && stream->ring->Writable() >= DECODE_AHEAD_CHUNK_FRAMES) {
+            if (!FillRingOnce(stream)) {
+                at_end = true;
+                stream->eof_serial.store(applied_serial, std::memory_order_release);
+            }
+            // 边写边读模式下没有解出新数据说明在等待写入，此时不要空转
+            if (at_end || stream->next_frame != before) continue;
+        }
+
+        // 环已满、已到末尾或等待数据写入：等待消费者腾出空间或新的 seek 请求
+        // 音频线程从不通知此条件变量，保证读取端无锁
+        std::unique_lock<std::mutex> lock(stream->wake_mutex);
+        stream->wake_cv.wait_for(lock, std::chrono::milliseconds(stream->wake_interval_ms), [stream, applied_serial] {
+            return stream->stop.load(std::memory_order_relaxed) ||
+                   stream->seek_serial.load(std::memory_order_relaxed) != applied_serial;
+        });
+    }
+}
+
+static void StartDecodeAhead(FlacStream* stream, int decode_ahead_ms) {
+    decode_ahead_ms = std::max(MIN_DECODE_AHEAD_MS, std::min(MAX_DECODE_AHEAD_MS, decode_ahead_ms));
+
+    uint64_t frames = static_cast<uint64_t>(stream->sample_rate) * decode_ahead_ms / 1000;
+    frames = std::max(frames, DECODE_AHEAD_CHUNK_FRAMES * 2);
+
+    stream->ring.reset(new SpscRing(stream->pcm.FrameBytes(), frames));
+    stream->wake_interval_ms = std::max(1, decode_ahead_ms / 4);
+
+    // 先在调用线程上填满环（或填入所有已写入的数据），避免开始播放时出现静音
+    while (stream->ring->Writable() > 0) {
+        uint64_t before = stream->next_frame;
+        if (!FillRingOnce(stream)) {
+            stream->eof_serial.store(0, std::memory_order_relaxed);
+            break;
+        }
+        if (stream->next_frame == before) break;
+    }
+
+    stream->worker = std::thread(DecodeAheadWorker, stream);
+}
+
+// 从 read 读取存储格式的数据写入调用者的缓冲区，平面格式经中转区解交错
+// plane_stride 为输出中每个声道平面的长度（帧），交错格式忽略
+template <typename ReadFn>
+static uint64_t ReadToOutput(FlacStream* stream, void* buffer, uint64_t frames, uint64_t plane_stride, ReadFn read) {
+    if (stream->options.sample_format != FLAC_SAMPLE_F32_PLANAR) {
+        return read(buffer, frames);
+    }
+
+    float* scratch = stream->planar_scratch.data();
+    uint64_t total = 0;
+    while (total < frames) {
+        uint64_t chunk = std::min(frames - total, PLANAR_CHUNK_FRAMES);
+        uint64_t got = read(scratch, chunk);
+        FlacDeinterleave(scratch, got, stream->channels, static_cast<float*>(buffer) + total, plane_stride);
+        total += got;
+        if (got < chunk) break;
+    }
+    return total;
+}
+
+// 从环中读取（音频线程），不触碰 I/O
+static long long ReadFromRing(FlacStream* stream, void* buffer, uint64_t frames_to_read, uint64_t plane_stride) {
+    // 工作线程已完成 seek：丢弃 seek 之前解码的数据
+    uint32_t flushed = stream->flush_serial.load(std::memory_order_acquire);
+    if (flushed != stream->read_serial.load(std::memory_order_relaxed)) {
+        stream->ring->SkipTo(stream->flush_pos.load(std::memory_order_relaxed));
+        stream->read_position.store(stream->flush_frame.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        stream->read_serial.store(flushed, std::memory_order_release);
+    }
+
+    // seek 尚未落地：环中都是旧位置的数据，输出静音
+    if (stream->seek_serial.load(std::memory_order_acquire) != flushed) {
+        return 0;
+    }
+
+    SpscRing* ring = stream->ring.get();
+    uint64_t read = ReadToOutput(stream, buffer, frames_to_read, plane_stride, [ring](void* out, uint64_t frames) {
+        return ring->Read(out, frames);
+    });
+    stream->read_position.fetch_add(read, std::memory_order_relaxed);
+    return static_cast<long long>(read);
+}
+
+// 同步模式：在读取边界执行信箱中最新的 seek 请求（调用线程即解码方）
+// 返回 false 表示目标位置的数据尚未写入，本次不能读取
+static bool ApplyPendingSeek(FlacStream* stream) {
+    uint32_t requested = stream->seek_serial.load(std::memory_order_acquire);
+    if (requested == stream->read_serial.load(std::memory_order_relaxed)) return true;
+
+    uint64_t target = stream->seek_target.load(std::memory_order_relaxed);
+    if (!IsSeekTargetAvailable(stream, target)) return false;
+
+    if (SeekDecoder(stream, target)) {
+        stream->read_position.store(target, std::memory_order_relaxed);
+    } else {
+        stream->failed_serial.store(requested, std::memory_order_relaxed);
+    }
+    stream->read_serial.store(requested, std::memory_order_release);
+    return true;
+}
+
+static void StopDecodeAhead(FlacStream* stream) {
+    if (!stream->worker.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(stream->wake_mutex);
+        stream->stop.store(true, std::memory_order_release);
+    }
+    stream->wake_cv.notify_all();
+    stream->worker.join();
+}
+
+// NaN 也视为无效
+static bool IsValidGain(float gain_db) {
+    return gain_db >= MIN_GAIN_DB && gain_db <= MAX_GAIN_DB;
+}
+
+static void SetStreamGain(FlacStream* stream, float gain_db, bool limiter) {
+    float gain = gain_db == 0.0f ? 1.0f : std::pow(10.0f, gain_db / 20.0f);
+    stream->gain.store(gain, std::memory_order_relaxed);
+    stream->limiter.store(limiter, std::memory_order_relaxed);
+}
+
+static void FinishOpen(FlacStream* stream, drflac* flac, const FlacStreamOptions* options, int* out_sample_rate, int* out_channels, unsigned long long* out_total_pcm_frames) {
+    stream->flac = flac;
+    stream->sample_rate = static_cast<int>(flac->sampleRate);
+    stream->channels = flac->channels;
+    stream->total_pcm_frames = flac->totalPCMFrameCount;
+    if (options) {
+        stream->options = *options;
+        SetStreamGain(stream, options->gain_db, options->limiter != 0);
+    }
+
+    // 在打开时完成 CPU 检测，音频线程上只使用已选定的内核
+    FlacGetPcmKernels();
+
+    // 先缩混再重采样，重采样器只处理输出声道
+    int output_channels = stream->options.output_channels;
+    if (output_channels > 0 && output_channels < stream->channels) {
+        stream->downmixer.reset(new FlacDownmixer());
+        if (stream->downmixer->Init(stream->channels, output_channels)) {
+            stream->downmix_scratch.resize(static_cast<size_t>(DOWNMIX_CHUNK_FRAMES) * stream->channels);
+            stream->channels = output_channels;
+        } else {
+            stream->downmixer.reset();
+        }
+    }
+
+    int output_rate = stream->options.output_sample_rate;
+    if (output_rate > 0 && output_rate != stream->sample_rate) {
+        stream->resampler.reset(new FlacResampler());
+        stream->resampler->Init(stream->channels, stream->sample_rate, output_rate, stream->options.resample_quality);
+        stream->sample_rate = output_rate;
+        stream->total_pcm_frames = stream->resampler->OutputFramesFor(stream->total_pcm_frames);
+    }
+
+    // 增益可在打开后随时开启，输出 s16 时总是准备 f32 中转区
+    if (stream->options.sample_format == FLAC_SAMPLE_S16) {
+        stream->process_scratch.resize(static_cast<size_t>(PROCESS_CHUNK_FRAMES) * stream->channels);
+    }
+
+    stream->pcm.Reset(stream->options.sample_format, stream->options.dither != 0, flac->bitsPerSample, stream->channels);
+    if (stream->options.sample_format == FLAC_SAMPLE_F32_PLANAR) {
+        stream->planar_scratch.resize(static_cast<size_t>(PLANAR_CHUNK_FRAMES) * stream->channels);
+    }
+
+    if (stream->options.decode_ahead_ms > 0) {
+        StartDecodeAhead(stream, stream->options.decode_ahead_ms);
+    }
+
+    // 输出音频信息
+    if (out_sample_rate) *out_sample_rate = stream->sample_rate;
+    if (out_channels) *out_channels = stream->channels;
+    if (out_total_pcm_frames) *out_total_pcm_frames = stream->total_pcm_frames;
+
+    stream->decoder_ready.store(true, std::memory_order_release);
+}
+
+// 扫描新写入的数据并发布可解码帧数，返回可解码帧数
+static uint64_t UpdateGrowing(FlacStream* stream, uint64_t written_bytes, bool is_complete) {
+    FlacGrowingState* growing = stream->growing.get();
+    std::lock_guard<std::mutex> lock(growing->mutex);
+
+    // 先抬高水位线，再发布可解码帧数：解码方看到新的帧数时，对应的字节一定可读
+    if (written_bytes > growing->scan_source->Watermark()) {
+        growing->scan_source->SetWatermark(written_bytes);
+        growing->decode_source->SetWatermark(written_bytes);
+    }
+
+    FlacFrameIndex& index = growing->index;
+    uint64_t read_offset = index.NextScanOffset() + growing->pending.size();
+    if (growing->scan_source->Seek(static_cast<int64_t>(read_offset), SEEK_SET)) {
+        for (;;) {
+            size_t old_size = growing->pending.size();
+            growing->pending.resize(old_size + GROWING_SCAN_CHUNK_BYTES);
+            size_t read = growing->scan_source->Read(growing->pending.data() + old_size, GROWING_SCAN_CHUNK_BYTES);
+            growing->pending.resize(old_size + read);
+
+            bool at_end = is_complete && read < GROWING_SCAN_CHUNK_BYTES;
+            size_t consumed = index.Scan(growing->pending.data(), growing->pending.size(), at_end);
+            growing->pending.erase(growing->pending.begin(), growing->pending.begin() + consumed);
+
+            if (read < GROWING_SCAN_CHUNK_BYTES) break;
+        }
+    }
+
+    growing->decodable_frames.store(index.DecodableFrames(), std::memory_order_release);
+    growing->complete.store(index.IsComplete(), std::memory_order_release);
+
+    return index.DecodableFrames();
+}
+
+// 推送流：收到完整元数据后打开解码器。返回 0=已打开, 1=数据不足, -1=错误
+static int TryOpenPushDecoder(FlacStream* stream, bool is_complete) {
+    if (stream->decoder_ready.load(std::memory_order_acquire)) return 0;
+
+    FlacGrowingState* growing = stream->growing.get();
+    PushByteSource layout_source(stream->push_buffer.get());
+    FlacStreamInfo info;
+    uint64_t first_frame_offset = 0;
+    if (!FlacReadStreamLayout(&layout_source, &info, &first_frame_offset)) {
+        if (!is_complete) return 1;
+        FlacSetLastError("Pushed data is not a valid FLAC stream");
+        return -1;
+    }
+
+    // 每次尝试都从头开始读取
+    PushByteSource* decode_source = new PushByteSource(stream->push_buffer.get());
+    stream->source.reset(decode_source);
+    growing->decode_source = decode_source;
+
+    drflac* flac = FlacOpenSource(decode_source, stream->arena.Callbacks());
+    if (!flac) {
+        if (!is_complete) return 1;
+        FlacSetLastError("Failed to open pushed FLAC stream");
+        return -1;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(growing->mutex);
+        growing->index.Reset(info, first_frame_offset);
+        growing->pending.clear();
+    }
+    UpdateGrowing(stream, stream->push_buffer->Size(), is_complete);
+
+    FinishOpen(stream, flac, nullptr, nullptr, nullptr, nullptr);
+    return 0;
+}
+
+bool FlacValidateStreamOptions(const FlacStreamOptions* options) {
+    if (!options) return true;
+    if (!FlacIsValidSampleFormat(options->sample_format)) {
+        FlacSetLastError("Invalid sample format");
+        return false;
+    }
+    if (options->output_sample_rate != 0 &&
+        (options->output_sample_rate < MIN_OUTPUT_SAMPLE_RATE || options->output_sample_rate > MAX_OUTPUT_SAMPLE_RATE)) {
+        FlacSetLastError("Invalid output sample rate");
+        return false;
+    }
+    if (options->resample_quality < FLAC_RESAMPLE_STANDARD || options->resample_quality > FLAC_RESAMPLE_HIGH) {
+        FlacSetLastError("Invalid resample quality");
+        return false;
+    }
+    if (options->output_channels < 0 || options->output_channels > 2) {
+        FlacSetLastError("Invalid output channel count");
+        return false;
+    }
+    if (!IsValidGain(options->gain_db)) {
+        FlacSetLastError("Invalid gain");
+        return false;
+    }
+    return true;
+}
+
+// 读取 PCM 帧到调用者的缓冲区（ReadFlacFrames 的实现），plane_stride 见 ReadToOutput
+static long long ReadPcm(FlacStream* stream, void* buffer, uint64_t frames_to_read, uint64_t plane_stride) {
+    // 推送流尚未收到完整元数据
+    if (!stream->decoder_ready.load(std::memory_order_acquire)) return 0;
+
+    if (stream->ring) {
+        return ReadFromRing(stream, buffer, frames_to_read, plane_stride);
+    }
+
+    if (!ApplyPendingSeek(stream)) return 0;
+    if (stream->failed_serial.load(std::memory_order_relaxed) == stream->read_serial.load(std::memory_order_relaxed)) return 0;
+
+    uint64_t decoded = ReadToOutput(stream, buffer, frames_to_read, plane_stride, [stream](void* out, uint64_t frames) {
+        return DecodeFrames(stream, out, frames);
+    });
+    stream->read_position.store(stream->out_frame, std::memory_order_relaxed);
+    return static_cast<long long>(decoded);
+}
+
+bool FlacStreamDrained(FlacStream* stream) {
+    if (!stream->decoder_ready.load(std::memory_order_acquire)) return false;
+
+    uint32_t landed = stream->read_serial.load(std::memory_order_acquire);
+    if (stream->seek_serial.load(std::memory_order_acquire) != landed) return false;
+    if (!stream->ring) return IsEndOfStream(stream);
+
+    // 工作线程先提交数据再发布 eof_serial，看到 EOF 后环中的剩余数据即为全部
+    if (stream->flush_serial.load(std::memory_order_acquire) != landed) return false;
+    return stream->eof_serial.load(std::memory_order_acquire) == landed && stream->ring->Readable() == 0;
+}
+
+// ========== 流式解码实现 ==========
+
+extern "C" {
+
+FLAC_API void* OpenFlacStream(const wchar_t* file_path, int* out_sample_rate, int* out_channels, unsigned long long* out_total_pcm_frames) {
+    return OpenFlacStreamEx(file_path, nullptr, out_sample_rate, out_channels, out_total_pcm_frames);
+}
+
+FLAC_API void* OpenFlacStreamEx(const wchar_t* file_path, const FlacStreamOptions* options, int* out_sample_rate, int* out_channels, unsigned long long* out_total_pcm_frames) {
+    if (!file_path) {
+        FlacSetLastError("File path is NULL");
+        return nullptr;
+    }
+    if (!FlacValidateStreamOptions(options)) return nullptr;
+
+    // 本地文件经内存映射读取（失败时退回 stdio），多个流之间不再争用 stdio 的锁
+    std::unique_ptr<FlacStream> stream(new FlacStream());
+    stream->source.reset(FlacOpenLocalSource(file_path));
+    drflac* flac = stream->source ? FlacOpenSource(stream->source.get(), stream->arena.Callbacks()) : nullptr;
+
+    if (!flac) {
+        FlacSetLastError("Failed to open FLAC file for streaming");
+        return nullptr;
+    }
+
+    stream->flac = flac;
+    StartSeekIndex(stream.get(), file_path);
+
+    FinishOpen(stream.get(), flac, options, out_sample_rate, out_channels, out_total_pcm_frames);
+    return static_cast<void*>(stream.release());
+}
+
+FLAC_API void* OpenFlacGrowingStream(const wchar_t* file_path, unsigned long long written_bytes, const FlacStreamOptions* options, int* out_sample_rate, int* out_channels, unsigned long long* out_total_pcm_frames) {
+    if (!file_path) {
+        FlacSetLastError("File path is NULL");
+        return nullptr;
+    }
+    if (!FlacValidateStreamOptions(options)) return nullptr;
+
+    FILE* decode_file = FlacOpenFileW(file_path);
+    FILE* scan_file = decode_file ? FlacOpenFileW(file_path) : nullptr;
+    if (!scan_file) {
+        if (decode_file) fclose(decode_file);
+        FlacSetLastError("Failed to open growing FLAC file");
+        return nullptr;
+    }
+
+    std::unique_ptr<FlacStream> stream(new FlacStream());
+    std::unique_ptr<FlacGrowingState> growing(new FlacGrowingState());
+
+    FileByteSource* decode_source = new FileByteSource(decode_file);
+    decode_source->SetWatermark(written_bytes);
+    stream->source.reset(decode_source);
+    growing->decode_source = decode_source;
+
+    growing->scan_source.reset(new FileByteSource(scan_file));
+    growing->scan_source->SetWatermark(written_bytes);
+
+    // 元数据（含封面）必须已经完整写入
+    FlacStreamInfo info;
+    uint64_t first_frame_offset = 0;
+    if (!FlacReadStreamLayout(growing->scan_source.get(), &info, &first_frame_offset)) {
+        FlacSetLastError("FLAC metadata not fully written yet");
+        return nullptr;
+    }
+    growing->index.Reset(info, first_frame_offset);
+
+    drflac* flac = FlacOpenSource(decode_source, stream->arena.Callbacks());
+    if (!flac) {
+        FlacSetLastError("Failed to open growing FLAC stream");
+        return nullptr;
+    }
+
+    stream->growing = std::move(growing);
+    UpdateGrowing(stream.get(), written_bytes, false);
+
+    FinishOpen(stream.get(), flac, options, out_sample_rate, out_channels, out_total_pcm_frames);
+    return static_cast<void*>(stream.release());
+}
+
+FLAC_API long long UpdateFlacGrowingStream(void* stream_handle, unsigned long long written_bytes, int is_complete) {
+    if (!stream_handle) {
+        FlacSetLastError("Stream handle is NULL");
+        return -1;
+    }
+
+    FlacStream* stream = static_cast<FlacStream*>(stream_handle);
+    if (!stream->growing || stream->push_buffer) {
+        FlacSetLastError("Stream is not a growing file stream");
+        return -1;
+    }
+
+    return static_cast<long long>(ToOutputFrames(stream, UpdateGrowing(stream, written_bytes, is_complete != 0)));
+}
+
+// ========== 回调 / 推送 API ==========
+
+FLAC_API void* OpenFlacStreamCallbacks(FlacReadCallback on_read, FlacSeekCallback on_seek, void* user_data, const FlacStreamOptions* options, int* out_sample_rate, int* out_channels, unsigned long long* out_total_pcm_frames) {
+    if (!on_read) {
+        FlacSetLastError("Read callback is NULL");
+        return nullptr;
+    }
+    if (!FlacValidateStreamOptions(options)) return nullptr;
+
+    std::unique_ptr<FlacStream> stream(new FlacStream());
+    stream->source.reset(new CallbackByteSource(on_read, on_seek, user_data));
+
+    drflac* flac = FlacOpenSource(stream->source.get(), stream->arena.Callbacks());
+    if (!flac) {
+        FlacSetLastError("Failed to open FLAC stream from callbacks");
+        return nullptr;
+    }
+
+    FinishOpen(stream.get(), flac, options, out_sample_rate, out_channels, out_total_pcm_frames);
+    return static_cast<void*>(stream.release());
+}
+
+FLAC_API void* CreateFlacPushStream(const FlacStreamOptions* options) {
+    if (!FlacValidateStreamOptions(options)) return nullptr;
+
+    FlacStream* stream = new FlacStream();
+    if (options) {
+        stream->options = *options;
+        SetStreamGain(stream, options->gain_db, options->limiter != 0);
+    }
+
+    stream->push_buffer.reset(new PushBuffer());
+    stream->growing.reset(new FlacGrowingState());
+    stream->growing->scan_source.reset(new PushByteSource(stream->push_buffer.get()));
+
+    return static_cast<void*>(stream);
+}
+
+FLAC_API int PushFlacStreamData(void* stream_handle, const void* data, size_t size) {
+    if (!stream_handle || (!data && size > 0)) {
+        FlacSetLastError("Invalid parameters");
+        return -1;
+    }
+
+    FlacStream* stream = static_cast<FlacStream*>(stream_handle);
+    if (!stream->push_buffer) {
+        FlacSetLastError("Stream is not a push stream");
+        return -1;
+    }
+    if (stream->growing->complete.load(std::memory_order_acquire)) {
+        FlacSetLastError("Push stream already finished");
+        return -1;
+    }
+
+    if (!stream->push_buffer->Append(data, size)) {
+        FlacSetLastError("Push stream buffer is full");
+        return -1;
+    }
+
+    if (!stream->decoder_ready.load(std::memory_order_acquire)) {
+        return TryOpenPushDecoder(stream, false) < 0 ? -1 : 0;
+    }
+
+    UpdateGrowing(stream, stream->push_buffer->Size(), false);
+    return 0;
+}
+
+FLAC_API int FinishFlacPushStream(void* stream_handle) {
+    if (!stream_handle) {
+        FlacSetLastError("Stream handle is NULL");
+        return -1;
+    }
+
+    FlacStream* stream = static_cast<FlacStream*>(stream_handle);
+    if (!stream->push_buffer) {
+        FlacSetLastError("Stream is not a push stream");
+        return -1;
+    }
+
+    if (!stream->decoder_ready.load(std::memory_order_acquire)) {
+        return TryOpenPushDecoder(stream, true) < 0 ? -1 : 0;
+    }
+
+    UpdateGrowing(stream, stream->push_buffer->Size(), true);
+    return 0;
+}
+
+FLAC_API int GetFlacStreamInfo(void* stream_handle, int* out_sample_rate, int* out_channels, unsigned long long* out_total_pcm_frames) {
+    if (!stream_handle) {
+        FlacSetLastError("Stream handle is NULL");
+        return -1;
+    }
+
+    FlacStream* stream = static_cast<FlacStream*>(stream_handle);
+    if (!stream->decoder_ready.load(std::memory_order_acquire)) return 1;
+
+    if (out_sample_rate) *out_sample_rate = stream->sample_rate;
+    if (out_channels) *out_channels = stream->channels;
+    if (out_total_pcm_frames) *out_total_pcm_frames = stream->total_pcm_frames;
+    return 0;
+}
+
+FLAC_API long long GetFlacDecodableFrames(void* stream_handle) {
+    if (!stream_handle) {
+        FlacSetLastError("Stream handle is NULL");
+        return -1;
+    }
+
+    FlacStream* stream = static_cast<FlacStream*>(stream_handle);
+    if (!stream->decoder_ready.load(std::memory_order_acquire)) return 0;
+    if (!stream->growing) {
+        return static_cast<long long>(stream->total_pcm_frames);
+    }
+
+    return static_cast<long long>(ToOutputFrames(stream, stream->growing->decodable_frames.load(std::memory_order_acquire)));
+}
+
+FLAC_API long long ReadFlacFrames(void* stream_handle, void* buffer, unsigned long long frames_to_read) {
+    if (!stream_handle) {
+        FlacSetLastError("Stream handle is NULL");
+        return -1;
+    }
+    if (!buffer) {
+        FlacSetLastError("Buffer is NULL");
+        return -1;
+    }
+
+    // 平面格式的声道平面长度即本次请求的帧数
+    return ReadPcm(static_cast<FlacStream*>(stream_handle), buffer, frames_to_read, frames_to_read);
+}
+
+FLAC_API int SeekFlacStream(void* stream_handle, unsigned long long frame_index) {
+    if (!stream_handle) {
+        FlacSetLastError("Stream handle is NULL");
+        return -1;
+    }
+
+    FlacStream* stream = static_cast<FlacStream*>(stream_handle);
+
+    if (!stream->decoder_ready.load(std::memory_order_acquire)) {
+        FlacSetLastError("Stream decoder is not ready");
+        return -1;
+    }
+
+    // 投递到信箱，由解码方在下一个读取边界执行（同步模式为下一次 ReadFlacFrames，预解码模式为工作线程）
+    stream->seek_target.store(frame_index, std::memory_order_relaxed);
+    stream->seek_serial.fetch_add(1, std::memory_order_release);
+
+    if (stream->ring) {
+        // 只唤醒工作线程；锁只与工作线程的等待竞争，音频线程从不获取
+        { std::lock_guard<std::mutex> lock(stream->wake_mutex); }
+        stream->wake_cv.notify_one();
+    }
+
+    return 0;
+}
+
+FLAC_API int GetFlacSeekState(void* stream_handle) {
+    if (!stream_handle) {
+        FlacSetLastError("Stream handle is NULL");
+        return -1;
+    }
+
+    FlacStream* stream = static_cast<FlacStream*>(stream_handle);
+    uint32_t landed = stream->read_serial.load(std::memory_order_acquire);
+    if (stream->seek_serial.load(std::memory_order_acquire) != landed) return 1;
+    return stream->failed_serial.load(std::memory_order_relaxed) == landed ? 2 : 0;
+}
+
+FLAC_API long long GetFlacStreamPosition(void* stream_handle) {
+    if (!stream_handle) {
+        FlacSetLastError("Stream handle is NULL");
+        return -1;
+    }
+
+    // seek 尚未落地时报告目标位置
+    FlacStream* stream = static_cast<FlacStream*>(stream_handle);
+    uint32_t requested = stream->seek_serial.load(std::memory_order_acquire);
+    if (requested != stream->read_serial.load(std::memory_order_acquire)) {
+        return static_cast<long long>(stream->seek_target.load(std::memory_order_relaxed));
+    }
+    return static_cast<long long>(stream->read_position.load(std::memory_order_relaxed));
+}
+
+// ========== 注册输出缓冲区 ==========
+
+FLAC_API void* RegisterFlacOutputBuffer(void* stream_handle, void* buffer, unsigned long long capacity_frames) {
+    if (!stream_handle || capacity_frames == 0) {
+        FlacSetLastError("Invalid parameters");
+        return nullptr;
+    }
+
+    FlacStream* stream = static_cast<FlacStream*>(stream_handle);
+    if (!stream->decoder_ready.load(std::memory_order_acquire)) {
+        FlacSetLastError("Stream decoder is not ready");
+        return nullptr;
+    }
+
+    if (buffer) {
+        stream->owned_output.reset();
+        stream->output = buffer;
+    } else {
+        stream->owned_output.reset(new uint8_t[capacity_frames * stream->pcm.FrameBytes()]());
+        stream->output = stream->owned_output.get();
+    }
+    stream->output_frames = capacity_frames;
+    return stream->output;
+}
+
+// 检查输出区间 [offset, offset + frames) 是否在注册的缓冲区内，返回 offset 处的写入位置
+// （平面格式为第一个声道平面中的位置）
+static void* OutputRegion(FlacStream* stream, uint64_t offset_frames, uint64_t frames) {
+    if (!stream->output) {
+        FlacSetLastError("Output buffer is not registered");
+        return nullptr;
+    }
+    if (offset_frames > stream->output_frames || frames > stream->output_frames - offset_frames) {
+        FlacSetLastError("Output range exceeds registered buffer");
+        return nullptr;
+    }
+    if (stream->options.sample_format == FLAC_SAMPLE_F32_PLANAR) {
+        return static_cast<float*>(stream->output) + offset_frames;
+    }
+    return static_cast<uint8_t*>(stream->output) + offset_frames * stream->pcm.FrameBytes();
+}
+
+FLAC_API long long ReadFlacFramesToOutput(void* stream_handle, unsigned long long offset_frames, unsigned long long frames_to_read) {
+    if (!stream_handle) {
+        FlacSetLastError("Stream handle is NULL");
+        return -1;
+    }
+
+    FlacStream* stream = static_cast<FlacStream*>(stream_handle);
+    void* out = OutputRegion(stream, offset_frames, frames_to_read);
+    if (!out) return -1;
+
+    return ReadPcm(stream, out, frames_to_read, stream->output_frames);
+}
+
+FLAC_API long long FillFlacOutput(void* stream_handle, unsigned long long offset_frames, unsigned long long frame_count) {
+    if (!stream_handle) {
+        FlacSetLastError("Stream handle is NULL");
+        return -1;
+    }
+
+    FlacStream* stream = static_cast<FlacStream*>(stream_handle);
+    if (!OutputRegion(stream, offset_frames, frame_count)) return -1;
+
+    // 读满为止；到达末尾、欠载或 seek 尚未落地时剩余部分填充静音
+    uint64_t filled = 0;
+    long long result = 0;
+    while (filled < frame_count) {
+        void* out = OutputRegion(stream, offset_frames + filled, frame_count - filled);
+        result = ReadPcm(stream, out, frame_count - filled, stream->output_frames);
+        if (result <= 0) break;
+        filled += static_cast<uint64_t>(result);
+    }
+
+    FlacFillSilence(stream->output, stream->options.sample_format, stream->channels,
+                    offset_frames + filled, frame_count - filled, stream->output_frames);
+
+    return result < 0 ? -1 : static_cast<long long>(filled);
+}
+
+FLAC_API long long GetFlacStreamBufferedFrames(void* stream_handle) {
+    if (!stream_handle) {
+        FlacSetLastError("Stream handle is NULL");
+        return -1;
+    }
+
+    FlacStream* stream = static_cast<FlacStream*>(stream_handle);
+    if (!stream->ring) return 0;
+
+    return static_cast<long long>(stream->ring->Readable());
+}
+
+FLAC_API int SetFlacStreamGain(void* stream_handle, float gain_db, int limiter) {
+    if (!stream_handle || !IsValidGain(gain_db)) {
+        FlacSetLastError("Invalid parameters");
+        return -1;
+    }
+    SetStreamGain(static_cast<FlacStream*>(stream_handle), gain_db, limiter != 0);
+    return 0;
+}
+
+FLAC_API void SetFlacSeekIndexCacheDir(const wchar_t* dir_path) {
+    FlacSetSeekIndexDir(dir_path);
+}
+
+FLAC_API void CloseFlacStream(void* stream_handle) {
+    if (stream_handle) {
+        FlacStream* stream = static_cast<FlacStream*>(stream_handle);
+        StopDecodeAhead(stream);
+        stream->analyzer.reset();
+        StopSeekIndex(stream);
+        if (stream->flac) drflac_close(stream->flac);
+        delete stream;
+    }
+}
+
+} // extern "C"
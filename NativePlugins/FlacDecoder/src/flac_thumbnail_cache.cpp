@@ -0,0 +1,352 @@
+#include "flac_internal.h"
+#include "flac_bcn.h"
+#include "flac_cover.h"
+#include "flac_thumbnail_cache.h"
+
+#include <cstring>
+#include <vector>
+
+// 文件头："CPTC" + 版本。缩放 / 遮罩 / 块压缩的输出有变化时递增版本，旧缓存在打开时清空
+static const char CACHE_MAGIC[4] = { 'C', 'P', 'T', 'C' };
+static const uint32_t CACHE_VERSION = 1;
+static const size_t CACHE_HEADER_BYTES = 16;
+static const size_t RECORD_HEADER_BYTES = 40;
+static const uint64_t RECORD_ALIGNMENT = 8;
+
+static const uint32_t RECORD_DATA = 1;
+static const uint32_t RECORD_ALIAS = 2;
+
+// 单条记录载荷上限（4096×4096 的 BC3 为 16MB）
+static const uint32_t MAX_PAYLOAD_BYTES = 16 * 1024 * 1024;
+
+static const int MAX_THUMBNAIL_SIZE = 4096;
+
+// ========== 编码 ==========
+
+static void PutU32(uint8_t*& p, uint32_t v) { for (int i = 0; i < 4; i++) *p++ = static_cast<uint8_t>(v >> (i * 8)); }
+static void PutU64(uint8_t*& p, uint64_t v) { for (int i = 0; i < 8; i++) *p++ = static_cast<uint8_t>(v >> (i * 8)); }
+
+static uint64_t GetLE(const uint8_t*& p, int bytes) {
+    uint64_t v = 0;
+    for (int i = 0; i < bytes; i++) v |= static_cast<uint64_t>(*p++) << (i * 8);
+    return v;
+}
+
+static uint64_t Fnv1a64(uint64_t hash, const void* data, size_t bytes) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < bytes; i++) {
+        hash ^= p[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+static uint32_t Fnv1a32(const void* data, size_t bytes) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < bytes; i++) {
+        hash ^= p[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static uint64_t HashU64(uint64_t hash, uint64_t value) {
+    uint8_t bytes[8];
+    uint8_t* p = bytes;
+    PutU64(p, value);
+    return Fnv1a64(hash, bytes, sizeof(bytes));
+}
+
+static uint64_t AlignRecord(uint64_t bytes) {
+    return (bytes + RECORD_ALIGNMENT - 1) & ~(RECORD_ALIGNMENT - 1);
+}
+
+// ========== 缓存文件 ==========
+
+FlacThumbnailCache::~FlacThumbnailCache() {
+    if (has_reader_) FlacCloseNativeFile(reader_);
+    if (file_) fclose(file_);
+}
+
+bool FlacThumbnailCache::Open(const wchar_t* path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    path_ = path;
+    file_ = FlacOpenFileForUpdateW(path);
+    if (!file_) return false;
+
+    uint8_t header[CACHE_HEADER_BYTES];
+    bool valid = fread(header, 1, sizeof(header), file_) == sizeof(header) && memcmp(header, CACHE_MAGIC, 4) == 0;
+    if (valid) {
+        const uint8_t* p = header + 4;
+        valid = static_cast<uint32_t>(GetLE(p, 4)) == CACHE_VERSION;
+    }
+    if (!valid && !Reset()) return false;
+
+    Scan();
+    has_reader_ = FlacOpenNativeFileW(path, &reader_, nullptr);
+    return true;
+}
+
+// 截断并写入新的文件头
+bool FlacThumbnailCache::Reset() {
+    fclose(file_);
+    file_ = FlacCreateFileW(path_.c_str());
+    if (file_) {
+        uint8_t header[CACHE_HEADER_BYTES] = { 0 };
+        uint8_t* p = header;
+        memcpy(p, CACHE_MAGIC, 4);
+        p += 4;
+        PutU32(p, CACHE_VERSION);
+        bool ok = fwrite(header, 1, sizeof(header), file_) == sizeof(header);
+        ok = fclose(file_) == 0 && ok;
+        file_ = ok ? FlacOpenFileForUpdateW(path_.c_str()) : nullptr;
+    }
+    return file_ != nullptr;
+}
+
+void FlacThumbnailCache::Scan() {
+    end_ = CACHE_HEADER_BYTES;
+    if (!FlacFileSeek(file_, 0, SEEK_END)) return;
+    int64_t length = FlacFileTell(file_);
+    if (length < 0 || !FlacFileSeek(file_, static_cast<int64_t>(end_), SEEK_SET)) return;
+
+    uint8_t header[RECORD_HEADER_BYTES];
+    while (end_ + RECORD_HEADER_BYTES <= static_cast<uint64_t>(length)) {
+        if (fread(header, 1, sizeof(header), file_) != sizeof(header)) break;
+
+        const uint8_t* p = header;
+        uint32_t type = static_cast<uint32_t>(GetLE(p, 4));
+        uint32_t bytes = static_cast<uint32_t>(GetLE(p, 4));
+        uint64_t key = GetLE(p, 8);
+        uint64_t value = GetLE(p, 8);
+        uint32_t info = static_cast<uint32_t>(GetLE(p, 4));
+        uint32_t checksum = static_cast<uint32_t>(GetLE(p, 4));
+        uint32_t header_checksum = static_cast<uint32_t>(GetLE(p, 4));
+
+        // 写了一半的记录：记录头校验失败，或载荷超出文件末尾
+        uint64_t next = end_ + AlignRecord(RECORD_HEADER_BYTES + bytes);
+        if (header_checksum != Fnv1a32(header, 32) || next > static_cast<uint64_t>(length)) break;
+
+        if (type == RECORD_DATA && bytes > 0 && bytes <= MAX_PAYLOAD_BYTES) {
+            entries_[key] = { end_ + RECORD_HEADER_BYTES, bytes, info, checksum };
+        } else if (type == RECORD_ALIAS && bytes == 0) {
+            aliases_[key] = value;
+        } else {
+            break;
+        }
+
+        end_ = next;
+        if (!FlacFileSeek(file_, static_cast<int64_t>(end_), SEEK_SET)) break;
+    }
+}
+
+bool FlacThumbnailCache::FindAlias(uint64_t identity_key, uint64_t* out_content_key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = aliases_.find(identity_key);
+    if (it == aliases_.end()) return false;
+    *out_content_key = it->second;
+    return true;
+}
+
+// 从只读句柄按偏移读满 bytes 字节
+static bool ReadFullyAt(FlacNativeFile file, uint64_t offset, void* out, size_t bytes) {
+    uint8_t* p = static_cast<uint8_t*>(out);
+    while (bytes > 0) {
+        int64_t read = FlacReadAt(file, offset, p, bytes);
+        if (read <= 0) return false;
+        p += read;
+        offset += static_cast<uint64_t>(read);
+        bytes -= static_cast<size_t>(read);
+    }
+    return true;
+}
+
+bool FlacThumbnailCache::Read(uint64_t content_key, uint32_t info, void* out, size_t bytes) {
+    Entry entry;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(content_key);
+        if (it == entries_.end() || it->second.info != info || it->second.bytes != bytes) return false;
+        entry = it->second;
+
+        if (!has_reader_) {
+            if (FlacFileSeek(file_, static_cast<int64_t>(entry.offset), SEEK_SET) &&
+                fread(out, 1, bytes, file_) == bytes &&
+                Fnv1a32(out, bytes) == entry.checksum) {
+                return true;
+            }
+            entries_.erase(it);
+            return false;
+        }
+    }
+
+    // Append 在 fflush 之后才把记录加入索引，查到的载荷已经写到文件里
+    if (ReadFullyAt(reader_, entry.offset, out, bytes) && Fnv1a32(out, bytes) == entry.checksum) {
+        return true;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(content_key);
+    if (it != entries_.end() && it->second.offset == entry.offset) entries_.erase(it);
+    return false;
+}
+
+bool FlacThumbnailCache::Append(uint32_t type, uint64_t key, uint64_t value, uint32_t info, const void* data, size_t bytes) {
+    if (!file_ || !writable_) return false;
+
+    size_t total = static_cast<size_t>(AlignRecord(RECORD_HEADER_BYTES + bytes));
+    std::vector<uint8_t> record(total, 0);
+    uint8_t* p = record.data();
+    PutU32(p, type);
+    PutU32(p, static_cast<uint32_t>(bytes));
+    PutU64(p, key);
+    PutU64(p, value);
+    PutU32(p, info);
+    PutU32(p, bytes > 0 ? Fnv1a32(data, bytes) : 0);
+    PutU32(p, Fnv1a32(record.data(), 32));
+    if (bytes > 0) memcpy(record.data() + RECORD_HEADER_BYTES, data, bytes);
+
+    // 写入失败时文件末尾可能留下半条记录，下次打开时会在该处停止扫描
+    writable_ = FlacFileSeek(file_, static_cast<int64_t>(end_), SEEK_SET) &&
+                fwrite(record.data(), 1, total, file_) == total &&
+                fflush(file_) == 0;
+    if (!writable_) return false;
+
+    end_ += total;
+    return true;
+}
+
+void FlacThumbnailCache::Write(uint64_t content_key, uint32_t info, const void* data, size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint64_t offset = end_ + RECORD_HEADER_BYTES;
+    if (bytes == 0 || bytes > MAX_PAYLOAD_BYTES || entries_.count(content_key)) return;
+    if (Append(RECORD_DATA, content_key, 0, info, data, bytes)) {
+        entries_[content_key] = { offset, static_cast<uint32_t>(bytes), info, Fnv1a32(data, bytes) };
+    }
+}
+
+void FlacThumbnailCache::WriteAlias(uint64_t identity_key, uint64_t content_key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = aliases_.find(identity_key);
+    if (it != aliases_.end() && it->second == content_key) return;
+    if (Append(RECORD_ALIAS, identity_key, content_key, 0, nullptr, 0)) {
+        aliases_[identity_key] = content_key;
+    }
+}
+
+// ========== 缓存键 ==========
+
+static uint64_t IdentityKey(const wchar_t* path, const FlacFileIdentity& identity, int size, int flags) {
+    uint64_t hash = 14695981039346656037ull;
+    for (const wchar_t* p = path; *p; ++p) {
+        hash = HashU64(hash, static_cast<uint32_t>(*p));
+    }
+    hash = HashU64(hash, identity.size);
+    hash = HashU64(hash, static_cast<uint64_t>(identity.mtime));
+    hash = HashU64(hash, static_cast<uint64_t>(size));
+    return HashU64(hash, static_cast<uint64_t>(flags));
+}
+
+static uint64_t ContentKey(const std::vector<uint8_t>& data, int size, int flags) {
+    uint64_t hash = Fnv1a64(14695981039346656037ull, data.data(), data.size());
+    hash = HashU64(hash, static_cast<uint64_t>(size));
+    return HashU64(hash, static_cast<uint64_t>(flags));
+}
+
+// ========== 缩略图缓存实现 ==========
+
+int FlacLoadCachedThumbnail(FlacThumbnailCache* cache, const wchar_t* file_path, int size, int flags,
+                            void* out_blocks, size_t capacity, int* out_format, const std::atomic<bool>* cancelled) {
+    if (!file_path || !out_blocks || !out_format || size <= 0 || size > MAX_THUMBNAIL_SIZE || size % 4 != 0) {
+        FlacSetLastError("Invalid arguments");
+        return -1;
+    }
+
+    bool bc3 = (flags & FLAC_COVER_CIRCULAR) != 0;
+    int format = bc3 ? FLAC_THUMBNAIL_BC3 : FLAC_THUMBNAIL_BC1;
+    size_t bytes = FlacBcnCompressedSize(size, size, bc3);
+    if (capacity < bytes) {
+        FlacSetLastError("Output buffer too small");
+        return -5;
+    }
+    *out_format = format;
+    uint32_t info = static_cast<uint32_t>(format) | (static_cast<uint32_t>(size) << 8);
+
+    FILE* file = FlacOpenFileW(file_path);
+    if (!file) {
+        FlacSetLastError("Failed to open file");
+        return -2;
+    }
+    FileByteSource source(file);
+
+    // 源文件未变化：身份键直接命中，不读取图片数据
+    FlacFileIdentity identity = {};
+    bool has_identity = FlacGetFileIdentity(file, &identity);
+    uint64_t identity_key = has_identity ? IdentityKey(file_path, identity, size, flags) : 0;
+    uint64_t content_key = 0;
+    if (cache && has_identity && cache->FindAlias(identity_key, &content_key) &&
+        cache->Read(content_key, info, out_blocks, bytes)) {
+        return static_cast<int>(bytes);
+    }
+
+    // 取消只在开销大的步骤之前检查（读取图片数据、解码压缩），已开始的步骤会做完
+    if (cancelled && cancelled->load(std::memory_order_relaxed)) return FLAC_THUMBNAIL_CANCELLED;
+    std::vector<uint8_t> data;
+    int result = FlacReadCoverData(&source, &data);
+    if (result != 0) return result;
+
+    // 同一张封面（如整张专辑共用的内嵌封面）只解码、压缩、保存一次
+    content_key = ContentKey(data, size, flags);
+    if (cache && cache->Read(content_key, info, out_blocks, bytes)) {
+        if (has_identity) cache->WriteAlias(identity_key, content_key);
+        return static_cast<int>(bytes);
+    }
+
+    if (cancelled && cancelled->load(std::memory_order_relaxed)) return FLAC_THUMBNAIL_CANCELLED;
+    std::vector<uint8_t> rgba(static_cast<size_t>(size) * size * 4);
+    result = FlacDecodeCoverThumbnail(data.data(), data.size(), size, flags, rgba.data());
+    if (result != 0) return result;
+
+    uint8_t* blocks = static_cast<uint8_t*>(out_blocks);
+    if (bc3) {
+        FlacCompressBc3(rgba.data(), size, size, blocks);
+    } else {
+        FlacCompressBc1(rgba.data(), size, size, blocks);
+    }
+
+    if (cache) {
+        cache->Write(content_key, info, blocks, bytes);
+        if (has_identity) cache->WriteAlias(identity_key, content_key);
+    }
+    return static_cast<int>(bytes);
+}
+
+extern "C" {
+
+FLAC_API void* OpenThumbnailCache(const wchar_t* cache_path) {
+    if (!cache_path) {
+        FlacSetLastError("Invalid arguments");
+        return nullptr;
+    }
+
+    FlacThumbnailCache* cache = new FlacThumbnailCache();
+    if (!cache->Open(cache_path)) {
+        delete cache;
+        FlacSetLastError("Failed to open thumbnail cache file");
+        return nullptr;
+    }
+    return cache;
+}
+
+FLAC_API int GetCachedCoverThumbnail(void* cache_handle, const wchar_t* file_path, int size, int flags,
+                                     void* out_blocks, size_t capacity, int* out_format) {
+    return FlacLoadCachedThumbnail(static_cast<FlacThumbnailCache*>(cache_handle), file_path, size, flags,
+                                   out_blocks, capacity, out_format, nullptr);
+}
+
+FLAC_API void CloseThumbnailCache(void* cache_handle) {
+    delete static_cast<FlacThumbnailCache*>(cache_handle);
+}
+
+} // extern "C"
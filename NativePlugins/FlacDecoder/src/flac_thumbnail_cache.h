@@ -0,0 +1,78 @@
+#ifndef CHILL_FLAC_THUMBNAIL_CACHE_H
+#define CHILL_FLAC_THUMBNAIL_CACHE_H
+
+// 压缩缩略图缓存：单个只追加的文件，保存 BC1 / BC3 块数据，按内容哈希去重。
+//
+// 文件布局（小端）：16 字节文件头（"CPTC" + 版本），之后是连续的记录，每条记录 8 字节对齐：
+//   40 字节记录头 { type, payload_bytes, key, value, info, payload_checksum, header_checksum, reserved } + 载荷
+// 数据记录（type 1）：key = 内容键（源图片数据 + 尺寸 + 选项的哈希），info = 格式 | 边长 << 8，载荷为压缩块。
+// 别名记录（type 2）：key = 身份键（源文件路径 + 大小 + 修改时间 + 尺寸 + 选项的哈希），value = 内容键，无载荷。
+// 打开时只扫描记录头建立索引；遇到校验失败或被截断的记录即停止，之后的追加从该位置覆盖写入。
+// 载荷在命中时校验，损坏的记录视为未命中并重新生成。
+// 命中时只在锁内查索引，载荷经单独的只读句柄按偏移在锁外读取（记录只追加，已索引的载荷不会被改写），
+// 多个封面调度工作线程的命中不互相等待。
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "flac_io.h"
+
+class FlacThumbnailCache {
+public:
+    FlacThumbnailCache() {}
+    ~FlacThumbnailCache();
+
+    FlacThumbnailCache(const FlacThumbnailCache&) = delete;
+    FlacThumbnailCache& operator=(const FlacThumbnailCache&) = delete;
+
+    // 打开（或创建）缓存文件，版本不符时清空
+    bool Open(const wchar_t* path);
+
+    // 身份键 → 内容键
+    bool FindAlias(uint64_t identity_key, uint64_t* out_content_key);
+
+    // 读取内容键对应的数据记录到 out（info 与载荷长度都必须一致）
+    bool Read(uint64_t content_key, uint32_t info, void* out, size_t bytes);
+
+    // 追加记录（写入失败后不再尝试写入，已有的索引仍可读取）
+    void Write(uint64_t content_key, uint32_t info, const void* data, size_t bytes);
+    void WriteAlias(uint64_t identity_key, uint64_t content_key);
+
+private:
+    struct Entry {
+        uint64_t offset;        // 载荷在文件中的位置
+        uint32_t bytes;
+        uint32_t info;
+        uint32_t checksum;
+    };
+
+    bool Reset();
+    void Scan();
+    bool Append(uint32_t type, uint64_t key, uint64_t value, uint32_t info, const void* data, size_t bytes);
+
+    // 只读句柄：Open 之后不再改变，读取不加锁；打开失败时退回到在锁内经 file_ 读取
+    FlacNativeFile reader_ = FlacNativeFile();
+    bool has_reader_ = false;
+
+    std::mutex mutex_;      // 保护以下全部成员（包括文件位置）
+    std::wstring path_;
+    FILE* file_ = nullptr;
+    uint64_t end_ = 0;      // 下一条记录的写入位置
+    bool writable_ = true;
+    std::unordered_map<uint64_t, Entry> entries_;
+    std::unordered_map<uint64_t, uint64_t> aliases_;
+};
+
+// FlacLoadCachedThumbnail 在 cancelled 被置位后返回的状态（不会出现在导出函数的返回值中）
+static const int FLAC_THUMBNAIL_CANCELLED = -6;
+
+// GetCachedCoverThumbnail 的实现（cache 可为 NULL）。cancelled 非 NULL 时在读取图片数据和解码之前检查，
+// 已置位则返回 FLAC_THUMBNAIL_CANCELLED
+int FlacLoadCachedThumbnail(FlacThumbnailCache* cache, const wchar_t* file_path, int size, int flags,
+                            void* out_blocks, size_t capacity, int* out_format, const std::atomic<bool>* cancelled);
+
+#endif // CHILL_FLAC_THUMBNAIL_CACHE_H
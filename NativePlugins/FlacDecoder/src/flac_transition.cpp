@@ -0,0 +1,493 @@
+#include "flac_internal.h"
+#include "flac_transition.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// 交叉淡化时长的上限（毫秒）
+static const int MAX_CROSSFADE_MS = 20000;
+
+static const double HALF_PI = 1.57079632679489661923;
+
+// 不区分大小写比较标签名（ASCII）
+static bool TagKeyEquals(const char* tag, size_t key_length, const char* key) {
+    if (strlen(key) != key_length) return false;
+    for (size_t i = 0; i < key_length; i++) {
+        char c = tag[i];
+        if (c >= 'a' && c <= 'z') c = static_cast<char>(c - 'a' + 'A');
+        if (c != key[i]) return false;
+    }
+    return true;
+}
+
+// iTunSMPB：空格分隔的十六进制字段，依次为保留、编码器延迟、结尾填充、原始长度（帧）……
+static int ParseHexFields(const char* s, uint64_t* fields, int capacity) {
+    int count = 0;
+    while (count < capacity) {
+        while (*s == ' ' || *s == '\t') s++;
+        uint64_t value = 0;
+        bool has_digits = false;
+        for (;; s++) {
+            int digit;
+            if (*s >= '0' && *s <= '9') digit = *s - '0';
+            else if (*s >= 'a' && *s <= 'f') digit = *s - 'a' + 10;
+            else if (*s >= 'A' && *s <= 'F') digit = *s - 'A' + 10;
+            else break;
+            value = (value << 4) | static_cast<uint64_t>(digit);
+            has_digits = true;
+        }
+        if (!has_digits) break;
+        fields[count++] = value;
+    }
+    return count;
+}
+
+// 源采样率的帧数换算到输出采样率（四舍五入）
+static uint64_t ToOutputRate(uint64_t frames, int source_rate, int output_rate) {
+    if (source_rate <= 0 || output_rate <= 0 || source_rate == output_rate) return frames;
+    return (frames * static_cast<uint64_t>(output_rate) + static_cast<uint64_t>(source_rate) / 2) /
+           static_cast<uint64_t>(source_rate);
+}
+
+// ========== 过渡引擎 ==========
+
+FlacTransition::FlacTransition(int sample_rate, int channels)
+    : sample_rate_(sample_rate), channels_(channels), kernels_(FlacGetPcmKernels()) {
+    for (int i = 0; i <= FADE_TABLE_SIZE; i++) {
+        double t = static_cast<double>(i) / FADE_TABLE_SIZE;
+        fade_tables_[FLAC_FADE_SINE][i] = static_cast<float>(std::sin(t * HALF_PI));
+        fade_tables_[FLAC_FADE_SQRT][i] = static_cast<float>(std::sqrt(t));
+        fade_tables_[FLAC_FADE_LINEAR][i] = static_cast<float>(t);
+    }
+}
+
+FlacTransition::~FlacTransition() {
+    // 音频线程已停止读取，不再需要交接
+    Destroy(pending_now_.exchange(nullptr));
+    Destroy(pending_next_.exchange(nullptr));
+    Destroy(current_);
+    Destroy(next_);
+    Destroy(outgoing_);
+    CollectRetired();
+}
+
+void FlacTransition::Destroy(Track* track) {
+    if (!track) return;
+    CloseFlacStream(track->stream);
+    delete track;
+}
+
+// ========== 控制线程 ==========
+
+void FlacTransition::CollectRetired() {
+    Track* track = retired_.exchange(nullptr, std::memory_order_acquire);
+    while (track) {
+        Track* next = track->next_retired;
+        Destroy(track);
+        track = next;
+    }
+}
+
+void FlacTransition::SetMode(int mode, int crossfade_ms, int curve) {
+    mode_.store(mode, std::memory_order_relaxed);
+    crossfade_frames_.store(static_cast<uint64_t>(sample_rate_) * crossfade_ms / 1000, std::memory_order_relaxed);
+    curve_.store(curve, std::memory_order_relaxed);
+}
+
+void FlacTransition::Queue(FlacStream* stream, const FlacGaplessTrim& trim, int queue) {
+    CollectRetired();
+
+    Track* track = new Track();
+    track->stream = stream;
+    if (stream->total_pcm_frames > 0) {
+        track->end = stream->total_pcm_frames > trim.trailing_frames ? stream->total_pcm_frames - trim.trailing_frames : 0;
+        track->start = std::min<uint64_t>(trim.leading_frames, track->end);
+    } else {
+        track->start = trim.leading_frames;
+    }
+
+    if (queue == FLAC_TRANSITION_QUEUE_NOW) {
+        // 立即切换会丢弃当前曲目之后排队的下一首，尚未交接的也一并丢弃
+        Destroy(pending_next_.exchange(nullptr, std::memory_order_acq_rel));
+        Destroy(pending_now_.exchange(track, std::memory_order_acq_rel));
+    } else {
+        Destroy(pending_next_.exchange(track, std::memory_order_acq_rel));
+    }
+}
+
+bool FlacTransition::Seek(uint64_t frame_index) {
+    CollectRetired();
+
+    // 尚未交接的立即切换优先；两者在控制线程关闭前都保持有效
+    Track* track = pending_now_.load(std::memory_order_acquire);
+    if (!track) track = published_current_.load(std::memory_order_acquire);
+    if (!track) return false;
+
+    uint64_t target = track->start + frame_index;
+    if (track->end != UINT64_MAX) target = std::min(target, track->end);
+    return SeekFlacStream(track->stream, target) == 0;
+}
+
+void FlacTransition::GetStatus(FlacTransitionStatus* out_status) {
+    CollectRetired();
+
+    uint32_t before, after;
+    do {
+        before = status_sequence_.load(std::memory_order_acquire);
+        out_status->serial = status_serial_.load(std::memory_order_relaxed);
+        out_status->state = status_state_.load(std::memory_order_relaxed);
+        out_status->position = status_position_.load(std::memory_order_relaxed);
+        out_status->length = status_length_.load(std::memory_order_relaxed);
+        out_status->next_queued = status_next_.load(std::memory_order_relaxed) ? 1 : 0;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = status_sequence_.load(std::memory_order_relaxed);
+    } while (before != after || (before & 1) != 0);
+
+    if (pending_next_.load(std::memory_order_acquire)) out_status->next_queued = 1;
+}
+
+// ========== 音频线程 ==========
+
+void FlacTransition::Retire(Track* track) {
+    track->next_retired = retired_.load(std::memory_order_relaxed);
+    while (!retired_.compare_exchange_weak(track->next_retired, track, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+}
+
+// 先发布新的当前曲目再交还旧的：控制线程关闭某个曲目时，published_current_ 一定已不再指向它
+void FlacTransition::SetCurrent(Track* track) {
+    current_ = track;
+    published_current_.store(track, std::memory_order_release);
+    serial_++;
+    ended_ = false;
+}
+
+void FlacTransition::BeginFade(uint64_t frames) {
+    int curve = curve_.load(std::memory_order_relaxed);
+    fade_table_ = fade_tables_[curve];
+    fade_position_ = 0;
+    fade_length_ = frames;
+}
+
+void FlacTransition::AcceptPending() {
+    Track* now = pending_now_.exchange(nullptr, std::memory_order_acq_rel);
+    if (now) {
+        if (next_) {
+            Retire(next_);
+            next_ = nullptr;
+        }
+
+        // 当前曲目淡出（已在淡出的曲目直接停止），没有淡化时长或已播放完时直接切换
+        Track* previous = current_;
+        uint64_t fade = crossfade_frames_.load(std::memory_order_relaxed);
+        bool fade_out = previous && fade > 0 && !ended_;
+        SetCurrent(now);
+        if (fade_out) {
+            if (outgoing_) Retire(outgoing_);
+            outgoing_ = previous;
+            BeginFade(fade);
+        } else if (previous) {
+            Retire(previous);
+        }
+    }
+
+    Track* next = pending_next_.exchange(nullptr, std::memory_order_acq_rel);
+    if (next) {
+        if (!current_) {
+            SetCurrent(next);
+        } else {
+            if (next_) Retire(next_);
+            next_ = next;
+        }
+    }
+}
+
+uint64_t FlacTransition::Remaining(Track* track) const {
+    if (track->end == UINT64_MAX) return UINT64_MAX;
+    uint64_t position = static_cast<uint64_t>(GetFlacStreamPosition(track->stream));
+    return track->end > position ? track->end - position : 0;
+}
+
+// 读取曲目裁剪范围内的数据，返回帧数；不足 frames 时 *out_ended 区分到达结尾与欠载
+uint64_t FlacTransition::ReadTrack(Track* track, float* out, uint64_t frames, bool* out_ended) {
+    FlacStream* stream = track->stream;
+    *out_ended = false;
+
+    // 开头的编码器延迟以读取丢弃的方式跳过（不 seek，预解码环中已有的数据保持有效），out 兼作丢弃区
+    uint64_t position = static_cast<uint64_t>(GetFlacStreamPosition(stream));
+    while (position < track->start) {
+        uint64_t skip = std::min(track->start - position, frames);
+        long long got = ReadFlacFrames(stream, out, skip);
+        if (got <= 0) {
+            *out_ended = FlacStreamDrained(stream);
+            return 0;
+        }
+        position += static_cast<uint64_t>(got);
+        if (static_cast<uint64_t>(got) < skip) {
+            *out_ended = FlacStreamDrained(stream);
+            return 0;
+        }
+    }
+
+    uint64_t want = frames;
+    if (track->end != UINT64_MAX) want = std::min(want, track->end > position ? track->end - position : 0);
+    if (want == 0) {
+        *out_ended = true;
+        return 0;
+    }
+
+    long long got = ReadFlacFrames(stream, out, want);
+    uint64_t read = got > 0 ? static_cast<uint64_t>(got) : 0;
+    if (read < want) {
+        *out_ended = FlacStreamDrained(stream);
+    } else if (want < frames) {
+        *out_ended = true;
+    }
+    return read;
+}
+
+// 淡化曲线在当前位置起 frames 帧的增益：淡入取 t，淡出取对称位置 1 - t，表项之间线性插值
+void FlacTransition::FillGains(uint64_t frames) {
+    const float* table = fade_table_;
+    const double scale = static_cast<double>(FADE_TABLE_SIZE) / static_cast<double>(fade_length_);
+    for (uint64_t i = 0; i < frames; i++) {
+        double x = static_cast<double>(fade_position_ + i) * scale;
+        int index = std::min(static_cast<int>(x), FADE_TABLE_SIZE - 1);
+        float frac = static_cast<float>(x - index);
+        gain_in_[i] = table[index] + (table[index + 1] - table[index]) * frac;
+
+        double y = FADE_TABLE_SIZE - x;
+        int mirror = std::min(static_cast<int>(y), FADE_TABLE_SIZE - 1);
+        float mirror_frac = static_cast<float>(y - mirror);
+        gain_out_[i] = table[mirror] + (table[mirror + 1] - table[mirror]) * mirror_frac;
+    }
+}
+
+void FlacTransition::Read(float* out, uint64_t frames) {
+    const uint64_t chunk_frames = CHUNK_FRAMES;
+    const size_t frame_samples = static_cast<size_t>(channels_);
+
+    AcceptPending();
+
+    while (frames > 0) {
+        uint64_t chunk = std::min(frames, chunk_frames);
+        if (!current_) {
+            memset(out, 0, static_cast<size_t>(chunk) * frame_samples * sizeof(float));
+            out += chunk * frame_samples;
+            frames -= chunk;
+            continue;
+        }
+
+        // 排队的下一首进入淡化时长：淡化时长取当前曲目的剩余帧数（下一首排队较晚时相应缩短），
+        // 之前的读取在淡化起点处截断，淡化的起点与回调的长度无关
+        if (!outgoing_ && next_ && mode_.load(std::memory_order_relaxed) == FLAC_TRANSITION_CROSSFADE) {
+            uint64_t fade = crossfade_frames_.load(std::memory_order_relaxed);
+            uint64_t remaining = Remaining(current_);
+            if (fade > 0 && remaining > 0 && remaining <= fade) {
+                outgoing_ = current_;
+                Track* next = next_;
+                next_ = nullptr;
+                SetCurrent(next);
+                BeginFade(remaining);
+            } else if (fade > 0 && remaining > fade) {
+                chunk = std::min(chunk, remaining - fade);
+            }
+        }
+
+        if (outgoing_) {
+            chunk = std::min(chunk, fade_length_ - fade_position_);
+            size_t samples = static_cast<size_t>(chunk) * frame_samples;
+
+            // 两首各自读取不足的部分（欠载、淡出的曲目提前结束）按静音混合
+            bool ended = false;
+            uint64_t incoming = ReadTrack(current_, out, chunk, &ended);
+            memset(out + incoming * frame_samples, 0, (samples - static_cast<size_t>(incoming) * frame_samples) * sizeof(float));
+            uint64_t outgoing = ReadTrack(outgoing_, scratch_, chunk, &ended);
+            memset(scratch_ + outgoing * frame_samples, 0, (samples - static_cast<size_t>(outgoing) * frame_samples) * sizeof(float));
+
+            FillGains(chunk);
+            kernels_.crossfade_f32(scratch_, out, gain_out_, gain_in_, chunk, channels_, out);
+
+            fade_position_ += chunk;
+            if (fade_position_ >= fade_length_) {
+                Retire(outgoing_);
+                outgoing_ = nullptr;
+            }
+            out += samples;
+            frames -= chunk;
+            continue;
+        }
+
+        bool ended = false;
+        uint64_t read = ReadTrack(current_, out, chunk, &ended);
+        out += read * frame_samples;
+        frames -= read;
+        if (read == chunk) continue;
+
+        // 无缝衔接：同一次读取接着从下一首取数据
+        if (ended && next_) {
+            Track* previous = current_;
+            Track* next = next_;
+            next_ = nullptr;
+            SetCurrent(next);
+            Retire(previous);
+            continue;
+        }
+
+        ended_ = ended;
+        uint64_t silence = chunk - read;
+        memset(out, 0, static_cast<size_t>(silence) * frame_samples * sizeof(float));
+        out += silence * frame_samples;
+        frames -= silence;
+    }
+
+    PublishStatus();
+}
+
+void FlacTransition::PublishStatus() {
+    int state = FLAC_TRANSITION_IDLE;
+    uint64_t position = 0;
+    uint64_t length = 0;
+    if (current_) {
+        state = outgoing_ ? FLAC_TRANSITION_FADING : (ended_ ? FLAC_TRANSITION_ENDED : FLAC_TRANSITION_PLAYING);
+        uint64_t stream_position = static_cast<uint64_t>(GetFlacStreamPosition(current_->stream));
+        position = stream_position > current_->start ? stream_position - current_->start : 0;
+        if (current_->end != UINT64_MAX) {
+            length = current_->end - current_->start;
+            position = std::min(position, length);
+        }
+    }
+
+    // 单写者的序号计数：奇数表示正在写入，控制线程读到前后一致的偶数序号为止
+    uint32_t sequence = status_sequence_.load(std::memory_order_relaxed);
+    status_sequence_.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    status_serial_.store(serial_, std::memory_order_relaxed);
+    status_state_.store(state, std::memory_order_relaxed);
+    status_position_.store(position, std::memory_order_relaxed);
+    status_length_.store(length, std::memory_order_relaxed);
+    status_next_.store(next_ != nullptr, std::memory_order_relaxed);
+    status_sequence_.store(sequence + 2, std::memory_order_release);
+}
+
+// ========== 导出函数 ==========
+
+extern "C" {
+
+FLAC_API void* CreateFlacTransition(int sample_rate, int channels) {
+    if (sample_rate <= 0 || channels < 1 || channels > FlacTransition::MAX_CHANNELS) {
+        FlacSetLastError("Invalid arguments");
+        return nullptr;
+    }
+    return new FlacTransition(sample_rate, channels);
+}
+
+FLAC_API int SetFlacTransitionMode(void* engine, int mode, int crossfade_ms, int curve) {
+    if (!engine || (mode != FLAC_TRANSITION_GAPLESS && mode != FLAC_TRANSITION_CROSSFADE) ||
+        crossfade_ms < 0 || crossfade_ms > MAX_CROSSFADE_MS || curve < FLAC_FADE_SINE || curve > FLAC_FADE_LINEAR) {
+        FlacSetLastError("Invalid arguments");
+        return -1;
+    }
+    static_cast<FlacTransition*>(engine)->SetMode(mode, crossfade_ms, curve);
+    return 0;
+}
+
+FLAC_API int GetFlacGaplessTrim(const wchar_t* file_path, int output_sample_rate, FlacGaplessTrim* out_trim) {
+    if (!file_path || !out_trim || output_sample_rate < 0) {
+        FlacSetLastError("Invalid arguments");
+        return -1;
+    }
+    out_trim->leading_frames = 0;
+    out_trim->trailing_frames = 0;
+
+    FlacProbeInfo probe = {};
+    int result = ProbeFlacFile(file_path, &probe);
+    if (result != 0) return result;
+
+    uint64_t fields[4] = {};
+    bool found = false;
+    const char* tag = probe.tags;
+    for (int i = 0; i < probe.tag_count; i++) {
+        size_t length = strlen(tag);
+        const char* separator = static_cast<const char*>(memchr(tag, '=', length));
+        if (separator && TagKeyEquals(tag, static_cast<size_t>(separator - tag), "ITUNSMPB")) {
+            found = ParseHexFields(separator + 1, fields, 4) >= 3;
+        }
+        tag += length + 1;
+    }
+
+    if (found) {
+        // 记录了原始长度时以它为准（部分编码器的填充字段不含最后一个不完整的块）
+        uint64_t total = probe.total_pcm_frames;
+        uint64_t delay = fields[1];
+        uint64_t trailing = fields[2];
+        if (fields[3] > 0 && total > delay + fields[3]) trailing = total - delay - fields[3];
+
+        int rate = output_sample_rate > 0 ? output_sample_rate : probe.sample_rate;
+        out_trim->leading_frames = ToOutputRate(delay, probe.sample_rate, rate);
+        out_trim->trailing_frames = ToOutputRate(trailing, probe.sample_rate, rate);
+    }
+    FreeFlacProbeInfo(&probe);
+    return 0;
+}
+
+FLAC_API int QueueFlacTransitionStream(void* engine, void* stream_handle, const FlacGaplessTrim* trim, int queue) {
+    if (!engine || !stream_handle || (queue != FLAC_TRANSITION_QUEUE_NEXT && queue != FLAC_TRANSITION_QUEUE_NOW)) {
+        FlacSetLastError("Invalid arguments");
+        return -1;
+    }
+
+    FlacTransition* transition = static_cast<FlacTransition*>(engine);
+    FlacStream* stream = static_cast<FlacStream*>(stream_handle);
+    if (!stream->decoder_ready.load(std::memory_order_acquire)) {
+        FlacSetLastError("Stream decoder is not ready");
+        return -1;
+    }
+    if (stream->options.sample_format != FLAC_SAMPLE_F32 || stream->sample_rate != transition->SampleRate() ||
+        stream->channels != transition->Channels()) {
+        FlacSetLastError("Stream format does not match the transition engine");
+        return -1;
+    }
+
+    FlacGaplessTrim resolved = {};
+    if (trim) resolved = *trim;
+    transition->Queue(stream, resolved, queue);
+    return 0;
+}
+
+FLAC_API long long ReadFlacTransition(void* engine, float* buffer, unsigned long long frames) {
+    if (!engine || !buffer) {
+        FlacSetLastError("Invalid arguments");
+        return -1;
+    }
+    static_cast<FlacTransition*>(engine)->Read(buffer, frames);
+    return static_cast<long long>(frames);
+}
+
+FLAC_API int SeekFlacTransition(void* engine, unsigned long long frame_index) {
+    if (!engine) {
+        FlacSetLastError("Invalid arguments");
+        return -1;
+    }
+    if (!static_cast<FlacTransition*>(engine)->Seek(frame_index)) {
+        FlacSetLastError("No current track");
+        return -1;
+    }
+    return 0;
+}
+
+FLAC_API int GetFlacTransitionStatus(void* engine, FlacTransitionStatus* out_status) {
+    if (!engine || !out_status) {
+        FlacSetLastError("Invalid arguments");
+        return -1;
+    }
+    static_cast<FlacTransition*>(engine)->GetStatus(out_status);
+    return 0;
+}
+
+FLAC_API void CloseFlacTransition(void* engine) {
+    delete static_cast<FlacTransition*>(engine);
+}
+
+} // extern "C"
@@ -0,0 +1,112 @@
+#ifndef CHILL_FLAC_TRANSITION_H
+#define CHILL_FLAC_TRANSITION_H
+
+// 过渡引擎：持有正在播放、排队和淡出中的流，在音频线程上混合为一路连续输出。
+//
+// 曲目在读取中按帧衔接：无缝模式下上一首读取不足且已到末尾时，同一次读取接着从下一首取数据；
+// 交叉淡化模式下上一首剩余帧数进入淡化时长后，两首按预先计算的曲线表逐帧加权混合（SIMD 内核）。
+// 控制线程与音频线程之间只有原子变量：排队的曲目经交接槽交给音频线程，被替换的曲目
+// 经无锁链表交还控制线程关闭；音频线程不分配内存、不加锁、不关闭流。
+
+#include "flac_decoder.h"
+
+#include <atomic>
+#include <cstdint>
+
+struct FlacStream;
+struct FlacPcmKernels;
+
+class FlacTransition {
+public:
+    static const int MAX_CHANNELS = 8;
+
+    FlacTransition(int sample_rate, int channels);
+    ~FlacTransition();
+
+    FlacTransition(const FlacTransition&) = delete;
+    FlacTransition& operator=(const FlacTransition&) = delete;
+
+    int SampleRate() const { return sample_rate_; }
+    int Channels() const { return channels_; }
+
+    // ========== 控制线程 ==========
+    void SetMode(int mode, int crossfade_ms, int curve);
+    void Queue(FlacStream* stream, const FlacGaplessTrim& trim, int queue);
+    bool Seek(uint64_t frame_index);
+    void GetStatus(FlacTransitionStatus* out_status);
+
+    // ========== 音频线程 ==========
+    void Read(float* out, uint64_t frames);
+
+private:
+    struct Track {
+        FlacStream* stream = nullptr;   // 引擎持有
+        uint64_t start = 0;             // 裁剪后的开头（流中的帧位置）
+        uint64_t end = UINT64_MAX;      // 裁剪后的结尾，未知时为 UINT64_MAX
+        Track* next_retired = nullptr;
+    };
+
+    // 控制线程：关闭音频线程交还的曲目
+    void CollectRetired();
+    static void Destroy(Track* track);
+
+    // 音频线程
+    void AcceptPending();
+    void SetCurrent(Track* track);
+    void BeginFade(uint64_t frames);
+    void Retire(Track* track);
+    uint64_t ReadTrack(Track* track, float* out, uint64_t frames, bool* out_ended);
+    uint64_t Remaining(Track* track) const;
+    void FillGains(uint64_t frames);
+    void PublishStatus();
+
+    const int sample_rate_;
+    const int channels_;
+    const FlacPcmKernels& kernels_;
+
+    // 衔接设置（控制线程写，音频线程在每次衔接开始时读取）
+    std::atomic<int> mode_{FLAC_TRANSITION_GAPLESS};
+    std::atomic<uint64_t> crossfade_frames_{0};
+    std::atomic<int> curve_{FLAC_FADE_SINE};
+
+    // 控制线程 → 音频线程：最近一次排队的曲目，立即切换与下一首各一个交接槽
+    // （音频线程取走前再次排队时由控制线程关闭旧的；暂停期间音频线程不读取，交接槽可能长时间保留）
+    std::atomic<Track*> pending_now_{nullptr};
+    std::atomic<Track*> pending_next_{nullptr};
+
+    // 音频线程 → 控制线程：被替换的曲目（音频线程压入，控制线程整条取走）
+    std::atomic<Track*> retired_{nullptr};
+
+    // 音频线程发布的当前曲目（控制线程 seek 使用，关闭前一定先经过 retired_）
+    std::atomic<Track*> published_current_{nullptr};
+
+    // ========== 以下只由音频线程访问 ==========
+    Track* current_ = nullptr;
+    Track* next_ = nullptr;
+    Track* outgoing_ = nullptr;     // 正在淡出
+    uint64_t fade_position_ = 0;
+    uint64_t fade_length_ = 0;
+    const float* fade_table_ = nullptr;
+    bool ended_ = false;
+    uint32_t serial_ = 0;
+
+    // 淡化曲线表（淡入增益，t 从 0 到 1；淡出增益按对称位置取值），创建时计算
+    static const int FADE_TABLE_SIZE = 1024;
+    float fade_tables_[3][FADE_TABLE_SIZE + 1];
+
+    // 每次混合的最大帧数及中转区
+    static const uint64_t CHUNK_FRAMES = 1024;
+    float scratch_[CHUNK_FRAMES * MAX_CHANNELS];
+    float gain_out_[CHUNK_FRAMES];
+    float gain_in_[CHUNK_FRAMES];
+
+    // ========== 状态（音频线程以序号计数发布，控制线程读取到一致的快照为止） ==========
+    std::atomic<uint32_t> status_sequence_{0};
+    std::atomic<uint32_t> status_serial_{0};
+    std::atomic<int> status_state_{FLAC_TRANSITION_IDLE};
+    std::atomic<uint64_t> status_position_{0};
+    std::atomic<uint64_t> status_length_{0};
+    std::atomic<bool> status_next_{false};
+};
+
+#endif // CHILL_FLAC_TRANSITION_H
@@ -0,0 +1,443 @@
+#include "flac_internal.h"
+#include "flac_parallel.h"
+#include "flac_waveform.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+
+// 第 0 层每秒的峰值数（每个峰值 20 毫秒）
+static const uint32_t PEAKS_PER_SECOND = 50;
+
+// 每段的第 0 层峰值数：4^4，段内可独立生成 0~4 层
+static const int SEGMENT_LEVELS = 4;
+static const uint64_t SEGMENT_PEAKS = 256;
+
+// 层数上限（4^15 个第 0 层峰值约合 680 万小时）
+static const int MAX_LEVELS = 16;
+
+static const char WAVEFORM_MAGIC[4] = { 'C', 'F', 'W', 'P' };
+static const uint32_t WAVEFORM_VERSION = 1;
+static const size_t WAVEFORM_HEADER_BYTES = 4 + 4 + 8 + 8 + 4 + 4 + 8 + 4 + 4;
+static const size_t WAVEFORM_PEAK_BYTES = 3;   // min, max, rms（就绪标记不保存）
+
+static FlacWaveformPeak QuantizePeak(float min, float max, float mean_square) {
+    FlacWaveformPeak peak;
+    peak.min = static_cast<signed char>(std::max(-127.0f, std::min(127.0f, std::floor(min * 127.0f))));
+    peak.max = static_cast<signed char>(std::max(-127.0f, std::min(127.0f, std::ceil(max * 127.0f))));
+    peak.rms = static_cast<unsigned char>(std::min(255.0f, std::sqrt(mean_square) * 255.0f + 0.5f));
+    peak.ready = 1;
+    return peak;
+}
+
+FlacWaveform::Decoder::~Decoder() {
+    if (flac) drflac_close(flac);
+}
+
+FlacWaveform::~FlacWaveform() {
+    cancel_.store(true, std::memory_order_relaxed);
+    if (runner_.joinable()) runner_.join();
+}
+
+uint64_t FlacWaveform::FramesPerPeak(int level) const {
+    return static_cast<uint64_t>(frames_per_peak_) << (2 * level);
+}
+
+uint64_t FlacWaveform::PeakCount(int level) const {
+    return levels_[level].size();
+}
+
+// ========== 打开 ==========
+
+bool FlacWaveform::Open(const wchar_t* path) {
+    path_ = path;
+
+    FILE* file = FlacOpenFileW(path);
+    if (!file) {
+        FlacSetLastError("Failed to open file");
+        return false;
+    }
+    has_identity_ = FlacGetFileIdentity(file, &identity_);
+
+    FileByteSource source(file);
+    drflac* flac = FlacOpenSource(&source, FlacPoolAllocationCallbacks());
+    if (!flac) {
+        FlacSetLastError("Failed to open FLAC file");
+        return false;
+    }
+    sample_rate_ = static_cast<int>(flac->sampleRate);
+    channels_ = flac->channels;
+    total_frames_ = flac->totalPCMFrameCount;
+    has_seektable_ = flac->seekpointCount > 0;
+    drflac_close(flac);
+
+    if (total_frames_ == 0 || sample_rate_ <= 0) {
+        FlacSetLastError("Stream length is unknown");
+        return false;
+    }
+
+    frames_per_peak_ = std::max<uint32_t>(1, static_cast<uint32_t>(sample_rate_) / PEAKS_PER_SECOND);
+    uint64_t count = (total_frames_ + frames_per_peak_ - 1) / frames_per_peak_;
+    levels_.emplace_back(count);
+    while (count > 1 && static_cast<int>(levels_.size()) < MAX_LEVELS) {
+        count = (count + FLAC_WAVEFORM_LEVEL_FACTOR - 1) / FLAC_WAVEFORM_LEVEL_FACTOR;
+        levels_.emplace_back(count);
+    }
+
+    segment_count_ = static_cast<size_t>((levels_[0].size() + SEGMENT_PEAKS - 1) / SEGMENT_PEAKS);
+    segment_ready_.reset(new std::atomic<uint8_t>[segment_count_]());
+
+    if (has_identity_ && LoadSidecar()) {
+        from_cache_ = true;
+        for (size_t i = 0; i < segment_count_; i++) {
+            segment_ready_[i].store(1, std::memory_order_relaxed);
+        }
+        segments_done_.store(segment_count_, std::memory_order_relaxed);
+        state_.store(FLAC_WAVEFORM_COMPLETE, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+void FlacWaveform::Start(int threads) {
+    if (from_cache_) return;
+    if (threads <= 0) threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    runner_ = std::thread(&FlacWaveform::Run, this, threads);
+}
+
+// ========== 生成 ==========
+
+// 文件没有 SEEKTABLE 时读取（或扫描生成并保存）持久化 seek 索引，与 OpenFlacStream 共用旁路文件
+void FlacWaveform::PrepareSeekpoints() {
+    if (has_seektable_) return;
+    if (has_identity_ && FlacLoadSeekIndex(path_.c_str(), identity_, &seekpoints_)) return;
+
+    std::unique_ptr<FlacByteSource> source(FlacOpenLocalSource(path_.c_str()));
+    if (!source) return;
+    if (FlacBuildSeekIndex(source.get(), &cancel_, &seekpoints_)) {
+        if (has_identity_) FlacSaveSeekIndex(path_.c_str(), identity_, seekpoints_);
+    } else {
+        // 扫描失败时退回 dr_flac 的二分查找
+        seekpoints_.clear();
+    }
+}
+
+std::unique_ptr<FlacWaveform::Decoder> FlacWaveform::OpenDecoder() {
+    std::unique_ptr<Decoder> decoder(new Decoder());
+    decoder->source.reset(FlacOpenLocalSource(path_.c_str()));
+    if (!decoder->source) return nullptr;
+    decoder->flac = FlacOpenSource(decoder->source.get(), FlacPoolAllocationCallbacks());
+    if (!decoder->flac) return nullptr;
+
+    if (!has_seektable_ && !seekpoints_.empty()) {
+        decoder->flac->pSeekpoints = const_cast<drflac_seekpoint*>(seekpoints_.data());
+        decoder->flac->seekpointCount = static_cast<drflac_uint32>(seekpoints_.size());
+    }
+    decoder->scratch.resize(static_cast<size_t>(frames_per_peak_) * channels_);
+    return decoder;
+}
+
+bool FlacWaveform::DecodeSegment(Decoder* decoder, size_t segment) {
+    uint64_t first_peak = segment * SEGMENT_PEAKS;
+    uint64_t last_peak = std::min(first_peak + SEGMENT_PEAKS, PeakCount(0));
+    uint64_t start_frame = first_peak * frames_per_peak_;
+
+    if (decoder->position != start_frame) {
+        if (!drflac_seek_to_pcm_frame(decoder->flac, start_frame)) {
+            decoder->position = UINT64_MAX;
+            return false;
+        }
+        decoder->position = start_frame;
+    }
+
+    const FlacPcmKernels& kernels = FlacGetPcmKernels();
+    std::vector<FlacWaveformPeak>& base = levels_[0];
+    for (uint64_t i = first_peak; i < last_peak; i++) {
+        if (cancel_.load(std::memory_order_relaxed)) return false;
+
+        uint64_t frames = std::min<uint64_t>(frames_per_peak_, total_frames_ - i * frames_per_peak_);
+        uint64_t read = 0;
+        while (read < frames) {
+            uint64_t got = drflac_read_pcm_frames_f32(decoder->flac, frames - read, decoder->scratch.data() + read * channels_);
+            if (got == 0) break;
+            read += got;
+        }
+
+        if (read < frames) {
+            // 文件被截断或损坏：该峰值之后的部分按静音处理
+            decoder->position = UINT64_MAX;
+            std::fill(base.begin() + static_cast<ptrdiff_t>(i), base.begin() + static_cast<ptrdiff_t>(last_peak), QuantizePeak(0.0f, 0.0f, 0.0f));
+            if (read == 0) break;
+        } else {
+            decoder->position += read;
+        }
+
+        size_t samples = static_cast<size_t>(read) * channels_;
+        float min = FLT_MAX, max = -FLT_MAX, sum_squares = 0.0f;
+        kernels.peak_f32(decoder->scratch.data(), samples, &min, &max, &sum_squares);
+        base[i] = QuantizePeak(min, max, sum_squares / static_cast<float>(samples));
+    }
+
+    int levels = std::min(SEGMENT_LEVELS, static_cast<int>(levels_.size()) - 1);
+    for (int level = 1; level <= levels; level++) {
+        uint64_t span = 1ull << (2 * level);
+        BuildLevel(level, first_peak / span, std::min((last_peak + span - 1) / span, PeakCount(level)));
+    }
+    return true;
+}
+
+void FlacWaveform::BuildLevel(int level, uint64_t begin, uint64_t end) {
+    const std::vector<FlacWaveformPeak>& children = levels_[level - 1];
+    std::vector<FlacWaveformPeak>& peaks = levels_[level];
+    uint64_t child_frames = FramesPerPeak(level - 1);
+
+    for (uint64_t i = begin; i < end; i++) {
+        int min = 127, max = -127;
+        double energy = 0.0, weight = 0.0;
+        uint64_t child_end = std::min<uint64_t>((i + 1) * FLAC_WAVEFORM_LEVEL_FACTOR, children.size());
+        for (uint64_t c = i * FLAC_WAVEFORM_LEVEL_FACTOR; c < child_end; c++) {
+            // RMS 按各子峰值覆盖的帧数加权（最后一个峰值可能不满）
+            double frames = static_cast<double>(std::min(child_frames, total_frames_ - c * child_frames));
+            double rms = children[c].rms;
+            min = std::min<int>(min, children[c].min);
+            max = std::max<int>(max, children[c].max);
+            energy += rms * rms * frames;
+            weight += frames;
+        }
+
+        FlacWaveformPeak& peak = peaks[i];
+        peak.min = static_cast<signed char>(min);
+        peak.max = static_cast<signed char>(max);
+        peak.rms = static_cast<unsigned char>(std::min(255.0, std::sqrt(energy / weight) + 0.5));
+        peak.ready = 1;
+    }
+}
+
+void FlacWaveform::Run(int threads) {
+    PrepareSeekpoints();
+
+    // 解码器在段之间复用：按需打开，最多与线程数相同
+    std::mutex idle_mutex;
+    std::vector<std::unique_ptr<Decoder>> idle;
+    std::atomic<bool> failed{false};
+
+    FlacParallelFor(segment_count_, threads, [&](size_t segment) {
+        if (cancel_.load(std::memory_order_relaxed) || failed.load(std::memory_order_relaxed)) return;
+
+        std::unique_ptr<Decoder> decoder;
+        {
+            std::lock_guard<std::mutex> lock(idle_mutex);
+            if (!idle.empty()) {
+                decoder = std::move(idle.back());
+                idle.pop_back();
+            }
+        }
+        if (!decoder) decoder = OpenDecoder();
+        if (!decoder) {
+            failed.store(true, std::memory_order_relaxed);
+            return;
+        }
+
+        if (DecodeSegment(decoder.get(), segment)) {
+            segment_ready_[segment].store(1, std::memory_order_release);
+            segments_done_.fetch_add(1, std::memory_order_relaxed);
+        } else if (!cancel_.load(std::memory_order_relaxed)) {
+            failed.store(true, std::memory_order_relaxed);
+        }
+
+        std::lock_guard<std::mutex> lock(idle_mutex);
+        idle.push_back(std::move(decoder));
+    });
+
+    if (cancel_.load(std::memory_order_relaxed)) return;
+    if (failed.load(std::memory_order_relaxed)) {
+        state_.store(FLAC_WAVEFORM_FAILED, std::memory_order_release);
+        return;
+    }
+
+    for (int level = SEGMENT_LEVELS + 1; level < static_cast<int>(levels_.size()); level++) {
+        BuildLevel(level, 0, PeakCount(level));
+    }
+    state_.store(FLAC_WAVEFORM_COMPLETE, std::memory_order_release);
+
+    if (has_identity_) SaveSidecar();
+}
+
+// ========== 读取 ==========
+
+void FlacWaveform::GetInfo(FlacWaveformInfo* out_info) const {
+    out_info->sample_rate = sample_rate_;
+    out_info->channels = channels_;
+    out_info->total_pcm_frames = total_frames_;
+    out_info->frames_per_peak = static_cast<int>(frames_per_peak_);
+    out_info->level_count = static_cast<int>(levels_.size());
+    out_info->state = state_.load(std::memory_order_acquire);
+    out_info->from_cache = from_cache_ ? 1 : 0;
+    out_info->progress = static_cast<float>(segments_done_.load(std::memory_order_relaxed)) / static_cast<float>(segment_count_);
+}
+
+int FlacWaveform::GetPeaks(int level, uint64_t start, int count, FlacWaveformPeak* out_peaks) const {
+    if (level < 0 || level >= static_cast<int>(levels_.size())) return -1;
+
+    const std::vector<FlacWaveformPeak>& peaks = levels_[level];
+    if (start >= peaks.size()) return 0;
+    size_t written = static_cast<size_t>(std::min<uint64_t>(static_cast<uint64_t>(count), peaks.size() - start));
+
+    if (level > SEGMENT_LEVELS) {
+        // 粗层在全部段完成后一次生成
+        if (state_.load(std::memory_order_acquire) == FLAC_WAVEFORM_COMPLETE) {
+            memcpy(out_peaks, peaks.data() + start, written * sizeof(FlacWaveformPeak));
+        } else {
+            memset(out_peaks, 0, written * sizeof(FlacWaveformPeak));
+        }
+        return static_cast<int>(written);
+    }
+
+    int shift = 2 * (SEGMENT_LEVELS - level);   // 峰值序号 >> shift = 段序号
+    for (size_t i = 0; i < written; i++) {
+        uint64_t index = start + i;
+        if (segment_ready_[static_cast<size_t>(index >> shift)].load(std::memory_order_acquire)) {
+            out_peaks[i] = peaks[static_cast<size_t>(index)];
+        } else {
+            memset(&out_peaks[i], 0, sizeof(FlacWaveformPeak));
+        }
+    }
+    return static_cast<int>(written);
+}
+
+// ========== 旁路文件 ==========
+
+static void PutU32(uint8_t*& p, uint32_t v) { for (int i = 0; i < 4; i++) *p++ = static_cast<uint8_t>(v >> (i * 8)); }
+static void PutU64(uint8_t*& p, uint64_t v) { for (int i = 0; i < 8; i++) *p++ = static_cast<uint8_t>(v >> (i * 8)); }
+
+static uint64_t GetLE(const uint8_t*& p, int bytes) {
+    uint64_t v = 0;
+    for (int i = 0; i < bytes; i++) v |= static_cast<uint64_t>(*p++) << (i * 8);
+    return v;
+}
+
+// 头部中除文件身份外的字段，读取时与刚打开的文件逐字节比较
+static void PutLayout(uint8_t*& p, int sample_rate, int channels, uint64_t total_frames, uint32_t frames_per_peak, size_t level_count) {
+    PutU32(p, static_cast<uint32_t>(sample_rate));
+    PutU32(p, static_cast<uint32_t>(channels));
+    PutU64(p, total_frames);
+    PutU32(p, frames_per_peak);
+    PutU32(p, static_cast<uint32_t>(level_count));
+}
+
+bool FlacWaveform::LoadSidecar() {
+    std::wstring sidecar = FlacSidecarPath(path_.c_str(), L".wavepk");
+    if (sidecar.empty()) return false;
+
+    FILE* file = FlacOpenFileW(sidecar.c_str());
+    if (!file) return false;
+
+    uint8_t header[WAVEFORM_HEADER_BYTES];
+    uint8_t layout[WAVEFORM_HEADER_BYTES - 24];
+    uint8_t* q = layout;
+    PutLayout(q, sample_rate_, channels_, total_frames_, frames_per_peak_, levels_.size());
+
+    bool ok = fread(header, 1, sizeof(header), file) == sizeof(header) &&
+              memcmp(header, WAVEFORM_MAGIC, 4) == 0 &&
+              memcmp(header + 24, layout, sizeof(layout)) == 0;
+    if (ok) {
+        const uint8_t* p = header + 4;
+        uint32_t version = static_cast<uint32_t>(GetLE(p, 4));
+        uint64_t size = GetLE(p, 8);
+        int64_t mtime = static_cast<int64_t>(GetLE(p, 8));
+        ok = version == WAVEFORM_VERSION && size == identity_.size && mtime == identity_.mtime;
+    }
+
+    std::vector<uint8_t> body;
+    for (size_t level = 0; ok && level < levels_.size(); level++) {
+        std::vector<FlacWaveformPeak>& peaks = levels_[level];
+        body.resize(peaks.size() * WAVEFORM_PEAK_BYTES);
+        ok = fread(body.data(), 1, body.size(), file) == body.size();
+        for (size_t i = 0; ok && i < peaks.size(); i++) {
+            peaks[i].min = static_cast<signed char>(body[i * WAVEFORM_PEAK_BYTES]);
+            peaks[i].max = static_cast<signed char>(body[i * WAVEFORM_PEAK_BYTES + 1]);
+            peaks[i].rms = body[i * WAVEFORM_PEAK_BYTES + 2];
+            peaks[i].ready = 1;
+        }
+    }
+    fclose(file);
+
+    if (!ok) {
+        for (std::vector<FlacWaveformPeak>& peaks : levels_) {
+            std::fill(peaks.begin(), peaks.end(), FlacWaveformPeak());
+        }
+    }
+    return ok;
+}
+
+void FlacWaveform::SaveSidecar() const {
+    std::wstring sidecar = FlacSidecarPath(path_.c_str(), L".wavepk");
+    if (sidecar.empty()) return;
+
+    size_t peak_count = 0;
+    for (const std::vector<FlacWaveformPeak>& peaks : levels_) peak_count += peaks.size();
+
+    std::vector<uint8_t> data(WAVEFORM_HEADER_BYTES + peak_count * WAVEFORM_PEAK_BYTES);
+    uint8_t* p = data.data();
+    memcpy(p, WAVEFORM_MAGIC, 4);
+    p += 4;
+    PutU32(p, WAVEFORM_VERSION);
+    PutU64(p, identity_.size);
+    PutU64(p, static_cast<uint64_t>(identity_.mtime));
+    PutLayout(p, sample_rate_, channels_, total_frames_, frames_per_peak_, levels_.size());
+    for (const std::vector<FlacWaveformPeak>& peaks : levels_) {
+        for (const FlacWaveformPeak& peak : peaks) {
+            *p++ = static_cast<uint8_t>(peak.min);
+            *p++ = static_cast<uint8_t>(peak.max);
+            *p++ = peak.rms;
+        }
+    }
+
+    // 同时打开同一文件的其他句柄不会读到写了一半的内容
+    FlacWriteFileAtomicW(sidecar.c_str(), data.data(), data.size());
+}
+
+// ========== 导出函数 ==========
+
+extern "C" {
+
+FLAC_API void* StartFlacWaveform(const wchar_t* file_path, int threads) {
+    if (!file_path) {
+        FlacSetLastError("File path is NULL");
+        return nullptr;
+    }
+
+    FlacWaveform* waveform = new FlacWaveform();
+    if (!waveform->Open(file_path)) {
+        delete waveform;
+        return nullptr;
+    }
+    waveform->Start(threads);
+    return waveform;
+}
+
+FLAC_API int GetFlacWaveformInfo(void* waveform, FlacWaveformInfo* out_info) {
+    if (!waveform || !out_info) {
+        FlacSetLastError("Invalid arguments");
+        return -1;
+    }
+    static_cast<FlacWaveform*>(waveform)->GetInfo(out_info);
+    return 0;
+}
+
+FLAC_API int GetFlacWaveformPeaks(void* waveform, int level, unsigned long long start, int count, FlacWaveformPeak* out_peaks) {
+    if (!waveform || count < 0 || (count > 0 && !out_peaks)) {
+        FlacSetLastError("Invalid arguments");
+        return -1;
+    }
+    int written = static_cast<FlacWaveform*>(waveform)->GetPeaks(level, start, count, out_peaks);
+    if (written < 0) FlacSetLastError("Invalid waveform level");
+    return written;
+}
+
+FLAC_API void CloseFlacWaveform(void* waveform) {
+    delete static_cast<FlacWaveform*>(waveform);
+}
+
+} // extern "C"
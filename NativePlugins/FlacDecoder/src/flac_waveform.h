@@ -0,0 +1,95 @@
+#ifndef CHILL_FLAC_WAVEFORM_H
+#define CHILL_FLAC_WAVEFORM_H
+
+// 波形概览：多分辨率的 min / max / RMS 峰值金字塔（所有声道合并统计）。
+//
+// 第 0 层每个峰值约 20 毫秒，之后每层合并 4 个。文件按 256 个第 0 层峰值（约 5 秒）切分为段，
+// 段首与第 4 层的峰值边界对齐：多个线程各自打开解码器，经 seek 索引跳到段首解码，
+// 每段完成后以 release 发布其 0~4 层，读取方按段检查就绪标记。更粗的层在全部段完成后生成。
+//
+// 旁路文件（小端，<缓存目录>/<路径哈希>.wavepk）：
+//   头部 { "CFWP", 版本, 文件大小, 修改时间, 采样率, 声道数, 总帧数, 每峰值帧数, 层数 } + 各层峰值依次排列
+
+#include "dr_flac.h"
+#include "flac_decoder.h"
+#include "flac_io.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+class FlacWaveform {
+public:
+    FlacWaveform() {}
+    ~FlacWaveform();
+
+    FlacWaveform(const FlacWaveform&) = delete;
+    FlacWaveform& operator=(const FlacWaveform&) = delete;
+
+    // 读取文件信息并分配各层；旁路文件有效时直接载入全部峰值。失败时设置错误消息
+    bool Open(const wchar_t* path);
+
+    // 在后台线程开始生成（已从旁路文件载入时什么也不做）
+    void Start(int threads);
+
+    void GetInfo(FlacWaveformInfo* out_info) const;
+
+    // 拷贝 level 层 [start, start + count) 的峰值，未就绪的写 0，返回写入数量（level 无效时返回 -1）
+    int GetPeaks(int level, uint64_t start, int count, FlacWaveformPeak* out_peaks) const;
+
+private:
+    // 一个工作线程上的解码器（各自打开文件，共享 seekpoint）
+    struct Decoder {
+        std::unique_ptr<FlacByteSource> source;
+        drflac* flac = nullptr;
+        uint64_t position = 0;          // UINT64_MAX 表示位置未知（解码出错后需重新 seek）
+        std::vector<float> scratch;     // 一个峰值的交错采样
+        ~Decoder();
+    };
+
+    // 第 level 层每个峰值覆盖的帧数 / 峰值数量
+    uint64_t FramesPerPeak(int level) const;
+    uint64_t PeakCount(int level) const;
+
+    // 由 level - 1 层合并生成 level 层的 [begin, end)
+    void BuildLevel(int level, uint64_t begin, uint64_t end);
+
+    bool LoadSidecar();
+    void SaveSidecar() const;
+
+    void Run(int threads);
+    void PrepareSeekpoints();
+    std::unique_ptr<Decoder> OpenDecoder();
+
+    // 解码一段并生成其 0~4 层，被取消或读取失败时返回 false
+    bool DecodeSegment(Decoder* decoder, size_t segment);
+
+    std::wstring path_;
+    FlacFileIdentity identity_ = {};
+    bool has_identity_ = false;
+
+    int sample_rate_ = 0;
+    int channels_ = 0;
+    uint64_t total_frames_ = 0;
+    uint32_t frames_per_peak_ = 0;
+    bool has_seektable_ = false;
+    bool from_cache_ = false;
+
+    // 打开后大小不再变化，峰值内容按下面的就绪标记发布
+    std::vector<std::vector<FlacWaveformPeak>> levels_;
+    size_t segment_count_ = 0;
+    std::unique_ptr<std::atomic<uint8_t>[]> segment_ready_;
+    std::atomic<size_t> segments_done_{0};
+    std::atomic<int> state_{FLAC_WAVEFORM_RUNNING};
+
+    // 文件没有 SEEKTABLE 时使用的 seekpoint（生成开始前准备好，之后只读）
+    std::vector<drflac_seekpoint> seekpoints_;
+
+    std::thread runner_;
+    std::atomic<bool> cancel_{false};
+};
+
+#endif // CHILL_FLAC_WAVEFORM_H
@@ -0,0 +1,105 @@
+#ifndef CHILL_FLAC_SPSC_RING_H
+#define CHILL_FLAC_SPSC_RING_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// 单生产者/单消费者无锁环形缓冲区（以 PCM 帧为单位）
+//
+// - 生产者：预解码线程，只调用 Writable / WriteRegion / CommitWrite / WritePosition
+// - 消费者：音频线程，只调用 Readable / Read / SkipTo
+// - 读写位置是单调递增的帧计数，容量为 2 的幂，下标 = 位置 & mask
+class SpscRing {
+public:
+    SpscRing(size_t frame_bytes, uint64_t min_frames)
+        : frame_bytes_(frame_bytes) {
+        capacity_ = 1;
+        while (capacity_ < min_frames) capacity_ <<= 1;
+        mask_ = capacity_ - 1;
+        data_.resize(static_cast<size_t>(capacity_) * frame_bytes_);
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    uint64_t Capacity() const { return capacity_; }
+    size_t FrameBytes() const { return frame_bytes_; }
+
+    // ========== 生产者 ==========
+
+    uint64_t Writable() const {
+        uint64_t w = write_pos_.load(std::memory_order_relaxed);
+        uint64_t r = read_pos_.load(std::memory_order_acquire);
+        return capacity_ - (w - r);
+    }
+
+    // 返回一段连续可写区域（不跨越环尾），帧数写入 out_frames
+    uint8_t* WriteRegion(uint64_t* out_frames) {
+        uint64_t w = write_pos_.load(std::memory_order_relaxed);
+        uint64_t index = w & mask_;
+        uint64_t contiguous = capacity_ - index;
+        uint64_t writable = Writable();
+        *out_frames = writable < contiguous ? writable : contiguous;
+        return data_.data() + index * frame_bytes_;
+    }
+
+    void CommitWrite(uint64_t frames) {
+        uint64_t w = write_pos_.load(std::memory_order_relaxed);
+        write_pos_.store(w + frames, std::memory_order_release);
+    }
+
+    uint64_t WritePosition() const {
+        return write_pos_.load(std::memory_order_relaxed);
+    }
+
+    // ========== 消费者 ==========
+
+    uint64_t Readable() const {
+        uint64_t r = read_pos_.load(std::memory_order_relaxed);
+        uint64_t w = write_pos_.load(std::memory_order_acquire);
+        return w - r;
+    }
+
+    // 拷贝最多 frames 帧到 dst，返回实际帧数（不阻塞）
+    uint64_t Read(void* dst, uint64_t frames) {
+        uint64_t r = read_pos_.load(std::memory_order_relaxed);
+        uint64_t w = write_pos_.load(std::memory_order_acquire);
+        uint64_t available = w - r;
+        if (frames > available) frames = available;
+        if (frames == 0) return 0;
+
+        uint64_t index = r & mask_;
+        uint64_t first = capacity_ - index;
+        if (first > frames) first = frames;
+
+        uint8_t* out = static_cast<uint8_t*>(dst);
+        memcpy(out, data_.data() + index * frame_bytes_, static_cast<size_t>(first * frame_bytes_));
+        if (frames > first) {
+            memcpy(out + first * frame_bytes_, data_.data(), static_cast<size_t>((frames - first) * frame_bytes_));
+        }
+
+        read_pos_.store(r + frames, std::memory_order_release);
+        return frames;
+    }
+
+    // 丢弃 pos 之前的所有数据（只向前移动）
+    void SkipTo(uint64_t pos) {
+        uint64_t r = read_pos_.load(std::memory_order_relaxed);
+        if (pos > r) {
+            read_pos_.store(pos, std::memory_order_release);
+        }
+    }
+
+private:
+    std::vector<uint8_t> data_;
+    size_t frame_bytes_;
+    uint64_t capacity_;
+    uint64_t mask_;
+
+    alignas(64) std::atomic<uint64_t> write_pos_{0};
+    alignas(64) std::atomic<uint64_t> read_pos_{0};
+};
+
+#endif // CHILL_FLAC_SPSC_RING_H
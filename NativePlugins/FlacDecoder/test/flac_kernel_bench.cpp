@@ -0,0 +1,90 @@
+// FLAC PCM Kernel Benchmark
+// 输出各 SIMD 级别下每个内核的吞吐量（百万采样/秒）
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include "../src/flac_fft.h"
+#include "../src/flac_simd.h"
+
+// 约 1 秒 96kHz 立体声，数据留在 L2 附近，主要衡量计算吞吐
+static const size_t SAMPLES = 96000 * 2;
+static const int ITERATIONS = 200;
+
+template <typename Fn>
+static double MeasureMsps(Fn fn) {
+    fn();  // 预热
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; i++) fn();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return static_cast<double>(SAMPLES) * ITERATIONS / seconds / 1e6;
+}
+
+int main() {
+    std::printf("=== FLAC PCM Kernel Benchmark ===\n");
+    std::printf("Selected: %s, %zu samples x %d iterations\n\n", FlacGetPcmKernels().name, SAMPLES, ITERATIONS);
+
+    std::vector<float> f32(SAMPLES);
+    std::vector<float> out(SAMPLES);
+    for (size_t i = 0; i < SAMPLES; i++) {
+        f32[i] = static_cast<float>(static_cast<int32_t>(i * 2654435761u)) / 2147483648.0f;
+    }
+
+    // 交叉淡化的每帧增益（立体声，帧数为采样数的一半）
+    std::vector<float> fade_out(SAMPLES / 2), fade_in(SAMPLES / 2);
+    for (size_t i = 0; i < SAMPLES / 2; i++) {
+        fade_in[i] = static_cast<float>(i) / static_cast<float>(SAMPLES / 2);
+        fade_out[i] = 1.0f - fade_in[i];
+    }
+
+    std::printf("%-8s %14s %14s %12s %12s %12s %12s %12s %14s\n", "level", "deint(2ch)", "deint(6ch)", "dot(64)", "mix(6->2)", "peak", "fft(2048)", "gain", "xfade(2ch)");
+
+    for (int level = FLAC_SIMD_SCALAR; level < FLAC_SIMD_LEVEL_COUNT; level++) {
+        const FlacPcmKernels* k = FlacGetPcmKernelsForLevel(static_cast<FlacSimdLevel>(level));
+        if (!k) continue;
+
+        double stereo_rate = MeasureMsps([&] { k->deinterleave_f32(f32.data(), SAMPLES / 2, 2, out.data(), SAMPLES / 2); });
+        double surround_rate = MeasureMsps([&] { k->deinterleave_f32(f32.data(), SAMPLES / 6, 6, out.data(), SAMPLES / 6); });
+        // 重采样器的典型用法：64 抽头滤波，逐个输出位置滑动
+        volatile float sink = 0.0f;
+        double dot_rate = MeasureMsps([&] {
+            float acc = 0.0f;
+            for (size_t i = 0; i + 64 <= SAMPLES; i += 64) acc += k->dot_f32(f32.data() + i, out.data() + i, 64);
+            sink = acc;
+        });
+        (void)sink;
+        // 5.1 → 立体声缩混（按输入采样数计）
+        static const float MATRIX[12] = { 0.41f, 0.0f, 0.29f, 0.0f, 0.29f, 0.0f, 0.0f, 0.41f, 0.29f, 0.0f, 0.0f, 0.29f };
+        double mix_rate = MeasureMsps([&] { k->mix_f32(f32.data(), SAMPLES / 6, 6, MATRIX, 2, out.data()); });
+
+        // 波形概览的典型用法：每个桶 882 个采样（44.1 kHz 单声道 20 ms）
+        volatile float peak_sink = 0.0f;
+        double peak_rate = MeasureMsps([&] {
+            float lo = 0.0f, hi = 0.0f, sum = 0.0f;
+            for (size_t i = 0; i + 882 <= SAMPLES; i += 882) k->peak_f32(f32.data() + i, 882, &lo, &hi, &sum);
+            peak_sink = lo + hi + sum;
+        });
+        (void)peak_sink;
+        // 频谱分析的典型用法：2048 点实数 FFT
+        FlacRealFft fft;
+        fft.Init(2048, k);
+        double fft_rate = MeasureMsps([&] {
+            for (size_t i = 0; i + 2048 <= SAMPLES; i += 2048) fft.Power(f32.data() + i, out.data() + i);
+        });
+        // 流输出级的增益（增益为 1，多次迭代后数据不变）
+        std::vector<float> gained(f32);
+        volatile float gain_sink = 0.0f;
+        double gain_rate = MeasureMsps([&] { gain_sink = k->gain_f32(gained.data(), SAMPLES, 1.0f); });
+        (void)gain_sink;
+        // 过渡引擎的立体声交叉淡化（按输出采样数计）
+        double fade_rate = MeasureMsps([&] {
+            k->crossfade_f32(f32.data(), gained.data(), fade_out.data(), fade_in.data(), SAMPLES / 2, 2, out.data());
+        });
+
+        std::printf("%-8s %14.1f %14.1f %12.1f %12.1f %12.1f %12.1f %12.1f %14.1f\n", k->name, stereo_rate, surround_rate, dot_rate, mix_rate, peak_rate, fft_rate, gain_rate, fade_rate);
+    }
+
+    std::printf("\n(Msamples/s, higher is better)\n");
+    return 0;
+}
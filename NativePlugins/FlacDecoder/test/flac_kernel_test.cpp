@@ -0,0 +1,221 @@
+// FLAC PCM Kernel Test
+// 验证各 SIMD 内核与标量实现（即当前输出）逐位一致；点积只要求在舍入误差内一致
+// 另以直接 DFT 校验实数 FFT 的功率谱
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "../src/flac_fft.h"
+#include "../src/flac_loudness.h"
+#include "../src/flac_simd.h"
+
+static int g_failures = 0;
+
+static void Check(bool ok, const char* kernel, const char* level, size_t count) {
+    if (!ok) {
+        std::printf("  [FAIL] %s/%s (count=%zu)\n", level, kernel, count);
+        g_failures++;
+    }
+}
+
+static bool SameBits(const std::vector<float>& a, const std::vector<float>& b) {
+    if (a.size() != b.size()) return false;
+    return a.empty() || std::memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0;
+}
+
+// 覆盖边界值和不同的尾部长度（不满一个向量的剩余部分走标量路径）
+static void TestLevel(const FlacPcmKernels& kernels, std::mt19937& rng) {
+    const FlacPcmKernels& scalar = *FlacGetPcmKernelsForLevel(FLAC_SIMD_SCALAR);
+    static const size_t COUNTS[] = { 0, 1, 7, 8, 15, 16, 17, 33, 1000, 4099 };
+
+    for (size_t count : COUNTS) {
+        // 平面长度大于帧数，确认不会越过各自的平面写入
+        for (int channels = 1; channels <= 8; channels++) {
+            std::vector<float> interleaved(count * channels);
+            for (float& v : interleaved) v = static_cast<float>(static_cast<int32_t>(rng())) / 2147483648.0f;
+
+            uint64_t stride = count + 3;
+            std::vector<float> planar_expected(stride * channels, -2.0f);
+            std::vector<float> planar_actual(stride * channels, -2.0f);
+            scalar.deinterleave_f32(interleaved.data(), count, channels, planar_expected.data(), stride);
+            kernels.deinterleave_f32(interleaved.data(), count, channels, planar_actual.data(), stride);
+            Check(SameBits(planar_expected, planar_actual), "deinterleave_f32", kernels.name, count);
+        }
+
+        // 声道矩阵：覆盖转置分组（4 声道一组，最后一组重叠）和 gather 路径
+        for (int in_channels = 2; in_channels <= 8; in_channels++) {
+            for (int out_channels = 1; out_channels <= 3; out_channels++) {
+                std::vector<float> in(count * in_channels);
+                std::vector<float> matrix(static_cast<size_t>(out_channels) * in_channels);
+                for (float& v : in) v = static_cast<float>(static_cast<int32_t>(rng())) / 2147483648.0f;
+                for (float& v : matrix) v = static_cast<float>(rng() % 1000) / 1000.0f;
+
+                std::vector<float> mix_expected(count * out_channels + 1, -2.0f);
+                std::vector<float> mix_actual(count * out_channels + 1, -2.0f);
+                scalar.mix_f32(in.data(), count, in_channels, matrix.data(), out_channels, mix_expected.data());
+                kernels.mix_f32(in.data(), count, in_channels, matrix.data(), out_channels, mix_actual.data());
+                Check(SameBits(mix_expected, mix_actual), "mix_f32", kernels.name, count);
+            }
+        }
+
+        // 点积：累加顺序不同，按绝对值之和给出误差上限
+        std::vector<float> a(count), b(count);
+        double magnitude = 0.0;
+        for (size_t i = 0; i < count; i++) {
+            a[i] = static_cast<float>(static_cast<int32_t>(rng())) / 2147483648.0f;
+            b[i] = static_cast<float>(static_cast<int32_t>(rng())) / 2147483648.0f;
+            magnitude += std::fabs(static_cast<double>(a[i]) * b[i]);
+        }
+        double dot_expected = scalar.dot_f32(a.data(), b.data(), count);
+        double dot_actual = kernels.dot_f32(a.data(), b.data(), count);
+        Check(std::fabs(dot_expected - dot_actual) <= magnitude * 1e-5 + 1e-30, "dot_f32", kernels.name, count);
+
+        // 峰值统计：最小 / 最大值逐位一致，平方和同样只比较误差上限（合并到已有的初始值上）
+        float min_expected = 0.25f, max_expected = -0.25f, sum_expected = 1.0f;
+        float min_actual = 0.25f, max_actual = -0.25f, sum_actual = 1.0f;
+        double squares = 1.0;
+        for (size_t i = 0; i < count; i++) squares += static_cast<double>(a[i]) * a[i];
+        scalar.peak_f32(a.data(), count, &min_expected, &max_expected, &sum_expected);
+        kernels.peak_f32(a.data(), count, &min_actual, &max_actual, &sum_actual);
+        Check(std::memcmp(&min_expected, &min_actual, sizeof(float)) == 0 &&
+              std::memcmp(&max_expected, &max_actual, sizeof(float)) == 0 &&
+              std::fabs(static_cast<double>(sum_expected) - sum_actual) <= squares * 1e-5,
+              "peak_f32", kernels.name, count);
+
+        // 增益：乘积与返回的峰值都逐位一致
+        std::vector<float> gained_expected(a), gained_actual(a);
+        float peak_expected = scalar.gain_f32(gained_expected.data(), count, 1.7f);
+        float peak_actual = kernels.gain_f32(gained_actual.data(), count, 1.7f);
+        Check(SameBits(gained_expected, gained_actual) && std::memcmp(&peak_expected, &peak_actual, sizeof(float)) == 0,
+              "gain_f32", kernels.name, count);
+
+        // 交叉淡化：count 为帧数，逐位一致（另测输出写回 a 的原地用法）
+        std::vector<float> gain_a(count), gain_b(count);
+        for (size_t i = 0; i < count; i++) {
+            gain_a[i] = static_cast<float>(rng() % 1000) / 1000.0f;
+            gain_b[i] = static_cast<float>(rng() % 1000) / 1000.0f;
+        }
+        for (int channels = 1; channels <= 6; channels++) {
+            std::vector<float> from(count * channels), to(count * channels);
+            for (float& v : from) v = static_cast<float>(static_cast<int32_t>(rng())) / 2147483648.0f;
+            for (float& v : to) v = static_cast<float>(static_cast<int32_t>(rng())) / 2147483648.0f;
+
+            std::vector<float> fade_expected(count * channels + 1, -2.0f);
+            std::vector<float> fade_actual(count * channels + 1, -2.0f);
+            scalar.crossfade_f32(from.data(), to.data(), gain_a.data(), gain_b.data(), count, channels, fade_expected.data());
+            kernels.crossfade_f32(from.data(), to.data(), gain_a.data(), gain_b.data(), count, channels, fade_actual.data());
+            std::vector<float> in_place(from);
+            in_place.push_back(-2.0f);
+            kernels.crossfade_f32(in_place.data(), to.data(), gain_a.data(), gain_b.data(), count, channels, in_place.data());
+            Check(SameBits(fade_expected, fade_actual) && SameBits(fade_expected, in_place), "crossfade_f32", kernels.name, count);
+        }
+    }
+}
+
+// radix-4 蝶形：quarter 从 1 到 256，覆盖 SIMD 实现回退到标量的各级
+static void TestRadix4(const FlacPcmKernels& kernels, std::mt19937& rng) {
+    const FlacPcmKernels& scalar = *FlacGetPcmKernelsForLevel(FLAC_SIMD_SCALAR);
+    const size_t n = 1024;
+    for (size_t quarter = 1; quarter <= n / 4; quarter *= 2) {
+        std::vector<float> twiddles(6 * quarter);
+        for (float& w : twiddles) w = static_cast<float>(static_cast<int32_t>(rng())) / 2147483648.0f;
+
+        std::vector<float> re_expected(n), im_expected(n);
+        for (size_t i = 0; i < n; i++) {
+            re_expected[i] = static_cast<float>(static_cast<int32_t>(rng())) / 2147483648.0f;
+            im_expected[i] = static_cast<float>(static_cast<int32_t>(rng())) / 2147483648.0f;
+        }
+        std::vector<float> re_actual = re_expected, im_actual = im_expected;
+
+        scalar.radix4_f32(re_expected.data(), im_expected.data(), n, quarter, twiddles.data());
+        kernels.radix4_f32(re_actual.data(), im_actual.data(), n, quarter, twiddles.data());
+        Check(SameBits(re_expected, re_actual) && SameBits(im_expected, im_actual), "radix4_f32", kernels.name, quarter);
+    }
+}
+
+// 实数 FFT 的功率谱与直接 DFT 一致（radix-4 级数为奇数和偶数的长度各取几个）
+static void TestRealFft(std::mt19937& rng) {
+    static const size_t SIZES[] = { 8, 16, 32, 256, 2048 };
+    for (size_t size : SIZES) {
+        std::vector<float> in(size);
+        for (float& v : in) v = static_cast<float>(static_cast<int32_t>(rng())) / 2147483648.0f;
+
+        FlacRealFft fft;
+        fft.Init(size);
+        std::vector<float> power(size / 2 + 1);
+        fft.Power(in.data(), power.data());
+
+        bool ok = true;
+        for (size_t k = 0; k <= size / 2; k++) {
+            double re = 0.0, im = 0.0;
+            for (size_t i = 0; i < size; i++) {
+                double angle = -2.0 * 3.14159265358979323846 * static_cast<double>(k * i % size) / static_cast<double>(size);
+                re += in[i] * std::cos(angle);
+                im += in[i] * std::sin(angle);
+            }
+            double expected = re * re + im * im;
+            ok = ok && std::fabs(expected - power[k]) <= 1e-4 * static_cast<double>(size) + 1e-4 * expected;
+        }
+        Check(ok, "real_fft", FlacGetPcmKernels().name, size);
+    }
+}
+
+// 响度测量：EBU Tech 3341 / 3342 的基本用例（立体声 1kHz 正弦），以及 fs/4 正弦的采样间峰值
+static void MeasureSine(FlacLoudnessMeter* meter, int sample_rate, double frequency, double phase, double dbfs, double seconds) {
+    double amplitude = std::pow(10.0, dbfs / 20.0);
+    size_t frames = static_cast<size_t>(seconds * sample_rate);
+    std::vector<float> in(frames * 2);
+    for (size_t i = 0; i < frames; i++) {
+        float v = static_cast<float>(amplitude * std::sin(2.0 * 3.14159265358979323846 * frequency * i / sample_rate + phase));
+        in[i * 2] = in[i * 2 + 1] = v;
+    }
+    meter->Process(in.data(), frames);
+}
+
+static void TestLoudness() {
+    FlacLoudnessMeter meter;
+    meter.Init(48000, 2);
+    MeasureSine(&meter, 48000, 1000.0, 0.0, -23.0, 20.0);
+    Check(std::fabs(meter.IntegratedLoudness() + 23.0) <= 0.1, "loudness -23", "meter", 20);
+    Check(meter.LoudnessRange() <= 0.1, "loudness range flat", "meter", 20);
+
+    meter.Init(44100, 2);
+    MeasureSine(&meter, 44100, 1000.0, 0.0, -20.0, 20.0);
+    MeasureSine(&meter, 44100, 1000.0, 0.0, -30.0, 20.0);
+    Check(std::fabs(meter.LoudnessRange() - 10.0) <= 1.0, "loudness range 10", "meter", 40);
+
+    // 采样点落在 ±0.707 振幅处，真峰值应回到 -6 dBTP
+    meter.Init(48000, 2);
+    MeasureSine(&meter, 48000, 12000.0, 3.14159265358979323846 / 4.0, -6.0, 1.0);
+    Check(std::fabs(20.0 * std::log10(meter.TruePeak()) + 6.0) <= 0.3, "true peak", "meter", 1);
+
+    meter.Init(48000, 2);
+    Check(meter.IntegratedLoudness() == FLAC_LOUDNESS_ABSOLUTE_GATE_LUFS && meter.TruePeak() == 0.0, "loudness silence", "meter", 0);
+}
+
+int main() {
+    std::printf("=== FLAC PCM Kernel Test ===\n");
+    std::printf("Selected: %s\n", FlacGetPcmKernels().name);
+
+    std::mt19937 rng(12345);
+    TestRealFft(rng);
+    TestLoudness();
+
+    for (int level = FLAC_SIMD_SCALAR; level < FLAC_SIMD_LEVEL_COUNT; level++) {
+        const FlacPcmKernels* kernels = FlacGetPcmKernelsForLevel(static_cast<FlacSimdLevel>(level));
+        if (!kernels) continue;
+        std::printf("Testing %s...\n", kernels->name);
+        TestLevel(*kernels, rng);
+        TestRadix4(*kernels, rng);
+    }
+
+    if (g_failures > 0) {
+        std::printf("FAILED: %d check(s)\n", g_failures);
+        return 1;
+    }
+    std::printf("All kernels match scalar\n");
+    return 0;
+}
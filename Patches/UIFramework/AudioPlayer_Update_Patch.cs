@@ -26,6 +26,7 @@ namespace ChillPatcher.Patches.UIFramework
     /// 4. 如果进度接近结尾，主动触发下一首
     /// 5. 【新增】使用防重入锁防止同一首歌的 EOF 被重复触发导致多首歌同时播放
     /// 6. 【新增】超时保护：如果播放进度长时间不变（默认 10 秒），认为流已结束
+    /// 7. 过渡引擎的共享 clip 交给 FlacTransitionService 跟随引擎的曲目切换
     /// </summary>
     [HarmonyPatch]
     public static class AudioPlayer_Update_Patch
@@ -74,6 +75,12 @@ namespace ChillPatcher.Patches.UIFramework
                 return true; // 使用原始逻辑
             }
 
+            // 过渡引擎的共享 clip：曲目切换和播放结束由引擎状态判断
+            if (FlacTransitionService.IsTransitionClip(audioSource.clip))
+            {
+                return !FlacTransitionService.Update(ProjectLifetimeScope.Resolve<MusicService>());
+            }
+
             // 快速检查：是否是流媒体相关的 AudioClip
             // 流媒体 clip 的名称以 "pcm_stream_" 开头
             var clipName = audioSource.clip.name;
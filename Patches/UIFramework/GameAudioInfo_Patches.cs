@@ -77,10 +77,26 @@ namespace ChillPatcher.Patches.UIFramework
                 FlacDecoder.FlacStreamReader streamReader = null;
                 string title = Path.GetFileNameWithoutExtension(filePath);
 
-                // 在后台线程打开流
+                // 过渡引擎已自动切换到这首：直接接管正在播放的共享 clip
+                if (FlacTransitionService.TryAdopt(filePath, out var adoptedClip))
+                {
+                    return (adoptedClip, title, "");
+                }
+
+                // 在后台线程打开流（已预加载的直接取用待命流）
+                bool useTransition = FlacTransitionService.IsEnabled;
+                var trim = default(FlacDecoder.FlacGaplessTrim);
                 await UniTask.RunOnThreadPool(() =>
                 {
-                    streamReader = new FlacDecoder.FlacStreamReader(filePath);
+                    streamReader = FlacPreloadService.TryTake(filePath) ?? new FlacDecoder.FlacStreamReader(
+                        filePath,
+                        UIFrameworkConfig.FlacDecodeAheadMs.Value,
+                        UIFrameworkConfig.FlacOutputSampleRate.Value,
+                        UIFrameworkConfig.FlacDownmixChannels.Value);
+                    if (useTransition)
+                    {
+                        trim = FlacTransitionService.GetTrim(filePath, streamReader);
+                    }
                 }, cancellationToken: ct);
 
                 if (streamReader == null)
@@ -94,6 +110,17 @@ namespace ChillPatcher.Patches.UIFramework
                 // 在主线程创建流式 AudioClip
                 AudioClip clip = null;
                 await UniTask.SwitchToMainThread();
+
+                // 过渡引擎：流交给引擎，播放共享 clip（失败时按普通流式 clip 播放）
+                if (useTransition)
+                {
+                    clip = FlacTransitionService.Attach(streamReader, trim, filePath);
+                    if (clip != null)
+                    {
+                        return (clip, title, "");
+                    }
+                }
+
                 clip = CreateStreamingAudioClip(streamReader, clipName);
 
                 if (clip == null)
@@ -121,9 +148,7 @@ namespace ChillPatcher.Patches.UIFramework
         /// </summary>
         private static AudioClip CreateStreamingAudioClip(FlacDecoder.FlacStreamReader streamReader, string clipName)
         {
-            const int BUFFER_SIZE_FRAMES = 4096; // 每次读取的帧数
-            float[] readBuffer = new float[BUFFER_SIZE_FRAMES * streamReader.Channels];
-            object lockObj = new object();
+            // 读取只在音频线程进行，Seek 只投递到 Native 的 seek 信箱，两个回调之间不需要加锁
 
             // 创建流式 AudioClip（stream = true）
             var clip = AudioClip.Create(
@@ -135,50 +160,30 @@ namespace ChillPatcher.Patches.UIFramework
                 (float[] data) => // PCM 读取回调
                 {
                     // Unity 在音频线程调用此回调
-                    lock (lockObj)
+                    // 到达末尾、欠载或 seek 尚未落地时 Native 已填充静音
+                    try
                     {
-                        try
-                        {
-                            int samplesNeeded = data.Length;
-                            int samplesWritten = 0;
-
-                            while (samplesWritten < samplesNeeded)
-                            {
-                                int framesToRead = Math.Min(BUFFER_SIZE_FRAMES, (samplesNeeded - samplesWritten) / streamReader.Channels);
-                                long framesRead = streamReader.ReadFrames(readBuffer, (ulong)framesToRead);
-
-                                if (framesRead <= 0)
-                                {
-                                    // 到达末尾或错误，填充静音
-                                    Array.Clear(data, samplesWritten, samplesNeeded - samplesWritten);
-                                    break;
-                                }
-
-                                int samplesToCopy = (int)framesRead * streamReader.Channels;
-                                Array.Copy(readBuffer, 0, data, samplesWritten, samplesToCopy);
-                                samplesWritten += samplesToCopy;
-                            }
-                        }
-                        catch (Exception ex)
+                        if (streamReader.FillBuffer(data) < 0)
                         {
-                            Plugin.Log.LogError($"[FlacStreamLoader] Error in PCM callback: {ex.Message}");
                             Array.Clear(data, 0, data.Length);
                         }
                     }
+                    catch (Exception ex)
+                    {
+                        Plugin.Log.LogError($"[FlacStreamLoader] Error in PCM callback: {ex.Message}");
+                        Array.Clear(data, 0, data.Length);
+                    }
                 },
                 (int newPosition) => // PCM 位置设置回调
                 {
-                    // Unity 调用此回调进行 seek
-                    lock (lockObj)
+                    // Unity 调用此回调进行 seek（可能在主线程）
+                    try
                     {
-                        try
-                        {
-                            streamReader.Seek((ulong)newPosition);
-                        }
-                        catch (Exception ex)
-                        {
-                            Plugin.Log.LogError($"[FlacStreamLoader] Error in seek callback: {ex.Message}");
-                        }
+                        streamReader.Seek((ulong)newPosition);
+                    }
+                    catch (Exception ex)
+                    {
+                        Plugin.Log.LogError($"[FlacStreamLoader] Error in seek callback: {ex.Message}");
                     }
                 });
 
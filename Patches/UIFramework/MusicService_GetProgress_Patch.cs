@@ -3,6 +3,7 @@ using Bulbul;
 using KanKikuchi.AudioManager;
 using ChillPatcher.ModuleSystem.Registry;
 using ChillPatcher.SDK.Models;
+using ChillPatcher.UIFramework.Audio;
 
 namespace ChillPatcher.Patches.UIFramework
 {
@@ -40,6 +41,13 @@ namespace ChillPatcher.Patches.UIFramework
                 return false; // 跳过原始逻辑
             }
 
+            // 过渡引擎的共享 clip：使用引擎中当前曲目的位置（clip 本身的时长是共享的余量）
+            if (FlacTransitionService.TryGetProgress(playingMusic.AudioClip, out float transitionProgress))
+            {
+                __result = transitionProgress;
+                return false;
+            }
+
             // 检查是否是流媒体歌曲
             var music = MusicRegistry.Instance?.GetMusic(playingMusic.UUID);
             if (music == null || music.SourceType != MusicSourceType.Stream)
@@ -4,6 +4,7 @@ using KanKikuchi.AudioManager;
 using UnityEngine;
 using ChillPatcher.ModuleSystem.Registry;
 using ChillPatcher.SDK.Models;
+using ChillPatcher.UIFramework.Audio;
 
 namespace ChillPatcher.Patches.UIFramework
 {
@@ -32,11 +33,6 @@ namespace ChillPatcher.Patches.UIFramework
         /// </summary>
         public static ChillPatcher.SDK.Interfaces.IPcmStreamReader ActivePcmReader { get; set; }
 
-        /// <summary>
-        /// 是否正在从 SetProgress 进行 Seek（防止 PCMSetPositionCallback 重复 Seek）
-        /// </summary>
-        public static bool IsSeekingFromSetProgress { get; set; }
-
         /// <summary>
         /// 拖动预览进度（拖动过程中显示的进度，但不实际 Seek）
         /// </summary>
@@ -90,6 +86,12 @@ namespace ChillPatcher.Patches.UIFramework
                 return true; // 使用原始逻辑
             }
 
+            // 过渡引擎的共享 clip：定位引擎中的当前曲目（只投递请求，拖动中也可直接定位）
+            if (FlacTransitionService.TrySeek(playingMusic.AudioClip, progress))
+            {
+                return false;
+            }
+
             // 检查是否是流媒体歌曲
             var music = MusicRegistry.Instance?.GetMusic(playingMusic.UUID);
             if (music == null || music.SourceType != MusicSourceType.Stream)
@@ -194,17 +196,10 @@ namespace ChillPatcher.Patches.UIFramework
                 
                 // 同步更新 AudioSource.time（虽然 PCM 流控制实际位置，但需要同步 UI）
                 // 【重要】使用原始时长，而不是 clip.length（包含 30 分钟余量）
-                IsSeekingFromSetProgress = true;
-                try
-                {
-                    float originalDuration = ActivePcmReader != null ? ActivePcmReader.Info.Duration : clip.length;
-                    if (originalDuration <= 0) originalDuration = clip.length;
-                    player.AudioSource.time = Mathf.Clamp(originalDuration * progress, 0f, clip.length);
-                }
-                finally
-                {
-                    IsSeekingFromSetProgress = false;
-                }
+                // 由此触发的 PCMSetPositionCallback 目标与刚才的 Seek 相同，会被去重跳过
+                float originalDuration = ActivePcmReader != null ? ActivePcmReader.Info.Duration : clip.length;
+                if (originalDuration <= 0) originalDuration = clip.length;
+                player.AudioSource.time = Mathf.Clamp(originalDuration * progress, 0f, clip.length);
                 
                 Plugin.Log.LogInfo($"[SetProgress_Patch] Seek succeeded to {progress:P1}");
                 return false;
@@ -3,6 +3,7 @@ using System.Collections.Generic;
 using System.IO;
 using System.Threading.Tasks;
 using Bulbul;
+using Cysharp.Threading.Tasks;
 using HarmonyLib;
 using UnityEngine;
 using UnityEngine.UI;
@@ -10,6 +11,7 @@ using R3;
 using ChillPatcher.UIFramework.Core;
 using ChillPatcher.UIFramework.Music;
 using ChillPatcher.ModuleSystem.Services;
+using ChillPatcher.Native;
 
 namespace ChillPatcher.Patches.UIFramework
 {
@@ -48,6 +50,9 @@ namespace ChillPatcher.Patches.UIFramework
         // 当前正在等待的歌曲 UUID（用于事件回调匹配）
         private static string _pendingMusicUuid;
 
+        // 当前正在后台生成缩略图的本地文件路径（切歌后丢弃过期结果）
+        private static string _pendingLocalPath;
+
         /// <summary>
         /// 检查是否已经有封面被设置（用于 UI 重排列补丁判断）
         /// </summary>
@@ -226,6 +231,7 @@ namespace ChillPatcher.Patches.UIFramework
                 return;
 
             bool useSquareMode = UIFrameworkConfig.EnableUIRearrange.Value;
+            _pendingLocalPath = null;
 
             // 如果有 UUID，使用 CoverService 的统一 API
             if (!string.IsNullOrEmpty(audioInfo.UUID))
@@ -257,6 +263,15 @@ namespace ChillPatcher.Patches.UIFramework
             if (audioInfo.PathType == AudioMode.LocalPc && !string.IsNullOrEmpty(audioInfo.LocalPath))
             {
                 _pendingMusicUuid = null;
+
+                // Native 可用时在后台线程解码、缩放和压缩，主线程只创建纹理
+                if (FlacDecoder.IsAvailable())
+                {
+                    int thumbnailResolution = useSquareMode ? UIRearrangePatch.AlbumArtResolution : 88;
+                    LoadLocalAlbumArtAsync(audioInfo.LocalPath, audioInfo.Title, useSquareMode, thumbnailResolution).Forget();
+                    return;
+                }
+
                 var albumArtTexture = TryLoadAlbumCover(audioInfo.LocalPath);
                 if (albumArtTexture != null)
                 {
@@ -316,6 +331,79 @@ namespace ChillPatcher.Patches.UIFramework
             }
         }
 
+        /// <summary>
+        /// 在后台线程生成本地文件的封面缩略图（FLAC 内嵌封面优先，其次文件夹中的封面图片）
+        /// </summary>
+        private static async UniTaskVoid LoadLocalAlbumArtAsync(string audioFilePath, string title, bool useSquareMode, int resolution)
+        {
+            _pendingLocalPath = audioFilePath;
+
+            // 压缩缩略图持久化在缓存中，再次播放同一首歌（或同一张专辑）时无需解码
+            byte[] blocks = null;
+            var format = TextureFormat.DXT1;
+            try
+            {
+                await UniTask.RunOnThreadPool(() =>
+                {
+                    if (string.Equals(Path.GetExtension(audioFilePath), ".flac", StringComparison.OrdinalIgnoreCase))
+                    {
+                        blocks = FlacDecoder.LoadCompressedCoverThumbnail(audioFilePath, resolution, !useSquareMode, out format);
+                    }
+                    if (blocks == null)
+                    {
+                        var coverPath = FindAlbumCoverPath(audioFilePath);
+                        if (coverPath != null)
+                            blocks = FlacDecoder.LoadCompressedCoverThumbnail(coverPath, resolution, !useSquareMode, out format);
+                    }
+                });
+            }
+            catch (Exception ex)
+            {
+                Plugin.Logger.LogWarning($"[MusicUI_AlbumArt_Patch] Error loading album cover: {ex.Message}");
+            }
+
+            await UniTask.SwitchToMainThread();
+
+            // 等待期间已切换到其他歌曲
+            if (_pendingLocalPath != audioFilePath)
+                return;
+            _pendingLocalPath = null;
+
+            var sprite = AlbumArtReader.CreateSpriteFromCompressed(blocks, resolution, format);
+            if (sprite != null)
+            {
+                ApplyAlbumArt(sprite, audioFilePath, title);
+                return;
+            }
+
+            // 本地文件但没有封面，使用本地导入专用封面
+            TryUseDefaultCover(useSquareMode, isLocalImport: true);
+        }
+
+        /// <summary>
+        /// 查找文件夹中的封面图片（常见的封面文件名）
+        /// </summary>
+        private static string FindAlbumCoverPath(string audioFilePath)
+        {
+            var directory = Path.GetDirectoryName(audioFilePath);
+            if (string.IsNullOrEmpty(directory) || !Directory.Exists(directory))
+                return null;
+
+            string[] coverNames = { "cover", "folder", "front", "album", "artwork" };
+            string[] extensions = { ".jpg", ".jpeg", ".png", ".bmp", ".gif" };
+
+            foreach (var name in coverNames)
+            {
+                foreach (var ext in extensions)
+                {
+                    var coverPath = Path.Combine(directory, name + ext);
+                    if (File.Exists(coverPath))
+                        return coverPath;
+                }
+            }
+            return null;
+        }
+
         /// <summary>
         /// 尝试加载专辑封面（从文件夹中查找）
         /// </summary>
@@ -323,32 +411,18 @@ namespace ChillPatcher.Patches.UIFramework
         {
             try
             {
-                var directory = Path.GetDirectoryName(audioFilePath);
-                if (string.IsNullOrEmpty(directory) || !Directory.Exists(directory))
+                var coverPath = FindAlbumCoverPath(audioFilePath);
+                if (coverPath == null)
                     return null;
 
-                // 查找常见的封面文件名
-                string[] coverNames = { "cover", "folder", "front", "album", "artwork" };
-                string[] extensions = { ".jpg", ".jpeg", ".png", ".bmp", ".gif" };
-
-                foreach (var name in coverNames)
+                var bytes = File.ReadAllBytes(coverPath);
+                var texture = new Texture2D(2, 2);
+                if (UnityEngine.ImageConversion.LoadImage(texture, bytes))
                 {
-                    foreach (var ext in extensions)
-                    {
-                        var coverPath = Path.Combine(directory, name + ext);
-                        if (File.Exists(coverPath))
-                        {
-                            var bytes = File.ReadAllBytes(coverPath);
-                            var texture = new Texture2D(2, 2);
-                            if (UnityEngine.ImageConversion.LoadImage(texture, bytes))
-                            {
-                                Plugin.Logger.LogInfo($"[MusicUI_AlbumArt_Patch] Loaded album cover from: {coverPath}");
-                                return texture;
-                            }
-                            UnityEngine.Object.Destroy(texture);
-                        }
-                    }
+                    Plugin.Logger.LogInfo($"[MusicUI_AlbumArt_Patch] Loaded album cover from: {coverPath}");
+                    return texture;
                 }
+                UnityEngine.Object.Destroy(texture);
             }
             catch (Exception ex)
             {
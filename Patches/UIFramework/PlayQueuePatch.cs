@@ -438,6 +438,12 @@ namespace ChillPatcher.Patches.UIFramework
             
             Plugin.Log.LogInfo($"[PlayQueuePatch] Got audio: {audio.Title}, AudioClip={(audio.AudioClip != null ? "exists" : "null")}");
             
+            // 过渡引擎的共享 clip 不属于某一首歌，重新播放时需要重新排入引擎
+            if (FlacTransitionService.IsTransitionClip(audio.AudioClip))
+            {
+                audio.AudioClip = null;
+            }
+            
             // 使用智能加载 - 自动判断音源类型
             AudioClip audioClip = audio.AudioClip;
             if (audioClip == null)
@@ -450,7 +456,7 @@ namespace ChillPatcher.Patches.UIFramework
                 if (playingMusic != null && playingMusic.AudioClip != null)
                 {
                     Plugin.Log.LogInfo($"[PlayQueuePatch] Stopping current: {playingMusic.AudioClipName}");
-                    SingletonMonoBehaviour<MusicManager>.Instance.Stop(playingMusic.AudioClip);
+                    StopCurrent(playingMusic, audio);
                 }
                 
                 // 立即切换 UI 显示到新歌曲，进度条会停在 0 等待加载
@@ -555,7 +561,7 @@ namespace ChillPatcher.Patches.UIFramework
                 var playingMusic = musicService.PlayingMusic;
                 if (playingMusic != null && playingMusic.AudioClip != null)
                 {
-                    SingletonMonoBehaviour<MusicManager>.Instance.Stop(playingMusic.AudioClip);
+                    StopCurrent(playingMusic, audio);
                 }
             }
             
@@ -567,12 +573,7 @@ namespace ChillPatcher.Patches.UIFramework
             
             Plugin.Log.LogInfo($"[PlayQueuePatch] About to play from playlist: {audio.Title}, loadState={audioClip.loadState}");
             
-            SingletonMonoBehaviour<MusicManager>.Instance.Play(
-                audioClip, 1f, 0f, 1f,
-                musicService.IsRepeatOneMusic,
-                true, "",
-                () => musicService.SkipCurrentMusic(MusicChangeKind.Auto).Forget<bool>()
-            );
+            PlayClip(musicService, audioClip);
             
             // 如果是本地音频（AudioClip 已存在），需要在这里更新状态和触发事件
             // 流媒体的话已经在加载前更新过了
@@ -764,7 +765,7 @@ namespace ChillPatcher.Patches.UIFramework
             if (playingMusic != null && playingMusic.AudioClip != null)
             {
                 Plugin.Log.LogInfo($"[PlayQueuePatch] Stopping current: {playingMusic.AudioClipName}");
-                SingletonMonoBehaviour<MusicManager>.Instance.Stop(playingMusic.AudioClip);
+                StopCurrent(playingMusic, audioInfo);
             }
             
             // 立即切换 UI 显示到新歌曲，进度条会停在 0 等待加载
@@ -833,12 +834,7 @@ namespace ChillPatcher.Patches.UIFramework
             
             Plugin.Log.LogInfo($"[PlayQueuePatch] About to play argument music: {audioInfo.Title}, loadState={audioClip.loadState}");
             
-            SingletonMonoBehaviour<MusicManager>.Instance.Play(
-                audioClip, 1f, 0f, 1f,
-                musicService.IsRepeatOneMusic,
-                true, "",
-                () => musicService.SkipCurrentMusic(MusicChangeKind.Auto).Forget<bool>()
-            );
+            PlayClip(musicService, audioClip);
             
             // 清除加载标志（UI 已在加载前更新过了）
             FacilityMusic_UpdateFacility_Patch.IsLoadingMusic = false;
@@ -872,7 +868,7 @@ namespace ChillPatcher.Patches.UIFramework
             if (playingMusic != null && playingMusic.AudioClip != null)
             {
                 Plugin.Log.LogInfo($"[PlayQueuePatch] Stopping current: {playingMusic.AudioClipName}");
-                SingletonMonoBehaviour<MusicManager>.Instance.Stop(playingMusic.AudioClip);
+                StopCurrent(playingMusic, audio);
             }
             
             // 立即切换 UI 显示到新歌曲，进度条会停在 0 等待加载
@@ -944,12 +940,7 @@ namespace ChillPatcher.Patches.UIFramework
             
             Plugin.Log.LogInfo($"[PlayQueuePatch] About to play: {audio.AudioClipName}, loadState={audioClip.loadState}");
             
-            SingletonMonoBehaviour<MusicManager>.Instance.Play(
-                audioClip, 1f, 0f, 1f,
-                musicService.IsRepeatOneMusic,
-                true, "",
-                () => musicService.SkipCurrentMusic(MusicChangeKind.Auto).Forget<bool>()
-            );
+            PlayClip(musicService, audioClip);
             
             // 清除加载标志（UI 已在加载前更新过了）
             FacilityMusic_UpdateFacility_Patch.IsLoadingMusic = false;
@@ -958,6 +949,41 @@ namespace ChillPatcher.Patches.UIFramework
             return true;
         }
         
+        /// <summary>
+        /// 停止当前播放
+        /// 过渡引擎的共享 clip 在下一首也经由引擎播放时继续播放，由引擎在新曲目排入时切换或淡出
+        /// </summary>
+        private static void StopCurrent(GameAudioInfo playingMusic, GameAudioInfo nextAudio)
+        {
+            if (FlacTransitionService.IsTransitionClip(playingMusic.AudioClip) && FlacTransitionService.CanHandle(nextAudio))
+            {
+                Plugin.Log.LogInfo($"[PlayQueuePatch] Keeping transition clip playing for: {nextAudio.Title}");
+                return;
+            }
+            SingletonMonoBehaviour<MusicManager>.Instance.Stop(playingMusic.AudioClip);
+        }
+        
+        /// <summary>
+        /// 播放加载好的 AudioClip
+        /// 过渡引擎的共享 clip 正在播放时不重新 Play（新曲目已在 Native 侧排入，重新 Play 会清空 Unity 的流缓冲造成间隙）；
+        /// 播放其他 clip 前停止共享 clip
+        /// </summary>
+        private static void PlayClip(MusicService musicService, AudioClip audioClip)
+        {
+            if (FlacTransitionService.IsTransitionClip(audioClip) && FlacTransitionService.IsPlaying)
+            {
+                return;
+            }
+            FlacTransitionService.Stop();
+            
+            SingletonMonoBehaviour<MusicManager>.Instance.Play(
+                audioClip, 1f, 0f, 1f,
+                musicService.IsRepeatOneMusic,
+                true, "",
+                () => musicService.SkipCurrentMusic(MusicChangeKind.Auto).Forget<bool>()
+            );
+        }
+        
         /// <summary>
         /// 检查是否是流式 AudioClip
         /// 流式 clip 使用 PCMReaderCallback，loadState 永远是 Unloaded
@@ -1003,6 +1029,13 @@ namespace ChillPatcher.Patches.UIFramework
                 Plugin.Log.LogDebug($"[PlayQueuePatch] Cleaned up cover for: {previousMusic.Title}");
             }
             
+            // 过渡引擎的共享 clip 由 FlacTransitionService 管理，只解除引用（流已归引擎所有）
+            if (FlacTransitionService.IsTransitionClip(previousMusic.AudioClip))
+            {
+                previousMusic.AudioClip = null;
+                return;
+            }
+            
             // 清理流式 AudioClip 的资源（FlacStreamReader）
             if (previousMusic.AudioClip != null)
             {
@@ -1116,7 +1149,7 @@ namespace ChillPatcher.Patches.UIFramework
             var playingMusic = musicService.PlayingMusic;
             if (playingMusic?.AudioClip != null)
             {
-                SingletonMonoBehaviour<MusicManager>.Instance.Stop(playingMusic.AudioClip);
+                StopCurrent(playingMusic, audio);
             }
             
             // 加载音频数据（跳过流式 AudioClip）
@@ -1127,12 +1160,7 @@ namespace ChillPatcher.Patches.UIFramework
             
             Plugin.Log.LogInfo($"[PlayQueuePatch] About to play from queue: {audio.AudioClipName}, loadState={audioClip.loadState}");
             
-            SingletonMonoBehaviour<MusicManager>.Instance.Play(
-                audioClip, 1f, 0f, 1f,
-                musicService.IsRepeatOneMusic,
-                true, "",
-                () => musicService.SkipCurrentMusic(MusicChangeKind.Auto).Forget<bool>()
-            );
+            PlayClip(musicService, audioClip);
             
             // 更新 MusicService 状态
             SetPlayingMusic(musicService, audio);
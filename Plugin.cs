@@ -13,6 +13,7 @@ using ChillPatcher.UIFramework.Music;
 using ChillPatcher.ModuleSystem;
 using ChillPatcher.ModuleSystem.Registry;
 using ChillPatcher.ModuleSystem.Services;
+using ChillPatcher.Native;
 using ChillPatcher.SDK.Interfaces;
 using Cysharp.Threading.Tasks;
 using Bulbul;
@@ -112,6 +113,9 @@ namespace ChillPatcher
             // 初始化核心服务
             DefaultCoverProvider.Initialize();
             CoreAudioLoader.Initialize();
+            CoreCoverThumbnailLoader.Initialize();
+            InitializeFlacIoBackend();
+            UIFramework.Audio.FlacPreloadService.Initialize();
             
             // 初始化 CoverService 的事件订阅
             CoverService.Instance.InitializeEventSubscriptions();
@@ -125,6 +129,22 @@ namespace ChillPatcher
             Logger.LogInfo("Core registries and services initialized!");
         }
 
+        /// <summary>
+        /// 按配置设置本地 FLAC 的 I/O 后端（需在打开任何 FLAC 文件之前调用）
+        /// </summary>
+        private void InitializeFlacIoBackend()
+        {
+            int value = UIFrameworkConfig.FlacIoBackend.Value;
+            if (value == 0 || !FlacDecoder.IsAvailable())
+                return;
+
+            var backend = (FlacDecoder.FlacIoBackend)Math.Max(0, Math.Min(value, 3));
+            if (FlacDecoder.ConfigureIoBackend(backend))
+                Logger.LogInfo($"FLAC I/O backend: {FlacDecoder.GetEffectiveIoBackend()}");
+            else
+                Logger.LogWarning($"Failed to set FLAC I/O backend {backend}");
+        }
+
         /// <summary>
         /// 订阅 MusicRegistry 事件以同步到游戏的 MusicService
         /// </summary>
@@ -420,6 +440,7 @@ namespace ChillPatcher
                     EventBus.Instance,
                     DefaultCoverProvider.Instance,
                     CoreAudioLoader.Instance,
+                    CoreCoverThumbnailLoader.Instance,
                     dependencyLoader
                 );
 
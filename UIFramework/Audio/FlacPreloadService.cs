@@ -0,0 +1,137 @@
+using System;
+using System.Collections.Generic;
+using System.IO;
+using Bulbul;
+using ChillPatcher.Native;
+using ChillPatcher.UIFramework.Music;
+
+namespace ChillPatcher.UIFramework.Audio
+{
+    /// <summary>
+    /// 播放队列 FLAC 预加载服务
+    /// 跟随 PlayQueueManager 的队列变化，让 Native 预加载器提前打开接下来的本地 FLAC 并预解码开头，
+    /// 切歌时 GameAudioInfo 的流式加载通过 TryTake 直接取用待命流
+    /// </summary>
+    public static class FlacPreloadService
+    {
+        private static readonly object _lock = new object();
+        private static FlacDecoder.FlacStreamPreloader _preloader;
+        private static bool _initialized;
+
+        // 最近一次交给流式加载的文件（正在播放），不再为它预加载
+        private static string _activePath;
+
+        /// <summary>
+        /// 订阅播放队列事件（FlacPreloadCount 为 0 时不启用）
+        /// </summary>
+        public static void Initialize()
+        {
+            if (_initialized || UIFrameworkConfig.FlacPreloadCount.Value <= 0)
+                return;
+
+            PlayQueueManager.Instance.OnQueueChanged += Refresh;
+            PlayQueueManager.Instance.OnCurrentChanged += _ => Refresh();
+            _initialized = true;
+            Plugin.Log.LogInfo($"[FlacPreload] Initialized (count: {UIFrameworkConfig.FlacPreloadCount.Value})");
+        }
+
+        /// <summary>
+        /// 取走已预加载的流，没有时返回 null（调用者照常打开）。可在后台线程调用，条目正在打开时等待打开完成
+        /// </summary>
+        public static FlacDecoder.FlacStreamReader TryTake(string filePath)
+        {
+            string path = NormalizePath(filePath);
+            FlacDecoder.FlacStreamPreloader preloader;
+            lock (_lock)
+            {
+                _activePath = path;
+                preloader = _preloader;
+            }
+            if (preloader == null || path == null)
+                return null;
+
+            var reader = FlacDecoder.FlacStreamReader.TryTakePrepared(preloader, path);
+            if (reader != null)
+            {
+                Plugin.Log.LogInfo($"[FlacPreload] Promoted prepared stream: {Path.GetFileName(path)}");
+            }
+            return reader;
+        }
+
+        /// <summary>
+        /// 按当前队列更新预加载列表（主线程）
+        /// </summary>
+        private static void Refresh()
+        {
+            try
+            {
+                var paths = CollectUpcoming(UIFrameworkConfig.FlacPreloadCount.Value);
+                var preloader = EnsurePreloader();
+                preloader?.Prepare(paths);
+            }
+            catch (Exception ex)
+            {
+                Plugin.Log.LogWarning($"[FlacPreload] Failed to update preload list: {ex.Message}");
+            }
+        }
+
+        /// <summary>
+        /// 队列中接下来的本地 FLAC（队首即将播放但尚未加载时也包括在内）
+        /// </summary>
+        private static List<string> CollectUpcoming(int count)
+        {
+            var queue = PlayQueueManager.Instance.Queue;
+            var paths = new List<string>(count);
+            string active;
+            lock (_lock)
+            {
+                active = _activePath;
+            }
+
+            for (int i = 0; i < queue.Count && paths.Count < count; i++)
+            {
+                var audio = queue[i];
+                if (audio == null || audio.PathType != AudioMode.LocalPc || string.IsNullOrEmpty(audio.LocalPath))
+                    continue;
+                if (!string.Equals(Path.GetExtension(audio.LocalPath), ".flac", StringComparison.OrdinalIgnoreCase))
+                    continue;
+
+                string path = NormalizePath(audio.LocalPath);
+                if (path == null || (i == 0 && path == active) || paths.Contains(path))
+                    continue;
+                paths.Add(path);
+            }
+            return paths;
+        }
+
+        private static FlacDecoder.FlacStreamPreloader EnsurePreloader()
+        {
+            lock (_lock)
+            {
+                if (_preloader == null && FlacDecoder.IsAvailable())
+                {
+                    _preloader = new FlacDecoder.FlacStreamPreloader(
+                        UIFrameworkConfig.FlacDecodeAheadMs.Value,
+                        UIFrameworkConfig.FlacOutputSampleRate.Value,
+                        UIFrameworkConfig.FlacDownmixChannels.Value);
+                }
+                return _preloader;
+            }
+        }
+
+        // 预加载器按路径字符串匹配，队列和加载请求使用同一种写法
+        private static string NormalizePath(string filePath)
+        {
+            if (string.IsNullOrEmpty(filePath))
+                return null;
+            try
+            {
+                return Path.GetFullPath(filePath);
+            }
+            catch (Exception)
+            {
+                return null;
+            }
+        }
+    }
+}
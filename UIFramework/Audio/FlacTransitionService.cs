@@ -0,0 +1,424 @@
+using System;
+using System.IO;
+using System.Threading;
+using Bulbul;
+using Cysharp.Threading.Tasks;
+using KanKikuchi.AudioManager;
+using UnityEngine;
+using ChillPatcher.Native;
+using ChillPatcher.UIFramework.Music;
+
+namespace ChillPatcher.UIFramework.Audio
+{
+    /// <summary>
+    /// 本地 FLAC 过渡服务（FlacTransitionMode 为 0 时不启用）
+    /// 所有本地 FLAC 共用一个长流式 AudioClip，PCM 回调只读取 Native 过渡引擎的混合输出：
+    /// - 切歌时新曲目以“立即切换”排入引擎（交叉淡化时当前曲目淡出），共享 clip 不停止也不重新 Play
+    /// - 当前曲目接近结尾时把播放队列中的下一首（本地 FLAC）排入引擎，由引擎无缝衔接或交叉淡化；
+    ///   引擎切换曲目后调用 SkipCurrentMusic 让托管侧跟上，加载时直接接管引擎中已在播放的流
+    /// - 下一首不是本地 FLAC 时引擎播放到结尾，按原来的方式切到下一首
+    /// </summary>
+    public static class FlacTransitionService
+    {
+        // 共享 clip 的时长：远长于单首曲目，Unity 不会在两次 Play 之间播放到 clip 结尾
+        private const int CLIP_HOURS = 6;
+
+        // 下一首在当前曲目剩余多少秒时排入引擎（另加交叉淡化时长），留出打开文件和预解码的时间
+        private const float QUEUE_LEAD_SECONDS = 15f;
+
+        private static FlacDecoder.FlacTransitionEngine _engine;
+        private static AudioClip _clip;
+
+        // 共享 clip 的 PCM 回调读取的引擎（回调只经由它访问引擎）
+        private static EngineFeed _feed;
+
+        // 引擎中已排队的下一首（规范化路径）
+        private static string _queuedPath;
+
+        // 引擎已自动切换到、等待托管侧加载时接管的曲目
+        private static string _adoptPath;
+
+        // 排入下一首时引擎的曲目序号，序号变化说明引擎已切换到下一首
+        private static uint _serial;
+
+        // 引擎当前曲目的代数：切歌或接管时加 1，后台打开的下一首据此判断是否过期
+        private static int _generation;
+
+        // 当前曲目是否已尝试过排入下一首 / 下一首是否正在打开 / 是否已处理过播放结束
+        private static bool _nextChecked;
+        private static bool _queueing;
+        private static bool _endHandled;
+
+        /// <summary>
+        /// 是否启用（配置开启且 Native 解码器可用）
+        /// </summary>
+        public static bool IsEnabled => UIFrameworkConfig.FlacTransitionMode.Value > 0 && FlacDecoder.IsAvailable();
+
+        /// <summary>
+        /// 是否为过渡引擎的共享 clip
+        /// </summary>
+        public static bool IsTransitionClip(AudioClip clip)
+        {
+            return clip != null && _clip != null && clip == _clip;
+        }
+
+        /// <summary>
+        /// 共享 clip 是否正在播放
+        /// </summary>
+        public static bool IsPlaying
+        {
+            get
+            {
+                if (_clip == null)
+                    return false;
+                var player = SingletonMonoBehaviour<MusicManager>.Instance.GetPlayer(_clip);
+                return player != null && player.AudioSource != null && player.AudioSource.isPlaying;
+            }
+        }
+
+        /// <summary>
+        /// 歌曲是否会经由过渡引擎播放（本地 FLAC，尚未加载为其他 clip）
+        /// </summary>
+        public static bool CanHandle(GameAudioInfo audio)
+        {
+            if (!IsEnabled || audio == null)
+                return false;
+            if (audio.AudioClip != null && !IsTransitionClip(audio.AudioClip))
+                return false;
+            return IsLocalFlac(audio);
+        }
+
+        /// <summary>
+        /// 引擎已自动切换到该文件时返回共享 clip，托管侧直接接管，不再打开新流
+        /// </summary>
+        public static bool TryAdopt(string filePath, out AudioClip clip)
+        {
+            clip = null;
+            if (_adoptPath == null || _clip == null || NormalizePath(filePath) != _adoptPath)
+                return false;
+
+            clip = _clip;
+            _adoptPath = null;
+            _generation++;
+            _nextChecked = false;
+            _endHandled = false;
+            Plugin.Log.LogInfo($"[FlacTransition] Adopted track from engine: {Path.GetFileName(filePath)}");
+            return true;
+        }
+
+        /// <summary>
+        /// 读取文件的编码器填充裁剪量（可在后台线程调用）
+        /// </summary>
+        public static FlacDecoder.FlacGaplessTrim GetTrim(string filePath, FlacDecoder.FlacStreamReader reader)
+        {
+            return FlacDecoder.FlacTransitionEngine.GetGaplessTrim(filePath, reader.SampleRate);
+        }
+
+        /// <summary>
+        /// 把刚打开的流以“立即切换”排入引擎，返回共享 clip（主线程）
+        /// 成功后流归引擎所有；返回 null 时流仍由调用者持有，按普通流式 clip 播放
+        /// </summary>
+        public static AudioClip Attach(FlacDecoder.FlacStreamReader reader, FlacDecoder.FlacGaplessTrim trim, string filePath)
+        {
+            if (!IsEnabled || reader == null)
+                return null;
+
+            try
+            {
+                // 共享 clip 正在播放且格式相同时沿用引擎（当前曲目按设置淡出），否则重新创建
+                bool reuse = _engine != null && _engine.SampleRate == reader.SampleRate &&
+                             _engine.Channels == reader.Channels && IsPlaying;
+                if (!reuse)
+                {
+                    Release();
+                    _engine = new FlacDecoder.FlacTransitionEngine(reader.SampleRate, reader.Channels);
+                    _feed = new EngineFeed { Engine = _engine };
+                    _clip = CreateClip(_feed);
+                }
+                ApplyMode();
+
+                if (!_engine.Queue(reader, trim, now: true))
+                {
+                    if (!reuse)
+                        Release();
+                    return null;
+                }
+
+                _queuedPath = null;
+                _adoptPath = null;
+                _generation++;
+                _nextChecked = false;
+                _endHandled = false;
+
+                Plugin.Log.LogInfo($"[FlacTransition] Switched to {Path.GetFileName(filePath)}" +
+                    (trim.LeadingFrames > 0 || trim.TrailingFrames > 0 ? $" (trim {trim.LeadingFrames}/{trim.TrailingFrames} frames)" : ""));
+                return _clip;
+            }
+            catch (Exception ex)
+            {
+                Plugin.Log.LogWarning($"[FlacTransition] Failed to attach stream: {ex.Message}");
+                return null;
+            }
+        }
+
+        /// <summary>
+        /// 停止共享 clip（切到不经过引擎的歌曲时调用）
+        /// </summary>
+        public static void Stop()
+        {
+            if (_clip != null && SingletonMonoBehaviour<MusicManager>.Instance.GetPlayer(_clip) != null)
+            {
+                SingletonMonoBehaviour<MusicManager>.Instance.Stop(_clip);
+            }
+        }
+
+        /// <summary>
+        /// 当前曲目的播放进度（0~1），clip 不是共享 clip 时返回 false
+        /// </summary>
+        public static bool TryGetProgress(AudioClip clip, out float progress)
+        {
+            progress = 0f;
+            if (!IsTransitionClip(clip) || _engine == null)
+                return false;
+
+            var status = _engine.GetStatus();
+            if (status.Length > 0)
+                progress = Mathf.Clamp01((float)status.Position / status.Length);
+            return true;
+        }
+
+        /// <summary>
+        /// 按进度定位当前曲目，clip 不是共享 clip 时返回 false
+        /// </summary>
+        public static bool TrySeek(AudioClip clip, float progress)
+        {
+            if (!IsTransitionClip(clip) || _engine == null)
+                return false;
+
+            var status = _engine.GetStatus();
+            if (status.Length > 0)
+                _engine.Seek((ulong)(status.Length * (double)Mathf.Clamp01(progress)));
+            return true;
+        }
+
+        /// <summary>
+        /// 共享 clip 播放中每帧调用（AudioPlayer.Update）：跟随引擎的曲目切换，按需排入下一首
+        /// </summary>
+        /// <returns>是否触发了切歌</returns>
+        public static bool Update(MusicService musicService)
+        {
+            if (_engine == null || musicService == null)
+                return false;
+
+            var status = _engine.GetStatus();
+
+            // 引擎已切换到排队的下一首：让托管侧跟上（加载时经 TryAdopt 接管，不打断播放）
+            if (_queuedPath != null && status.Serial != _serial)
+            {
+                _adoptPath = _queuedPath;
+                _queuedPath = null;
+                _serial = status.Serial;
+                Plugin.Log.LogInfo($"[FlacTransition] Engine moved to next track: {Path.GetFileName(_adoptPath)}");
+                musicService.SkipCurrentMusic(MusicChangeKind.Auto).Forget<bool>();
+                return true;
+            }
+
+            // 接近结尾时排入下一首（托管侧尚未接管上一次切换时不排）
+            if (!_nextChecked && _adoptPath == null && status.Length > 0 &&
+                (status.State == FlacDecoder.FlacTransitionState.Playing || status.State == FlacDecoder.FlacTransitionState.Ended))
+            {
+                float remaining = (float)(status.Length - Math.Min(status.Position, status.Length)) / _engine.SampleRate;
+                float lead = QUEUE_LEAD_SECONDS + Mathf.Max(0, UIFrameworkConfig.FlacCrossfadeMs.Value) / 1000f;
+                if (remaining <= lead)
+                {
+                    _nextChecked = true;
+                    QueueNextAsync(musicService, _engine, _generation).Forget();
+                }
+            }
+
+            // 没有排队的下一首，播放结束：按原来的方式切到下一首
+            if (status.State == FlacDecoder.FlacTransitionState.Ended && _queuedPath == null && !_queueing && !_endHandled)
+            {
+                _endHandled = true;
+                Plugin.Log.LogInfo("[FlacTransition] Track ended without a queued successor, skipping");
+                musicService.SkipCurrentMusic(MusicChangeKind.Auto).Forget<bool>();
+                return true;
+            }
+            return false;
+        }
+
+        /// <summary>
+        /// 把播放队列中的下一首排入引擎（后台打开，主线程排队）
+        /// </summary>
+        private static async UniTaskVoid QueueNextAsync(MusicService musicService, FlacDecoder.FlacTransitionEngine engine, int generation)
+        {
+            // 单曲循环时队列中的下一首不是接下来播放的曲目
+            var queue = PlayQueueManager.Instance.Queue;
+            if (musicService.IsRepeatOneMusic || queue.Count < 2 || !IsLocalFlac(queue[1]))
+                return;
+
+            string path = NormalizePath(queue[1].LocalPath);
+            if (path == null)
+                return;
+
+            FlacDecoder.FlacStreamReader reader = null;
+            var trim = default(FlacDecoder.FlacGaplessTrim);
+            _queueing = true;
+            try
+            {
+                await UniTask.RunOnThreadPool(() =>
+                {
+                    reader = FlacPreloadService.TryTake(path) ?? new FlacDecoder.FlacStreamReader(
+                        path,
+                        UIFrameworkConfig.FlacDecodeAheadMs.Value,
+                        UIFrameworkConfig.FlacOutputSampleRate.Value,
+                        UIFrameworkConfig.FlacDownmixChannels.Value);
+                    trim = GetTrim(path, reader);
+                });
+                await UniTask.SwitchToMainThread();
+            }
+            catch (Exception ex)
+            {
+                Plugin.Log.LogWarning($"[FlacTransition] Failed to open next track: {ex.Message}");
+                reader?.Dispose();
+                return;
+            }
+            finally
+            {
+                _queueing = false;
+            }
+
+            // 打开期间已切歌或引擎已重建
+            if (engine != _engine || generation != _generation)
+            {
+                reader.Dispose();
+                return;
+            }
+
+            // 格式不同的曲目不能接在同一个引擎后面，播放结束后按原来的方式切歌
+            if (reader.SampleRate != engine.SampleRate || reader.Channels != engine.Channels || !engine.Queue(reader, trim, now: false))
+            {
+                Plugin.Log.LogInfo($"[FlacTransition] Next track cannot be joined ({reader.SampleRate}Hz, {reader.Channels}ch): {Path.GetFileName(path)}");
+                reader.Dispose();
+                return;
+            }
+
+            _queuedPath = path;
+            _serial = engine.GetStatus().Serial;
+            Plugin.Log.LogInfo($"[FlacTransition] Queued next track: {Path.GetFileName(path)}");
+        }
+
+        private static void ApplyMode()
+        {
+            var mode = UIFrameworkConfig.FlacTransitionMode.Value >= 2
+                ? FlacDecoder.FlacTransitionMode.Crossfade
+                : FlacDecoder.FlacTransitionMode.Gapless;
+            int crossfadeMs = Mathf.Clamp(UIFrameworkConfig.FlacCrossfadeMs.Value, 0, 20000);
+            var curve = (FlacDecoder.FlacFadeCurve)Mathf.Clamp(UIFrameworkConfig.FlacCrossfadeCurve.Value, 0, 2);
+            _engine.SetMode(mode, crossfadeMs, curve);
+        }
+
+        /// <summary>
+        /// PCM 回调与主线程之间的交接：主线程摘下引擎后回调只输出静音，
+        /// 回调退出 Read 之前引擎不会被关闭
+        /// </summary>
+        private sealed class EngineFeed
+        {
+            public FlacDecoder.FlacTransitionEngine Engine;
+
+            // 正在读取引擎的回调数（音频线程）
+            public int Readers;
+        }
+
+        private static AudioClip CreateClip(EngineFeed feed)
+        {
+            // 读取只在音频线程进行；Unity 的位置回调（Play 时的 0 等）不影响引擎，定位经 TrySeek 投递
+            var engine = feed.Engine;
+            int frames = (int)Math.Min((long)engine.SampleRate * 3600 * CLIP_HOURS, int.MaxValue / engine.Channels);
+            return AudioClip.Create(
+                "flac_transition",
+                frames,
+                engine.Channels,
+                engine.SampleRate,
+                stream: true,
+                (float[] data) =>
+                {
+                    // 先登记再取引擎：主线程摘下引擎后看到 Readers 为 0，之后的回调只会取到 null
+                    Interlocked.Increment(ref feed.Readers);
+                    try
+                    {
+                        var current = Volatile.Read(ref feed.Engine);
+                        if (current != null)
+                            current.Read(data);
+                        else
+                            Array.Clear(data, 0, data.Length);
+                    }
+                    catch (Exception ex)
+                    {
+                        Plugin.Log.LogError($"[FlacTransition] Error in PCM callback: {ex.Message}");
+                        Array.Clear(data, 0, data.Length);
+                    }
+                    finally
+                    {
+                        Interlocked.Decrement(ref feed.Readers);
+                    }
+                },
+                (int newPosition) => { });
+        }
+
+        /// <summary>
+        /// 停止共享 clip 并摘下引擎，引擎在音频线程退出读取后的下一帧关闭
+        /// </summary>
+        private static void Release()
+        {
+            Stop();
+            var engine = Interlocked.Exchange(ref _engine, null);
+            var feed = _feed;
+            _feed = null;
+            if (feed != null)
+                Interlocked.Exchange(ref feed.Engine, null);
+            if (engine != null)
+                DisposeWhenIdleAsync(feed, engine).Forget();
+            if (_clip != null)
+            {
+                UnityEngine.Object.Destroy(_clip);
+                _clip = null;
+            }
+            _queuedPath = null;
+            _adoptPath = null;
+        }
+
+        /// <summary>
+        /// 等音频线程不再读取摘下的引擎后关闭它（主线程，至少等一帧）
+        /// </summary>
+        private static async UniTaskVoid DisposeWhenIdleAsync(EngineFeed feed, FlacDecoder.FlacTransitionEngine engine)
+        {
+            do
+            {
+                await UniTask.Yield();
+            }
+            while (feed != null && Volatile.Read(ref feed.Readers) != 0);
+            engine.Dispose();
+        }
+
+        private static bool IsLocalFlac(GameAudioInfo audio)
+        {
+            return audio != null && audio.PathType == AudioMode.LocalPc && !string.IsNullOrEmpty(audio.LocalPath) &&
+                   string.Equals(Path.GetExtension(audio.LocalPath), ".flac", StringComparison.OrdinalIgnoreCase);
+        }
+
+        private static string NormalizePath(string filePath)
+        {
+            if (string.IsNullOrEmpty(filePath))
+                return null;
+            try
+            {
+                return Path.GetFullPath(filePath);
+            }
+            catch (Exception)
+            {
+                return null;
+            }
+        }
+    }
+}
@@ -18,6 +18,12 @@ namespace ChillPatcher.UIFramework.Audio
     /// </summary>
     public static class StreamingAudioLoader
     {
+        /// <summary>
+        /// 位置回调的去重容差（毫秒）
+        /// 覆盖 AudioSource.time 的浮点误差以及 Seek 与回调之间音频线程已读取的数据
+        /// </summary>
+        private const int SEEK_DEDUP_TOLERANCE_MS = 100;
+
         /// <summary>
         /// 检查歌曲是否是流媒体源
         /// </summary>
@@ -329,9 +335,11 @@ namespace ChillPatcher.UIFramework.Audio
         {
             if (reader == null) return;
 
-            // 如果是从 SetProgress 发起的 Seek，跳过这个回调
-            // 因为 SetProgress 已经调用过 reader.Seek() 了
-            if (Patches.UIFramework.MusicService_SetProgress_Patch.IsSeekingFromSetProgress)
+            // Seek 按目标位置去重：读取器已经位于（或正前往）该位置时跳过
+            // SetProgress 执行 Seek 后同步 AudioSource.time 会再次触发此回调，这里自然被忽略
+            long current = reader.HasPendingSeek ? reader.PendingSeekFrame : (long)reader.CurrentFrame;
+            long tolerance = (long)reader.Info.SampleRate * SEEK_DEDUP_TOLERANCE_MS / 1000;
+            if (current >= 0 && Math.Abs(position - current) <= tolerance)
             {
                 return;
             }
@@ -367,6 +375,12 @@ namespace ChillPatcher.UIFramework.Audio
         {
             if (audioInfo == null) return null;
 
+            // 过渡引擎的共享 clip 不属于某一首歌，需要重新加载以排入引擎
+            if (FlacTransitionService.IsTransitionClip(audioInfo.AudioClip))
+            {
+                audioInfo.AudioClip = null;
+            }
+
             // 如果已经有 AudioClip，直接返回
             if (audioInfo.AudioClip != null)
             {
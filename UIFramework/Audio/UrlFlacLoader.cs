@@ -11,8 +11,8 @@ namespace ChillPatcher.UIFramework.Audio
     /// <summary>
     /// URL FLAC 加载器
     /// 实现边下边播功能：
-    /// 1. 后台下载 FLAC 文件到缓存
-    /// 2. 等待足够的缓冲数据后开始解码
+    /// 1. 后台下载 FLAC 数据，直接推送到 Native 解码器（不经过临时文件）
+    /// 2. 收到完整元数据和足够的缓冲数据后开始解码
     /// 3. 播放过程中监控缓冲状态
     /// 4. 缓冲不足时自动静音（不影响 UI 播放状态）
     /// </summary>
@@ -23,11 +23,11 @@ namespace ChillPatcher.UIFramework.Audio
         /// <summary>开始播放前需要的最小缓冲字节数（默认 32KB）</summary>
         public const int MIN_BUFFER_BEFORE_PLAY = 32 * 1024;
 
-        /// <summary>播放中暂停阈值（低于此值暂停等待）</summary>
-        public const int BUFFER_PAUSE_THRESHOLD = 8 * 1024;
-
-        /// <summary>播放中恢复阈值（高于此值才恢复播放）</summary>
-        public const int BUFFER_RESUME_THRESHOLD = 16 * 1024;
+        /// <summary>
+        /// 播放中恢复阈值（毫秒）
+        /// 可解码的音频不足以填满本次回调时暂停等待，积累到此时长后才恢复播放
+        /// </summary>
+        public const int BUFFER_RESUME_MS = 250;
 
         /// <summary>等待缓冲的检查间隔（毫秒）</summary>
         private const int BUFFER_CHECK_INTERVAL_MS = 50;
@@ -40,9 +40,8 @@ namespace ChillPatcher.UIFramework.Audio
         #region 字段
 
         private readonly string _url;
-        private readonly string _cacheFilePath;
-        private FileStream _writeStream;
-        private FlacDecoder.FlacStreamReader _flacReader;
+        private FlacDecoder.FlacStreamReader _pushReader;   // 下载线程推送数据的目标
+        private volatile FlacDecoder.FlacStreamReader _flacReader;  // 解码器就绪后才发布
         
         private volatile bool _disposed;
         private volatile bool _downloadComplete;
@@ -73,9 +72,6 @@ namespace ChillPatcher.UIFramework.Audio
         /// <summary>FLAC 流读取器</summary>
         public FlacDecoder.FlacStreamReader FlacReader => _flacReader;
 
-        /// <summary>缓存文件路径</summary>
-        public string CacheFilePath => _cacheFilePath;
-
         /// <summary>是否正在缓冲等待</summary>
         public bool IsBuffering => _isBuffering;
 
@@ -83,49 +79,43 @@ namespace ChillPatcher.UIFramework.Audio
         public bool IsReadyToPlay => _flacReader != null && DownloadedBytes >= MIN_BUFFER_BEFORE_PLAY;
 
         /// <summary>
-        /// 当前可用的缓冲字节数
-        /// 计算方法：已下载字节 - 当前读取位置对应的字节
+        /// 当前可用的缓冲帧数
+        /// 由 Native 扫描已下载数据中的帧头得出：已完整下载的帧 - 当前读取位置
         /// </summary>
-        public long AvailableBufferBytes
+        public long AvailableFrames
         {
             get
             {
                 if (_flacReader == null) return 0;
-                
-                // 估算：假设平均每帧占用的字节数
-                // FLAC 压缩比通常在 50-70%，这里用保守估计
-                var bytesPerFrame = _flacReader.Channels * 2.5f; // 16bit stereo ≈ 4 bytes/frame, 压缩后约 2.5
-                var currentBytePos = (long)(_flacReader.CurrentFrame * bytesPerFrame);
-                var availableBytes = Interlocked.Read(ref _downloadedBytes) - currentBytePos;
-                
-                return Math.Max(0, availableBytes);
+
+                var decodable = _flacReader.DecodableFrames;
+                var current = _flacReader.CurrentFrame;
+                return decodable > current ? (long)(decodable - current) : 0;
             }
         }
 
         /// <summary>
         /// 是否应该暂停等待缓冲（带滞后控制）
-        /// 低于 BUFFER_PAUSE_THRESHOLD 时进入缓冲状态
-        /// 高于 BUFFER_RESUME_THRESHOLD 时才恢复播放
+        /// 可解码帧数不足 framesNeeded（即本次回调必然欠载）时进入缓冲状态，
+        /// 积累到 BUFFER_RESUME_MS 的音频后才恢复播放
         /// </summary>
-        public bool ShouldWaitForBuffer
+        public bool ShouldWaitForBuffer(int framesNeeded)
         {
-            get
+            if (_downloadComplete) return false; // 下载完成，不需要等待
+
+            var availableFrames = AvailableFrames;
+
+            // 滞后控制逻辑
+            if (_isBuffering)
             {
-                if (_downloadComplete) return false; // 下载完成，不需要等待
-                
-                var availableBytes = AvailableBufferBytes;
-                
-                // 滞后控制逻辑
-                if (_isBuffering)
-                {
-                    // 已在缓冲状态，需要达到恢复阈值才能退出
-                    return availableBytes < BUFFER_RESUME_THRESHOLD;
-                }
-                else
-                {
-                    // 正常播放状态，低于暂停阈值才进入缓冲
-                    return availableBytes < BUFFER_PAUSE_THRESHOLD;
-                }
+                // 已在缓冲状态，需要达到恢复阈值才能退出
+                var resumeFrames = Math.Max(framesNeeded, (long)_flacReader.SampleRate * BUFFER_RESUME_MS / 1000);
+                return availableFrames < resumeFrames;
+            }
+            else
+            {
+                // 正常播放状态，不够填满本次回调才进入缓冲
+                return availableFrames < framesNeeded;
             }
         }
 
@@ -136,13 +126,6 @@ namespace ChillPatcher.UIFramework.Audio
         public UrlFlacLoader(string url)
         {
             _url = url ?? throw new ArgumentNullException(nameof(url));
-            
-            // 创建临时缓存文件
-            var cacheDir = Path.Combine(Path.GetTempPath(), "ChillPatcher", "flac_cache");
-            Directory.CreateDirectory(cacheDir);
-            _cacheFilePath = Path.Combine(cacheDir, $"stream_{Guid.NewGuid():N}.flac");
-            
-            Plugin.Log.LogDebug($"[UrlFlacLoader] Cache file: {_cacheFilePath}");
         }
 
         public void Dispose()
@@ -158,26 +141,10 @@ namespace ChillPatcher.UIFramework.Audio
                 // 等待下载任务完成
                 try { _downloadTask?.Wait(1000); } catch { }
 
-                // 关闭 FLAC 读取器
-                _flacReader?.Dispose();
+                // 关闭 FLAC 读取器（_flacReader 与 _pushReader 是同一个对象）
                 _flacReader = null;
-
-                // 关闭写入流
-                _writeStream?.Dispose();
-                _writeStream = null;
-
-                // 删除缓存文件
-                try
-                {
-                    if (File.Exists(_cacheFilePath))
-                    {
-                        File.Delete(_cacheFilePath);
-                    }
-                }
-                catch (Exception ex)
-                {
-                    Plugin.Log.LogWarning($"[UrlFlacLoader] Failed to delete cache: {ex.Message}");
-                }
+                _pushReader?.Dispose();
+                _pushReader = null;
             }
             catch (Exception ex)
             {
@@ -202,14 +169,8 @@ namespace ChillPatcher.UIFramework.Audio
             {
                 Plugin.Log.LogInfo($"[UrlFlacLoader] Starting download: {_url}");
 
-                // 创建写入流（允许共享读取）
-                _writeStream = new FileStream(
-                    _cacheFilePath, 
-                    FileMode.Create, 
-                    FileAccess.Write, 
-                    FileShare.Read,
-                    DOWNLOAD_BUFFER_SIZE,
-                    FileOptions.WriteThrough);
+                // 创建推送流，下载到的字节直接送入解码器
+                _pushReader = FlacDecoder.FlacStreamReader.CreatePush();
 
                 // 启动后台下载
                 _downloadCts = CancellationTokenSource.CreateLinkedTokenSource(cancellationToken);
@@ -237,10 +198,23 @@ namespace ChillPatcher.UIFramework.Audio
                 }
 
                 var downloadedBytes = Interlocked.Read(ref _downloadedBytes);
-                Plugin.Log.LogInfo($"[UrlFlacLoader] Buffer ready ({downloadedBytes} bytes), opening FLAC decoder...");
+                Plugin.Log.LogInfo($"[UrlFlacLoader] Buffer ready ({downloadedBytes} bytes), waiting for FLAC metadata...");
+
+                // 元数据（含封面）较大时需要等待更多数据，解码器才会打开
+                while (!_pushReader.TryGetStreamInfo())
+                {
+                    if (_downloadFailed || _downloadComplete)
+                    {
+                        // 下载已结束仍无法打开，说明数据本身无效
+                        Plugin.Log.LogError($"[UrlFlacLoader] Failed to open FLAC stream ({Interlocked.Read(ref _downloadedBytes)} bytes)");
+                        return false;
+                    }
+
+                    cancellationToken.ThrowIfCancellationRequested();
+                    await Task.Delay(BUFFER_CHECK_INTERVAL_MS, cancellationToken);
+                }
 
-                // 打开 FLAC 解码器
-                _flacReader = new FlacDecoder.FlacStreamReader(_cacheFilePath);
+                _flacReader = _pushReader;
 
                 Plugin.Log.LogInfo($"[UrlFlacLoader] ✅ Ready: {_flacReader.SampleRate}Hz, {_flacReader.Channels}ch, {_flacReader.TotalPcmFrames} frames");
 
@@ -260,8 +234,8 @@ namespace ChillPatcher.UIFramework.Audio
 
         /// <summary>
         /// 读取 PCM 帧（带缓冲检测和滞后控制）
-        /// 如果缓冲不足，阻塞等待直到数据可用
-        /// 使用滞后阈值：低于 8KB 暂停，高于 16KB 才恢复
+        /// 如果已下载的完整帧不足以填满本次回调，阻塞等待直到数据可用
+        /// 使用滞后阈值：不足本次回调时暂停，积累到 BUFFER_RESUME_MS 才恢复
         /// </summary>
         /// <param name="buffer">输出缓冲区</param>
         /// <param name="framesToRead">要读取的帧数</param>
@@ -275,20 +249,20 @@ namespace ChillPatcher.UIFramework.Audio
             }
 
             // 检查是否需要等待缓冲（带滞后控制）
-            if (ShouldWaitForBuffer)
+            if (ShouldWaitForBuffer(framesToRead))
             {
                 // 进入缓冲状态
                 if (!_isBuffering)
                 {
                     _isBuffering = true;
-                    Plugin.Log.LogDebug($"[UrlFlacLoader] 缓冲不足，开始等待... ({AvailableBufferBytes} bytes available)");
+                    Plugin.Log.LogDebug($"[UrlFlacLoader] 缓冲不足，开始等待... ({AvailableFrames} frames available)");
                 }
                 
                 // 使用 SpinWait 阻塞等待（无超时，直到数据足够或失败/取消）
                 var spinWait = new SpinWait();
                 var startTime = Environment.TickCount;
                 
-                while (ShouldWaitForBuffer && !_disposed && !_downloadFailed)
+                while (ShouldWaitForBuffer(framesToRead) && !_disposed && !_downloadFailed)
                 {
                     // 检查是否下载完成（下载完了就不用等了）
                     if (_downloadComplete)
@@ -316,13 +290,19 @@ namespace ChillPatcher.UIFramework.Audio
                 // 缓冲恢复，退出缓冲状态
                 var waitTime = Environment.TickCount - startTime;
                 _isBuffering = false;
-                Plugin.Log.LogDebug($"[UrlFlacLoader] 缓冲恢复，等待了 {waitTime}ms ({AvailableBufferBytes} bytes available)");
+                Plugin.Log.LogDebug($"[UrlFlacLoader] 缓冲恢复，等待了 {waitTime}ms ({AvailableFrames} frames available)");
             }
 
-            // 正常读取
+            // 正常读取（不足部分由 Native 填充静音）
             try
             {
-                return _flacReader.ReadFrames(buffer, (ulong)framesToRead);
+                long filled = _flacReader.FillBuffer(buffer);
+                if (filled < 0)
+                {
+                    Array.Clear(buffer, 0, buffer.Length);
+                    return framesToRead;
+                }
+                return filled;
             }
             catch (Exception ex)
             {
@@ -366,13 +346,17 @@ namespace ChillPatcher.UIFramework.Audio
                     {
                         cancellationToken.ThrowIfCancellationRequested();
 
-                        await _writeStream.WriteAsync(buffer, 0, bytesRead, cancellationToken);
-                        await _writeStream.FlushAsync(cancellationToken);
-                        
+                        // 推送给解码器，由 Native 确认哪些帧已完整
+                        if (!_pushReader.PushData(buffer, bytesRead))
+                        {
+                            throw new InvalidDataException("Downloaded data is not a valid FLAC stream");
+                        }
+
                         Interlocked.Add(ref _downloadedBytes, bytesRead);
                     }
                 }
 
+                _pushReader.FinishPush();
                 _downloadComplete = true;
                 Plugin.Log.LogInfo($"[UrlFlacLoader] Download complete: {Interlocked.Read(ref _downloadedBytes)} bytes");
             }
@@ -1,4 +1,5 @@
 using System;
+using ChillPatcher.Native;
 using UnityEngine;
 
 namespace ChillPatcher.UIFramework.Music
@@ -19,6 +20,11 @@ namespace ChillPatcher.UIFramework.Music
 
             try
             {
+                // 优先由 Native 一次完成缩放和圆形遮罩
+                var nativeSprite = TryCreateNativeSprite(source, resolution, circular: true);
+                if (nativeSprite != null)
+                    return nativeSprite;
+
                 // 创建圆形蒙版纹理
                 var circularTexture = new Texture2D(resolution, resolution, TextureFormat.RGBA32, false);
                 
@@ -90,6 +96,10 @@ namespace ChillPatcher.UIFramework.Music
                     );
                 }
 
+                var nativeSprite = TryCreateNativeSprite(source, resolution, circular: false);
+                if (nativeSprite != null)
+                    return nativeSprite;
+
                 // 创建缩放后的纹理
                 var scaledTexture = new Texture2D(resolution, resolution, TextureFormat.RGBA32, false);
                 var scaledColors = GetScaledPixels(source, resolution, resolution);
@@ -110,6 +120,59 @@ namespace ChillPatcher.UIFramework.Music
             }
         }
 
+        /// <summary>
+        /// 从 RGBA32 像素（Unity 行序）创建 Sprite（需在主线程调用）
+        /// </summary>
+        public static Sprite CreateSpriteFromRgba(byte[] rgba, int resolution)
+        {
+            if (rgba == null || rgba.Length != resolution * resolution * 4)
+                return null;
+
+            var texture = new Texture2D(resolution, resolution, TextureFormat.RGBA32, false);
+            texture.LoadRawTextureData(rgba);
+            texture.Apply();
+
+            return Sprite.Create(
+                texture,
+                new Rect(0, 0, resolution, resolution),
+                new Vector2(0.5f, 0.5f),
+                100f
+            );
+        }
+
+        /// <summary>
+        /// 从 DXT1 / DXT5 块数据创建 Sprite（需在主线程调用），数据直接上传，不经过像素解码
+        /// </summary>
+        public static Sprite CreateSpriteFromCompressed(byte[] blocks, int resolution, TextureFormat format)
+        {
+            int expected = format == TextureFormat.DXT5 ? resolution * resolution : resolution * resolution / 2;
+            if (blocks == null || blocks.Length != expected)
+                return null;
+
+            var texture = new Texture2D(resolution, resolution, format, false);
+            texture.LoadRawTextureData(blocks);
+            texture.Apply(false, false);
+
+            return Sprite.Create(
+                texture,
+                new Rect(0, 0, resolution, resolution),
+                new Vector2(0.5f, 0.5f),
+                100f
+            );
+        }
+
+        /// <summary>
+        /// 用 Native 缩放（和遮罩）可读纹理，不可用时返回 null 由托管实现处理
+        /// </summary>
+        private static Sprite TryCreateNativeSprite(Texture2D source, int resolution, bool circular)
+        {
+            if (!FlacDecoder.IsAvailable() || !source.isReadable)
+                return null;
+
+            var rgba = FlacDecoder.ResizeCoverPixels(source.GetPixels32(), source.width, source.height, resolution, circular);
+            return rgba != null ? CreateSpriteFromRgba(rgba, resolution) : null;
+        }
+
         /// <summary>
         /// 缩放像素数据
         /// </summary>
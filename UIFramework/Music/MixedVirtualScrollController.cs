@@ -48,6 +48,10 @@ namespace ChillPatcher.UIFramework.Music
         private bool _isInitialized = false;
         private int _bufferCount = 3;
         private bool _isPaused = false;
+        private bool _coverVisibilityDirty = false;
+
+        // 封面预加载范围：视口上下各多少项内的专辑封面提前解码，范围外的请求取消
+        private const int COVER_PREFETCH_COUNT = 20;
 
         #endregion
 
@@ -192,6 +196,7 @@ namespace ChillPatcher.UIFramework.Music
             ClearAllActiveItems();
 
             _items = items ?? new List<PlaylistListItem>();
+            _coverVisibilityDirty = true;
 
             // 计算位置
             RecalculatePositions();
@@ -229,6 +234,13 @@ namespace ChillPatcher.UIFramework.Music
                 _visibleStartIndex = start;
                 _visibleEndIndex = end;
                 OnVisibleRangeChanged?.Invoke(start, end);
+                _coverVisibilityDirty = true;
+            }
+
+            if (_coverVisibilityDirty)
+            {
+                _coverVisibilityDirty = false;
+                UpdateCoverVisibility();
             }
 
             // 检查是否滚动到底部
@@ -304,6 +316,21 @@ namespace ChillPatcher.UIFramework.Music
         /// 计算可见范围
         /// </summary>
         private (int start, int end) CalculateVisibleRange()
+        {
+            if (_items.Count == 0)
+                return (0, 0);
+
+            var (start, end) = CalculateViewportRange();
+            start = Mathf.Max(0, start - _bufferCount);
+            end = Mathf.Min(_items.Count, end + _bufferCount);
+
+            return (start, end);
+        }
+
+        /// <summary>
+        /// 计算视口实际覆盖的范围（不含缓冲项）
+        /// </summary>
+        private (int start, int end) CalculateViewportRange()
         {
             if (_items.Count == 0)
                 return (0, 0);
@@ -320,17 +347,41 @@ namespace ChillPatcher.UIFramework.Music
             float scrollPosition = _contentTransform.anchoredPosition.y;
 
             // 二分查找起始位置
-            int start = FindItemAtPosition(scrollPosition);
-            start = Mathf.Max(0, start - _bufferCount);
+            int start = Mathf.Max(0, FindItemAtPosition(scrollPosition));
 
             // 查找结束位置
             float endPosition = scrollPosition + viewportHeight;
-            int end = FindItemAtPosition(endPosition);
-            end = Mathf.Min(_items.Count, end + _bufferCount + 1);
+            int end = Mathf.Min(_items.Count, FindItemAtPosition(endPosition) + 1);
 
             return (start, end);
         }
 
+        /// <summary>
+        /// 把视口和预加载范围内的专辑告知 CoverService，用于封面解码的优先级和取消
+        /// </summary>
+        private void UpdateCoverVisibility()
+        {
+            var (viewStart, viewEnd) = CalculateViewportRange();
+            int prefetchStart = Mathf.Max(0, viewStart - COVER_PREFETCH_COUNT);
+            int prefetchEnd = Mathf.Min(_items.Count, viewEnd + COVER_PREFETCH_COUNT);
+
+            var visible = new List<string>();
+            var prefetch = new List<string>();
+            for (int i = prefetchStart; i < prefetchEnd; i++)
+            {
+                var item = _items[i];
+                if (item.ItemType != PlaylistItemType.AlbumHeader || item.AlbumHeader == null)
+                    continue;
+
+                if (i >= viewStart && i < viewEnd)
+                    visible.Add(item.AlbumHeader.AlbumId);
+                else
+                    prefetch.Add(item.AlbumHeader.AlbumId);
+            }
+
+            CoverService.Instance.UpdateAlbumCoverVisibility(visible, prefetch);
+        }
+
         /// <summary>
         /// 二分查找指定位置的项索引
         /// </summary>
@@ -477,6 +528,10 @@ namespace ChillPatcher.UIFramework.Music
             var go = new GameObject($"AlbumHeader_{index}");
             go.transform.SetParent(_contentTransform, false);
 
+            // 滚动中被取消的封面请求在专辑头重新渲染时补发
+            if (item.AlbumHeader.CoverImage != null)
+                item.AlbumHeader.CoverImage = CoverService.Instance.EnsureAlbumCoverRequested(item.AlbumHeader.AlbumId, item.AlbumHeader.CoverImage);
+
             var headerView = go.AddComponent<AlbumHeaderView>();
             headerView.Initialize();
             headerView.Setup(item.AlbumHeader);
@@ -558,8 +613,9 @@ namespace ChillPatcher.UIFramework.Music
                 _scrollRect.onValueChanged.RemoveListener(OnScrollValueChanged);
             }
 
-            // 取消订阅 CoverService 封面加载事件
+            // 取消订阅 CoverService 封面加载事件，并取消尚未完成的封面请求
             CoverService.Instance.OnAlbumCoverLoaded -= OnCoverLoaded;
+            CoverService.Instance.ResetAlbumCoverVisibility();
 
             ClearAllActiveItems();
 
@@ -54,6 +54,52 @@ namespace ChillPatcher
         /// 虚拟滚动缓冲区大小（默认：3）
         /// </summary>
         public static ConfigEntry<int> VirtualScrollBufferSize { get; private set; }
+
+        /// <summary>
+        /// 本地 FLAC 预解码缓冲时长（毫秒，默认：0=关闭）
+        /// 开启后由 Native 后台线程提前解码，音频线程只拷贝数据，避免磁盘卡顿导致爆音
+        /// </summary>
+        public static ConfigEntry<int> FlacDecodeAheadMs { get; private set; }
+
+        /// <summary>
+        /// 本地 FLAC 输出采样率（Hz，默认：0=保持源采样率）
+        /// 设置后由 Native 高质量重采样器转换，避免 Unity 对高采样率文件做低质量转换
+        /// </summary>
+        public static ConfigEntry<int> FlacOutputSampleRate { get; private set; }
+
+        /// <summary>
+        /// 本地多声道 FLAC 缩混后的声道数（默认：0=保持源声道数，1=单声道，2=立体声）
+        /// 设置后 5.1 / 7.1 文件在 Native 侧缩混，减少跨 P/Invoke 拷贝和预解码缓冲的数据量
+        /// </summary>
+        public static ConfigEntry<int> FlacDownmixChannels { get; private set; }
+
+        /// <summary>
+        /// 预加载播放队列中接下来的本地 FLAC 数量（默认：2，0=关闭）
+        /// Native 后台提前打开并预解码开头，切歌时直接取用，减少两首歌之间的空白
+        /// </summary>
+        public static ConfigEntry<int> FlacPreloadCount { get; private set; }
+
+        /// <summary>
+        /// 本地 FLAC 曲目之间的衔接方式（默认：0=关闭，1=无缝，2=交叉淡化）
+        /// 开启后由 Native 过渡引擎持有前后两首的流并混合为一路连续输出，不再等托管侧检测到结尾后再加载下一首
+        /// </summary>
+        public static ConfigEntry<int> FlacTransitionMode { get; private set; }
+
+        /// <summary>
+        /// 交叉淡化时长（毫秒，默认：6000），无缝模式下用于手动切歌时的淡出（0=直接切换）
+        /// </summary>
+        public static ConfigEntry<int> FlacCrossfadeMs { get; private set; }
+
+        /// <summary>
+        /// 交叉淡化曲线（默认：0=等功率 sin/cos，1=等功率平方根，2=线性）
+        /// </summary>
+        public static ConfigEntry<int> FlacCrossfadeCurve { get; private set; }
+
+        /// <summary>
+        /// 本地 FLAC 的读取方式（默认：0=自动（内存映射），1=内存映射，2=线程池异步读取，3=io_uring 异步读取）
+        /// 机械硬盘、网络共享等慢速存储上选 2 或 3，由独立的 I/O 队列提前读取，缺页不再落在解码线程上
+        /// </summary>
+        public static ConfigEntry<int> FlacIoBackend { get; private set; }
         
         public static void Initialize(ConfigFile config)
         {
@@ -114,6 +160,62 @@ namespace ChillPatcher
                 3,
                 "Virtual scroll buffer size"
             );
+
+            FlacDecodeAheadMs = config.Bind(
+                "Advanced",
+                "FlacDecodeAheadMs",
+                0,  // 默认关闭
+                "Decode local FLAC files ahead on a native background thread (buffer length in ms, 0 = disabled)"
+            );
+
+            FlacOutputSampleRate = config.Bind(
+                "Advanced",
+                "FlacOutputSampleRate",
+                0,  // 默认关闭
+                "Resample local FLAC files natively to this sample rate in Hz (e.g. 48000, 0 = keep source rate)"
+            );
+
+            FlacDownmixChannels = config.Bind(
+                "Advanced",
+                "FlacDownmixChannels",
+                0,  // 默认关闭
+                "Downmix multi-channel local FLAC files natively using ITU coefficients (2 = stereo, 1 = mono, 0 = keep source channels)"
+            );
+
+            FlacPreloadCount = config.Bind(
+                "Advanced",
+                "FlacPreloadCount",
+                2,
+                "Number of upcoming local FLAC tracks in the play queue to open and pre-decode in the background (0 = disabled)"
+            );
+
+            FlacTransitionMode = config.Bind(
+                "Advanced",
+                "FlacTransitionMode",
+                0,  // 默认关闭
+                "Join consecutive local FLAC tracks in a native transition engine (0 = disabled, 1 = gapless, 2 = crossfade)"
+            );
+
+            FlacCrossfadeMs = config.Bind(
+                "Advanced",
+                "FlacCrossfadeMs",
+                6000,
+                "Crossfade length in ms for the FLAC transition engine (0~20000; in gapless mode only used to fade out on manual track changes)"
+            );
+
+            FlacCrossfadeCurve = config.Bind(
+                "Advanced",
+                "FlacCrossfadeCurve",
+                0,
+                "Crossfade curve for the FLAC transition engine (0 = equal-power sine, 1 = equal-power square root, 2 = linear)"
+            );
+
+            FlacIoBackend = config.Bind(
+                "Advanced",
+                "FlacIoBackend",
+                0,  // 默认内存映射
+                "How local FLAC files are read (0 = auto/memory-mapped, 1 = memory-mapped, 2 = async thread pool, 3 = async io_uring, falls back to the thread pool when unavailable). Use 2 or 3 on slow storage such as HDDs or network shares"
+            );
         }
     }
 }
@@ -223,6 +223,7 @@ if not exist "%LicenseDir%" mkdir "%LicenseDir%"
 if exist "LICENSE" copy /y "LICENSE" "%LicenseDir%\ChillPatcher-LICENSE.txt" >nul
 if exist "rime\librime\LICENSE" copy /y "rime\librime\LICENSE" "%LicenseDir%\librime-LICENSE.txt" >nul
 if exist "NativePlugins\dr_libs\LICENSE" copy /y "NativePlugins\dr_libs\LICENSE" "%LicenseDir%\dr_libs-LICENSE.txt" >nul
+if exist "NativePlugins\stb\LICENSE" copy /y "NativePlugins\stb\LICENSE" "%LicenseDir%\stb-LICENSE.txt" >nul
 
 echo.
 echo ========================================